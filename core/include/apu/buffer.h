@@ -10,7 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Where is the buffer and how reads or writes are behaviour
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-enum class buffer_location_t
+enum class buffer_location_t : uint8_t
 {
 	UNKNOWN = 0,
 	HOST = 1,
@@ -19,7 +19,7 @@ enum class buffer_location_t
 	VIDEO = 4
 };
 
-enum class buffer_operation_frequency_t
+enum class buffer_operation_frequency_t : uint8_t
 {
 	NEVER = 0,
 	ONCE = 1,
@@ -80,7 +80,7 @@ enum class sampler_read_t
 	LINEAR = 2
 };
 
-enum class sampler_wrap_mode_t
+enum class sampler_wrap_mode_t : uint8_t
 {
 	REPEAT = 0,
 	MIRROR = 1,
@@ -108,6 +108,15 @@ enum class buffer_object_layout_t
 	CUBE = 4
 };
 
+// How vexels are ordered inside each surface. When tiled, row_byte_count is the step between rows of tiles and the
+// vexels of a tile are in Z (Morton) order, x in the low bit.
+enum class buffer_tiling_t : uint8_t
+{
+	LINEAR = 0,			// rows of row_byte_count bytes
+	MORTON_4X4 = 1,		// 4x4 vexel micro-tiles
+	MORTON_64X64 = 2,	// 64 bytes x 64 rows tiles (4 KiB); vexels of 1, 2, 4, 8, 16, 32 or 64 bytes
+};
+
 struct buffer_object_size_t
 {
 	uint64_t width;
@@ -132,4 +141,5 @@ struct buffer_layout_t
 	uint64_t byte_count;
 	uint32_t array_count;
 	uint32_t lod_count;
+	buffer_tiling_t tiling;
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <apu/buffer.h>
+#include <core/threading.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Anillo de memoria por frame
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Sub-reservas transitorias (constantes de cada draw, vértices dinámicos) de un solo bloque de memoria, sin cerrojos ni
+liberaciones individuales. El bloque se divide en chunks de chunk_byte_count bytes que se entregan en orden circular:
+	- Cada hebra tiene su cursor (una línea de caché) y reserva dentro de su chunk con un CAS sobre su propio estado, así
+	  que en el caso normal no comparte líneas con nadie. Al llenarse el chunk toma el siguiente del anillo con un CAS
+	  sobre head. Las reservas de más de un chunk toman varios seguidos (sin dar la vuelta al final del bloque).
+	- frame_ring_next_frame() cierra el frame: desde ahí los cursores con chunks del frame anterior piden uno nuevo y los
+	  chunks del frame que ahora queda frames_in_flight frames atrás vuelven a estar libres, todos de una vez. Quien
+	  llama garantiza con sus fences que el consumidor ha terminado ese frame y que no hay reservas en curso.
+	- Si los frames en vuelo ocupan todo el anillo la reserva devuelve nullptr (failed_count) y el llamante recurre a
+	  otra memoria; nunca se espera.
+Los desplazamientos (offset) son desde el inicio del bloque, para enlazar la región en un buffer mapeado que cubra el
+bloque entero (memory en frame_ring_init()).
+*/
+
+struct frame_ring_config_t
+{
+	uint64_t	byte_count = 8ull << 20;
+	uint32_t	chunk_byte_count = 64u << 10;	// potencia de dos, de 256 bytes a 8 MiB
+	uint32_t	frames_in_flight = 3;
+	uint32_t	cursor_count = 0;				// cursores de hebra (0 = 2 por hebra de parallel_thread_count())
+	uint64_t	first_frame = 0;				// número del frame con el que empieza el anillo
+};
+
+struct alignas(CACHELINE) frame_ring_cursor_t
+{
+	std::atomic<uint64_t>	state{ 0 };			// (chunk + 1) << 24 | bytes usados; 0 = sin chunk
+};
+
+struct frame_ring_t
+{
+	uint8_t*								data = nullptr;
+	uint64_t								byte_count = 0;
+	uint64_t								chunk_count = 0;
+	uint32_t								chunk_shift = 0;
+	uint32_t								frames_in_flight = 0;
+	uint32_t								cursor_count = 0;
+	bool									owns_data = false;
+	std::unique_ptr<frame_ring_cursor_t[]>	cursors;
+	std::unique_ptr<uint64_t[]>				frame_starts;		// primer chunk de cada frame en vuelo (frame % frames)
+	uint64_t								frame = 0;
+
+	alignas(CACHELINE) std::atomic<uint64_t>	head{ 0 };		// siguiente chunk (cuenta sin dar la vuelta)
+	std::atomic<uint64_t>					limit{ 0 };			// head no pasa de aquí
+	std::atomic<uint64_t>					frame_start{ 0 };	// primer chunk del frame actual
+	std::atomic<uint64_t>					failed_count{ 0 };
+};
+
+struct frame_ring_range_t
+{
+	void*		data = nullptr;
+	uint64_t	offset = 0;
+	uint64_t	byte_count = 0;
+	uint64_t	frame = 0;
+};
+
+// memory: bloque de config.byte_count bytes alineado al menos a lo que se vaya a pedir (nullptr = propio, alineado a
+// 4 KiB). false si la configuración no es válida o falta memoria.
+bool	frame_ring_init(frame_ring_t& ring, const frame_ring_config_t& config, void* memory = nullptr);
+void	frame_ring_release(frame_ring_t& ring);
+
+// O(1) sin cerrojos. alignment: potencia de dos de hasta chunk_byte_count (0 = 16). nullptr si no cabe.
+void*	frame_ring_alloc(frame_ring_t& ring, uint64_t byte_count, uint64_t alignment, uint64_t* offset = nullptr);
+
+// Con la alineación de access.usage (host_buffer_usage_alignment(), host_buffer.h). false si el buffer no admite ser
+// una subregión (can_use_subregion), no es del host o no cabe.
+bool	frame_ring_alloc(frame_ring_t& ring, const buffer_access_t& access, uint64_t byte_count, frame_ring_range_t& range);
+
+// Empieza el frame siguiente y devuelve su número; el frame número - frames_in_flight queda libre
+uint64_t	frame_ring_next_frame(frame_ring_t& ring);
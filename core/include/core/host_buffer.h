@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <apu/buffer.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Buffers en memoria del host
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Reserva de buffers con buffer_location_t::HOST (o UNKNOWN) según las frecuencias de buffer_access_t. La escritura que
+cuenta es la mayor de host_write y host_map_for_write, y la lectura la mayor de host_read y host_map_for_read:
+	FRAME		escritura MANY_TIMES_PER_FRAME o ALWAYS, can_use_subregion y sin lecturas del host más allá de ONCE:
+				datos de un frame. Salen sin cerrojos de un frame_ring_t (frame_ring.h) compartido y, si éste se llena,
+				de bloques por frame que se reutilizan; host_buffer_free() no libera nada y la memoria vuelve al anillo
+				cuando host_buffer_next_frame() ha avanzado frames_in_flight frames.
+	STREAMING	escritura EVERY_FRAME (o más frecuente sin can_use_subregion) sin lecturas del host más allá de ONCE:
+				memoria alineada a 64 bytes que se rellena con host_buffer_write(), con stores no temporales que no
+				pasan por la caché (el consumidor es otra unidad y el host no vuelve a leerla) y llenan líneas enteras
+				como en la memoria write-combining.
+	PAGES		escritura NEVER, ONCE u ONCE_EVERY_MANY_FRAMES y al menos huge_page_byte_count bytes: mmap propio,
+				alineado a 2 MiB y con MADV_HUGEPAGE (VirtualAlloc en Windows) para que la subida ocupe pocas entradas
+				de TLB y se devuelva al sistema al liberarla.
+	HEAP		el resto: reserva alineada del heap.
+host_buffer_stats() da los bytes vivos, el pico y el número de reservas de cada estrategia.
+*/
+
+enum class host_buffer_strategy_t : uint8_t
+{
+	HEAP = 0,
+	PAGES,
+	STREAMING,
+	FRAME,
+	COUNT
+};
+
+struct host_buffer_t
+{
+	void*					data = nullptr;
+	uint64_t				byte_count = 0;
+	host_buffer_strategy_t	strategy = host_buffer_strategy_t::HEAP;
+};
+
+struct host_buffer_config_t
+{
+	uint64_t	huge_page_byte_count = 2ull << 20;	// tamaño mínimo de PAGES
+	uint64_t	frame_ring_byte_count = 8ull << 20;	// frame_ring_t de FRAME (0 = sólo bloques)
+	uint64_t	frame_block_byte_count = 1ull << 20;	// bloques de FRAME cuando el anillo está lleno
+	uint32_t	frames_in_flight = 3;
+};
+
+struct host_buffer_stats_t
+{
+	uint64_t	byte_count[size_t(host_buffer_strategy_t::COUNT)];		// vivos
+	uint64_t	peak_byte_count[size_t(host_buffer_strategy_t::COUNT)];
+	uint64_t	alloc_count[size_t(host_buffer_strategy_t::COUNT)];		// desde el inicio
+	uint64_t	frame_pool_byte_count;									// bloques que guarda FRAME fuera del anillo
+	uint64_t	frame_ring_failed_count;								// reservas FRAME que no cupieron en el anillo
+	uint64_t	frame;
+};
+
+// Se aplica a las reservas siguientes; cambiar frames_in_flight o los tamaños de FRAME vacía su memoria, así que sólo
+// debe hacerse sin reservas FRAME vivas.
+void					host_buffer_configure(const host_buffer_config_t& config);
+
+// Alineación de las sub-reservas para los usos de usage (la mayor; 16 si no hay ninguno con requisitos): 256 para
+// constantes, almacenamiento, texturas y destinos de transferencia, 64 para indirectos y 16 para vértices e índices.
+uint64_t				host_buffer_usage_alignment(buffer_usage_t usage);
+
+// Estrategia que usaría host_buffer_alloc() (COUNT si el buffer no es del host)
+host_buffer_strategy_t	host_buffer_strategy(const buffer_access_t& access, uint64_t byte_count);
+
+// alignment: potencia de dos (0 = 16). false si la ubicación no es del host o falta memoria.
+bool					host_buffer_alloc(const buffer_access_t& access, uint64_t byte_count, uint64_t alignment,
+										  host_buffer_t& buffer);
+void					host_buffer_free(host_buffer_t& buffer);
+
+// Copia a buffer.data + offset; con STREAMING usa stores no temporales y termina con una barrera de stores
+void					host_buffer_write(const host_buffer_t& buffer, uint64_t offset, const void* src, uint64_t byte_count);
+
+// Cierra el frame actual; las reservas FRAME de hace frames_in_flight frames dejan de ser válidas. No debe coincidir
+// con reservas FRAME en curso.
+void					host_buffer_next_frame();
+
+void					host_buffer_stats(host_buffer_stats_t& stats);
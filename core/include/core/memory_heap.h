@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <apu/buffer.h>
+#include <core/threading.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sub-reservas de un heap (TLSF)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Reparte un rango de byte_count bytes (un bloque grande del host o una reserva de memoria del dispositivo) entre muchos
+recursos. Sólo se manejan desplazamientos: los metadatos van aparte, así que la memoria puede no ser accesible desde la
+CPU.
+
+Two-Level Segregated Fit: los huecos libres se clasifican por el bit más alto de su tamaño (primer nivel) y 32
+subdivisiones lineales de cada potencia de dos (segundo nivel), con un mapa de bits por nivel. Reservar redondea el
+tamaño al principio de la clase siguiente, de modo que cualquier hueco de esa clase vale, y la busca con dos ctz;
+liberar une el bloque con sus vecinos físicos libres. Las dos operaciones son O(1) y el desperdicio por redondeo es
+como mucho 1/32 del tamaño. Los tamaños y desplazamientos son múltiplos de 16 bytes; una alineación mayor se consigue
+buscando alignment - 16 bytes de más y devolviendo el hueco delantero a las listas.
+
+memory_heap_report() mide la fragmentación (1 - hueco mayor / bytes libres). memory_heap_compact() lleva las reservas
+vivas al principio del heap sin cambiar su orden, así que el relleno de alineación entre ellas sigue libre: actualiza
+los metadatos y devuelve los movimientos, y copiar los datos y cambiar el offset de cada memory_heap_allocation_t
+(block no cambia) queda para quien conoce los recursos.
+*/
+
+struct memory_heap_block_t
+{
+	uint64_t	offset;
+	uint64_t	byte_count;
+	uint32_t	prev_phys;			// nodos vecinos en memoria (kNone si no hay)
+	uint32_t	next_phys;
+	uint32_t	prev_free;			// lista de su clase mientras está libre
+	uint32_t	next_free;
+	uint8_t		alignment_log2;
+	bool		free;
+};
+
+struct memory_heap_t
+{
+	static constexpr uint32_t	kFirstLevels = 64;
+	static constexpr uint32_t	kSecondLevels = 32;
+	static constexpr uint32_t	kNone = UINT32_MAX;
+
+	uint64_t							byte_count = 0;
+	uint64_t							used_byte_count = 0;
+	uint32_t							alloc_count = 0;
+	uint32_t							free_block_count = 0;
+	uint32_t							first_block = kNone;	// el de offset 0
+	uint64_t							first_level_bitmap = 0;
+	uint32_t							second_level_bitmap[kFirstLevels] = {};
+	uint32_t							free_heads[kFirstLevels][kSecondLevels];
+	std::vector<memory_heap_block_t>	blocks;				// nodos; los que no se usan forman una pila en unused
+	std::vector<uint32_t>				unused;
+	spinlock_t							lock;
+};
+
+struct memory_heap_allocation_t
+{
+	uint64_t	offset = 0;
+	uint64_t	byte_count = 0;			// pedidos
+	uint32_t	block = memory_heap_t::kNone;
+};
+
+struct memory_heap_report_t
+{
+	uint64_t	byte_count;
+	uint64_t	used_byte_count;		// redondeos incluidos
+	uint64_t	free_byte_count;
+	uint64_t	largest_free_byte_count;
+	uint32_t	alloc_count;
+	uint32_t	free_block_count;
+	float		fragmentation;			// 0 = todo lo libre es un solo hueco
+};
+
+struct memory_heap_move_t
+{
+	uint32_t	block;
+	uint64_t	src_offset;
+	uint64_t	dst_offset;
+	uint64_t	byte_count;
+};
+
+// byte_count se redondea hacia abajo a 16 bytes. false si queda vacío.
+bool	memory_heap_init(memory_heap_t& heap, uint64_t byte_count);
+
+// alignment: potencia de dos (0 = 16). false si no hay hueco.
+bool	memory_heap_alloc(memory_heap_t& heap, uint64_t byte_count, uint64_t alignment, memory_heap_allocation_t& allocation);
+
+// Con la alineación de usage (host_buffer_usage_alignment(), host_buffer.h)
+bool	memory_heap_alloc(memory_heap_t& heap, buffer_usage_t usage, uint64_t byte_count, memory_heap_allocation_t& allocation);
+
+void	memory_heap_free(memory_heap_t& heap, memory_heap_allocation_t& allocation);
+
+void	memory_heap_report(memory_heap_t& heap, memory_heap_report_t& report);
+
+// Deja las reservas seguidas desde 0 en su orden actual, cada una en la primera posición alineada tras la anterior, y
+// el resto al final. Los rellenos de alineación entre reservas quedan como huecos libres, así que con alineaciones
+// mezcladas la fragmentación no baja a 0. moves va en orden de desplazamiento: aplicados uno tras otro con memmove
+// (pueden solaparse) mueven los datos. Devuelve los bytes a mover.
+uint64_t	memory_heap_compact(memory_heap_t& heap, std::vector<memory_heap_move_t>& moves);
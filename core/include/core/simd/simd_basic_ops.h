@@ -234,6 +234,13 @@ namespace simd
 	template<> SIMD_FORCEINLINE simd_pack_t<4, double> div<4, double>(const simd_pack_t<4, double>& a, const simd_pack_t<4, double>& b) { return simd_pack_t<4, double>(_mm256_div_pd(a.m, b.m)); }
 	template<> SIMD_FORCEINLINE simd_pack_t<4, double> min<4, double>(const simd_pack_t<4, double>& a, const simd_pack_t<4, double>& b) { return simd_pack_t<4, double>(_mm256_min_pd(a.m, b.m)); }
 	template<> SIMD_FORCEINLINE simd_pack_t<4, double> max<4, double>(const simd_pack_t<4, double>& a, const simd_pack_t<4, double>& b) { return simd_pack_t<4, double>(_mm256_max_pd(a.m, b.m)); }
+
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> add<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_add_ps(a.m, b.m)); }
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> sub<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_sub_ps(a.m, b.m)); }
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> mul<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_mul_ps(a.m, b.m)); }
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> div<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_div_ps(a.m, b.m)); }
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> min<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_min_ps(a.m, b.m)); }
+	template<> SIMD_FORCEINLINE simd_pack_t<8, float> max<8, float>(const simd_pack_t<8, float>& a, const simd_pack_t<8, float>& b) { return simd_pack_t<8, float>(_mm256_max_ps(a.m, b.m)); }
 #endif
 #if defined(__AVX2__) || defined(_M_AVX2)
 	template<> SIMD_FORCEINLINE simd_pack_t<8, int32_t>		add<8, int>(const simd_pack_t<8, int>& a, const simd_pack_t<8, int>& b) { return simd_pack_t<8, int>(_mm256_add_epi32(a.m, b.m)); }
@@ -1,8 +1,12 @@
 #pragma once
 #include <simd/simd_types.h>
 
+#include <span>
+
 namespace simd {
 
+template<typename T>
+SIMD_FORCEINLINE T clampT(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
 
 
 // -----------------------------------------------------
@@ -35,20 +39,27 @@ SIMD_FORCEINLINE simd_pack_t<D, uint8_t> pack_saturate(const simd_pack_t<D, floa
 }
 
 // float <-> half (solo declaraciones escalares aquí; implementación en .cpp)
+// Bit-exactas con F16C / FCVT en el modo por defecto: redondeo al par más cercano (también al generar subnormales
+// half), desbordamiento a ±inf y NaN silenciado conservando los 10 bits altos de la carga útil.
 uint16_t float_to_half(float f);
 float    half_to_float(uint16_t h);
 
+// Arrays completos: usan la tabla de simd::kernels() (F16C con AVX2/AVX-512, FCVT en NEON/SVE, software en el resto)
+// con los mismos resultados que las versiones escalares. out.size() >= in.size().
+void float_to_half(std::span<const float> in, std::span<uint16_t> out);
+void half_to_float(std::span<const uint16_t> in, std::span<float> out);
+
 // Packs float<->half por-lane (inline)
 template<int D>
 SIMD_FORCEINLINE simd_pack_t<D, uint16_t> float_to_half(const simd_pack_t<D, float>& a) {
 	simd_pack_t<D, uint16_t> r(uint16_t{0});
-	for (int i=0;i<D;++i) (&r.x)[i] = float_to_half((&a.x)[i]);
+	for (int i=0;i<D;++i) r[i] = float_to_half(a[i]);
 	return r;
 }
 template<int D>
 SIMD_FORCEINLINE simd_pack_t<D, float> half_to_float(const simd_pack_t<D, uint16_t>& a) {
 	simd_pack_t<D, float> r(0.f);
-	for (int i=0;i<D;++i) (&r.x)[i] = half_to_float((&a.x)[i]);
+	for (int i=0;i<D;++i) r[i] = half_to_float(a[i]);
 	return r;
 }
 
@@ -148,17 +159,39 @@ pack_saturate<4>(const simd_pack_t<4, int32_t>& a) {
 #if defined(__F16C__)
 template<> SIMD_FORCEINLINE simd_pack_t<4, uint16_t>
 float_to_half<4>(const simd_pack_t<4, float>& a) {
-	__m128  x  = a.m;
-	__m128i h4 = _mm_cvtps_ph(x, 0); // RNE
-	alignas(16) uint16_t out[8];
-	_mm_store_si128((__m128i*)out, h4);
-	return simd_pack_t<4, uint16_t>(out[0], out[1], out[2], out[3]);
+	__m128i h4 = _mm_cvtps_ph(a.m, _MM_FROUND_TO_NEAREST_INT);
+	simd_pack_t<4, uint16_t> r;
+	_mm_storel_epi64((__m128i*)&r, h4);
+	return r;
 }
 template<> SIMD_FORCEINLINE simd_pack_t<4, float>
 half_to_float<4>(const simd_pack_t<4, uint16_t>& a) {
-	alignas(16) uint16_t in[8] = { a.x,a.y,a.z,a.w,0,0,0,0 };
-	__m128 f4 = _mm_cvtph_ps(_mm_load_si128((const __m128i*)in));
-	return simd_pack_t<4, float>(f4);
+	return simd_pack_t<4, float>(_mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)&a)));
+}
+#if defined(__AVX__) || defined(_M_AVX)
+template<> SIMD_FORCEINLINE simd_pack_t<8, uint16_t>
+float_to_half<8>(const simd_pack_t<8, float>& a) {
+	simd_pack_t<8, uint16_t> r;
+	_mm_storeu_si128((__m128i*)r.v, _mm256_cvtps_ph(a.m, _MM_FROUND_TO_NEAREST_INT));
+	return r;
+}
+template<> SIMD_FORCEINLINE simd_pack_t<8, float>
+half_to_float<8>(const simd_pack_t<8, uint16_t>& a) {
+	return simd_pack_t<8, float>(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)a.v)));
+}
+#endif
+#endif
+
+#if defined(__AVX512F__)
+template<> SIMD_FORCEINLINE simd_pack_t<16, uint16_t>
+float_to_half<16>(const simd_pack_t<16, float>& a) {
+	simd_pack_t<16, uint16_t> r;
+	_mm256_storeu_si256((__m256i*)r.v, _mm512_cvtps_ph(a.m, _MM_FROUND_TO_NEAREST_INT));
+	return r;
+}
+template<> SIMD_FORCEINLINE simd_pack_t<16, float>
+half_to_float<16>(const simd_pack_t<16, uint16_t>& a) {
+	return simd_pack_t<16, float>(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)a.v)));
 }
 #endif
 
@@ -178,21 +211,17 @@ pack_saturate<4>(const simd_pack_t<4, int32_t>& a) {
 	return simd_pack_t<4, int16_t>(vget_lane_s16(i16,0), vget_lane_s16(i16,1),
 	                               vget_lane_s16(i16,2), vget_lane_s16(i16,3));
 }
-#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC__)
+// vcvt_f16_f32 es ARMv8 base en AArch64; en ARMv7 necesita la extensión fp16 (__ARM_FP bit 1)
+#if defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2))
 template<> SIMD_FORCEINLINE simd_pack_t<4, uint16_t>
 float_to_half<4>(const simd_pack_t<4, float>& a) {
-	float16x4_t h = vcvt_f16_f32(a.m);
-	return simd_pack_t<4, uint16_t>(
-		vget_lane_u16(vreinterpret_u16_f16(h),0),
-		vget_lane_u16(vreinterpret_u16_f16(h),1),
-		vget_lane_u16(vreinterpret_u16_f16(h),2),
-		vget_lane_u16(vreinterpret_u16_f16(h),3));
+	simd_pack_t<4, uint16_t> r;
+	vst1_u16((uint16_t*)&r, vreinterpret_u16_f16(vcvt_f16_f32(a.m)));
+	return r;
 }
 template<> SIMD_FORCEINLINE simd_pack_t<4, float>
 half_to_float<4>(const simd_pack_t<4, uint16_t>& a) {
-	uint64_t pack = (uint64_t)a.x | ((uint64_t)a.y<<16) | ((uint64_t)a.z<<32) | ((uint64_t)a.w<<48);
-	float16x4_t h = vreinterpret_f16_u16(vcreate_u16(pack));
-	return simd_pack_t<4, float>(vcvt_f32_f16(h));
+	return simd_pack_t<4, float>(vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16((const uint16_t*)&a))));
 }
 #endif
 #endif // NEON
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ===============================
+//  Despacho en tiempo de ejecución
+// ===============================
+//
+// Las especializaciones de simd_pack_t se eligen al compilar (#if defined(__AVX2__)...), por lo que un binario
+// compilado para x86-64 base nunca usa AVX2/FMA. Para los kernels masivos (arrays de floats) se compila una versión
+// por ISA en su propia unidad de traducción y aquí se elige, una sola vez, la mejor que soporte la CPU.
+//
+// Uso:
+//   const simd::kernels_t& k = simd::kernels();
+//   k.add_f32(a, b, r, n);
+
+namespace simd {
+
+	enum class isa_t : uint8_t {
+		SCALAR = 0,
+		SSE2,
+		SSE41,
+		AVX2,		// AVX2 + FMA + F16C
+		AVX512,		// AVX-512 F/DQ/BW/VL
+		NEON,
+		SVE,		// SVE/SVE2, ancho de vector escalable (128-2048 bits)
+		COUNT
+	};
+
+	const char* isa_name(isa_t isa) noexcept;
+
+	// Tabla de kernels de una ISA. Todos aceptan punteros sin alinear y cualquier n (cola incluida).
+	// Los resultados pueden apuntar a la misma memoria que las entradas (r == a).
+	struct kernels_t {
+		isa_t	isa;
+		int		float_lanes;	// anchura nativa en floats (1, 4, 8, 16); 0 si es escalable (SVE), ver lanes_f32()
+
+		// r[i] = a[i] OP b[i]
+		void	(*add_f32)(const float* a, const float* b, float* r, size_t n);
+		void	(*sub_f32)(const float* a, const float* b, float* r, size_t n);
+		void	(*mul_f32)(const float* a, const float* b, float* r, size_t n);
+		void	(*min_f32)(const float* a, const float* b, float* r, size_t n);
+		void	(*max_f32)(const float* a, const float* b, float* r, size_t n);
+		// r[i] = a[i] * b[i] + c[i]
+		void	(*fma_f32)(const float* a, const float* b, const float* c, float* r, size_t n);
+		// r[i] = a[i] * s + o
+		void	(*scale_f32)(const float* a, float s, float o, float* r, size_t n);
+
+		// Reducciones (n == 0 -> 0 para suma/dot, +inf/-inf para hmin/hmax)
+		float	(*hadd_f32)(const float* a, size_t n);
+		float	(*hmin_f32)(const float* a, size_t n);
+		float	(*hmax_f32)(const float* a, size_t n);
+		float	(*dot_f32)(const float* a, const float* b, size_t n);
+
+		// float <-> half (binary16), redondeo al par más cercano; mismos bits que simd::float_to_half/half_to_float
+		void	(*f32_to_f16)(const float* a, uint16_t* r, size_t n);
+		void	(*f16_to_f32)(const uint16_t* a, float* r, size_t n);
+
+		// 8 bits sin signo <-> float (texturas unorm8 con s = 1/255 y 255):
+		// r[i] = a[i] · s;  r[i] = a[i] · s saturado a [0, 255] y redondeado hacia arriba desde .5 (NaN -> 0)
+		void	(*u8_to_f32)(const uint8_t* a, float s, float* r, size_t n);
+		void	(*f32_to_u8)(const float* a, float s, uint8_t* r, size_t n);
+	};
+
+	// Mejor ISA soportada por esta CPU y compilada en el binario
+	isa_t				best_isa() noexcept;
+
+	// Tabla activa. Se selecciona la primera vez que se llama (thread-safe).
+	const kernels_t&	kernels() noexcept;
+
+	// Tabla de una ISA concreta; nullptr si no está compilada o la CPU no la soporta.
+	const kernels_t*	kernels_for(isa_t isa) noexcept;
+
+	// Anchura real en floats de una tabla; para SVE se consulta el registro en la CPU actual.
+	int					lanes_f32(const kernels_t& k) noexcept;
+
+	// Fuerza la tabla activa (tests / comparativas). Devuelve false si la ISA no está disponible.
+	bool				force_isa(isa_t isa) noexcept;
+
+} // namespace simd
@@ -1,5 +1,8 @@
 #pragma once
 #include <simd/simd_types.h>
+#include <simd/simd_reg_ops.h>
+
+#include <limits>
 
 
 namespace simd
@@ -16,9 +19,8 @@ namespace simd
 namespace simd {
 	namespace helpers {
 		template<typename T>	SIMD_FORCEINLINE T _poly_exp2_fast(T f) {
-			// Aproximación típica: 2^f ≈ 1 + f*ln2 + f^2*(ln2^2/2) + ...
-			// Pero afinada con coeficientes “prácticos” para error bajo:
-			// p(f) = 1 + c1 f + c2 f^2 + c3 f^3 + c4 f^4 (+ c5 f^5)
+			// 2^f en f ∈ [-0.5, 0.5]: Taylor de grado 5, error relativo < 4e-6
+			// p(f) = 1 + c1 f + c2 f^2 + c3 f^3 + c4 f^4 + c5 f^5
 			const T c1 = T(0.69314718056);
 			const T c2 = T(0.24022650696);
 			const T c3 = T(0.05550410866);
@@ -27,40 +29,75 @@ namespace simd {
 			return ((((c5 * f + c4) * f + c3) * f + c2) * f + c1) * f + T(1);
 		}
 
-		// --- exp2(f) más precisa en f ∈ [-0.5, 0.5] — minimax corto (grado 6)
-		template<typename T>	SIMD_FORCEINLINE T _poly_exp2_precise(T f) {
-			// Simétrica alrededor de 0 para mejor estabilidad
-			const T c1 = T(0.6931471805599453);
-			const T c2 = T(0.2402265069591007);
-			const T c3 = T(0.0555041086648216);
-			const T c4 = T(0.0096181291076285);
-			const T c5 = T(0.0013333558146428);
-			const T c6 = T(0.0001540341121616);
-			T f2 = f * f;
-			return T(1) + f * (c1 + f * (c2 + f * (c3 + f * (c4 + f * (c5 + f * c6)))));
+		// --- e^r en r ∈ [-ln2/2, ln2/2]: e^r = 1 + r + r²·P(r)
+		// float: minimax de grado 5 (Cephes expf). double: Taylor hasta r^13 (el siguiente término es < 5e-18).
+		template<typename T> struct _exp_coefs_;
+		template<> struct _exp_coefs_<float> {
+			static constexpr float c[6] = { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f,
+			                                4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+		};
+		template<> struct _exp_coefs_<double> {
+			static constexpr double c[12] = { 1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+			                                  1.0 / 362880.0,     1.0 / 40320.0,     1.0 / 5040.0,     1.0 / 720.0,
+			                                  1.0 / 120.0,        1.0 / 24.0,        1.0 / 6.0,        0.5 };
+		};
+
+		template<typename T>	SIMD_FORCEINLINE T _poly_exp_precise(T r) {
+			const T* c = _exp_coefs_<T>::c;
+			constexpr int n = int(sizeof(_exp_coefs_<T>::c) / sizeof(T));
+			T p = c[0];
+			for (int i = 1; i < n; ++i) p = p * r + c[i];
+			return (p * r) * r + r + T(1);
 		}
 
-		// --- log2(m) en m ∈ [1,2) — rápido (grado 3-4)
-		template<typename T>	SIMD_FORCEINLINE T _poly_log2_fast(T m) {
-			// m = 1 + y, y∈[0,1)
-			T y = m - T(1);
-			// Minimax breve para log2(1+y)
-			const T c1 = T(1.4426950408889634);   // 1/ln(2)
-			const T c2 = T(-0.7213475204444817);
-			const T c3 = T(0.4808983469629878);
-			const T c4 = T(-0.3606737602222408);
-			return ((c4 * y + c3) * y + c2) * y + c1;   // c1*y + c2*y^2 + ...
+		// --- exp2(f) más precisa en f ∈ [-0.5, 0.5]: e^(f·ln2)
+		template<typename T>	SIMD_FORCEINLINE T _poly_exp2_precise(T f) {
+			return _poly_exp_precise(f * _cst_<T>::ln2);
 		}
 
-		// --- log2(m) más precisa en m ∈ [√½,√2] — grado 6 impar sobre r=(m-1)/(m+1)
-		template<typename T>	SIMD_FORCEINLINE T _poly_log2_precise(T m) {
-			// Transformación de Halley: r = (m-1)/(m+1), log(m) ≈ 2[r + r^3/3 + r^5/5 + ...]
+		// --- ln(m) en m ∈ [√½, √2): r = (m-1)/(m+1), ln(m) = 2·atanh(r) = 2[r + r^3/3 + r^5/5 + ...], |r| <= 0.1716
+		// fast: hasta r^5 (error < 2e-6). precise: hasta r^9 (float) / r^19 (double), por debajo del redondeo.
+		template<typename T> struct _log_coefs_;
+		template<> struct _log_coefs_<float> {
+			static constexpr float c[4] = { 1.0f / 9.0f, 1.0f / 7.0f, 1.0f / 5.0f, 1.0f / 3.0f };
+		};
+		template<> struct _log_coefs_<double> {
+			static constexpr double c[9] = { 1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0,
+			                                 1.0 / 9.0,  1.0 / 7.0,  1.0 / 5.0,  1.0 / 3.0 };
+		};
+
+		template<typename T>	SIMD_FORCEINLINE T _poly_ln_fast(T m) {
+			T r = (m - T(1)) / (m + T(1));
+			T z = r * r;
+			T r2 = r + r;
+			return r2 * z * (z * T(0.2) + T(1.0 / 3.0)) + r2;
+		}
+		template<typename T>	SIMD_FORCEINLINE T _poly_ln_precise(T m) {
+			const T* c = _log_coefs_<T>::c;
+			constexpr int n = int(sizeof(_log_coefs_<T>::c) / sizeof(T));
 			T r = (m - T(1)) / (m + T(1));
-			T r2 = r * r, r3 = r * r2, r5 = r3 * r2, r7 = r5 * r2;
-			T ln = T(2) * (r + r3 / T(3) + r5 / T(5) + r7 / T(7));
-			return ln * _cst_<T>::inv_ln2;
+			T z = r * r;
+			T p = c[0];
+			for (int i = 1; i < n; ++i) p = p * z + c[i];
+			T r2 = r + r;
+			return r2 * z * p + r2;
 		}
 
+		// --- log2(m) en m ∈ [√½, √2)
+		template<typename T>	SIMD_FORCEINLINE T _poly_log2_fast(T m) { return _poly_ln_fast(m) * _cst_<T>::inv_ln2; }
+		template<typename T>	SIMD_FORCEINLINE T _poly_log2_precise(T m) { return _poly_ln_precise(m) * _cst_<T>::inv_ln2; }
+
+		// Rango útil de la entrada: por debajo el resultado es 0, por encima +inf
+		template<typename T> struct _exp_range_;
+		template<> struct _exp_range_<float> {
+			static constexpr float lo2 = -151.0f, hi2 = 129.0f;		// exp2
+			static constexpr float lo = -105.0f, hi = 89.5f;		// exp
+		};
+		template<> struct _exp_range_<double> {
+			static constexpr double lo2 = -1076.0, hi2 = 1025.0;
+			static constexpr double lo = -746.0, hi = 710.5;
+		};
+
 		// ============================
 		// Reconstrucción 2^k vía bits
 		// ============================
@@ -75,6 +112,63 @@ namespace simd {
 			uint64_t bits = (uint64_t(k) << 52);
 			return _bit_cast<double>(bits);
 		}
+
+		// a·2^k en dos pasos: cada mitad de k cae en el rango normal, así el resultado llega a subnormal o a +inf
+		// sin saturar antes de tiempo (2^128 no existe en float, pero 1.4·2^127 sí)
+		SIMD_FORCEINLINE float  _scale2i(float a, int k) {
+			const int k1 = k >> 1;
+			return a * _exp2i_bits(k1) * _exp2i_bits(k - k1);
+		}
+		SIMD_FORCEINLINE double _scale2i(double a, int k) {
+			const int k1 = k >> 1;
+			return a * _exp2i_bits_d(k1) * _exp2i_bits_d(k - k1);
+		}
+
+		// Entero más cercano (|x| dentro de _exp_range_)
+		template<typename T>	SIMD_FORCEINLINE int _round_i(T x) { return x >= T(0) ? int(x + T(0.5)) : -int(T(0.5) - x); }
+
+		// x = m·2^e con m ∈ [√½, √2). x finito y > 0 (subnormales incluidos)
+		SIMD_FORCEINLINE float  _log_reduce(float x, int& e) {
+			uint32_t u = _bit_cast<uint32_t>(x);
+			e = 0;
+			if (u < 0x00800000u) { u = _bit_cast<uint32_t>(x * 16777216.0f); e = -24; }
+			e += int(u >> 23) - 127;
+			float m = _bit_cast<float>((u & 0x007FFFFFu) | (127u << 23));
+			if (m > 1.41421356237f) { m *= 0.5f; ++e; }
+			return m;
+		}
+		SIMD_FORCEINLINE double _log_reduce(double x, int& e) {
+			uint64_t u = _bit_cast<uint64_t>(x);
+			e = 0;
+			if (u < 0x0010000000000000ull) { u = _bit_cast<uint64_t>(x * 18014398509481984.0); e = -54; }
+			e += int(u >> 52) - 1023;
+			double m = _bit_cast<double>((u & 0x000FFFFFFFFFFFFFull) | (uint64_t(1023) << 52));
+			if (m > 1.4142135623730951) { m *= 0.5; ++e; }
+			return m;
+		}
+
+		// Casos fuera de (0, +inf): log(0) = -inf, log(+inf) = +inf, log(x < 0) = log(NaN) = NaN
+		template<typename T>	SIMD_FORCEINLINE bool _log_special(T x, T& r) {
+			if (x > T(0) && x < std::numeric_limits<T>::infinity()) return false;
+			r = x == T(0) ? -std::numeric_limits<T>::infinity() : (x > T(0) ? x : std::numeric_limits<T>::quiet_NaN());
+			return true;
+		}
+
+		template<typename T, bool Precise>	SIMD_FORCEINLINE T _exp2_impl(T x) {
+			if (x != x) return x;
+			x = x < _exp_range_<T>::lo2 ? _exp_range_<T>::lo2 : (x > _exp_range_<T>::hi2 ? _exp_range_<T>::hi2 : x);
+			const int k = _round_i(x);
+			const T   f = x - T(k);
+			return _scale2i(Precise ? _poly_exp2_precise(f) : _poly_exp2_fast(f), k);
+		}
+
+		template<typename T, bool Precise>	SIMD_FORCEINLINE T _log2_impl(T x) {
+			T r;
+			if (_log_special(x, r)) return r;
+			int e;
+			const T m = _log_reduce(x, e);
+			return T(e) + (Precise ? _poly_log2_precise(m) : _poly_log2_fast(m));
+		}
 	}
 }
 
@@ -87,20 +181,11 @@ namespace simd {
 
 // exp exp2
 namespace simd {
+	// Reducción a f ∈ [-0.5, 0.5] alrededor de la potencia entera más cercana. Las entradas fuera de _exp_range_
+	// se saturan (0 o +inf) y NaN se propaga.
 	template<typename T> SIMD_FORCEINLINE T fast_exp2(const T& x);
-	template<> SIMD_FORCEINLINE float  fast_exp2<float >(const float& x) {
-		// x = k + f, f∈[0,1)
-		int   k = (int)x; if (x < 0 && float(k) != x) --k; // floor
-		float f = x - (float)k;
-		float a = helpers::_poly_exp2_fast(f);
-		return a * helpers::_exp2i_bits(k);
-	}
-	template<> SIMD_FORCEINLINE double fast_exp2<double>(const double& x) {
-		int    k = (int)x; if (x < 0 && double(k) != x) --k;
-		double f = x - (double)k;
-		double a = helpers::_poly_exp2_fast(f);
-		return a * helpers::_exp2i_bits_d(k);
-	}
+	template<> SIMD_FORCEINLINE float  fast_exp2<float >(const float& x) { return helpers::_exp2_impl<float, false>(x); }
+	template<> SIMD_FORCEINLINE double fast_exp2<double>(const double& x) { return helpers::_exp2_impl<double, false>(x); }
 
 	template<typename T> SIMD_FORCEINLINE T fast_exp(const T& x) {
 		// e^x = 2^(x * log2(e))
@@ -108,50 +193,41 @@ namespace simd {
 	}
 
 	template<typename T> SIMD_FORCEINLINE T fast_precise_exp2(const T& x);
-	template<> SIMD_FORCEINLINE float  fast_precise_exp2<float >(const float& x) {
-		// Reducción a f∈[-0.5,0.5] alrededor de la potencia entera más cercana
-		float  kf = x >= 0 ? float(int(x + 0.5f)) : float(int(x - 0.5f));
-		int    k = (int)kf;
-		float  f = x - kf;
-		float  a = _poly_exp2_precise(f);
-		return a * _exp2i_bits(k);
-	}
-	template<> SIMD_FORCEINLINE double fast_precise_exp2<double>(const double& x) {
-		double kf = x >= 0 ? double((long long)(x + 0.5)) : double((long long)(x - 0.5));
-		int    k = (int)kf;
-		double f = x - kf;
-		double a = _poly_exp2_precise(f);
-		return a * _exp2i_bits_d(k);
-	}
+	template<> SIMD_FORCEINLINE float  fast_precise_exp2<float >(const float& x) { return helpers::_exp2_impl<float, true>(x); }
+	template<> SIMD_FORCEINLINE double fast_precise_exp2<double>(const double& x) { return helpers::_exp2_impl<double, true>(x); }
 
 	template<typename T> SIMD_FORCEINLINE T fast_precise_exp(const T& x) {
-		// exp(x) = 2^(x/ln2) con reducción Cody–Waite usando ln2_hi + ln2_lo si quisiéramos hacerlo en base e
-		return fast_precise_exp2<T>(x * _cst_<T>::inv_ln2);
+		// Reducción Cody–Waite en base e: r = x - k·ln2_hi - k·ln2_lo, sin el error de escalar x por log2(e)
+		if (x != x) return x;
+		const T xc = x < helpers::_exp_range_<T>::lo ? helpers::_exp_range_<T>::lo : (x > helpers::_exp_range_<T>::hi ? helpers::_exp_range_<T>::hi : x);
+		const int k = helpers::_round_i(xc * _cst_<T>::inv_ln2);
+		const T   r = (xc - T(k) * _cst_<T>::ln2_hi) - T(k) * _cst_<T>::ln2_lo;
+		return helpers::_scale2i(helpers::_poly_exp_precise(r), k);
 	}
 
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_exp2(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_exp2<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_exp2<T>(a[i]);
 		return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_exp(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_exp<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_exp<T>(a[i]);
 		return r;
 	}
 
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_precise_exp2(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_precise_exp2<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_precise_exp2<T>(a[i]);
 		return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_precise_exp(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_precise_exp<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_precise_exp<T>(a[i]);
 		return r;
 	}
 }
@@ -160,22 +236,10 @@ namespace simd {
 // log log2
 namespace simd
 {
+	// x = m·2^e con m ∈ [√½, √2) y log2(x) = e + log2(m). log(0) = -inf, log(x < 0) = NaN.
 	template<typename T> SIMD_FORCEINLINE T fast_log2(const T& x);
-	template<> SIMD_FORCEINLINE float  fast_log2<float >(const float& x) {
-		// Descompone x = m * 2^e, con m∈[1,2)
-		uint32_t u = _bit_cast<uint32_t>(x);
-		int  e = int((u >> 23) & 0xFFu) - 127;
-		u = (u & 0x007FFFFFu) | (127u << 23);   // fuerza m en [1,2)
-		float m = _bit_cast<float>(u);
-		return float(e) + _poly_log2_fast(m);
-	}
-	template<> SIMD_FORCEINLINE double fast_log2<double>(const double& x) {
-		uint64_t u = _bit_cast<uint64_t>(x);
-		int  e = int((u >> 52) & 0x7FFull) - 1023;
-		u = (u & 0x000FFFFFFFFFFFFFull) | (uint64_t(1023) << 52);
-		double m = _bit_cast<double>(u);
-		return double(e) + _poly_log2_fast(m);
-	}
+	template<> SIMD_FORCEINLINE float  fast_log2<float >(const float& x) { return helpers::_log2_impl<float, false>(x); }
+	template<> SIMD_FORCEINLINE double fast_log2<double>(const double& x) { return helpers::_log2_impl<double, false>(x); }
 
 	template<typename T> SIMD_FORCEINLINE T fast_log(const T& x) {
 		// ln(x) = log2(x) * ln(2)
@@ -183,55 +247,41 @@ namespace simd
 	}
 
 	template<typename T> SIMD_FORCEINLINE T fast_precise_log2(const T& x);
-	template<> SIMD_FORCEINLINE float  fast_precise_log2<float >(const float& x) {
-		// Empuja m a ~[√½,√2] para mejorar polinomio
-		uint32_t u = _bit_cast<uint32_t>(x);
-		int  e = int((u >> 23) & 0xFFu) - 127;
-		u = (u & 0x007FFFFFu) | (127u << 23);
-		float m = _bit_cast<float>(u);
-
-		// Si m < √2/2, duplica m y ajusta e--
-		const float sqrt2_half = 0.70710678118654752440f; // ≈ √(1/2)
-		if (m < (1.0f / 1.41421356237f)) { m *= 2.0f; --e; }
-		return float(e) + _poly_log2_precise(m);
-	}
-	template<> SIMD_FORCEINLINE double fast_precise_log2<double>(const double& x) {
-		uint64_t u = _bit_cast<uint64_t>(x);
-		int  e = int((u >> 52) & 0x7FFull) - 1023;
-		u = (u & 0x000FFFFFFFFFFFFFull) | (uint64_t(1023) << 52);
-		double m = _bit_cast<double>(u);
-
-		if (m < (1.0 / 1.4142135623730951)) { m *= 2.0; --e; }
-		return double(e) + _poly_log2_precise(m);
-	}
+	template<> SIMD_FORCEINLINE float  fast_precise_log2<float >(const float& x) { return helpers::_log2_impl<float, true>(x); }
+	template<> SIMD_FORCEINLINE double fast_precise_log2<double>(const double& x) { return helpers::_log2_impl<double, true>(x); }
 
 	template<typename T> SIMD_FORCEINLINE T fast_precise_log(const T& x) {
-		return fast_precise_log2<T>(x) * _cst_<T>::ln2;
+		// ln(x) = e·ln2 + ln(m), con e·ln2 en dos partes para no perder bits cuando e es grande
+		T r;
+		if (helpers::_log_special(x, r)) return r;
+		int e;
+		const T m = helpers::_log_reduce(x, e);
+		return T(e) * _cst_<T>::ln2_hi + (T(e) * _cst_<T>::ln2_lo + helpers::_poly_ln_precise(m));
 	}
 
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_log2(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_log2<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_log2<T>(a[i]);
 		return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_log(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_log<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_log<T>(a[i]);
 		return r;
 	}
 
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_precise_log2(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_precise_log2<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_precise_log2<T>(a[i]);
 		return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> fast_precise_log(const simd_pack_t<D, T>& a) {
 		simd_pack_t<D, T> r(T{});
-		for (int i = 0;i < D;++i) (&r.x)[i] = fast_precise_log<T>((&a.x)[i]);
+		for (int i = 0;i < D;++i) r[i] = fast_precise_log<T>(a[i]);
 		return r;
 	}
 
@@ -241,74 +291,11 @@ namespace simd
 // sigmoid softplus relu
 namespace simd
 {
-	template<typename T>
-	SIMD_FORCEINLINE T sigmoid_fast(const T& x) {
-		// versión estable simple
-		if (x >= T(0)) {
-			T e = fast_exp<T>(-x);
-			return T(1) / (T(1) + e);
-		}
-		else {
-			T e = fast_exp<T>(x);
-			return e / (T(1) + e);
-		}
-	}
-	template<typename T>
-	SIMD_FORCEINLINE T sigmoid_precise(const T& x) {
-		if (x >= T(0)) {
-			T e = fast_precise_exp<T>(-x);
-			return T(1) / (T(1) + e);
-		}
-		else {
-			T e = fast_precise_exp<T>(x);
-			return e / (T(1) + e);
-		}
-	}
-	template<int D, typename T>
-	SIMD_FORCEINLINE simd_pack_t<D, T> sigmoid_fast(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = sigmoid_fast<T>((&v.x)[i]); return r;
-	}
-	template<int D, typename T>
-	SIMD_FORCEINLINE simd_pack_t<D, T> sigmoid_precise(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = sigmoid_precise<T>((&v.x)[i]); return r;
-	}
-
-	template<typename T> SIMD_FORCEINLINE T relu(const T& x) { return x < T(0) ? T(0) : x; }
-	template<int D, typename T>
-	SIMD_FORCEINLINE simd_pack_t<D, T> relu(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) { T x = (&v.x)[i]; (&r.x)[i] = x < T(0) ? T(0) : x; } return r;
-	}
-
-	template<typename T>
-	SIMD_FORCEINLINE T softplus_fast(const T& x) {
-		// log(1+exp(x)) estable: umbrales típicos ~20
-		const T hi = T(20), lo = T(-20);
-		if (x > hi) return x;
-		if (x < lo) return fast_exp<T>(x);
-		return fast_log<T>(T(1) + fast_exp<T>(x));
-	}
-	template<typename T>
-	SIMD_FORCEINLINE T softplus_precise(const T& x) {
-		const T hi = T(20), lo = T(-20);
-		if (x > hi) return x;
-		if (x < lo) return fast_precise_exp<T>(x);
-		return fast_precise_log<T>(T(1) + fast_precise_exp<T>(x));
-	}
-	template<int D, typename T>
-	SIMD_FORCEINLINE simd_pack_t<D, T> softplus_fast(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = softplus_fast<T>((&v.x)[i]); return r;
-	}
-	template<int D, typename T>
-	SIMD_FORCEINLINE simd_pack_t<D, T> softplus_precise(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = softplus_precise<T>((&v.x)[i]); return r;
-	}
-
-	// fast_log1p / fast_expm1 (usadas en softplus estable)
+	// fast_log1p / fast_expm1
 	template<typename T> SIMD_FORCEINLINE T fast_expm1(const T& x) {
 		// aproximación estable: para |x| pequeño usa serie, si no usa fast_exp
 		const T th = T(1e-3);
-		if (x > th) return fast_exp<T>(x) - T(1);
-		if (x < -th) return -(fast_exp<T>(-x) - T(1));
+		if (x > th || x < -th) return fast_exp<T>(x) - T(1);
 		// serie: x + x^2/2 + x^3/6
 		T x2 = x * x; return x + x2 * T(0.5) + x2 * x * T(1.0 / 6.0);
 	}
@@ -330,40 +317,43 @@ namespace simd
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> sigmoid_fast(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = sigmoid_fast<T>((&v.x)[i]); return r;
+		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) r[i] = sigmoid_fast<T>(v[i]); return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> sigmoid_precise(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = sigmoid_precise<T>((&v.x)[i]); return r;
+		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) r[i] = sigmoid_precise<T>(v[i]); return r;
 	}
 
 	// ReLU
 	template<typename T> SIMD_FORCEINLINE T relu(const T& x) { return x < T(0) ? T(0) : x; }
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> relu(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) { T x = (&v.x)[i]; (&r.x)[i] = x < T(0) ? T(0) : x; } return r;
+		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) { T x = v[i]; r[i] = x < T(0) ? T(0) : x; } return r;
 	}
 
-	// Softplus estable: log(1+exp(x)) con clamps y log1p/expm1 rápidos
+	// Softplus estable: log(1+exp(x)) con clamps; por debajo de -20, log(1+e^x) ≈ e^x
 	template<typename T> SIMD_FORCEINLINE T softplus_fast(const T& x) {
 		const T hi = T(20), lo = T(-20);
 		if (x > hi) return x;
-		if (x < lo) return fast_expm1<T>(x); // ~ e^x para x << 0
+		if (x < lo) return fast_exp<T>(x);
 		return fast_log1p<T>(fast_exp<T>(x));
 	}
+	// precise: max(x, 0) + log1p(e^-|x|), con log1p(e) = log(1+e)·e/((1+e)-1) para no perder e cuando 1+e redondea
 	template<typename T> SIMD_FORCEINLINE T softplus_precise(const T& x) {
-		const T hi = T(20), lo = T(-20);
-		if (x > hi) return x;
-		if (x < lo) return fast_expm1<T>(x);
-		return fast_precise_log<T>(T(1) + fast_precise_exp<T>(x));
+		if (x != x) return x;
+		const T e = fast_precise_exp<T>(x < T(0) ? x : -x);
+		const T u = T(1) + e;
+		const T d = u - T(1);
+		const T l = d > T(0) ? fast_precise_log<T>(u) * (e / d) : e;
+		return (x > T(0) ? x : T(0)) + l;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> softplus_fast(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = softplus_fast<T>((&v.x)[i]); return r;
+		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) r[i] = softplus_fast<T>(v[i]); return r;
 	}
 	template<int D, typename T>
 	SIMD_FORCEINLINE simd_pack_t<D, T> softplus_precise(const simd_pack_t<D, T>& v) {
-		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) (&r.x)[i] = softplus_precise<T>((&v.x)[i]); return r;
+		simd_pack_t<D, T> r(T{}); for (int i = 0;i < D;++i) r[i] = softplus_precise<T>(v[i]); return r;
 	}
 }
 
@@ -436,16 +426,16 @@ namespace simd
 
 #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__aarch64__)
 	template <> SIMD_FORCEINLINE simd_pack_t<4, float>
-	sqrt(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(neon_sqrt_via_rsqrt_f32x4(v.m)); }
+	sqrt(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(helpers::neon_sqrt_via_rsqrt_f32x4(v.m)); }
 
 	template <> SIMD_FORCEINLINE simd_pack_t<4, float>
-	rsq(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(neon_rsqrt_nr_f32x4(v.m)); }
+	rsq(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(helpers::neon_rsqrt_nr_f32x4(v.m)); }
 #elif defined(__SSE__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=1)
 	template <> SIMD_FORCEINLINE simd_pack_t<4, float>
 	sqrt(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(_mm_sqrt_ps(v.m)); }
 
 	template <> SIMD_FORCEINLINE simd_pack_t<4, float>
-	rsq(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(sse_rsqrt_nr_ps(v.m)); }
+	rsq(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(helpers::sse_rsqrt_nr_ps(v.m)); }
 #else
 	template <> SIMD_FORCEINLINE simd_pack_t<4, float>
 	sqrt(const simd_pack_t<4, float>& v) { return simd_pack_t<4, float>(std::sqrt(v.x), std::sqrt(v.y), std::sqrt(v.z), std::sqrt(v.w)); }
@@ -472,8 +462,8 @@ namespace simd
 		return simd_pack_t<2, float>(x);
 	}
 #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__aarch64__)
-	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	sqrt(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(neon_sqrt_via_rsqrt_f32x2(v.m)); }
-	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	rsq(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(neon_rsqrt_nr_f32x2(v.m)); }
+	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	sqrt(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(helpers::neon_sqrt_via_rsqrt_f32x2(v.m)); }
+	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	rsq(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(helpers::neon_rsqrt_nr_f32x2(v.m)); }
 #else
 	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	sqrt(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(std::sqrt(v.x), std::sqrt(v.y)); }
 	template <> SIMD_FORCEINLINE simd_pack_t<2, float>	rsq(const simd_pack_t<2, float>& v) { return simd_pack_t<2, float>(1.f / std::sqrt(v.x), 1.f / std::sqrt(v.y)); }
@@ -514,4 +504,183 @@ namespace simd
 	template <> SIMD_FORCEINLINE simd_pack_t<4, double>	rsq(const simd_pack_t<4, double>& v) { return simd_pack_t<4, double>(1.0 / std::sqrt(v.x), 1.0 / std::sqrt(v.y), 1.0 / std::sqrt(v.z), 1.0 / std::sqrt(v.w)); }
 #endif
 
-}
\ No newline at end of file
+}
+
+
+// exp exp2 log log2 sigmoid softplus sobre el registro completo
+//
+// Kernels sin ramas sobre simd_internal::vop, con la misma aritmética que las versiones escalares:
+//  exp2/exp: k = round(x) (exp: Cody–Waite con ln2_hi/ln2_lo), polinomio en la fracción y 2^k construido por bits en
+//            dos mitades (pow2i), así que los resultados subnormales y el desbordamiento a +inf salen sin ramas.
+//  log2/log: exponente y mantisa por bits, mantisa a [√½, √2), serie de atanh. Subnormales escalados antes.
+//            log(0) = -inf, log(+inf) = +inf, log(x < 0) = NaN.
+//  sigmoid:  e = exp(-|x|), 1/(1+e) o e/(1+e) según el signo.
+//  softplus: max(x, 0) + log1p(exp(-|x|)).
+// Error máximo medido en float y double (SSE2, AVX2+FMA y la ruta escalar coinciden salvo redondeos de FMA):
+//  fast_precise_exp2 / exp:  1 ulp, subnormales incluidos
+//  fast_precise_log / log2:  2 ulp / 3 ulp
+//  sigmoid_precise:          3 ulp                softplus_precise:  4 ulp
+//  fast_exp2 / exp:          4e-6 / 7e-6 relativo fast_log2 / log:   1e-5 / 2e-6 absoluto
+//  sigmoid_fast:             6e-6 relativo        softplus_fast:     6e-6 relativo
+
+namespace simd {
+namespace exp_detail {
+
+  using simd_internal::vop;
+
+  // Horner sobre una tabla de coeficientes (de mayor a menor grado)
+  template<typename V, typename T, int N>
+  SIMD_FORCEINLINE typename V::v_t v_horner(typename V::v_t x, const T (&c)[N]) {
+    typename V::v_t p = V::set1(c[0]);
+    for (int i = 1; i < N; ++i) p = V::fma(p, x, V::set1(c[i]));
+    return p;
+  }
+
+  // p·2^k con k entero en v_t, en dos mitades para que cada 2^n sea un exponente normal
+  template<typename T, int D>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_scale2i(typename vop<T, D>::v_t p, typename vop<T, D>::v_t kf) {
+    using V = vop<T, D>;
+    const auto k1 = V::round(V::mul(kf, V::set1(T(0.5))));
+    return V::mul(V::mul(p, V::pow2i(k1)), V::pow2i(V::sub(kf, k1)));
+  }
+
+  // e^r en |r| <= ln2/2
+  template<typename T, int D>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_poly_exp(typename vop<T, D>::v_t r) {
+    using V = vop<T, D>;
+    const auto p = v_horner<V>(r, helpers::_exp_coefs_<T>::c);
+    return V::add(V::fma(V::mul(p, r), r, r), V::set1(T(1)));
+  }
+
+  // NaN se conserva: max/min devuelven el segundo operando cuando alguno es NaN en x86
+  template<typename T, int D>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_clamp(typename vop<T, D>::v_t x, T lo, T hi) {
+    using V = vop<T, D>;
+    return V::min(V::set1(hi), V::max(V::set1(lo), x));
+  }
+
+  template<typename T, int D, bool Precise>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_exp2(typename vop<T, D>::v_t x) {
+    using V = vop<T, D>;
+    x = v_clamp<T, D>(x, helpers::_exp_range_<T>::lo2, helpers::_exp_range_<T>::hi2);
+    const auto kf = V::round(x);
+    const auto f = V::sub(x, kf);
+    typename V::v_t p;
+    if constexpr (Precise) {
+      p = v_poly_exp<T, D>(V::mul(f, V::set1(_cst_<T>::ln2)));
+    } else {
+      const T c[6] = { T(0.00133335581), T(0.00961812911), T(0.05550410866), T(0.24022650696), T(0.69314718056), T(1) };
+      p = v_horner<V>(f, c);
+    }
+    return v_scale2i<T, D>(p, kf);
+  }
+
+  template<typename T, int D, bool Precise>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_exp(typename vop<T, D>::v_t x) {
+    using V = vop<T, D>;
+    if constexpr (!Precise) {
+      return v_exp2<T, D, false>(V::mul(x, V::set1(_cst_<T>::inv_ln2)));
+    } else {
+      x = v_clamp<T, D>(x, helpers::_exp_range_<T>::lo, helpers::_exp_range_<T>::hi);
+      const auto kf = V::round(V::mul(x, V::set1(_cst_<T>::inv_ln2)));
+      auto r = V::fnma(kf, V::set1(_cst_<T>::ln2_hi), x);
+      r = V::fnma(kf, V::set1(_cst_<T>::ln2_lo), r);
+      return v_scale2i<T, D>(v_poly_exp<T, D>(r), kf);
+    }
+  }
+
+  template<typename T, int D, bool Precise, bool Base2>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_log(typename vop<T, D>::v_t x) {
+    using V = vop<T, D>;
+    using v_t = typename V::v_t;
+    constexpr bool is_float = sizeof(T) == sizeof(float);
+    const v_t zero = V::set1(T(0));
+    const v_t one = V::set1(T(1));
+    const v_t inf = V::set1(std::numeric_limits<T>::infinity());
+
+    // Subnormales: escalar por 2^24 / 2^54 y descontarlo del exponente
+    const auto tiny = V::lt(x, V::set1(std::numeric_limits<T>::min()));
+    const v_t xs = V::select(tiny, V::mul(x, V::set1(is_float ? T(16777216.0) : T(18014398509481984.0))), x);
+    v_t e = V::sub(V::exponent(xs), V::select(tiny, V::set1(is_float ? T(24) : T(54)), zero));
+    v_t m = V::mantissa(xs);
+
+    const auto big = V::gt(m, V::set1(T(1.41421356237309504880)));
+    m = V::select(big, V::mul(m, V::set1(T(0.5))), m);
+    e = V::add(e, V::select(big, one, zero));
+
+    const v_t r = V::div(V::sub(m, one), V::add(m, one));
+    const v_t z = V::mul(r, r);
+    const v_t r2 = V::add(r, r);
+    v_t p;
+    if constexpr (Precise) {
+      p = v_horner<V>(z, helpers::_log_coefs_<T>::c);
+    } else {
+      p = V::fma(z, V::set1(T(0.2)), V::set1(T(1.0 / 3.0)));
+    }
+    const v_t ln_m = V::fma(V::mul(r2, z), p, r2);
+
+    v_t res;
+    if constexpr (Base2) res = V::fma(ln_m, V::set1(_cst_<T>::inv_ln2), e);
+    else                 res = V::fma(e, V::set1(_cst_<T>::ln2_hi), V::fma(e, V::set1(_cst_<T>::ln2_lo), ln_m));
+
+    // Fuera de (0, +inf): 0 -> -inf, +inf -> +inf, negativos y NaN -> NaN
+    const auto valid = V::m_and(V::gt(x, zero), V::lt(x, inf));
+    const v_t special = V::select(V::eq(x, zero), V::set1(-std::numeric_limits<T>::infinity()),
+                                  V::select(V::gt(x, zero), x, V::set1(std::numeric_limits<T>::quiet_NaN())));
+    return V::select(valid, res, special);
+  }
+
+  template<typename T, int D, bool Precise>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_sigmoid(typename vop<T, D>::v_t x) {
+    using V = vop<T, D>;
+    const auto e = v_exp<T, D, Precise>(V::xor_(V::abs(x), V::set1(T(-0.0))));
+    const auto r = V::div(V::set1(T(1)), V::add(V::set1(T(1)), e));
+    return V::select(V::lt(x, V::set1(T(0))), V::mul(e, r), r);
+  }
+
+  template<typename T, int D, bool Precise>
+  SIMD_FORCEINLINE typename vop<T, D>::v_t v_softplus(typename vop<T, D>::v_t x) {
+    using V = vop<T, D>;
+    const auto zero = V::set1(T(0));
+    const auto e = v_exp<T, D, Precise>(V::xor_(V::abs(x), V::set1(T(-0.0))));
+    const auto u = V::add(V::set1(T(1)), e);
+    // log1p(e) = log(u)·e/(u-1): recupera los bits de e que se pierden al redondear 1+e
+    const auto d = V::sub(u, V::set1(T(1)));
+    const auto l = V::select(V::gt(d, zero), V::div(V::mul(v_log<T, D, Precise, false>(u), e), d), e);
+    return V::add(V::max(zero, x), l);
+  }
+
+} // namespace exp_detail
+
+#define SIMD_GEN_EXP_VOP(dim, type)                                                                                                                                               \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_exp2<dim,type>(const simd_pack_t<dim,type>& a)          { return simd_pack_t<dim,type>(exp_detail::v_exp2<type,dim,false>(a.m)); }       \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_exp<dim,type>(const simd_pack_t<dim,type>& a)           { return simd_pack_t<dim,type>(exp_detail::v_exp<type,dim,false>(a.m)); }        \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_precise_exp2<dim,type>(const simd_pack_t<dim,type>& a)  { return simd_pack_t<dim,type>(exp_detail::v_exp2<type,dim,true>(a.m)); }        \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_precise_exp<dim,type>(const simd_pack_t<dim,type>& a)   { return simd_pack_t<dim,type>(exp_detail::v_exp<type,dim,true>(a.m)); }         \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_log2<dim,type>(const simd_pack_t<dim,type>& a)          { return simd_pack_t<dim,type>(exp_detail::v_log<type,dim,false,true>(a.m)); }   \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_log<dim,type>(const simd_pack_t<dim,type>& a)           { return simd_pack_t<dim,type>(exp_detail::v_log<type,dim,false,false>(a.m)); }  \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_precise_log2<dim,type>(const simd_pack_t<dim,type>& a)  { return simd_pack_t<dim,type>(exp_detail::v_log<type,dim,true,true>(a.m)); }    \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> fast_precise_log<dim,type>(const simd_pack_t<dim,type>& a)   { return simd_pack_t<dim,type>(exp_detail::v_log<type,dim,true,false>(a.m)); }   \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> sigmoid_fast<dim,type>(const simd_pack_t<dim,type>& a)       { return simd_pack_t<dim,type>(exp_detail::v_sigmoid<type,dim,false>(a.m)); }    \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> sigmoid_precise<dim,type>(const simd_pack_t<dim,type>& a)    { return simd_pack_t<dim,type>(exp_detail::v_sigmoid<type,dim,true>(a.m)); }     \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> softplus_fast<dim,type>(const simd_pack_t<dim,type>& a)      { return simd_pack_t<dim,type>(exp_detail::v_softplus<type,dim,false>(a.m)); }   \
+  template<> SIMD_FORCEINLINE simd_pack_t<dim,type> softplus_precise<dim,type>(const simd_pack_t<dim,type>& a)   { return simd_pack_t<dim,type>(exp_detail::v_softplus<type,dim,true>(a.m)); }
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+  SIMD_GEN_EXP_VOP(4, float)
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__aarch64__)
+  SIMD_GEN_EXP_VOP(2, double)
+#endif
+#if defined(__AVX2__) || defined(_M_AVX2)
+  SIMD_GEN_EXP_VOP(8, float)
+  SIMD_GEN_EXP_VOP(4, double)
+#endif
+#if defined(__AVX512F__)
+  SIMD_GEN_EXP_VOP(16, float)
+  SIMD_GEN_EXP_VOP(8, double)
+#endif
+
+#undef SIMD_GEN_EXP_VOP
+
+} // namespace simd
@@ -11,8 +11,8 @@
   #include <smmintrin.h>   // SSE4.1
 #endif
 
-// AVX
-#if defined(__AVX__) || defined(_M_AVX) || defined(__AVX2__) || defined(_M_AVX2)
+// AVX / AVX-512
+#if defined(__AVX__) || defined(_M_AVX) || defined(__AVX2__) || defined(_M_AVX2) || defined(__AVX512F__)
   #include <immintrin.h>
 #endif
 
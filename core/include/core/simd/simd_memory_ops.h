@@ -8,55 +8,55 @@ namespace simd {
   template<int D>
   SIMD_FORCEINLINE simd_pack_t<D,float> gather(const float* base, const int* idx){
     simd_pack_t<D,float> r(0.f);
-    for (int i=0;i<D;++i) (&r.x)[i] = base[idx[i]];
+    for (int i=0;i<D;++i) r[i] = base[idx[i]];
     return r;
   }
   template<int D>
   SIMD_FORCEINLINE simd_pack_t<D,double> gather(const double* base, const int* idx){
     simd_pack_t<D,double> r(0.0);
-    for (int i=0;i<D;++i) (&r.x)[i] = base[idx[i]];
+    for (int i=0;i<D;++i) r[i] = base[idx[i]];
     return r;
   }
 
   template<int D>
   SIMD_FORCEINLINE void scatter(float* base, const int* idx, const simd_pack_t<D,float>& v){
-    for (int i=0;i<D;++i) base[idx[i]] = (&v.x)[i];
+    for (int i=0;i<D;++i) base[idx[i]] = v[i];
   }
   template<int D>
   SIMD_FORCEINLINE void scatter(double* base, const int* idx, const simd_pack_t<D,double>& v){
-    for (int i=0;i<D;++i) base[idx[i]] = (&v.x)[i];
+    for (int i=0;i<D;++i) base[idx[i]] = v[i];
   }
 
   template<int D>
   SIMD_FORCEINLINE simd_pack_t<D,float> masked_load(const float* p, const simd_pack_t<D,float>& m01, float fallback = 0.f){
     simd_pack_t<D,float> r(fallback);
-    for (int i=0;i<D;++i) if ((&m01.x)[i] != 0.0f) (&r.x)[i] = p[i];
+    for (int i=0;i<D;++i) if (m01[i] != 0.0f) r[i] = p[i];
     return r;
   }
   template<int D>
   SIMD_FORCEINLINE simd_pack_t<D,double> masked_load(const double* p, const simd_pack_t<D,double>& m01, double fallback = 0.0){
     simd_pack_t<D,double> r(fallback);
-    for (int i=0;i<D;++i) if ((&m01.x)[i] != 0.0) (&r.x)[i] = p[i];
+    for (int i=0;i<D;++i) if (m01[i] != 0.0) r[i] = p[i];
     return r;
   }
 
   template<int D>
   SIMD_FORCEINLINE void masked_store(float* p, const simd_pack_t<D,float>& m01, const simd_pack_t<D,float>& v){
-    for (int i=0;i<D;++i) if ((&m01.x)[i] != 0.0f) p[i] = (&v.x)[i];
+    for (int i=0;i<D;++i) if (m01[i] != 0.0f) p[i] = v[i];
   }
   template<int D>
   SIMD_FORCEINLINE void masked_store(double* p, const simd_pack_t<D,double>& m01, const simd_pack_t<D,double>& v){
-    for (int i=0;i<D;++i) if ((&m01.x)[i] != 0.0) p[i] = (&v.x)[i];
+    for (int i=0;i<D;++i) if (m01[i] != 0.0) p[i] = v[i];
   }
 
   template<int D>
   SIMD_FORCEINLINE void stream_store(float* p, const simd_pack_t<D,float>& v){
     // Fallback: almacena normal
-    for (int i=0;i<D;++i) p[i] = (&v.x)[i];
+    for (int i=0;i<D;++i) p[i] = v[i];
   }
   template<int D>
   SIMD_FORCEINLINE void stream_store(double* p, const simd_pack_t<D,double>& v){
-    for (int i=0;i<D;++i) p[i] = (&v.x)[i];
+    for (int i=0;i<D;++i) p[i] = v[i];
   }
 
 } // namespace simd
@@ -72,6 +72,66 @@ template<> SIMD_FORCEINLINE simd_pack_t<4,double> simd::gather<4>(const double*
 }
 #endif
 
+// AVX-512: gather y scatter nativos; las máscaras se convierten a __mmask16/__mmask8 y los lanes apagados no acceden a
+// memoria (sin fallos de página), así que masked_load/masked_store sirven para colas de arrays.
+#if defined(__AVX512F__)
+template<> SIMD_FORCEINLINE simd_pack_t<16,float> simd::gather<16>(const float* base, const int* idx){
+  return simd_pack_t<16,float>(_mm512_i32gather_ps(_mm512_loadu_si512(idx), base, 4));
+}
+template<> SIMD_FORCEINLINE simd_pack_t<8,double> simd::gather<8>(const double* base, const int* idx){
+  return simd_pack_t<8,double>(_mm512_i32gather_pd(_mm256_loadu_si256((const __m256i*)idx), base, 8));
+}
+template<> SIMD_FORCEINLINE void simd::scatter<16>(float* base, const int* idx, const simd_pack_t<16,float>& v){
+  _mm512_i32scatter_ps(base, _mm512_loadu_si512(idx), v.m, 4);
+}
+template<> SIMD_FORCEINLINE void simd::scatter<8>(double* base, const int* idx, const simd_pack_t<8,double>& v){
+  _mm512_i32scatter_pd(base, _mm256_loadu_si256((const __m256i*)idx), v.m, 8);
+}
+
+template<> SIMD_FORCEINLINE simd_pack_t<16,float> simd::masked_load<16>(const float* p, const simd_pack_t<16,float>& m01, float fallback){
+  const __mmask16 k = _mm512_cmp_ps_mask(m01.m, _mm512_setzero_ps(), _CMP_NEQ_UQ);
+  return simd_pack_t<16,float>(_mm512_mask_loadu_ps(_mm512_set1_ps(fallback), k, p));
+}
+template<> SIMD_FORCEINLINE simd_pack_t<8,double> simd::masked_load<8>(const double* p, const simd_pack_t<8,double>& m01, double fallback){
+  const __mmask8 k = _mm512_cmp_pd_mask(m01.m, _mm512_setzero_pd(), _CMP_NEQ_UQ);
+  return simd_pack_t<8,double>(_mm512_mask_loadu_pd(_mm512_set1_pd(fallback), k, p));
+}
+template<> SIMD_FORCEINLINE void simd::masked_store<16>(float* p, const simd_pack_t<16,float>& m01, const simd_pack_t<16,float>& v){
+  _mm512_mask_storeu_ps(p, _mm512_cmp_ps_mask(m01.m, _mm512_setzero_ps(), _CMP_NEQ_UQ), v.m);
+}
+template<> SIMD_FORCEINLINE void simd::masked_store<8>(double* p, const simd_pack_t<8,double>& m01, const simd_pack_t<8,double>& v){
+  _mm512_mask_storeu_pd(p, _mm512_cmp_pd_mask(m01.m, _mm512_setzero_pd(), _CMP_NEQ_UQ), v.m);
+}
+
+// stream_store AVX-512 (p alineado a 64 bytes)
+template<> SIMD_FORCEINLINE void simd::stream_store<16>(float* p, const simd_pack_t<16,float>& v){ _mm512_stream_ps(p, v.m); }
+template<> SIMD_FORCEINLINE void simd::stream_store<8>(double* p, const simd_pack_t<8,double>& v){ _mm512_stream_pd(p, v.m); }
+
+namespace simd {
+
+  // Variantes con máscara nativa: bit i = lane i
+  SIMD_FORCEINLINE __mmask16 tail_mask16(int n) { return n >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << n) - 1u); }
+  SIMD_FORCEINLINE __mmask8  tail_mask8(int n)  { return n >= 8 ? __mmask8(0xFF) : __mmask8((1u << n) - 1u); }
+
+  SIMD_FORCEINLINE simd_pack_t<16,float> masked_load(const float* p, __mmask16 k, float fallback = 0.f){
+    return simd_pack_t<16,float>(_mm512_mask_loadu_ps(_mm512_set1_ps(fallback), k, p));
+  }
+  SIMD_FORCEINLINE simd_pack_t<8,double> masked_load(const double* p, __mmask8 k, double fallback = 0.0){
+    return simd_pack_t<8,double>(_mm512_mask_loadu_pd(_mm512_set1_pd(fallback), k, p));
+  }
+  SIMD_FORCEINLINE void masked_store(float* p, __mmask16 k, const simd_pack_t<16,float>& v){ _mm512_mask_storeu_ps(p, k, v.m); }
+  SIMD_FORCEINLINE void masked_store(double* p, __mmask8 k, const simd_pack_t<8,double>& v){ _mm512_mask_storeu_pd(p, k, v.m); }
+
+  SIMD_FORCEINLINE void scatter(float* base, const int* idx, const simd_pack_t<16,float>& v, __mmask16 k){
+    _mm512_mask_i32scatter_ps(base, k, _mm512_maskz_loadu_epi32(k, idx), v.m, 4);
+  }
+  SIMD_FORCEINLINE void scatter(double* base, const int* idx, const simd_pack_t<8,double>& v, __mmask8 k){
+    _mm512_mask_i32scatter_pd(base, k, _mm512_castsi512_si256(_mm512_maskz_loadu_epi32(__mmask16(k), idx)), v.m, 8);
+  }
+
+} // namespace simd
+#endif
+
 #if defined(__AVX__) || defined(_M_AVX)
 // stream_store AVX
 template<> SIMD_FORCEINLINE void simd::stream_store<8>(float* p,  const simd_pack_t<8,float>& v){ _mm256_stream_ps(p, v.m); }
@@ -94,7 +154,7 @@ namespace simd {
   template<int D, typename T>
   SIMD_FORCEINLINE simd_pack_t<D,T> load(const T* p) {
     simd_pack_t<D,T> out;
-    for (int i = 0; i < D; ++i) (&out.x)[i] = p[i];
+    for (int i = 0; i < D; ++i) out[i] = p[i];
     return out;
   }
 
@@ -107,7 +167,7 @@ namespace simd {
   #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
     out.m = _mm_loadu_ps(p);
   #else
-    for (int i = 0; i < 4; ++i) (&out.x)[i] = p[i];
+    for (int i = 0; i < 4; ++i) out[i] = p[i];
   #endif
     return out;
   }
@@ -119,7 +179,7 @@ namespace simd {
   #if defined(__ARM_NEON) || defined(__ARM_NEON__)
     out.m = vld1_f32(p);
   #else
-    for (int i = 0; i < 2; ++i) (&out.x)[i] = p[i];
+    for (int i = 0; i < 2; ++i) out[i] = p[i];
   #endif
     return out;
   }
@@ -133,7 +193,7 @@ namespace simd {
   #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
     out.m = _mm_loadu_pd(p);
   #else
-    for (int i = 0; i < 2; ++i) (&out.x)[i] = p[i];
+    for (int i = 0; i < 2; ++i) out[i] = p[i];
   #endif
     return out;
   }
@@ -145,11 +205,31 @@ namespace simd {
   #if defined(__AVX__) || defined(_M_AVX)
     out.m = _mm256_loadu_pd(p);
   #else
-    for (int i = 0; i < 4; ++i) (&out.x)[i] = p[i];
+    for (int i = 0; i < 4; ++i) out[i] = p[i];
+  #endif
+    return out;
+  }
+
+  // float8 (AVX)
+  template<>
+  SIMD_FORCEINLINE simd_pack_t<8,float> load<8,float>(const float* p) {
+    simd_pack_t<8,float> out;
+  #if defined(__AVX__) || defined(_M_AVX)
+    out.m = _mm256_loadu_ps(p);
+  #else
+    for (int i = 0; i < 8; ++i) out.v[i] = p[i];
   #endif
     return out;
   }
 
+  // float16 / double8 / i32x16 (AVX-512)
+#if defined(__AVX512F__)
+  template<> SIMD_FORCEINLINE simd_pack_t<16,float>    load<16,float>(const float* p)       { return simd_pack_t<16,float>(_mm512_loadu_ps(p)); }
+  template<> SIMD_FORCEINLINE simd_pack_t<8,double>    load<8,double>(const double* p)      { return simd_pack_t<8,double>(_mm512_loadu_pd(p)); }
+  template<> SIMD_FORCEINLINE simd_pack_t<16,int>      load<16,int>(const int* p)           { return simd_pack_t<16,int>(_mm512_loadu_si512(p)); }
+  template<> SIMD_FORCEINLINE simd_pack_t<16,unsigned> load<16,unsigned>(const unsigned* p) { return simd_pack_t<16,unsigned>(_mm512_loadu_si512(p)); }
+#endif
+
   // i32/u32x4
   namespace load_detail {
     template<typename T>
@@ -165,7 +245,7 @@ namespace simd {
     #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
       out.m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
     #else
-      for (int i = 0; i < 4; ++i) (&out.x)[i] = p[i];
+      for (int i = 0; i < 4; ++i) out[i] = p[i];
     #endif
       return out;
     }
@@ -184,7 +264,7 @@ namespace simd {
   // Fallback escalar
   template<int D, typename T>
   SIMD_FORCEINLINE void store(T* p, const simd_pack_t<D,T>& v) {
-    for (int i = 0; i < D; ++i) p[i] = (&v.x)[i];
+    for (int i = 0; i < D; ++i) p[i] = v[i];
   }
 
   // float4
@@ -195,7 +275,7 @@ namespace simd {
   #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
     _mm_storeu_ps(p, v.m);
   #else
-    for (int i = 0; i < 4; ++i) p[i] = (&v.x)[i];
+    for (int i = 0; i < 4; ++i) p[i] = v[i];
   #endif
   }
 
@@ -205,7 +285,7 @@ namespace simd {
   #if defined(__ARM_NEON) || defined(__ARM_NEON__)
     vst1_f32(p, v.m);
   #else
-    for (int i = 0; i < 2; ++i) p[i] = (&v.x)[i];
+    for (int i = 0; i < 2; ++i) p[i] = v[i];
   #endif
   }
 
@@ -217,7 +297,7 @@ namespace simd {
   #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
     _mm_storeu_pd(p, v.m);
   #else
-    for (int i = 0; i < 2; ++i) p[i] = (&v.x)[i];
+    for (int i = 0; i < 2; ++i) p[i] = v[i];
   #endif
   }
 
@@ -227,10 +307,28 @@ namespace simd {
   #if defined(__AVX__) || defined(_M_AVX)
     _mm256_storeu_pd(p, v.m);
   #else
-    for (int i = 0; i < 4; ++i) p[i] = (&v.x)[i];
+    for (int i = 0; i < 4; ++i) p[i] = v[i];
+  #endif
+  }
+
+  // float8 (AVX)
+  template<>
+  SIMD_FORCEINLINE void store<8,float>(float* p, const simd_pack_t<8,float>& v) {
+  #if defined(__AVX__) || defined(_M_AVX)
+    _mm256_storeu_ps(p, v.m);
+  #else
+    for (int i = 0; i < 8; ++i) p[i] = v.v[i];
   #endif
   }
 
+  // float16 / double8 / i32x16 (AVX-512)
+#if defined(__AVX512F__)
+  template<> SIMD_FORCEINLINE void store<16,float>(float* p, const simd_pack_t<16,float>& v)          { _mm512_storeu_ps(p, v.m); }
+  template<> SIMD_FORCEINLINE void store<8,double>(double* p, const simd_pack_t<8,double>& v)        { _mm512_storeu_pd(p, v.m); }
+  template<> SIMD_FORCEINLINE void store<16,int>(int* p, const simd_pack_t<16,int>& v)                { _mm512_storeu_si512(p, v.m); }
+  template<> SIMD_FORCEINLINE void store<16,unsigned>(unsigned* p, const simd_pack_t<16,unsigned>& v) { _mm512_storeu_si512(p, v.m); }
+#endif
+
   // i32/u32x4
   namespace store_detail {
     template<typename T>
@@ -245,7 +343,7 @@ namespace simd {
     #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
       _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v.m);
     #else
-      for (int i = 0; i < 4; ++i) p[i] = (&v.x)[i];
+      for (int i = 0; i < 4; ++i) p[i] = v[i];
     #endif
     }
   }
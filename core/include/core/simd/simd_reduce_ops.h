@@ -7,21 +7,21 @@ namespace simd {
   template<int D, typename T> SIMD_FORCEINLINE
   T hadd(const simd_pack_t<D,T>& v) {
     T s = T(0);
-    for (int i=0;i<D;++i) s += (&v.x)[i];
+    for (int i=0;i<D;++i) s += v[i];
     return s;
   }
 
   template<int D, typename T> SIMD_FORCEINLINE
   T hmin(const simd_pack_t<D,T>& v) {
-    T m = (&v.x)[0];
-    for (int i=1;i<D;++i) if ((&v.x)[i] < m) m = (&v.x)[i];
+    T m = v[0];
+    for (int i=1;i<D;++i) if (v[i] < m) m = v[i];
     return m;
   }
 
   template<int D, typename T> SIMD_FORCEINLINE
   T hmax(const simd_pack_t<D,T>& v) {
-    T m = (&v.x)[0];
-    for (int i=1;i<D;++i) if ((&v.x)[i] > m) m = (&v.x)[i];
+    T m = v[0];
+    for (int i=1;i<D;++i) if (v[i] > m) m = v[i];
     return m;
   }
 
@@ -29,6 +29,16 @@ namespace simd {
 // ESPECIALIZACIONES SIMD (SSE/AVX/NEON) — sin #if dentro de las funciones
 // ======================================================================
 
+#if defined(__AVX512F__)
+// --------------------- AVX-512 ---------------------
+template<> SIMD_FORCEINLINE float  hadd<16,float>(const simd_pack_t<16,float>& v){ return _mm512_reduce_add_ps(v.m); }
+template<> SIMD_FORCEINLINE double hadd<8,double>(const simd_pack_t<8,double>& v){ return _mm512_reduce_add_pd(v.m); }
+template<> SIMD_FORCEINLINE float  hmin<16,float>(const simd_pack_t<16,float>& v){ return _mm512_reduce_min_ps(v.m); }
+template<> SIMD_FORCEINLINE double hmin<8,double>(const simd_pack_t<8,double>& v){ return _mm512_reduce_min_pd(v.m); }
+template<> SIMD_FORCEINLINE float  hmax<16,float>(const simd_pack_t<16,float>& v){ return _mm512_reduce_max_ps(v.m); }
+template<> SIMD_FORCEINLINE double hmax<8,double>(const simd_pack_t<8,double>& v){ return _mm512_reduce_max_pd(v.m); }
+#endif
+
 #if defined(__AVX__) || defined(_M_AVX)
 // --------------------- AVX -------------------------
 template<> SIMD_FORCEINLINE float  hadd<8,float >(const simd_pack_t<8,float >& v){
@@ -0,0 +1,585 @@
+// simd_reg_ops.h
+#pragma once
+
+#include <simd/simd_types.h>
+
+// ===============================
+//  Operaciones sobre registros nativos
+// ===============================
+//
+// Capa fina sobre los intrínsecos para escribir una sola vez los kernels sin ramas (trig, exp, log...) y
+// especializarlos para cada registro: vop<T,D> sólo existe para las combinaciones con registro nativo.
+//
+//  v_t : registro de T               m_t : máscara por lane (todo unos / todo ceros)
+//  i_t : enteros por lane. En lanes de 64 bits sólo son significativos los 32 bits bajos.
+//
+// sqrt() es la raíz por lane correctamente redondeada (en ARMv7 se aproxima con rsqrt + Newton).
+// select(m, a, b) devuelve a donde m es cierto y b en el resto.
+// pow2i(n) construye 2^n por bits para n entero (en v_t) dentro del rango de exponentes normales; exponent() y
+// mantissa() descomponen a = mantissa · 2^exponent con mantissa ∈ [1, 2) para a finito, normal y positivo.
+
+namespace simd_internal {
+
+	template<typename T, int D> struct vop;
+
+	template<typename T, int D>
+	concept has_vop = requires { typename vop<T, D>::v_t; };
+
+
+	// ------------------------------------------------------------------------------------------------------------------
+	// x86 SSE2: float4 / double2
+	// ------------------------------------------------------------------------------------------------------------------
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	template<> struct vop<float, 4> {
+		using scalar_t = float;
+		using v_t = __m128;
+		using m_t = __m128;
+		using i_t = __m128i;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return _mm_set1_ps(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm_add_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm_sub_ps(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm_mul_ps(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm_div_ps(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm_min_ps(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm_max_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm_sqrt_ps(a); }
+#if defined(__FMA__)
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm_fmadd_ps(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm_fnmadd_ps(a, b, c); }
+#else
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#endif
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm_and_ps(_mm_set1_ps(-0.0f), a); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm_xor_ps(a, b); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm_cmpgt_ps(a, b); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm_cmplt_ps(a, b); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm_cmpeq_ps(a, b); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return _mm_and_ps(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return _mm_andnot_ps(a, b); }	// ~a & b
+		static SIMD_FORCEINLINE bool any(m_t m) { return _mm_movemask_ps(m) != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) {
+#if defined(__SSE4_1__)
+			return _mm_blendv_ps(b, a, m);
+#else
+			return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#endif
+		}
+
+		// Redondeo al entero más cercano (|a| < 2^31)
+		static SIMD_FORCEINLINE v_t round(v_t a) {
+#if defined(__SSE4_1__)
+			return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+			return _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+#endif
+		}
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm_cvtps_epi32(a); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+		// Lanes con (q & bit) != 0
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) {
+			const __m128i b = _mm_set1_epi32(bit);
+			return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, b), b));
+		}
+		// Bit de signo donde (q & 2) != 0 (cuadrantes 2 y 3)
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23)); }
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m128i e = _mm_and_si128(_mm_srli_epi32(_mm_castps_si128(a), 23), _mm_set1_epi32(0xFF));
+			return _mm_sub_ps(_mm_cvtepi32_ps(e), _mm_set1_ps(127.0f));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return _mm_or_ps(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(1.0f));
+		}
+	};
+
+	template<> struct vop<double, 2> {
+		using scalar_t = double;
+		using v_t = __m128d;
+		using m_t = __m128d;
+		using i_t = __m128i;	// [q0, q0, q1, q1]: cada entero duplicado en los dos dwords de su lane
+
+		static SIMD_FORCEINLINE v_t set1(double s) { return _mm_set1_pd(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm_add_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm_sub_pd(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm_mul_pd(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm_div_pd(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm_min_pd(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm_max_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm_sqrt_pd(a); }
+#if defined(__FMA__)
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm_fmadd_pd(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm_fnmadd_pd(a, b, c); }
+#else
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+#endif
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm_and_pd(_mm_set1_pd(-0.0), a); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm_xor_pd(a, b); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm_cmpgt_pd(a, b); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm_cmplt_pd(a, b); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm_cmpeq_pd(a, b); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return _mm_and_pd(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return _mm_andnot_pd(a, b); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return _mm_movemask_pd(m) != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) {
+#if defined(__SSE4_1__)
+			return _mm_blendv_pd(b, a, m);
+#else
+			return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+#endif
+		}
+
+		static SIMD_FORCEINLINE v_t round(v_t a) {
+#if defined(__SSE4_1__)
+			return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+#else
+			return _mm_cvtepi32_pd(_mm_cvtpd_epi32(a));
+#endif
+		}
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm_shuffle_epi32(_mm_cvtpd_epi32(a), _MM_SHUFFLE(1, 1, 0, 0)); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) {
+			const __m128i b = _mm_set1_epi32(bit);
+			return _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(q, b), b));
+		}
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(q, _mm_set1_epi32(2)), 62)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) {
+			const __m128i k = _mm_shuffle_epi32(_mm_cvtpd_epi32(n), _MM_SHUFFLE(1, 1, 0, 0));
+			return _mm_castsi128_pd(_mm_slli_epi64(_mm_add_epi32(k, _mm_set1_epi32(1023)), 52));
+		}
+		// Sin conversión int64 -> double en SSE2: el exponente se inserta en la mantisa de 2^52 y se resta
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m128i e = _mm_and_si128(_mm_srli_epi64(_mm_castpd_si128(a), 52), _mm_set1_epi64x(0x7FF));
+			const __m128d f = _mm_castsi128_pd(_mm_or_si128(e, _mm_set1_epi64x(0x4330000000000000ll)));
+			return _mm_sub_pd(f, _mm_set1_pd(4503599627370496.0 + 1023.0));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return _mm_or_pd(_mm_and_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFFll))), _mm_set1_pd(1.0));
+		}
+	};
+#endif
+
+
+	// ------------------------------------------------------------------------------------------------------------------
+	// x86 AVX2: float8 / double4
+	// ------------------------------------------------------------------------------------------------------------------
+#if defined(__AVX2__) || defined(_M_AVX2)
+	template<> struct vop<float, 8> {
+		using scalar_t = float;
+		using v_t = __m256;
+		using m_t = __m256;
+		using i_t = __m256i;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return _mm256_set1_ps(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm256_add_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm256_sub_ps(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm256_mul_ps(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm256_div_ps(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm256_min_ps(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm256_max_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm256_sqrt_ps(a); }
+#if defined(__FMA__)
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm256_fmadd_ps(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm256_fnmadd_ps(a, b, c); }
+#else
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm256_sub_ps(c, _mm256_mul_ps(a, b)); }
+#endif
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm256_and_ps(_mm256_set1_ps(-0.0f), a); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm256_xor_ps(a, b); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return _mm256_and_ps(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return _mm256_andnot_ps(a, b); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return _mm256_movemask_ps(m) != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return _mm256_blendv_ps(b, a, m); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm256_cvtps_epi32(a); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) {
+			const __m256i b = _mm256_set1_epi32(bit);
+			return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, b), b));
+		}
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23)); }
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m256i e = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(a), 23), _mm256_set1_epi32(0xFF));
+			return _mm256_sub_ps(_mm256_cvtepi32_ps(e), _mm256_set1_ps(127.0f));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return _mm256_or_ps(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF))), _mm256_set1_ps(1.0f));
+		}
+	};
+
+	template<> struct vop<double, 4> {
+		using scalar_t = double;
+		using v_t = __m256d;
+		using m_t = __m256d;
+		using i_t = __m256i;	// enteros de 64 bits con signo
+
+		static SIMD_FORCEINLINE v_t set1(double s) { return _mm256_set1_pd(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm256_add_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm256_sub_pd(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm256_mul_pd(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm256_div_pd(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm256_min_pd(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm256_max_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm256_sqrt_pd(a); }
+#if defined(__FMA__)
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm256_fmadd_pd(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm256_fnmadd_pd(a, b, c); }
+#else
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm256_sub_pd(c, _mm256_mul_pd(a, b)); }
+#endif
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm256_and_pd(_mm256_set1_pd(-0.0), a); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm256_xor_pd(a, b); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return _mm256_and_pd(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return _mm256_andnot_pd(a, b); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return _mm256_movemask_pd(m) != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return _mm256_blendv_pd(b, a, m); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(a)); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm256_add_epi64(a, _mm256_set1_epi64x(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) {
+			const __m256i b = _mm256_set1_epi64x(bit);
+			return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, b), b));
+		}
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, _mm256_set1_epi64x(2)), 62)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) {
+			const __m256i k = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n));
+			return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(k, _mm256_set1_epi64x(1023)), 52));
+		}
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m256i e = _mm256_and_si256(_mm256_srli_epi64(_mm256_castpd_si256(a), 52), _mm256_set1_epi64x(0x7FF));
+			const __m256d f = _mm256_castsi256_pd(_mm256_or_si256(e, _mm256_set1_epi64x(0x4330000000000000ll)));
+			return _mm256_sub_pd(f, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return _mm256_or_pd(_mm256_and_pd(a, _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFFll))), _mm256_set1_pd(1.0));
+		}
+	};
+#endif
+
+
+	// ------------------------------------------------------------------------------------------------------------------
+	// x86 AVX-512F: float16 / double8. Las máscaras son registros k (__mmask16 / __mmask8)
+	// ------------------------------------------------------------------------------------------------------------------
+#if defined(__AVX512F__)
+	template<> struct vop<float, 16> {
+		using scalar_t = float;
+		using v_t = __m512;
+		using m_t = __mmask16;
+		using i_t = __m512i;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return _mm512_set1_ps(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm512_add_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm512_sub_ps(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm512_mul_ps(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm512_div_ps(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm512_min_ps(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm512_max_ps(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm512_sqrt_ps(a); }
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm512_fmadd_ps(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm512_fnmadd_ps(a, b, c); }
+		// and/xor de coma flotante son AVX-512DQ: se hacen en el dominio entero
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF))); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(int(0x80000000u)))); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b))); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return m_t(a & b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return m_t(~a & b); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return m != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return _mm512_mask_blend_ps(m, b, a); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm512_cvtps_epi32(a); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm512_add_epi32(a, _mm512_set1_epi32(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) { return _mm512_test_epi32_mask(q, _mm512_set1_epi32(bit)); }
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_and_si512(q, _mm512_set1_epi32(2)), 30)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23)); }
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m512i e = _mm512_and_si512(_mm512_srli_epi32(_mm512_castps_si512(a), 23), _mm512_set1_epi32(0xFF));
+			return _mm512_sub_ps(_mm512_cvtepi32_ps(e), _mm512_set1_ps(127.0f));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			const __m512i m = _mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x007FFFFF));
+			return _mm512_castsi512_ps(_mm512_or_si512(m, _mm512_set1_epi32(0x3F800000)));
+		}
+	};
+
+	template<> struct vop<double, 8> {
+		using scalar_t = double;
+		using v_t = __m512d;
+		using m_t = __mmask8;
+		using i_t = __m512i;	// enteros de 64 bits con signo
+
+		static SIMD_FORCEINLINE v_t set1(double s) { return _mm512_set1_pd(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return _mm512_add_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return _mm512_sub_pd(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return _mm512_mul_pd(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return _mm512_div_pd(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return _mm512_min_pd(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return _mm512_max_pd(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return _mm512_sqrt_pd(a); }
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return _mm512_fmadd_pd(a, b, c); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return _mm512_fnmadd_pd(a, b, c); }
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFll))); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64((long long)0x8000000000000000ull))); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b))); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return m_t(a & b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return m_t(~a & b); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return m != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return _mm512_mask_blend_pd(m, b, a); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return _mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(a)); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return _mm512_add_epi64(a, _mm512_set1_epi64(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) { return _mm512_test_epi64_mask(q, _mm512_set1_epi64(bit)); }
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_and_si512(q, _mm512_set1_epi64(2)), 62)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) {
+			const __m512i k = _mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(n));
+			return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(k, _mm512_set1_epi64(1023)), 52));
+		}
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const __m512i e = _mm512_and_si512(_mm512_srli_epi64(_mm512_castpd_si512(a), 52), _mm512_set1_epi64(0x7FF));
+			const __m512d f = _mm512_castsi512_pd(_mm512_or_si512(e, _mm512_set1_epi64(0x4330000000000000ll)));
+			return _mm512_sub_pd(f, _mm512_set1_pd(4503599627370496.0 + 1023.0));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			const __m512i m = _mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x000FFFFFFFFFFFFFll));
+			return _mm512_castsi512_pd(_mm512_or_si512(m, _mm512_set1_epi64(0x3FF0000000000000ll)));
+		}
+	};
+#endif
+
+
+	// ------------------------------------------------------------------------------------------------------------------
+	// ARM NEON: float4 (y double2 en AArch64)
+	// ------------------------------------------------------------------------------------------------------------------
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	template<> struct vop<float, 4> {
+		using scalar_t = float;
+		using v_t = float32x4_t;
+		using m_t = uint32x4_t;
+		using i_t = int32x4_t;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return vdupq_n_f32(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return vaddq_f32(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return vsubq_f32(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return vmulq_f32(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) {
+#if defined(__aarch64__)
+			return vdivq_f32(a, b);
+#else
+			float32x4_t x = vrecpeq_f32(b);
+			x = vmulq_f32(x, vrecpsq_f32(b, x));
+			x = vmulq_f32(x, vrecpsq_f32(b, x));
+			return vmulq_f32(a, x);
+#endif
+		}
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return vminq_f32(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return vmaxq_f32(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) {
+#if defined(__aarch64__)
+			return vsqrtq_f32(a);
+#else
+			// a·rsqrt(a) con 2 pasos de Newton; 0 -> 0
+			float32x4_t x = vrsqrteq_f32(a);
+			x = vmulq_f32(x, vrsqrtsq_f32(vmulq_f32(a, x), x));
+			x = vmulq_f32(x, vrsqrtsq_f32(vmulq_f32(a, x), x));
+			return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0.0f)), a, vmulq_f32(a, x));
+#endif
+		}
+#if defined(__aarch64__)
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return vfmaq_f32(c, a, b); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return vfmsq_f32(c, a, b); }
+#else
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return vmlaq_f32(c, a, b); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return vmlsq_f32(c, a, b); }
+#endif
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return vabsq_f32(a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x80000000u))); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return vcgtq_f32(a, b); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return vcltq_f32(a, b); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return vceqq_f32(a, b); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return vandq_u32(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return vbicq_u32(b, a); }
+		static SIMD_FORCEINLINE bool any(m_t m) {
+			const uint32x2_t h = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+			return (vget_lane_u32(h, 0) | vget_lane_u32(h, 1)) != 0;
+		}
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return vbslq_f32(m, a, b); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) {
+#if defined(__aarch64__)
+			return vrndnq_f32(a);
+#else
+			return vcvtq_f32_s32(cvt_i(a));
+#endif
+		}
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) {
+#if defined(__aarch64__)
+			return vcvtnq_s32_f32(a);
+#else
+			// ARMv7 sólo trunca: suma ±0.5 según el signo
+			const float32x4_t h = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(sign(a)), vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+			return vcvtq_s32_f32(vaddq_f32(a, h));
+#endif
+		}
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) { return vtstq_s32(q, vdupq_n_s32(bit)); }
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return vreinterpretq_f32_s32(vshlq_n_s32(vandq_s32(q, vdupq_n_s32(2)), 30)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) { return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23)); }
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const uint32x4_t e = vandq_u32(vshrq_n_u32(vreinterpretq_u32_f32(a), 23), vdupq_n_u32(0xFF));
+			return vsubq_f32(vcvtq_f32_u32(e), vdupq_n_f32(127.0f));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x007FFFFFu)), vdupq_n_u32(0x3F800000u)));
+		}
+	};
+#endif
+
+#if defined(__aarch64__)
+	template<> struct vop<double, 2> {
+		using scalar_t = double;
+		using v_t = float64x2_t;
+		using m_t = uint64x2_t;
+		using i_t = int64x2_t;
+
+		static SIMD_FORCEINLINE v_t set1(double s) { return vdupq_n_f64(s); }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return vaddq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return vsubq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return vmulq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return vdivq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return vminq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return vmaxq_f64(a, b); }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return vsqrtq_f64(a); }
+		static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return vfmaq_f64(c, a, b); }
+		static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return vfmsq_f64(c, a, b); }
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return vabsq_f64(a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(0x8000000000000000ull))); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(a), vreinterpretq_u64_f64(b))); }
+
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return vcgtq_f64(a, b); }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return vcltq_f64(a, b); }
+		static SIMD_FORCEINLINE m_t eq(v_t a, v_t b) { return vceqq_f64(a, b); }
+		static SIMD_FORCEINLINE m_t m_and(m_t a, m_t b) { return vandq_u64(a, b); }
+		static SIMD_FORCEINLINE m_t m_andnot(m_t a, m_t b) { return vbicq_u64(b, a); }
+		static SIMD_FORCEINLINE bool any(m_t m) { return vmaxvq_u32(vreinterpretq_u32_u64(m)) != 0; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return vbslq_f64(m, a, b); }
+
+		static SIMD_FORCEINLINE v_t round(v_t a) { return vrndnq_f64(a); }
+		static SIMD_FORCEINLINE i_t cvt_i(v_t a) { return vcvtnq_s64_f64(a); }
+		static SIMD_FORCEINLINE i_t add_i(i_t a, int b) { return vaddq_s64(a, vdupq_n_s64(b)); }
+		static SIMD_FORCEINLINE m_t bit_mask(i_t q, int bit) { return vtstq_s64(q, vdupq_n_s64(bit)); }
+		static SIMD_FORCEINLINE v_t quadrant_sign(i_t q) { return vreinterpretq_f64_s64(vshlq_n_s64(vandq_s64(q, vdupq_n_s64(2)), 62)); }
+
+		static SIMD_FORCEINLINE v_t pow2i(v_t n) { return vreinterpretq_f64_s64(vshlq_n_s64(vaddq_s64(vcvtq_s64_f64(n), vdupq_n_s64(1023)), 52)); }
+		static SIMD_FORCEINLINE v_t exponent(v_t a) {
+			const uint64x2_t e = vandq_u64(vshrq_n_u64(vreinterpretq_u64_f64(a), 52), vdupq_n_u64(0x7FF));
+			return vsubq_f64(vcvtq_f64_u64(e), vdupq_n_f64(1023.0));
+		}
+		static SIMD_FORCEINLINE v_t mantissa(v_t a) {
+			return vreinterpretq_f64_u64(vorrq_u64(vandq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(0x000FFFFFFFFFFFFFull)), vdupq_n_u64(0x3FF0000000000000ull)));
+		}
+	};
+#endif
+
+} // namespace simd_internal
+
+
+
+// ===============================
+//  Operadores de packs con registro nativo
+// ===============================
+//
+// + - * / y negación para los simd_pack_t<D,T> con vop<T,D>, también con un escalar a cualquier lado. Van en el espacio
+// de nombres global, como simd_pack_t, para que se encuentren por ADL desde cualquier lambda. simd::min/max por lane
+// completan el juego; con AVX-512 los packs de 16 enteros tienen además + - * y min/max propios.
+
+#define SIMD_GEN_VOP_OPERATOR(OP, func)                                                                                  \
+template<int D, typename T> requires simd_internal::has_vop<T, D>                                                        \
+SIMD_FORCEINLINE simd_pack_t<D, T> operator OP(const simd_pack_t<D, T>& a, const simd_pack_t<D, T>& b) {                 \
+	return simd_pack_t<D, T>(simd_internal::vop<T, D>::func(a.m, b.m));                                                  \
+}                                                                                                                        \
+template<int D, typename T> requires simd_internal::has_vop<T, D>                                                        \
+SIMD_FORCEINLINE simd_pack_t<D, T> operator OP(const simd_pack_t<D, T>& a, std::type_identity_t<T> b) {                  \
+	return simd_pack_t<D, T>(simd_internal::vop<T, D>::func(a.m, simd_internal::vop<T, D>::set1(b)));                    \
+}                                                                                                                        \
+template<int D, typename T> requires simd_internal::has_vop<T, D>                                                        \
+SIMD_FORCEINLINE simd_pack_t<D, T> operator OP(std::type_identity_t<T> a, const simd_pack_t<D, T>& b) {                  \
+	return simd_pack_t<D, T>(simd_internal::vop<T, D>::func(simd_internal::vop<T, D>::set1(a), b.m));                    \
+}
+
+SIMD_GEN_VOP_OPERATOR(+, add)
+SIMD_GEN_VOP_OPERATOR(-, sub)
+SIMD_GEN_VOP_OPERATOR(*, mul)
+SIMD_GEN_VOP_OPERATOR(/, div)
+
+#undef SIMD_GEN_VOP_OPERATOR
+
+template<int D, typename T> requires simd_internal::has_vop<T, D>
+SIMD_FORCEINLINE simd_pack_t<D, T> operator-(const simd_pack_t<D, T>& a) {
+	return simd_pack_t<D, T>(simd_internal::vop<T, D>::xor_(a.m, simd_internal::vop<T, D>::set1(T(-0.0))));
+}
+
+namespace simd {
+
+	template<int D, typename T> requires simd_internal::has_vop<T, D>
+	SIMD_FORCEINLINE simd_pack_t<D, T> min(const simd_pack_t<D, T>& a, const simd_pack_t<D, T>& b) { return simd_pack_t<D, T>(simd_internal::vop<T, D>::min(a.m, b.m)); }
+	template<int D, typename T> requires simd_internal::has_vop<T, D>
+	SIMD_FORCEINLINE simd_pack_t<D, T> max(const simd_pack_t<D, T>& a, const simd_pack_t<D, T>& b) { return simd_pack_t<D, T>(simd_internal::vop<T, D>::max(a.m, b.m)); }
+
+} // namespace simd
+
+#if defined(__AVX512F__)
+SIMD_FORCEINLINE simd_pack_t<16, int>		operator+(const simd_pack_t<16, int>& a, const simd_pack_t<16, int>& b) { return simd_pack_t<16, int>(_mm512_add_epi32(a.m, b.m)); }
+SIMD_FORCEINLINE simd_pack_t<16, unsigned>	operator+(const simd_pack_t<16, unsigned>& a, const simd_pack_t<16, unsigned>& b) { return simd_pack_t<16, unsigned>(_mm512_add_epi32(a.m, b.m)); }
+SIMD_FORCEINLINE simd_pack_t<16, int>		operator-(const simd_pack_t<16, int>& a, const simd_pack_t<16, int>& b) { return simd_pack_t<16, int>(_mm512_sub_epi32(a.m, b.m)); }
+SIMD_FORCEINLINE simd_pack_t<16, unsigned>	operator-(const simd_pack_t<16, unsigned>& a, const simd_pack_t<16, unsigned>& b) { return simd_pack_t<16, unsigned>(_mm512_sub_epi32(a.m, b.m)); }
+SIMD_FORCEINLINE simd_pack_t<16, int>		operator*(const simd_pack_t<16, int>& a, const simd_pack_t<16, int>& b) { return simd_pack_t<16, int>(_mm512_mullo_epi32(a.m, b.m)); }
+SIMD_FORCEINLINE simd_pack_t<16, unsigned>	operator*(const simd_pack_t<16, unsigned>& a, const simd_pack_t<16, unsigned>& b) { return simd_pack_t<16, unsigned>(_mm512_mullo_epi32(a.m, b.m)); }
+
+namespace simd {
+
+	SIMD_FORCEINLINE simd_pack_t<16, int>		min(const simd_pack_t<16, int>& a, const simd_pack_t<16, int>& b) { return simd_pack_t<16, int>(_mm512_min_epi32(a.m, b.m)); }
+	SIMD_FORCEINLINE simd_pack_t<16, unsigned>	min(const simd_pack_t<16, unsigned>& a, const simd_pack_t<16, unsigned>& b) { return simd_pack_t<16, unsigned>(_mm512_min_epu32(a.m, b.m)); }
+	SIMD_FORCEINLINE simd_pack_t<16, int>		max(const simd_pack_t<16, int>& a, const simd_pack_t<16, int>& b) { return simd_pack_t<16, int>(_mm512_max_epi32(a.m, b.m)); }
+	SIMD_FORCEINLINE simd_pack_t<16, unsigned>	max(const simd_pack_t<16, unsigned>& a, const simd_pack_t<16, unsigned>& b) { return simd_pack_t<16, unsigned>(_mm512_max_epu32(a.m, b.m)); }
+
+} // namespace simd
+#endif
@@ -0,0 +1,493 @@
+// simd_soa_types.h
+#pragma once
+
+#include <simd/simd_types.h>
+#include <simd/simd_memory_ops.h>
+#include <simd/simd_reg_ops.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <utility>
+
+// ===============================
+//  Contenedores SoA (structure of arrays)
+// ===============================
+//
+// simd_pack_t<3,T> no tiene registro: cross/dot3/normalize sobre miles de vectores van a velocidad escalar.
+// soa_vec_t<N,T> guarda cada componente en su propio array alineado a 64 bytes, así que un registro contiene la
+// misma componente de W vectores (8 floats con AVX2, 16 con AVX-512) y las operaciones geométricas procesan W
+// vectores por instrucción sin shuffles.
+//
+//  - size() vectores válidos; cada array se rellena hasta padded_size() (múltiplo de 64 bytes) con ceros. Los
+//    kernels recorren registros completos sin cola y sólo se escriben lanes >= size() con el resultado de entradas
+//    a cero (que es cero en todas las operaciones de aquí).
+//  - Las salidas SoA se redimensionan al tamaño de la entrada y pueden ser la misma instancia que una entrada.
+//  - aos_to_soa / soa_to_aos convierten desde/hacia arrays intercalados (x0 y0 z0 x1 ...) para la ingesta.
+//
+//   simd::soa_vec3<float> p(n), q(n), r;
+//   simd::cross(p, q, r);
+//   simd::normalize_safe(r, r);
+
+namespace simd {
+
+	template<int N, typename T>
+	class soa_vec_t {
+		static_assert(N >= 2 && N <= 4, "soa_vec_t: 2, 3 o 4 componentes");
+
+	public:
+		using value_type = T;
+		static constexpr int components = N;
+		static constexpr size_t kAlign = 64;
+		static constexpr size_t kPad = kAlign / sizeof(T);
+
+		soa_vec_t() = default;
+		explicit soa_vec_t(size_t n) { resize(n); }
+		soa_vec_t(const soa_vec_t& o) { _copy_from(o); }
+		soa_vec_t(soa_vec_t&& o) noexcept { _swap(o); }
+		~soa_vec_t() { _release(); }
+
+		soa_vec_t& operator=(const soa_vec_t& o) {
+			if (this != &o) { _release(); _copy_from(o); }
+			return *this;
+		}
+		soa_vec_t& operator=(soa_vec_t&& o) noexcept {
+			if (this != &o) { _release(); _swap(o); }
+			return *this;
+		}
+
+		size_t size() const { return mSize; }
+		size_t padded_size() const { return mStride; }
+		bool empty() const { return mSize == 0; }
+
+		// Conserva los primeros min(n, size()) vectores; el resto queda a cero
+		void resize(size_t n) {
+			const size_t stride = (n + kPad - 1) / kPad * kPad;
+			if (stride == mStride) {
+				for (int c = 0; c < N; ++c)
+					if (n < mSize) std::memset(data(c) + n, 0, (mSize - n) * sizeof(T));
+				mSize = n;
+				return;
+			}
+			T* mem = stride ? static_cast<T*>(::operator new(stride * N * sizeof(T), std::align_val_t(kAlign))) : nullptr;
+			if (mem) std::memset(mem, 0, stride * N * sizeof(T));
+			const size_t keep = n < mSize ? n : mSize;
+			for (int c = 0; c < N && keep; ++c)
+				std::memcpy(mem + c * stride, data(c), keep * sizeof(T));
+			_release();
+			mData = mem;
+			mSize = n;
+			mStride = stride;
+		}
+
+		void clear() { _release(); }
+
+		// Stream de la componente c (0 = x ... N-1)
+		T* data(int c) { return mData + c * mStride; }
+		const T* data(int c) const { return mData + c * mStride; }
+
+		T* x() { return data(0); }
+		T* y() { return data(1); }
+		T* z() requires (N >= 3) { return data(2); }
+		T* w() requires (N >= 4) { return data(3); }
+		const T* x() const { return data(0); }
+		const T* y() const { return data(1); }
+		const T* z() const requires (N >= 3) { return data(2); }
+		const T* w() const requires (N >= 4) { return data(3); }
+
+		simd_pack_t<N, T> get(size_t i) const {
+			assert(i < mSize);
+			simd_pack_t<N, T> r(T(0));
+			for (int c = 0; c < N; ++c) r[c] = data(c)[i];
+			return r;
+		}
+		void set(size_t i, const simd_pack_t<N, T>& v) {
+			assert(i < mSize);
+			for (int c = 0; c < N; ++c) data(c)[i] = v[c];
+		}
+
+	private:
+		void _release() {
+			if (mData) ::operator delete(mData, std::align_val_t(kAlign));
+			mData = nullptr;
+			mSize = mStride = 0;
+		}
+		void _copy_from(const soa_vec_t& o) {
+			resize(o.mSize);
+			if (mStride) std::memcpy(mData, o.mData, mStride * N * sizeof(T));
+		}
+		void _swap(soa_vec_t& o) noexcept {
+			std::swap(mData, o.mData);
+			std::swap(mSize, o.mSize);
+			std::swap(mStride, o.mStride);
+		}
+
+		T*		mData = nullptr;
+		size_t	mSize = 0;
+		size_t	mStride = 0;
+	};
+
+	template<typename T> using soa_vec2 = soa_vec_t<2, T>;
+	template<typename T> using soa_vec3 = soa_vec_t<3, T>;
+	template<typename T> using soa_vec4 = soa_vec_t<4, T>;
+
+} // namespace simd
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Kernels
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace simd {
+	namespace soa_detail {
+
+		using simd_internal::has_vop;
+
+		// Registro más ancho con vop<T,W>; 1 si no hay ninguno
+		template<typename T>
+		constexpr int lanes() {
+			if constexpr (has_vop<T, 16>) return 16;
+			else if constexpr (has_vop<T, 8>) return 8;
+			else if constexpr (has_vop<T, 4>) return 4;
+			else if constexpr (has_vop<T, 2>) return 2;
+			else return 1;
+		}
+
+		template<typename T, int W = lanes<T>()>
+		struct ops : simd_internal::vop<T, W> {
+			using v_t = typename simd_internal::vop<T, W>::v_t;
+			static constexpr int width = W;
+			static SIMD_FORCEINLINE v_t load(const T* p) { return simd::load<W, T>(p).m; }
+			static SIMD_FORCEINLINE void store(T* p, v_t v) { simd::store<W, T>(p, simd_pack_t<W, T>(v)); }
+		};
+
+		// Sin registro nativo: un lane escalar con la misma interfaz
+		template<typename T>
+		struct ops<T, 1> {
+			using v_t = T;
+			using m_t = bool;
+			static constexpr int width = 1;
+			static SIMD_FORCEINLINE v_t load(const T* p) { return *p; }
+			static SIMD_FORCEINLINE void store(T* p, v_t v) { *p = v; }
+			static SIMD_FORCEINLINE v_t set1(T s) { return s; }
+			static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return a + b; }
+			static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return a - b; }
+			static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return a * b; }
+			static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return a / b; }
+			static SIMD_FORCEINLINE v_t sqrt(v_t a) { return std::sqrt(a); }
+			static SIMD_FORCEINLINE v_t fma(v_t a, v_t b, v_t c) { return a * b + c; }
+			static SIMD_FORCEINLINE v_t fnma(v_t a, v_t b, v_t c) { return c - a * b; }
+			static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return a > b; }
+			static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return m ? a : b; }
+		};
+
+		// Suma de productos componente a componente
+		template<int N, typename V>
+		SIMD_FORCEINLINE typename V::v_t dot(const typename V::v_t* a, const typename V::v_t* b) {
+			auto s = V::mul(a[0], b[0]);
+			for (int c = 1; c < N; ++c) s = V::fma(a[c], b[c], s);
+			return s;
+		}
+
+		template<int N, typename T, typename V>
+		SIMD_FORCEINLINE void load_vec(const soa_vec_t<N, T>& s, size_t i, typename V::v_t* r) {
+			for (int c = 0; c < N; ++c) r[c] = V::load(s.data(c) + i);
+		}
+
+		template<int N, typename T, typename V>
+		SIMD_FORCEINLINE void store_vec(soa_vec_t<N, T>& s, size_t i, const typename V::v_t* r) {
+			for (int c = 0; c < N; ++c) V::store(s.data(c) + i, r[c]);
+		}
+
+		// Sólo los count < W primeros lanes (salidas escalares de tamaño exacto)
+		template<typename T, typename V>
+		SIMD_FORCEINLINE void store_partial(T* out, typename V::v_t v, size_t count) {
+			alignas(64) T tmp[V::width];
+			V::store(tmp, v);
+			for (size_t k = 0; k < count; ++k) out[k] = tmp[k];
+		}
+
+		// out[i] = f(registro i) para i < n, con out de tamaño exacto
+		template<typename T, typename V, typename F>
+		SIMD_FORCEINLINE void scalar_out(std::span<T> out, size_t n, F&& f) {
+			constexpr size_t W = V::width;
+			size_t i = 0;
+			for (; i + W <= n; i += W) V::store(out.data() + i, f(i));
+			if (i < n) store_partial<T, V>(out.data() + i, f(i), n - i);
+		}
+
+	} // namespace soa_detail
+
+
+	// ===============================
+	//  Operaciones geométricas
+	// ===============================
+
+	// out[i] = dot(a[i], b[i])
+	template<int N, typename T>
+	void dot(const soa_vec_t<N, T>& a, const soa_vec_t<N, T>& b, std::span<T> out) {
+		using V = soa_detail::ops<T>;
+		assert(a.size() == b.size() && out.size() >= a.size());
+		soa_detail::scalar_out<T, V>(out, a.size(), [&](size_t i) {
+			typename V::v_t va[N], vb[N];
+			soa_detail::load_vec<N, T, V>(a, i, va);
+			soa_detail::load_vec<N, T, V>(b, i, vb);
+			return soa_detail::dot<N, V>(va, vb);
+		});
+	}
+
+	// out[i] = |a[i]|
+	template<int N, typename T>
+	void length(const soa_vec_t<N, T>& a, std::span<T> out) {
+		using V = soa_detail::ops<T>;
+		assert(out.size() >= a.size());
+		soa_detail::scalar_out<T, V>(out, a.size(), [&](size_t i) {
+			typename V::v_t va[N];
+			soa_detail::load_vec<N, T, V>(a, i, va);
+			return V::sqrt(soa_detail::dot<N, V>(va, va));
+		});
+	}
+
+	// out[i] = a[i] x b[i]. Con 4 componentes se cruzan xyz y w = 0.
+	template<int N, typename T>
+		requires (N >= 3)
+	void cross(const soa_vec_t<N, T>& a, const soa_vec_t<N, T>& b, soa_vec_t<N, T>& out) {
+		using V = soa_detail::ops<T>;
+		assert(a.size() == b.size());
+		out.resize(a.size());
+		for (size_t i = 0; i < a.padded_size(); i += V::width) {
+			typename V::v_t va[N], vb[N], r[N];
+			soa_detail::load_vec<N, T, V>(a, i, va);
+			soa_detail::load_vec<N, T, V>(b, i, vb);
+			r[0] = V::fnma(va[2], vb[1], V::mul(va[1], vb[2]));
+			r[1] = V::fnma(va[0], vb[2], V::mul(va[2], vb[0]));
+			r[2] = V::fnma(va[1], vb[0], V::mul(va[0], vb[1]));
+			if constexpr (N == 4) r[3] = V::set1(T(0));
+			soa_detail::store_vec<N, T, V>(out, i, r);
+		}
+	}
+
+	// out[i] = a[i] / |a[i]|, o 0 si |a[i]| <= eps
+	template<int N, typename T>
+	void normalize_safe(const soa_vec_t<N, T>& a, soa_vec_t<N, T>& out, T eps = T(1e-6)) {
+		using V = soa_detail::ops<T>;
+		out.resize(a.size());
+		const auto veps = V::set1(eps);
+		const auto zero = V::set1(T(0));
+		for (size_t i = 0; i < a.padded_size(); i += V::width) {
+			typename V::v_t va[N];
+			soa_detail::load_vec<N, T, V>(a, i, va);
+			const auto len = V::sqrt(soa_detail::dot<N, V>(va, va));
+			const auto inv = V::select(V::gt(len, veps), V::div(V::set1(T(1)), len), zero);
+			for (int c = 0; c < N; ++c) va[c] = V::mul(va[c], inv);
+			soa_detail::store_vec<N, T, V>(out, i, va);
+		}
+	}
+
+	// out[i] = I[i] - 2·dot(N[i], I[i])·N[i]
+	template<int N, typename T>
+	void reflect(const soa_vec_t<N, T>& I, const soa_vec_t<N, T>& n, soa_vec_t<N, T>& out) {
+		using V = soa_detail::ops<T>;
+		assert(I.size() == n.size());
+		out.resize(I.size());
+		for (size_t i = 0; i < I.padded_size(); i += V::width) {
+			typename V::v_t vi[N], vn[N];
+			soa_detail::load_vec<N, T, V>(I, i, vi);
+			soa_detail::load_vec<N, T, V>(n, i, vn);
+			const auto d2 = V::mul(V::set1(T(2)), soa_detail::dot<N, V>(vn, vi));
+			for (int c = 0; c < N; ++c) vi[c] = V::fnma(d2, vn[c], vi[c]);
+			soa_detail::store_vec<N, T, V>(out, i, vi);
+		}
+	}
+
+	// out[i] = b[i]·dot(a[i], b[i]) / dot(b[i], b[i]), o 0 si b[i] es nulo
+	template<int N, typename T>
+	void project(const soa_vec_t<N, T>& a, const soa_vec_t<N, T>& b, soa_vec_t<N, T>& out) {
+		using V = soa_detail::ops<T>;
+		assert(a.size() == b.size());
+		out.resize(a.size());
+		const auto zero = V::set1(T(0));
+		for (size_t i = 0; i < a.padded_size(); i += V::width) {
+			typename V::v_t va[N], vb[N];
+			soa_detail::load_vec<N, T, V>(a, i, va);
+			soa_detail::load_vec<N, T, V>(b, i, vb);
+			const auto bb = soa_detail::dot<N, V>(vb, vb);
+			const auto s = V::select(V::gt(bb, zero), V::div(soa_detail::dot<N, V>(va, vb), bb), zero);
+			for (int c = 0; c < N; ++c) va[c] = V::mul(vb[c], s);
+			soa_detail::store_vec<N, T, V>(out, i, va);
+		}
+	}
+
+} // namespace simd
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Transposición AoS <-> SoA
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace simd {
+	namespace soa_detail {
+
+		// Bloques de 4 vectores float; devuelve cuántos vectores ha procesado (el resto va por el bucle genérico)
+		template<int N, typename T>
+		SIMD_FORCEINLINE size_t deinterleave4(const T*, size_t, soa_vec_t<N, T>&) { return 0; }
+		template<int N, typename T>
+		SIMD_FORCEINLINE size_t interleave4(const soa_vec_t<N, T>&, T*, size_t) { return 0; }
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		// a = x0 y0 z0 x1 | b = y1 z1 x2 y2 | c = z2 x3 y3 z3
+		template<>
+		SIMD_FORCEINLINE size_t deinterleave4<3, float>(const float* in, size_t n, soa_vec_t<3, float>& out) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, in += 12) {
+				const __m128 a = _mm_loadu_ps(in), b = _mm_loadu_ps(in + 4), c = _mm_loadu_ps(in + 8);
+				const __m128 x2x3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+				const __m128 y01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), y23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+				const __m128 z01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), z23 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+				_mm_store_ps(out.x() + i, _mm_shuffle_ps(a, x2x3, _MM_SHUFFLE(2, 0, 3, 0)));
+				_mm_store_ps(out.y() + i, _mm_shuffle_ps(y01, y23, _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_store_ps(out.z() + i, _mm_shuffle_ps(z01, z23, _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t interleave4<3, float>(const soa_vec_t<3, float>& in, float* out, size_t n) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, out += 12) {
+				const __m128 x = _mm_load_ps(in.x() + i), y = _mm_load_ps(in.y() + i), z = _mm_load_ps(in.z() + i);
+				const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				_mm_storeu_ps(out, a);
+				_mm_storeu_ps(out + 4, b);
+				_mm_storeu_ps(out + 8, c);
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t deinterleave4<4, float>(const float* in, size_t n, soa_vec_t<4, float>& out) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, in += 16) {
+				__m128 r0 = _mm_loadu_ps(in), r1 = _mm_loadu_ps(in + 4), r2 = _mm_loadu_ps(in + 8), r3 = _mm_loadu_ps(in + 12);
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				_mm_store_ps(out.x() + i, r0);
+				_mm_store_ps(out.y() + i, r1);
+				_mm_store_ps(out.z() + i, r2);
+				_mm_store_ps(out.w() + i, r3);
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t interleave4<4, float>(const soa_vec_t<4, float>& in, float* out, size_t n) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, out += 16) {
+				__m128 r0 = _mm_load_ps(in.x() + i), r1 = _mm_load_ps(in.y() + i), r2 = _mm_load_ps(in.z() + i), r3 = _mm_load_ps(in.w() + i);
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				_mm_storeu_ps(out, r0);
+				_mm_storeu_ps(out + 4, r1);
+				_mm_storeu_ps(out + 8, r2);
+				_mm_storeu_ps(out + 12, r3);
+			}
+			return i;
+		}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		// vld3q/vld4q desintercalan en la propia carga
+		template<>
+		SIMD_FORCEINLINE size_t deinterleave4<3, float>(const float* in, size_t n, soa_vec_t<3, float>& out) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, in += 12) {
+				const float32x4x3_t v = vld3q_f32(in);
+				vst1q_f32(out.x() + i, v.val[0]);
+				vst1q_f32(out.y() + i, v.val[1]);
+				vst1q_f32(out.z() + i, v.val[2]);
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t interleave4<3, float>(const soa_vec_t<3, float>& in, float* out, size_t n) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, out += 12) {
+				float32x4x3_t v;
+				v.val[0] = vld1q_f32(in.x() + i);
+				v.val[1] = vld1q_f32(in.y() + i);
+				v.val[2] = vld1q_f32(in.z() + i);
+				vst3q_f32(out, v);
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t deinterleave4<4, float>(const float* in, size_t n, soa_vec_t<4, float>& out) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, in += 16) {
+				const float32x4x4_t v = vld4q_f32(in);
+				vst1q_f32(out.x() + i, v.val[0]);
+				vst1q_f32(out.y() + i, v.val[1]);
+				vst1q_f32(out.z() + i, v.val[2]);
+				vst1q_f32(out.w() + i, v.val[3]);
+			}
+			return i;
+		}
+
+		template<>
+		SIMD_FORCEINLINE size_t interleave4<4, float>(const soa_vec_t<4, float>& in, float* out, size_t n) {
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4, out += 16) {
+				float32x4x4_t v;
+				v.val[0] = vld1q_f32(in.x() + i);
+				v.val[1] = vld1q_f32(in.y() + i);
+				v.val[2] = vld1q_f32(in.z() + i);
+				v.val[3] = vld1q_f32(in.w() + i);
+				vst4q_f32(out, v);
+			}
+			return i;
+		}
+#endif
+
+	} // namespace soa_detail
+
+	// aos = x0 y0 [z0 [w0]] x1 ...: aos.size() / N vectores
+	template<int N, typename T>
+	void aos_to_soa(std::span<const T> aos, soa_vec_t<N, T>& out) {
+		const size_t n = aos.size() / N;
+		out.resize(n);
+		size_t i = soa_detail::deinterleave4<N, T>(aos.data(), n, out);
+		for (; i < n; ++i)
+			for (int c = 0; c < N; ++c) out.data(c)[i] = aos[i * N + c];
+	}
+
+	// aos.size() >= in.size() * N
+	template<int N, typename T>
+	void soa_to_aos(const soa_vec_t<N, T>& in, std::span<T> aos) {
+		const size_t n = in.size();
+		assert(aos.size() >= n * N);
+		size_t i = soa_detail::interleave4<N, T>(in, aos.data(), n);
+		for (; i < n; ++i)
+			for (int c = 0; c < N; ++c) aos[i * N + c] = in.data(c)[i];
+	}
+
+	// Packs sin relleno (simd_pack_t<3,T> son 3 T seguidos; simd_pack_t<4,float> es un __m128)
+	template<int N, typename T>
+	void aos_to_soa(std::span<const simd_pack_t<N, T>> aos, soa_vec_t<N, T>& out) {
+		static_assert(sizeof(simd_pack_t<N, T>) == N * sizeof(T), "aos_to_soa: simd_pack_t con relleno");
+		aos_to_soa<N, T>(std::span<const T>(reinterpret_cast<const T*>(aos.data()), aos.size() * N), out);
+	}
+
+	template<int N, typename T>
+	void soa_to_aos(const soa_vec_t<N, T>& in, std::span<simd_pack_t<N, T>> aos) {
+		static_assert(sizeof(simd_pack_t<N, T>) == N * sizeof(T), "soa_to_aos: simd_pack_t con relleno");
+		soa_to_aos<N, T>(in, std::span<T>(reinterpret_cast<T*>(aos.data()), aos.size() * N));
+	}
+
+} // namespace simd
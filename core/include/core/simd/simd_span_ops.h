@@ -0,0 +1,208 @@
+// simd_span_ops.h
+#pragma once
+
+#include <simd/simd_types.h>
+#include <simd/simd_memory_ops.h>
+#include <simd/simd_reg_ops.h>
+#include <simd/simd_exp_ops.h>
+#include <simd/simd_trigonometry_ops.h>
+#include <core/threading.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// ===============================
+//  Operaciones sobre arrays
+// ===============================
+//
+// transform() recorre arrays contiguos en packs del registro más ancho con vop<T,W> (16 floats / 8 doubles con AVX-512,
+// 8 / 4 con AVX2, 4 / 2 con SSE2 y NEON) y llama a la lambda con un simd_pack_t<W,T>, así que reutiliza directamente los
+// kernels por pack. Sin ningún registro nativo la lambda recibe escalares T de uno en uno.
+//  - Cabeza: si la salida no está alineada al registro, un primer pack parcial la alinea.
+//  - Cuerpo: packs completos. Los store son sin alinear (storeu), pero con la salida ya alineada ninguno cruza una
+//    línea de caché y cuestan lo mismo que los alineados; las entradas pueden seguir desalineadas.
+//  - Cola: los n % W restantes se copian a un pack temporal y sólo se escriben los lanes válidos.
+//
+// Encadenar operaciones dentro de la misma lambda las fusiona en una única pasada sobre memoria:
+//   simd::transform(in, out, [](const auto& v) { return simd::fast_exp(v * 0.5f) + 1.0f; });
+//
+// in y out pueden ser el mismo array (in-place). Con exec_t::PARALLEL y arrays grandes el trabajo se reparte con
+// parallel_for en bloques de kParallelGrain elementos.
+
+namespace simd {
+
+	// Registro más ancho con vop<T,W>; 1 si no hay ninguno
+	template<typename T> struct native_lanes {
+		static constexpr int value = simd_internal::has_vop<T, 16> ? 16 : simd_internal::has_vop<T, 8> ? 8 :
+									 simd_internal::has_vop<T, 4> ? 4 : simd_internal::has_vop<T, 2> ? 2 : 1;
+	};
+	template<typename T> inline constexpr int native_lanes_v = native_lanes<T>::value;
+
+	enum class exec_t : uint8_t {
+		SERIAL,
+		PARALLEL
+	};
+
+	// Elementos por tarea en ejecución paralela (64 KB de floats: amortiza el reparto y cabe en L2)
+	constexpr size_t kParallelGrain = 16 * 1024;
+
+	namespace span_detail {
+
+		// Pack parcial: n < W elementos a través de un temporal
+		template<int W, typename T, typename F>
+		SIMD_FORCEINLINE void unary_partial(const T* in, T* out, size_t n, F& f) {
+			alignas(64) T tmp[W] = {};
+			for (size_t i = 0; i < n; ++i) tmp[i] = in[i];
+			store<W, T>(tmp, f(load<W, T>(tmp)));
+			for (size_t i = 0; i < n; ++i) out[i] = tmp[i];
+		}
+
+		template<int W, typename T, typename F>
+		SIMD_FORCEINLINE void binary_partial(const T* a, const T* b, T* out, size_t n, F& f) {
+			alignas(64) T ta[W] = {};
+			alignas(64) T tb[W] = {};
+			for (size_t i = 0; i < n; ++i) { ta[i] = a[i]; tb[i] = b[i]; }
+			store<W, T>(ta, f(load<W, T>(ta), load<W, T>(tb)));
+			for (size_t i = 0; i < n; ++i) out[i] = ta[i];
+		}
+
+		// Elementos hasta que out quede alineado a W * sizeof(T)
+		template<int W, typename T>
+		SIMD_FORCEINLINE size_t head_count(const T* out, size_t n) {
+			const size_t misalign = (reinterpret_cast<uintptr_t>(out) / sizeof(T)) % W;
+			const size_t head = misalign ? size_t(W) - misalign : 0;
+			return head < n ? head : n;
+		}
+
+		template<int W, typename T, typename F>
+		void unary_range(const T* in, T* out, size_t n, F& f) {
+			if constexpr (W == 1) {
+				for (size_t i = 0; i < n; ++i) out[i] = f(in[i]);
+				return;
+			}
+			size_t i = head_count<W>(out, n);
+			if (i) unary_partial<W>(in, out, i, f);
+			for (; i + W <= n; i += W)
+				store<W, T>(out + i, f(load<W, T>(in + i)));
+			if (i < n) unary_partial<W>(in + i, out + i, n - i, f);
+		}
+
+		template<int W, typename T, typename F>
+		void binary_range(const T* a, const T* b, T* out, size_t n, F& f) {
+			if constexpr (W == 1) {
+				for (size_t i = 0; i < n; ++i) out[i] = f(a[i], b[i]);
+				return;
+			}
+			size_t i = head_count<W>(out, n);
+			if (i) binary_partial<W>(a, b, out, i, f);
+			for (; i + W <= n; i += W)
+				store<W, T>(out + i, f(load<W, T>(a + i), load<W, T>(b + i)));
+			if (i < n) binary_partial<W>(a + i, b + i, out + i, n - i, f);
+		}
+
+		// Operaciones por lanes de las funciones con nombre: vop<T,W> con pack, la del lenguaje con escalar (W = 1)
+#define SIMD_GEN_SPAN_VOP_BINARY(name, OP)                                                                        \
+		template<typename T>                                                                                     \
+		SIMD_FORCEINLINE T name(T a, T b) { return a OP b; }                                                     \
+		template<int W, typename T>                                                                              \
+		SIMD_FORCEINLINE simd_pack_t<W, T> name(const simd_pack_t<W, T>& a, const simd_pack_t<W, T>& b) {        \
+			return simd_pack_t<W, T>(simd_internal::vop<T, W>::name(a.m, b.m));                                  \
+		}
+
+		SIMD_GEN_SPAN_VOP_BINARY(add, +)
+		SIMD_GEN_SPAN_VOP_BINARY(sub, -)
+		SIMD_GEN_SPAN_VOP_BINARY(mul, *)
+		SIMD_GEN_SPAN_VOP_BINARY(div, /)
+
+#undef SIMD_GEN_SPAN_VOP_BINARY
+
+		template<typename T>
+		SIMD_FORCEINLINE T sqrt(T a) { return std::sqrt(a); }
+		template<int W, typename T>
+		SIMD_FORCEINLINE simd_pack_t<W, T> sqrt(const simd_pack_t<W, T>& a) { return simd_pack_t<W, T>(simd_internal::vop<T, W>::sqrt(a.m)); }
+
+	} // namespace span_detail
+
+	// out[i] = f(in[i]) por packs de W lanes. out.size() >= in.size().
+	template<typename T, typename F>
+	void transform(std::span<const T> in, std::span<T> out, F&& f, exec_t exec = exec_t::SERIAL) {
+		constexpr int W = native_lanes_v<T>;
+		assert(out.size() >= in.size());
+		const size_t n = in.size();
+		if (exec == exec_t::PARALLEL && n > kParallelGrain) {
+			parallel_for(n, kParallelGrain, [&](size_t begin, size_t end) {
+				span_detail::unary_range<W>(in.data() + begin, out.data() + begin, end - begin, f);
+			});
+			return;
+		}
+		span_detail::unary_range<W>(in.data(), out.data(), n, f);
+	}
+
+	// out[i] = f(a[i], b[i]) por packs de W lanes. a y b del mismo tamaño.
+	template<typename T, typename F>
+	void transform(std::span<const T> a, std::span<const T> b, std::span<T> out, F&& f, exec_t exec = exec_t::SERIAL) {
+		constexpr int W = native_lanes_v<T>;
+		assert(a.size() == b.size() && out.size() >= a.size());
+		const size_t n = a.size();
+		if (exec == exec_t::PARALLEL && n > kParallelGrain) {
+			parallel_for(n, kParallelGrain, [&](size_t begin, size_t end) {
+				span_detail::binary_range<W>(a.data() + begin, b.data() + begin, out.data() + begin, end - begin, f);
+			});
+			return;
+		}
+		span_detail::binary_range<W>(a.data(), b.data(), out.data(), n, f);
+	}
+
+} // namespace simd
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Funciones con nombre sobre spans
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define SIMD_GEN_SPAN_UNARY_PARTIAL(type, name, packfunc)                                                     \
+	inline void name(std::span<const type> in, std::span<type> out, exec_t exec = exec_t::SERIAL) {            \
+		transform<type>(in, out, [](const auto& v) { return packfunc(v); }, exec);                           \
+	}
+
+#define SIMD_GEN_SPAN_UNARY(name, packfunc)           \
+	SIMD_GEN_SPAN_UNARY_PARTIAL(float, name, packfunc)  \
+	SIMD_GEN_SPAN_UNARY_PARTIAL(double, name, packfunc)
+
+#define SIMD_GEN_SPAN_BINARY_PARTIAL(type, name, packfunc)                                                              \
+	inline void name(std::span<const type> a, std::span<const type> b, std::span<type> out, exec_t exec = exec_t::SERIAL) { \
+		transform<type>(a, b, out, [](const auto& x, const auto& y) { return packfunc(x, y); }, exec);                  \
+	}
+
+#define SIMD_GEN_SPAN_BINARY(name, packfunc)           \
+	SIMD_GEN_SPAN_BINARY_PARTIAL(float, name, packfunc)  \
+	SIMD_GEN_SPAN_BINARY_PARTIAL(double, name, packfunc)
+
+namespace simd {
+
+	SIMD_GEN_SPAN_BINARY(add, span_detail::add)
+	SIMD_GEN_SPAN_BINARY(sub, span_detail::sub)
+	SIMD_GEN_SPAN_BINARY(mul, span_detail::mul)
+	SIMD_GEN_SPAN_BINARY(div, span_detail::div)
+
+	SIMD_GEN_SPAN_UNARY(exp, fast_precise_exp)
+	SIMD_GEN_SPAN_UNARY(exp2, fast_precise_exp2)
+	SIMD_GEN_SPAN_UNARY(log, fast_precise_log)
+	SIMD_GEN_SPAN_UNARY(log2, fast_precise_log2)
+	SIMD_GEN_SPAN_UNARY(sqrt, span_detail::sqrt)
+	SIMD_GEN_SPAN_UNARY(sin, fast_precise_sin)
+	SIMD_GEN_SPAN_UNARY(cos, fast_precise_cos)
+	SIMD_GEN_SPAN_UNARY(atan, fast_precise_atan)
+	SIMD_GEN_SPAN_UNARY(sigmoid, sigmoid_precise)
+	SIMD_GEN_SPAN_UNARY(softplus, softplus_precise)
+
+} // namespace simd
+
+#undef SIMD_GEN_SPAN_UNARY
+#undef SIMD_GEN_SPAN_UNARY_PARTIAL
+#undef SIMD_GEN_SPAN_BINARY
+#undef SIMD_GEN_SPAN_BINARY_PARTIAL
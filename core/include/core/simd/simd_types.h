@@ -50,6 +50,7 @@ namespace simd_internal {
 #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
 	template<> struct reg<float, 4> { using type_t = __m128; };
 	template<> struct reg<int, 4> { using type_t = __m128i; };
+	template<> struct reg<unsigned, 4> { using type_t = __m128i; };
 	template<> struct reg<double, 2> { using type_t = __m128d; };
 #endif
 
@@ -85,6 +86,19 @@ namespace simd_internal {
 # endif
 #endif
 
+	// -------- AVX-512: 16 floats / 8 doubles / 16 enteros por registro
+#if defined(__AVX512F__)
+	template<> struct reg<float,    16> { using type_t = __m512;  };
+	template<> struct reg<double,    8> { using type_t = __m512d; };
+	template<> struct reg<int,      16> { using type_t = __m512i; };
+	template<> struct reg<unsigned, 16> { using type_t = __m512i; };
+#elif defined(__GNUC__) || defined(__clang__)
+	template<> struct reg<float,    16> { using type_t = float    __attribute__((__vector_size__(64), __may_alias__)); };
+	template<> struct reg<double,    8> { using type_t = double   __attribute__((__vector_size__(64), __may_alias__)); };
+	template<> struct reg<int,      16> { using type_t = int      __attribute__((__vector_size__(64), __may_alias__)); };
+	template<> struct reg<unsigned, 16> { using type_t = unsigned __attribute__((__vector_size__(64), __may_alias__)); };
+#endif
+
 	// -------- D=3: asegura que exista type_t también para 3 componentes
 	// Usamos un contenedor trivial para D=3 en todas las T.
 	template<typename T>
@@ -111,6 +125,7 @@ struct simd_pack_t<2, T> {
 
 	static constexpr int component_count() { return 2; }
 
+	SIMD_FORCEINLINE simd_pack_t() = default;
 	SIMD_FORCEINLINE explicit constexpr	simd_pack_t(typename simd_internal::reg<T, 2>::type_t value) : m(value) {}
 	SIMD_FORCEINLINE explicit constexpr simd_pack_t(T value) : x(value), y(value) {}
 	SIMD_FORCEINLINE constexpr simd_pack_t(T x_, T y_) : x(x_), y(y_) {}
@@ -132,6 +147,7 @@ struct simd_pack_t<3, T> {
 		typename simd_internal::reg<T, 3>::type_t m; // siempre definido (wrapper trivial)
 	};
 
+	SIMD_FORCEINLINE simd_pack_t() = default;
 	SIMD_FORCEINLINE explicit constexpr simd_pack_t(typename simd_internal::reg<T, 3>::type_t value) : m(value) {}
 	SIMD_FORCEINLINE explicit constexpr simd_pack_t(T value) : x(value), y(value), z(value) {}
 	SIMD_FORCEINLINE constexpr simd_pack_t(T x_, T y_, T z_) : x(x_), y(y_), z(z_) {}
@@ -155,6 +171,7 @@ struct simd_pack_t<4, T> {
 		typename simd_internal::reg<T, 4>::type_t m;
 	};
 
+	SIMD_FORCEINLINE simd_pack_t() = default;
 	SIMD_FORCEINLINE explicit constexpr
 		simd_pack_t(typename simd_internal::reg<T, 4>::type_t value) : m(value) {}
 	SIMD_FORCEINLINE explicit constexpr simd_pack_t(T value) : x(value), y(value), z(value), w(value) {}
@@ -180,6 +197,7 @@ struct simd_pack_t<8, T> {
         typename simd_internal::reg<T, 8>::type_t m;
     };
 
+    SIMD_FORCEINLINE simd_pack_t() = default;
     SIMD_FORCEINLINE explicit constexpr
         simd_pack_t(typename simd_internal::reg<T, 8>::type_t value) : m(value) {}
     SIMD_FORCEINLINE explicit constexpr simd_pack_t(T value) {
@@ -201,6 +219,36 @@ struct simd_pack_t<8, T> {
     SIMD_FORCEINLINE const T& operator[](int index) const { return channel(index); }
 };
 
+// -------- D = 16 (AVX-512)
+template <typename T>
+struct simd_pack_t<16, T> {
+    union {
+        struct { T v[16]; };
+        typename simd_internal::reg<T, 16>::type_t m;
+    };
+
+    SIMD_FORCEINLINE simd_pack_t() = default;
+    SIMD_FORCEINLINE explicit constexpr
+        simd_pack_t(typename simd_internal::reg<T, 16>::type_t value) : m(value) {}
+    SIMD_FORCEINLINE explicit constexpr simd_pack_t(T value) {
+        for (int i = 0; i < 16; ++i) v[i] = value;
+    }
+    SIMD_FORCEINLINE constexpr simd_pack_t(
+        T v0,T v1,T v2,T v3,T v4,T v5,T v6,T v7,T v8,T v9,T v10,T v11,T v12,T v13,T v14,T v15
+    ) : v{v0,v1,v2,v3,v4,v5,v6,v7,v8,v9,v10,v11,v12,v13,v14,v15} {}
+    template <typename T2>
+    SIMD_FORCEINLINE explicit constexpr simd_pack_t(const simd_pack_t<16, T2>& other) {
+        for (int i = 0; i < 16; ++i) v[i] = T(other.v[i]);
+    }
+
+    SIMD_FORCEINLINE static constexpr int component_count() { return 16; }
+    SIMD_FORCEINLINE T&       channel(int index)       { assert(index >= 0 && index < 16); return v[index]; }
+    SIMD_FORCEINLINE const T& channel(int index) const { assert(index >= 0 && index < 16); return v[index]; }
+
+    SIMD_FORCEINLINE T&       operator[](int index)       { return channel(index); }
+    SIMD_FORCEINLINE const T& operator[](int index) const { return channel(index); }
+};
+
 
 
 
@@ -231,8 +279,8 @@ namespace simd {
 	template<> struct _cst_<double> {
 		static constexpr double ln2 = 0.693147180559945309417232121458176568;
 		static constexpr double inv_ln2 = 1.44269504088896340735992468100189214; // log2(e)
-		static constexpr double ln2_hi = 0.6931471805596629; // split (Cody–Waite)
-		static constexpr double ln2_lo = 2.384185791015625e-07;
+		static constexpr double ln2_hi = 6.93147180369123816490e-01; // split (Cody–Waite): k·ln2_hi exacto para |k| < 2^21
+		static constexpr double ln2_lo = 1.90821492927058770002e-10;
 	};
 
 	// splat genérico
@@ -4,6 +4,9 @@
 #include <atomic>
 #include <thread>
 #include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
 
 //
 // --- Hints por arquitectura para espera activa ---
@@ -102,6 +105,158 @@ static_assert(alignof(spinlock_aligned_t) >= CACHELINE, "spinlock_aligned_t debe
 static_assert(sizeof(spinlock_aligned_t) % alignof(spinlock_aligned_t) == 0, "sizeof(spinlock_aligned_t) debe ser múltiplo de su alineación");
 
 
+//
+// --- Cerrojo híbrido: gira y después duerme ---
+// Para secciones que pueden alargarse o con más hebras que núcleos: si el dueño pierde el procesador, girar sólo gasta
+// el turno. Tras un giro corto con cpu_relax() la hebra duerme en el propio estado (futex en Linux, std::atomic::wait
+// en el resto) hasta que unlock() la despierte. Estado: 0 libre, 1 cogido, 2 cogido con posibles hebras dormidas, de
+// modo que unlock() sólo hace la llamada al sistema cuando alguien puede estar esperando.
+void hybrid_lock_slow(std::atomic<uint32_t>& state) noexcept;
+void hybrid_lock_wake(std::atomic<uint32_t>& state) noexcept;
+
+struct hybrid_lock_t
+{
+    std::atomic<uint32_t> state{0};
+
+    inline void lock() noexcept
+    {
+        uint32_t expected = 0;
+        if (!state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            hybrid_lock_slow(state);
+    }
+
+    [[nodiscard]] inline bool try_lock() noexcept
+    {
+        uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    inline void unlock() noexcept
+    {
+        if (state.exchange(0, std::memory_order_release) == 2)
+            hybrid_lock_wake(state);
+    }
+};
+
+
+//
+// --- Cerrojos justos (por orden de llegada) ---
+// spinlock_t no respeta el orden y al soltarlo todas las hebras que esperan van a por la misma línea de caché. Con
+// muchos núcleos peleando por el mismo cerrojo conviene uno de éstos:
+//   ticket_lock_t  dos contadores: cada hebra saca número y espera a que lo llamen, con una espera proporcional a
+//                  los que tiene delante. Todas leen la misma línea, pero sólo escriben al sacar número.
+//   mcs_lock_t     cola de nodos, uno por hebra que espera: cada una gira sobre su propio nodo y al soltar sólo se
+//                  escribe en el del siguiente. Es la opción que escala con 32 o más hebras.
+// Los dos sirven a lock_guard_spin. En mcs_lock_t, lock() sin nodo lo saca de una reserva de la hebra y unlock() lo
+// devuelve, así que hay que soltarlo desde la misma hebra; quien quiera el nodo en su pila usa las versiones con
+// mcs_node_t, en las que unlock() recibe el mismo nodo que lock().
+struct alignas(CACHELINE) ticket_lock_t
+{
+    std::atomic<uint32_t> next{0};
+    alignas(CACHELINE) std::atomic<uint32_t> serving{0};    // en otra línea: quien saca número no molesta a quien espera
+
+    static constexpr uint32_t kBackoffPerWaiter = 32;
+
+    inline void lock() noexcept
+    {
+        const uint32_t ticket = next.fetch_add(1, std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t current = serving.load(std::memory_order_acquire);
+            if (current == ticket)
+                return;
+            for (uint32_t i = (ticket - current) * kBackoffPerWaiter; i; --i)
+                cpu_relax();
+        }
+    }
+
+    [[nodiscard]] inline bool try_lock() noexcept
+    {
+        uint32_t current = serving.load(std::memory_order_acquire);
+        uint32_t expected = current;
+        return next.compare_exchange_strong(expected, current + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    inline void unlock() noexcept
+    {
+        serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+struct alignas(CACHELINE) mcs_node_t
+{
+    std::atomic<mcs_node_t*> next{nullptr};
+    std::atomic<bool> waiting{false};
+};
+
+// Nodos de la reserva de la hebra que llama (16 por hebra; si se acaban se piden al heap)
+mcs_node_t* mcs_node_acquire();
+void mcs_node_release(mcs_node_t* node);
+
+struct alignas(CACHELINE) mcs_lock_t
+{
+    std::atomic<mcs_node_t*> tail{nullptr};
+    mcs_node_t* holder = nullptr;                           // sólo lo toca quien tiene el cerrojo
+
+    inline void lock(mcs_node_t& node) noexcept
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.waiting.store(true, std::memory_order_relaxed);
+        mcs_node_t* prev = tail.exchange(&node, std::memory_order_acq_rel);
+        if (!prev)
+            return;
+        prev->next.store(&node, std::memory_order_release);
+        while (node.waiting.load(std::memory_order_acquire))
+            cpu_relax();
+    }
+
+    [[nodiscard]] inline bool try_lock(mcs_node_t& node) noexcept
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        mcs_node_t* expected = nullptr;
+        return tail.compare_exchange_strong(expected, &node, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    inline void unlock(mcs_node_t& node) noexcept
+    {
+        mcs_node_t* next = node.next.load(std::memory_order_acquire);
+        if (!next) {
+            mcs_node_t* expected = &node;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+                return;
+            // Alguien ya se ha puesto en la cola pero aún no se ha enlazado
+            while (!(next = node.next.load(std::memory_order_acquire)))
+                cpu_relax();
+        }
+        next->waiting.store(false, std::memory_order_release);
+    }
+
+    inline void lock() noexcept
+    {
+        mcs_node_t* node = mcs_node_acquire();
+        lock(*node);
+        holder = node;
+    }
+
+    [[nodiscard]] inline bool try_lock() noexcept
+    {
+        mcs_node_t* node = mcs_node_acquire();
+        if (!try_lock(*node)) {
+            mcs_node_release(node);
+            return false;
+        }
+        holder = node;
+        return true;
+    }
+
+    inline void unlock() noexcept
+    {
+        mcs_node_t* node = holder;
+        unlock(*node);
+        mcs_node_release(node);
+    }
+};
+
+
 template<class Spinlock>
 struct lock_guard_spin {
     explicit lock_guard_spin(Spinlock& s) : s_(s) { s_.lock(); }
@@ -115,10 +270,144 @@ private:
 
 
 
+//
+// --- Secciones críticas ---
+// Cerrojo recursivo (la misma hebra puede volver a entrar) con contadores de entradas y de entradas que tuvieron que
+// esperar. Todos los miembros tienen constructor constexpr (el dueño es un entero y no un std::thread::id, que no lo
+// tiene), así que las secciones globales son constinit y están listas antes de ejecutar nada.
+
+// Distinto de 0 y propio de cada hebra viva; el mismo desde cualquier módulo del proceso
+uintptr_t critical_section_thread_token();
+
+struct alignas(CACHELINE) critical_section_t
+{
+    std::mutex                      mutex;
+    std::atomic<uintptr_t>          owner{0};   // critical_section_thread_token() de quien la tiene; 0 = libre
+    uint32_t                        depth = 0;
+    std::atomic<uint64_t>           enter_count{0};
+    std::atomic<uint64_t>           contended_count{0};
+
+    inline void lock()
+    {
+        const uintptr_t self = critical_section_thread_token();
+        if (owner.load(std::memory_order_relaxed) == self) { ++depth; return; }
+        enter_count.fetch_add(1, std::memory_order_relaxed);
+        if (!mutex.try_lock()) {
+            contended_count.fetch_add(1, std::memory_order_relaxed);
+            mutex.lock();
+        }
+        owner.store(self, std::memory_order_relaxed);
+        depth = 1;
+    }
+
+    [[nodiscard]] inline bool try_lock()
+    {
+        const uintptr_t self = critical_section_thread_token();
+        if (owner.load(std::memory_order_relaxed) == self) { ++depth; return true; }
+        if (!mutex.try_lock())
+            return false;
+        enter_count.fetch_add(1, std::memory_order_relaxed);
+        owner.store(self, std::memory_order_relaxed);
+        depth = 1;
+        return true;
+    }
+
+    inline void unlock()
+    {
+        if (--depth == 0) {
+            owner.store(0, std::memory_order_relaxed);
+            mutex.unlock();
+        }
+    }
+};
+
+struct critical_section_stats_t
+{
+    uint64_t    enter_count;
+    uint64_t    contended_count;
+    uint64_t    busiest_contended_count;    // de la sección con más esperas
+};
+
+// Secciones repartidas por clave entre critical_section_count() secciones: por dirección de un objeto o por nombre (se
+// hashea el texto, así que el mismo nombre da la misma sección en todo el proceso). Dos claves pueden caer en la misma
+// sección; dentro de una sección no se debe entrar en la de otra clave salvo en un orden fijo.
+critical_section_t& critical_section(const void* key);
+critical_section_t& critical_section(const char* name);
+size_t critical_section_count();
+void critical_section_stats(critical_section_stats_t& stats);
+
+// Compatibilidad: una sola sección global para todo el proceso. El código nuevo usa critical_section().
 void enter_to_critical_section();
 void exit_from_critical_section();
 
+//
+// --- Cerrojos por dirección ---
+// memory_lock(p) protege el objeto de p con una franja de una tabla de spinlock_aligned_t, una por línea de caché. La
+// franja sale del finalizador de murmur3 de la dirección, así que los objetos alineados se reparten por toda la tabla.
+// Dos objetos pueden compartir franja: una hebra no debe tener más de un memory_lock() a la vez. memory_lock() sin
+// argumento es un cerrojo aparte para todo el proceso.
+// Antes del primer memory_lock(); se redondea a potencia de dos, 0 = cuatro por hebra del sistema (256 si no se llama).
+// Devuelve false si la tabla ya está en uso.
+bool memory_lock_configure(size_t stripe_count);
+size_t memory_lock_stripe_count();
+
 void memory_lock(const void*);
 void memory_unlock(const void*);
 void memory_lock();
 void memory_unlock();
+
+// Cede el procesador a otra hebra
+void thread_yield();
+
+
+//
+// --- Sistema de tareas ---
+// Un solo pool de hebras con robo de trabajo para todo el proceso. Cada hebra del pool tiene una cola Chase-Lev (push y
+// pop del propietario por abajo sin cerrojos, robo por arriba con un CAS) y las hebras de fuera dejan sus tareas en una
+// cola común. Una hebra sin trabajo saca de su cola, después de la común y después roba a otra al azar; tras un rato
+// girando con cpu_relax() duerme hasta que llegue trabajo. job_wait() no duerme: ejecuta tareas mientras espera, así
+// que se puede esperar desde dentro de una tarea.
+// Por defecto hay una hebra por núcleo físico de los que el proceso puede usar (afinidad y topología del sistema),
+// contando la que llama a job_wait() o parallel_for().
+struct job_t;
+using job_function_t = void (*)(const job_t& job);
+
+// Tareas pendientes de un grupo; las hijas que lanza una tarea con el mismo contador cuentan para quien lo espera
+struct job_counter_t
+{
+    std::atomic<size_t> pending{0};
+};
+
+struct job_t
+{
+    job_function_t  function;
+    void*           data;
+    size_t          begin;
+    size_t          end;
+    job_counter_t*  counter;
+};
+
+// Antes de la primera tarea; 0 = según la topología. Devuelve false si el pool ya está en marcha.
+bool job_system_configure(size_t thread_count);
+
+// Encola la tarea (en la cola propia si se llama desde el pool). Si la cola está llena se ejecuta en el momento.
+void job_run(job_function_t function, void* data, size_t begin, size_t end, job_counter_t& counter);
+
+// Ejecuta tareas hasta que counter llega a 0
+void job_wait(job_counter_t& counter);
+
+// Índice de la hebra del pool que llama (0 .. parallel_thread_count() - 2) o -1 fuera del pool
+int job_worker_index();
+
+//
+// --- Paralelismo de datos ---
+// Reparte [0, count) en rangos contiguos de al menos `grain` elementos y llama a body(begin, end) desde varias hebras
+// (la llamante incluida) del sistema de tareas. Vuelve cuando han terminado todos los rangos. Con count <= grain, o
+// con una sola hebra, llama a body(0, count) directamente.
+// El rango se parte en mitades como tareas: cada tarea ofrece su mitad alta a las demás hebras mientras el trozo
+// supere max(grain, count / (8 * hebras)), de modo que los rangos se ajustan al número de hebras y el robo equilibra
+// las partes lentas.
+using parallel_body_t = std::function<void(size_t begin, size_t end)>;
+
+size_t parallel_thread_count();
+void parallel_for(size_t count, size_t grain, const parallel_body_t& body);
@@ -504,7 +504,7 @@ struct vexel_format_t {
          return vexel_format_t(
             vexel_format_t(vexel_space_t::RGB, vexel_order_t::RGBA, vexel_interpolation_t::LINEAR).code
             |
-            vexel_format_t(media_format_t::VEXEL_RESOURCE, vexel_resource_t(dimension), has_lods, vexel_struct_t::ONE).code
+            vexel_format_t(media_format_t::VEXEL_RESOURCE, vexel_resource_t(dimension), has_lods, vexel_struct_t::SINGLE).code
             |
             format.code
          );
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <core/vexel.h>
+#include <core/vexel_convert.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Formatos comprimidos por bloques
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Decodificación de BLOCK_BC1..BLOCK_BC7 según la especificación de D3D11 y de BLOCK_ETC2 (RGB) y BLOCK_ASTC_* (2D)
+según la de Khronos:
+	BC1, BC2, BC3, BC7	-> VEC4 UN8 RGBA (BC1 con índice 3 en modo de tres colores da negro transparente;
+						   BC2 y BC3 usan siempre la paleta de cuatro colores)
+	BC4, BC5			-> VEC1 / VEC2 UN8, o SN8 si el formato tiene is_signed
+	BC6H				-> VEC4 F16 RGBA con alfa 1 (UF16, o SF16 si el formato tiene is_signed)
+	ETC2				-> VEC4 UN8 RGBA con alfa 255 (modos individual, diferencial, T, H y plano)
+	ASTC				-> perfil LDR: VEC4 UN8 RGBA con los 8 bits altos del resultado (con el redondeo de sRGB si el
+						   espacio es SRGB); perfil HDR si el formato es FLOAT: VEC4 F16 RGBA. Los bloques no válidos,
+						   y los de extremos HDR en el perfil LDR, dan magenta.
+El formato decodificado conserva el espacio del comprimido, de modo que un destino en otro espacio recibe además la
+conversión de color de vexel_converter() (vexel_color.h). Los bloques reservados de BC6H y BC7 decodifican a 0.
+
+Las imágenes guardan los bloques fila a fila; row_byte_count[0] de la superficie comprimida son los bytes por fila de
+bloques (0 = contiguas). Los bordes que no llenan un bloque se recortan al escribir.
+
+Las búsquedas en las paletas de BC1-BC5 van por AVX2 o NEON (tbl) cuando el procesador los tiene; BC6H y BC7 leen
+los campos con desplazamientos sobre 128 bits. ASTC guarda por huella los modos de bloque, las tablas de infill de
+los pesos y las de partición, e interpola con AVX2 (gather y permutación) o NEON; fetch_block_vexel evalúa sólo el
+vexel pedido. Las imágenes y cadenas de LODs se reparten entre hebras por filas de
+bloques con parallel_for.
+*/
+
+struct vexel_block_info_t
+{
+	uint8_t width;			// vexels por bloque
+	uint8_t height;
+	uint8_t byte_count;		// bytes por bloque
+};
+
+// false si el layout no es de bloques comprimidos. BLOCK_ETC2 es ETC2 RGB (8 bytes).
+bool			vexel_block_info(vexel_layout_t layout, vexel_block_info_t& info);
+
+// Formato al que decodifica decode_block(); código 0 si el formato no se puede decodificar
+vexel_format_t	vexel_block_decoded_format(vexel_format_t format);
+
+// Acceso aleatorio: un bloque a width x height vexels de vexel_block_decoded_format(), separados row_byte_count
+bool			decode_block(vexel_format_t format, const void* block, void* dst, size_t row_byte_count);
+
+// Imagen 2D a cualquier formato que admita vexel_converter(); false si los tamaños no coinciden
+bool			decode_blocks(const vexel_surface_t& src, const vexel_surface_t& dst);
+
+// Todos los niveles, caras y elementos de layout (orden DDS/KTX: elemento -> cara -> LOD -> corte) a dst contiguo en
+// dst_format, con el mismo orden. false si layout.byte_count no es 0 y no alcanza para la cadena.
+bool			decode_block_lods(vexel_format_t format, const buffer_layout_t& layout, const void* src,
+								  vexel_format_t dst_format, void* dst);
+
+// Un vexel en RGBA float, sin cambiar de espacio; decodifica sólo su bloque
+bool			fetch_block_vexel(const vexel_surface_t& src, uint32_t x, uint32_t y, float rgba[4]);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Codificación
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Codificación a BC1, BC3, BC4, BC5, BC7 y ETC2. La entrada de cada bloque es el formato decodificado del comprimido
+(vexel_block_decoded_format), así que decodificar y volver a codificar no cambia de espacio ni de tipo:
+	BC1		RGB por eje principal + mínimos cuadrados; con algún alfa < 128 usa el modo de tres colores y negro transparente
+	BC3		color de BC1 con cuatro colores + alfa como BC4
+	BC4/BC5	extremos de cada canal, con y sin los valores fijos 0/255 (-127/127 con signo)
+	BC7		modo 6 (RGBA, un subconjunto); los bloques opacos prueban además el modo 1 (RGB, dos subconjuntos) en las
+			particiones con menor residuo
+	ETC2	modos individual y diferencial de ETC1, con los dos flips y las ocho tablas (válidos también para ETC1)
+
+El error de cada candidato se mide sobre la paleta exacta del decodificador con registros de 4 floats (SSE2 o NEON).
+encode_blocks reparte los bloques de toda la imagen entre hebras con parallel_for; los bordes que no llenan un bloque
+repiten la última fila y columna.
+*/
+
+enum class block_quality_t : uint8_t
+{
+	FAST,		// un ajuste por bloque
+	NORMAL,		// refinado por mínimos cuadrados; BC4/BC5 y ETC2 prueban todos los modos
+	HIGH,		// además búsqueda local de los extremos cuantizados y más particiones de BC7
+};
+
+struct block_encode_params_t
+{
+	block_quality_t	quality = block_quality_t::NORMAL;
+};
+
+// Formato comprimido para datos en src_format: conserva el espacio de color y, en BC4/BC5, is_signed. Código 0 si el
+// layout no se puede codificar.
+vexel_format_t	vexel_block_encoded_format(vexel_layout_t layout, vexel_format_t src_format);
+
+// Un bloque desde width x height vexels de vexel_block_decoded_format(format), separados row_byte_count
+bool			encode_block(vexel_format_t format, const void* src, size_t row_byte_count, void* block,
+							 const block_encode_params_t& params = {});
+
+// Imagen 2D desde cualquier formato que admita vexel_converter() a dst.format; false si los tamaños no coinciden
+bool			encode_blocks(const vexel_surface_t& src, const vexel_surface_t& dst, const block_encode_params_t& params = {});
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <core/vexel.h>
+
+#include <cstddef>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Funciones de transferencia y gamuts de vexel_space_t
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Cada espacio RGB gestionado se descompone en una función de transferencia y unas primarias:
+
+	espacio			transferencia				primarias (blanco)
+	RGB				lineal						BT.709 (D65)
+	SRGB			sRGB						BT.709 (D65)
+	EXTENDED_SRGB	sRGB simétrica en negativos	BT.709 (D65)
+	ADOBE_RGB		potencia 563/256			Adobe RGB 1998 (D65)
+	BT709			OETF BT.709					BT.709 (D65)
+	BT2020			OETF BT.709 (BT.2020 10 bits)	BT.2020 (D65)
+	HDR10_ST2084	PQ (SMPTE ST 2084)			BT.2020 (D65)
+	HDR10_HLG		HLG (BT.2100, luz de escena)	BT.2020 (D65)
+	DISPLAY_P3		sRGB						P3 (D65)
+	DCI_P3			potencia 2.6				P3 (blanco DCI, adaptado con Bradford)
+
+El resto (EUCLIDEAN, YUV, HSL, CMYK, HDR_EBGR, DOLBYVISION, PASS_THROUGH, DISPLAY_NATIVE_AMD) no se gestiona: la
+conversión entre formatos sólo cambia la representación.
+
+Unidades lineales: 1.0 es el blanco de referencia en todos los espacios. En PQ equivale a 203 cd/m² (BT.2408), así
+que el pico de 10000 cd/m² decodifica a 49.26; en HLG la señal 0.75 decodifica a 1.0.
+
+Las curvas en float usan fast_log2/fast_exp2 sobre registros completos (error relativo ~2e-5, suficiente para
+destinos de hasta 16 bits). Las entradas negativas se llevan a 0 salvo en EXTENDED_SRGB y en las partes lineales.
+*/
+
+enum class vexel_transfer_t : uint8_t
+{
+	LINEAR,
+	SRGB,
+	EXTENDED_SRGB,
+	BT709,
+	GAMMA_ADOBE,
+	GAMMA_26,
+	PQ,
+	HLG,
+};
+
+enum class vexel_gamut_t : uint8_t
+{
+	NONE,		// espacio no gestionado
+	BT709,
+	ADOBE_RGB,
+	DISPLAY_P3,
+	DCI_P3,
+	BT2020,
+};
+
+vexel_transfer_t	vexel_transfer(vexel_space_t space);
+vexel_gamut_t		vexel_gamut(vexel_space_t space);
+
+// Valores codificados -> lineales y lineales -> codificados. src y dst pueden ser el mismo buffer.
+void				vexel_transfer_decode(vexel_transfer_t transfer, const float* src, float* dst, size_t n);
+void				vexel_transfer_encode(vexel_transfer_t transfer, const float* src, float* dst, size_t n);
+
+// Matriz 3x3 por filas de RGB lineal de src a RGB lineal de dst; false si alguno de los dos no está gestionado
+bool				vexel_gamut_matrix(vexel_gamut_t src, vexel_gamut_t dst, float m[9]);
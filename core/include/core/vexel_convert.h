@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core/vexel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <apu/buffer.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Conversión de formatos de vexel
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Formatos soportados (campos estructurales de vexel_format_t + order):
+- VECTOR_1..4 con UNIFORM_8/16/32 INTEGER (unorm, snorm, uint, sint) y UNIFORM_16/32/64 FLOAT (half, float, double).
+- Empaquetados INTEGER (unorm, snorm, uint, sint): PACK_4_4, PACK_4_4_4_4, PACK_5_6_5, PACK_1_5_5_5, PACK_5_5_5_1,
+  PACK_2_10_10_10. El layout debe coincidir con el número de campos.
+- Empaquetados FLOAT: PACK_10_11_11 (r11g11b10 sin signo) y PACK_5_9_9_9 (rgb9e5 con exponente compartido).
+
+Convenios:
+- order indica qué canal ocupa cada componente en memoria (BGRA: b, g, r, a). Con menos de 4 canales se toma el
+  orden sin los canales ausentes (VECTOR_3 BGRA = b, g, r; ARGB = r, g, b).
+- Los empaquetados nombran los campos de MSB a LSB y el primer canal del orden va en los bits bajos:
+  PACK_5_6_5 RGBA = r[4:0] g[10:5] b[15:11]; PACK_2_10_10_10 RGBA = r[9:0] ... a[31:30] (DXGI R10G10B10A2).
+- Canales que el origen no tiene: 0 para color y 1 (máximo en unorm) para alfa.
+- float -> entero redondea al más cercano y satura; NaN -> 0. r11g11b10 satura los finitos al máximo representable.
+- Si los espacios de origen y destino son distintos y ambos gestionados (vexel_color.h), se decodifica la
+  transferencia del origen, se pasa de gamut y se codifica con la del destino; alfa no se toca. Formatos UINT/SINT
+  y espacios no gestionados sólo cambian de representación.
+
+El conversor de cada par (origen, destino) se resuelve una sola vez y se cachea por los dos códigos de 64 bits, de
+modo que el bucle por vexel no evalúa el formato. Los buffers deben estar alineados al tamaño del elemento.
+*/
+
+struct vexel_converter_t;
+
+// Bytes por vexel; 0 si el formato no es convertible (bloques comprimidos, YUV, matrices, FIXED...)
+uint32_t					vexel_byte_count(vexel_format_t format);
+
+// Conversor cacheado para el par; nullptr si alguno de los dos formatos no está soportado. Válido hasta el final
+// del proceso y utilizable desde varios hilos a la vez.
+const vexel_converter_t*	vexel_converter(vexel_format_t src_format, vexel_format_t dst_format);
+
+// Convierte count vexels con un conversor ya resuelto. src y dst no pueden solaparse.
+void						convert(const vexel_converter_t& converter, const void* src, void* dst, size_t count);
+
+// Convierte min(src / tamaño origen, dst / tamaño destino) vexels y devuelve cuántos; 0 si el par no está soportado.
+size_t						convert(vexel_format_t src_format, vexel_format_t dst_format,
+									std::span<const std::byte> src, std::span<std::byte> dst);
+
+// Superficie 2D de host: tamaño de layout.object_size (width x height); el resto del layout no se usa. Los formatos
+// de varios planos (YUV) usan planes[1] y planes[2]; row_byte_count = 0 indica filas contiguas.
+struct vexel_surface_t
+{
+	vexel_format_t		format;
+	buffer_layout_t		layout;
+	void*				planes[3];
+	uint64_t			row_byte_count[3];
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <core/vexel.h>
+#include <core/vexel_convert.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Generación de LODs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Cadena de LODs de un buffer_layout_t a partir del nivel 0. Cada nivel mide max(1, n >> 1) en cada eje (también con
+tamaños que no son potencia de dos) y se filtra en float desde el anterior sin cuantizar, de forma separable en x, y
+y, en LAYOUT_3D, z:
+	BOX		media ponderada por el área que cubre cada vexel de origen (2x2 exacto en tamaños pares)
+	KAISER	sinc con ventana de Kaiser de radio 3 (kaiser_alpha controla la caída)
+	LANCZOS	Lanczos-3
+Los bordes repiten el último vexel; las caras de CUBE se filtran por separado.
+
+Los espacios gestionados (vexel_color.h) se filtran en RGB lineal, así que sRGB y el resto de transferencias no
+oscurecen los niveles; alfa se filtra tal cual. Los formatos no gestionados sólo cambian de representación. El resultado
+se devuelve al formato de origen con vexel_converter() (saturando en los enteros).
+
+Memoria: orden DDS/KTX (elemento -> cara -> LOD -> corte). lods[l] da los pasos del nivel l: row_byte_count entre filas,
+surface_byte_count entre cortes y volume_byte_count del nivel entero; el nivel l empieza tras los volume_byte_count de
+los anteriores y cada cara o elemento tras object_byte_count (el de lods[0]). vexel_lod_padding() rellena la tabla
+para filas alineadas.
+
+Los niveles dependen del anterior, así que se generan en orden; dentro de cada uno las filas de todas las caras,
+elementos y cortes se reparten entre hebras con parallel_for y los filtros van por AVX2 o NEON.
+*/
+
+enum class mip_filter_t : uint8_t
+{
+	BOX,
+	KAISER,
+	LANCZOS,
+};
+
+struct mip_params_t
+{
+	mip_filter_t	filter = mip_filter_t::BOX;
+	float			kaiser_alpha = 4.0f;
+};
+
+// Pasos de los layout.lod_count niveles con filas (o filas de tiles si layout.tiling no es LINEAR, vexel_tiling.h)
+// alineadas a row_alignment bytes (0 o 1 = sin relleno). Devuelve los bytes de todo el layout (todas las caras y
+// elementos); 0 si el tiling no admite vexel_byte_count.
+uint64_t	vexel_lod_padding(const buffer_layout_t& layout, uint32_t vexel_byte_count, uint32_t row_alignment,
+							  buffer_object_padding_t* lods);
+
+// Rellena los niveles 1..lod_count-1 de data desde el nivel 0. false si el formato no admite vexel_converter(), el
+// layout está en tiles, algún paso no alcanza para su nivel o, con layout.byte_count distinto de 0, la cadena no cabe.
+bool		generate_lods(vexel_format_t format, const buffer_layout_t& layout, const buffer_object_padding_t* lods,
+						  void* data, const mip_params_t& params = {});
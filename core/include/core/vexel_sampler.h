@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <core/vexel.h>
+#include <core/vexel_convert.h>
+#include <simd/simd_types.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Muestreo de texturas en CPU
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Muestreador de software para buffer_sampler_t (render de respaldo en CPU y horneado de texturas). La textura se prepara
+una vez a RGBA float (RGB lineal si el espacio está gestionado, de modo que sRGB se filtra en lineal como en la GPU)
+con todos sus niveles, caras y elementos; los bloques comprimidos pasan por decode_block_lods().
+
+Cada llamada muestrea 8 coordenadas normalizadas (u, v, w en [0, 1) cubren la textura) con un LOD explícito por
+lane, sin derivadas:
+	- LOD <= 0 usa mag_filter y LOD > 0 min_filter (NONE equivale a NEAREST). NEAREST toma el vexel que contiene la
+	  coordenada y LINEAR interpola los 2, 4 u 8 vecinos desde los centros de los vexels.
+	- mip_filter NONE usa el nivel 0, NEAREST el nivel más cercano y LINEAR mezcla los dos niveles que rodean el LOD
+	  (trilineal en 2D). El LOD se satura a los niveles que tiene la textura.
+	- Modos de borde por eje: REPEAT, MIRRORED_REPEAT (espejo con periodo 2n), MIRROR (espejo una vez y luego el
+	  borde, como MIRROR_CLAMP_TO_EDGE), CLAMP_TO_EDGE y CLAMP_TO_BORDER, que mezcla border (negro transparente por
+	  defecto) con el peso de los vecinos que caen fuera.
+LAYOUT_1D usa sólo u, LAYOUT_2D y CUBE u y v, y LAYOUT_3D las tres. layer elige elemento y cara (elemento * 6 + cara
+en CUBE); la selección de cara por dirección queda para quien llama.
+
+Los vecinos se leen con gather sobre los canales intercalados: simd::gather<8> de simd_memory_ops.h (la instrucción
+gather cuando el binario se compila con AVX2) y, en binarios base con CPU AVX2, _mm256_i32gather_ps con el cálculo de
+coordenadas y bordes también en registros de 8 lanes.
+*/
+
+struct sampler_texture_t
+{
+	buffer_object_layout_t	object_layout = buffer_object_layout_t::NONE;
+	vexel_space_t			space = vexel_space_t::RGB;	// de los texels y de lo que devuelve el muestreo
+	uint32_t				layer_count = 0;			// elementos x caras
+	uint32_t				lod_count = 0;
+	std::vector<int32_t>	sizes;						// por nivel: anchura, altura, profundidad, 0
+	std::vector<int32_t>	offsets;					// en floats, por capa y nivel (capa * lod_count + nivel)
+	std::vector<float>		texels;						// RGBA
+};
+
+// Resultado de 8 lanes por canal
+struct sampler_rgba_t
+{
+	simd_pack_t<8, float>	r, g, b, a;
+};
+
+// lods con los pasos de cada nivel como en generate_lods() (vexel_mip.h); nullptr = niveles contiguos. Los formatos
+// por bloques se leen siempre contiguos. false si el formato no se puede leer, el layout está en tiles (se pasa antes a
+// LINEAR con copy_surface_tiling(), vexel_tiling.h) o la textura pasa de 2^31 floats.
+bool	make_sampler_texture(vexel_format_t format, const buffer_layout_t& layout, const buffer_object_padding_t* lods,
+							 const void* data, sampler_texture_t& texture);
+
+// 8 coordenadas; v, w y lod se ignoran si la textura no tiene ese eje. border = RGBA de CLAMP_TO_BORDER (nullptr = 0).
+// false si la textura está vacía o layer no existe.
+bool	sample_texture(const sampler_texture_t& texture, const buffer_sampler_t& sampler, uint32_t layer,
+					   const simd_pack_t<8, float>& u, const simd_pack_t<8, float>& v, const simd_pack_t<8, float>& w,
+					   const simd_pack_t<8, float>& lod, sampler_rgba_t& out, const float* border = nullptr);
+
+// count coordenadas a rgba intercalado (4 floats por coordenada). v, w y lod pueden ser nullptr (0). Los lotes se
+// reparten entre hebras con parallel_for.
+bool	sample_texture(const sampler_texture_t& texture, const buffer_sampler_t& sampler, uint32_t layer, size_t count,
+					   const float* u, const float* v, const float* w, const float* lod, float* rgba,
+					   const float* border = nullptr);
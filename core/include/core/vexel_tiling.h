@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <core/vexel.h>
+#include <core/vexel_convert.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Superficies en tiles (orden Z)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+buffer_layout_t::tiling elige cómo se guardan los vexels de cada superficie (apu/buffer.h):
+	LINEAR			filas de row_byte_count bytes
+	MORTON_4X4		tiles de 4x4 vexels (64 bytes con vexels de 4 bytes: una línea de caché)
+	MORTON_64X64	tiles de 64 bytes x 64 filas (4 KiB, una página): 16x64 vexels de 4 bytes, 8x64 de 8...
+Los tiles van fila a fila, row_byte_count bytes entre filas de tiles, y dentro de cada tile los vexels siguen el orden
+Z con x en el bit bajo; en los tiles no cuadrados, cuando se acaban los bits del eje corto el resto son del largo. Los
+vecinos de un filtro bilineal o de una pasada por columnas caen así en la misma línea o página. Las superficies que
+no llenan el último tile se rellenan con ceros al copiar. vexel_lod_padding() (vexel_mip.h) calcula los pasos de una
+cadena en tiles; generate_lods() y make_sampler_texture() trabajan sobre superficies LINEAR.
+
+copy_surface_tiling() recorre cada tile en el orden de memoria y obtiene (x, y) con pext cuando la CPU tiene BMI2;
+si no, recorre las filas del tile y avanza el índice Z con un incremento enmascarado. Las copias de cada vexel son de
+tamaño fijo (1 a 16 bytes) y las filas de tiles se reparten entre hebras con parallel_for.
+*/
+
+struct vexel_tile_info_t
+{
+	uint32_t	width;			// vexels
+	uint32_t	height;
+	uint32_t	byte_count;
+	uint32_t	x_mask;			// bits del índice Z del vexel dentro del tile que forman x y los que forman y
+	uint32_t	y_mask;
+};
+
+// false si la combinación no existe (MORTON_64X64 con vexels que no son potencia de dos o de más de 64 bytes). LINEAR
+// da un tile de 1x1.
+bool		vexel_tile_info(buffer_tiling_t tiling, uint32_t vexel_byte_count, vexel_tile_info_t& info);
+
+// Bytes desde el inicio de la superficie hasta el vexel (x, y); row_byte_count entre filas de tiles
+uint64_t	tiled_vexel_offset(const vexel_tile_info_t& info, uint32_t vexel_byte_count, uint64_t row_byte_count,
+							   uint64_t x, uint32_t y);
+
+// Copia una superficie 2D entre dos tilings (layout.tiling de cada una; iguales también vale). Los formatos deben
+// tener el mismo vexel_byte_count(); row_byte_count[0] = 0 indica filas (o filas de tiles) contiguas. false si los
+// tamaños o los formatos no coinciden.
+bool		copy_surface_tiling(const vexel_surface_t& src, const vexel_surface_t& dst);
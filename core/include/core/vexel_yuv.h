@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <core/vexel.h>
+#include <core/vexel_convert.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Conversión YUV <-> RGB
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+Superficies YUV (layout BLOCK_YUV_*, bit_count UNIFORM_8 o UNIFORM_16 con las muestras alineadas al MSB, como P010):
+	Y_U_V		planes[0] = Y, planes[1] = U, planes[2] = V			(I420, I422, I444)
+	Y_UV		planes[0] = Y, planes[1] = U V entrelazados			(NV12, NV16, NV24)
+	YUYV/UYVY	planes[0] = Y0 U Y1 V / U Y0 V Y1 por pareja de vexels	(YUY2, UYVY)
+Con order BGRA se intercambian U y V (YV12, NV21, YVYU...). La croma 4:2:x está cosituada a la izquierda y, en 4:2:0,
+centrada entre las dos filas de luma (MPEG-2 / H.264). Los tamaños impares redondean la croma hacia arriba.
+
+El lado RGB es cualquier formato que admita vexel_converter() (planes[0]); se pasa por RGBA float en el espacio de la
+matriz (BT709 para BT.601 y BT.709, BT2020 para BT.2020), así que un destino en otro espacio gestionado recibe además
+la conversión de transferencia y gamut (vexel_color.h).
+
+row_byte_count = 0 indica filas contiguas. Las filas se reparten entre hebras con parallel_for y la aritmética va
+por simd::kernels().
+*/
+
+enum class yuv_matrix_t : uint8_t
+{
+	BT601,
+	BT709,
+	BT2020,
+};
+
+enum class yuv_range_t : uint8_t
+{
+	LIMITED,	// 16-235 / 16-240 (x256 en 16 bits)
+	FULL,
+};
+
+enum class yuv_chroma_filter_t : uint8_t
+{
+	NEAREST,
+	LINEAR,		// lectura: interpolación bilineal según el sitio de la croma; escritura: [1 2 1]/4 y media vertical
+};
+
+struct yuv_params_t
+{
+	yuv_matrix_t		matrix = yuv_matrix_t::BT709;
+	yuv_range_t			range = yuv_range_t::LIMITED;
+	yuv_chroma_filter_t	chroma_filter = yuv_chroma_filter_t::LINEAR;
+};
+
+bool	is_yuv_layout(vexel_layout_t layout);
+
+// false si algún formato no está soportado o los tamaños no coinciden
+bool	yuv_to_rgb(const vexel_surface_t& src, const vexel_surface_t& dst, const yuv_params_t& params = {});
+bool	rgb_to_yuv(const vexel_surface_t& src, const vexel_surface_t& dst, const yuv_params_t& params = {});
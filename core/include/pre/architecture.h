@@ -31,6 +31,10 @@
 #define CPU_AVX2_BIT	(1 << 24)
 #define CPU_AVX512_BIT	(1 << 25)
 #define CPU_NEON_BIT	(1 << 26)
+#define CPU_FMA_BIT		(1 << 27)
+#define CPU_F16C_BIT	(1 << 28)
+#define CPU_BMI2_BIT	(1 << 29)
+#define CPU_SVE_BIT		(1 << 30)
 
 
 
@@ -85,6 +89,7 @@
 #define CPU_AVX2		(CPU_AVX2_BIT | CPU_AVX)
 #define CPU_AVX512		(CPU_AVX512_BIT | CPU_AVX2)
 #define CPU_NEON		(CPU_NEON_BIT)
+#define CPU_SVE			(CPU_SVE_BIT | CPU_NEON)
 #define CPU_PURE		()
 #if defined(__AVX512BW__) && defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
 #	define CPU_EXTENSIONS_BIT (CPU_AVX512)
@@ -116,6 +121,8 @@
 #	define CPU_EXTENSIONS_BIT (CPU_PPC)
 #elif defined(__i386__) || defined(__x86_64__)
 #	define CPU_EXTENSIONS_BIT (CPU_X86)
+#elif defined(__ARM_FEATURE_SVE)
+#	define CPU_EXTENSIONS_BIT (CPU_SVE)
 #elif defined(__ARM_NEON)
 #	define CPU_EXTENSIONS_BIT (CPU_NEON)
 #elif defined(__MMX__)
@@ -153,6 +160,8 @@
 #		pragma message("GLM: SSE3 instruction set")
 #	elif(CPU_EXTENSIONS_BIT == CPU_SSE2)
 #		pragma message("GLM: SSE2 instruction set")
+#	elif(CPU_EXTENSIONS_BIT == CPU_SVE)
+#		pragma message("GLM: SVE instruction set")
 #	elif(CPU_EXTENSIONS_BIT == CPU_NEON)
 #		pragma message("GLM: NEON instruction set")
 #	endif//CPU_EXTENSIONS_BIT
@@ -0,0 +1,139 @@
+#ifndef PRE_CPU_FEATURES_H
+#define PRE_CPU_FEATURES_H
+
+#include <pre.h>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Runtime cpu extensions detection
+//
+// pre/architecture.h sólo sabe lo que el compilador ha habilitado (CPU_EXTENSIONS_BIT). Aquí se consulta la CPU real
+// (cpuid + xgetbv en x86, auxv en ARM) y se devuelve la misma máscara de bits CPU_*_BIT, para que el código pueda
+// elegir en tiempo de ejecución implementaciones compiladas para ISAs superiores a la del binario base.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__i386__) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_X64)
+#	define CPU_RUNTIME_X86 1
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#elif (defined(__aarch64__) || defined(__arm__)) && defined(__linux__)
+#	define CPU_RUNTIME_ARM_LINUX 1
+#	include <sys/auxv.h>
+#endif
+
+
+namespace cpu_internal {
+
+#if defined(CPU_RUNTIME_X86)
+	inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t r[4]) noexcept
+	{
+#	if defined(_MSC_VER)
+		int regs[4];
+		__cpuidex(regs, (int)leaf, (int)subleaf);
+		for (int i = 0; i < 4; ++i) r[i] = (uint32_t)regs[i];
+#	else
+		__cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+#	endif
+	}
+
+	// Estado de registros que el SO guarda en cambios de contexto (XCR0)
+	inline uint64_t xgetbv0() noexcept
+	{
+#	if defined(_MSC_VER)
+		return _xgetbv(0);
+#	else
+		uint32_t lo, hi;
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		return ((uint64_t)hi << 32) | lo;
+#	endif
+	}
+#endif
+
+	inline uint32_t detect_extensions() noexcept
+	{
+		uint32_t bits = 0;
+
+#if defined(CPU_RUNTIME_X86)
+		uint32_t r[4];
+		cpuid(0, 0, r);
+		const uint32_t max_leaf = r[0];
+		if (max_leaf < 1)
+			return bits;
+
+		cpuid(1, 0, r);
+		const uint32_t ecx1 = r[2], edx1 = r[3];
+		if (edx1 & (1u << 23)) bits |= CPU_MMX_BIT;
+		if (edx1 & (1u << 25)) bits |= CPU_SSE1_BIT;
+		if (edx1 & (1u << 26)) bits |= CPU_SSE2_BIT;
+		if (ecx1 & (1u << 0))  bits |= CPU_SSE3_BIT;
+		if (ecx1 & (1u << 9))  bits |= CPU_SSSE3_BIT;
+		if (ecx1 & (1u << 19)) bits |= CPU_SSE41_BIT;
+		if (ecx1 & (1u << 20)) bits |= CPU_SSE42_BIT;
+
+		// AVX exige soporte de CPU y que el SO salve YMM (OSXSAVE + XCR0[2:1])
+		const bool osxsave = (ecx1 & (1u << 27)) != 0;
+		const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+		const bool ymm_ok = (xcr0 & 0x6) == 0x6;
+		const bool zmm_ok = (xcr0 & 0xE6) == 0xE6;
+
+		if (ymm_ok && (ecx1 & (1u << 28))) bits |= CPU_AVX_BIT;
+		if (ymm_ok && (ecx1 & (1u << 12))) bits |= CPU_FMA_BIT;
+		if (ymm_ok && (ecx1 & (1u << 29))) bits |= CPU_F16C_BIT;
+
+		if (max_leaf >= 7)
+		{
+			cpuid(7, 0, r);
+			const uint32_t ebx7 = r[1];
+			if (ymm_ok && (ebx7 & (1u << 5))) bits |= CPU_AVX2_BIT;
+			if (ebx7 & (1u << 8)) bits |= CPU_BMI2_BIT;
+			// AVX-512 F + DQ + BW + VL, igual que el nivel CPU_AVX512 de compilación
+			const uint32_t avx512_mask = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+			if (zmm_ok && (ebx7 & avx512_mask) == avx512_mask) bits |= CPU_AVX512_BIT;
+		}
+
+#elif defined(__aarch64__)
+		// NEON (ASIMD) es obligatorio en AArch64; SVE es opcional (Neoverse V1/V2, A64FX...)
+		bits |= CPU_NEON_BIT;
+#	if defined(CPU_RUNTIME_ARM_LINUX) && defined(HWCAP_SVE)
+		if (getauxval(AT_HWCAP) & HWCAP_SVE) bits |= CPU_SVE_BIT;
+#	endif
+
+#elif defined(CPU_RUNTIME_ARM_LINUX)
+#	if defined(HWCAP_NEON)
+		if (getauxval(AT_HWCAP) & HWCAP_NEON) bits |= CPU_NEON_BIT;
+#	endif
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		bits |= CPU_NEON_BIT;
+#endif
+
+		return bits;
+	}
+
+} // namespace cpu_internal
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Máscara CPU_*_BIT de extensiones disponibles en la máquina actual (se calcula una sola vez).
+inline uint32_t cpu_runtime_extensions() noexcept
+{
+	static const uint32_t bits = cpu_internal::detect_extensions();
+	return bits;
+}
+
+// true si la CPU dispone de todos los bits pedidos (admite las máscaras compuestas CPU_AVX2, CPU_SSE41...)
+inline bool cpu_has(uint32_t mask) noexcept
+{
+	return (cpu_runtime_extensions() & mask) == mask;
+}
+
+
+#endif // PRE_CPU_FEATURES_H
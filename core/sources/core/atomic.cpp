@@ -1,153 +1,271 @@
 #define BUILD_DLL
 
-#include <core/atomic.h>
+#include <pre.h>
+#include <core/threading.h>
 
+#include <algorithm>
+#include <bit>
 
-#if (OS_PLATFORM & OS_PLATFORM_WINDOWS)
+#if (OS & OS_LINUX)
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
 
-	#include <windows.h>
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cerrojo híbrido
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static INIT_ONCE gOnce = INIT_ONCE_STATIC_INIT;
-static CRITICAL_SECTION gCS;
+namespace {
 
-static BOOL CALLBACK init_cs(PINIT_ONCE, PVOID, PVOID*) {
-    InitializeCriticalSection(&gCS);
-    return TRUE;
-}
+	// cpu_relax() antes de dormir: unos microsegundos, lo que dura una sección corta y menos que dormir y despertar
+	constexpr int kHybridSpins = 64;
 
-DLL_FNC(void) enter_to_critical_section() 
-{
-    InitOnceExecuteOnce(&gOnce, init_cs, NULL, NULL);
-    EnterCriticalSection(&gCS);
-}
-DLL_FNC(void) exit_from_critical_section() 
-{
-	 LeaveCriticalSection(&gCS); 
-}
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "el futex espera sobre un entero de 32 bits");
 
+	void park(std::atomic<uint32_t>& state, uint32_t value)
+	{
+#if (OS & OS_LINUX)
+		// Vuelve en seguida si state ya no vale value; las señales y los despertares espurios se resuelven al reintentar
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
 #else
+		state.wait(value, std::memory_order_relaxed);
+#endif
+	}
 
-    #include <pthread.h>
+} // namespace
+
+DLL_FNC(void)	hybrid_lock_slow(std::atomic<uint32_t>& state) noexcept
+{
+	int spins = 1;
+	for (int round = 0; round < kHybridSpins; round += spins) {
+		uint32_t value = state.load(std::memory_order_relaxed);
+		if (value == 0) {
+			if (state.compare_exchange_weak(value, 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return;
+			continue;
+		}
+		// Ya hay hebras dormidas: adelantarlas girando sólo retrasa su turno
+		if (value == 2)
+			break;
+		for (int i = 0; i < spins; ++i)
+			cpu_relax();
+		spins = std::min(spins * 2, 16);
+	}
+
+	// Se marca 2 al coger el cerrojo aunque ya no quede nadie: a lo sumo cuesta un hybrid_lock_wake() de más
+	while (state.exchange(2, std::memory_order_acquire) != 0)
+		park(state, 2);
+}
 
-    static	pthread_mutex_t gMutex;
-    static	int				gMutexInitialized = 23563456;
+DLL_FNC(void)	hybrid_lock_wake(std::atomic<uint32_t>& state) noexcept
+{
+#if (OS & OS_LINUX)
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+	state.notify_one();
+#endif
+}
 
-    void	InitMutex()
-    {
-        if (gMutexInitialized != 0)
-        {
-            gMutexInitialized = 0;
 
-            pthread_mutexattr_t Attr;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Nodos de mcs_lock_t
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-            pthread_mutexattr_init(&Attr);
-            pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
-            pthread_mutex_init(&gMutex, &Attr);
-        }
-    }
+namespace {
 
+	constexpr uint32_t kThreadMcsNodes = 16;
 
-	DLL_FNC(void)	enter_to_critical_section()
+	// Un nodo vuelve a la reserva en cuanto se suelta su cerrojo: el siguiente de la cola ya no lo lee
+	struct mcs_node_pool_t
 	{
-        InitMutex();
-        pthread_mutex_lock(&gMutex);
-	}
-	DLL_FNC(void)	exit_from_critical_section()
-    {
-        pthread_mutex_unlock(&gMutex);
-    }
-
-#endif // defined
+		mcs_node_t	nodes[kThreadMcsNodes];
+		uint32_t	free_mask = (1u << kThreadMcsNodes) - 1;
+	};
 
+	thread_local mcs_node_pool_t gMcsNodes;
 
+} // namespace
 
-#include <sched.h>
+DLL_FNC(mcs_node_t*)	mcs_node_acquire()
+{
+	mcs_node_pool_t& pool = gMcsNodes;
+	if (!pool.free_mask)
+		return new mcs_node_t();
+	const uint32_t index = uint32_t(std::countr_zero(pool.free_mask));
+	pool.free_mask &= pool.free_mask - 1;
+	return &pool.nodes[index];
+}
 
-DLL_FNC(void)	thread_yield()
+DLL_FNC(void)	mcs_node_release(mcs_node_t* node)
 {
-#if (OS_PLATFORM & OS_PLATFORM_WINDOWS)
-    Sleep(0);
-#else
-    sched_yield();
-#endif
+	mcs_node_pool_t& pool = gMcsNodes;
+	const uintptr_t index = (uintptr_t(node) - uintptr_t(pool.nodes)) / sizeof(mcs_node_t);
+	if (index >= kThreadMcsNodes) {
+		delete node;
+		return;
+	}
+	pool.free_mask |= 1u << uint32_t(index);
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Secciones críticas
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
 
+	constexpr size_t kCriticalSections = 64;
 
+	// constinit: listas antes de cualquier constructor estático, que puede usarlas sin carreras
+	constinit critical_section_t gCriticalSections[kCriticalSections];
+	constinit critical_section_t gLegacySection;
 
+	thread_local char tCriticalSectionToken;
 
+	// Finalizador de murmur3: las direcciones alineadas reparten sus bits altos por todos los bits del resultado
+	uint64_t mix(uint64_t key)
+	{
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdull;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ull;
+		key ^= key >> 33;
+		return key;
+	}
 
+	size_t section_index(uint64_t key)
+	{
+		return size_t(mix(key) % kCriticalSections);
+	}
 
+} // namespace
 
+DLL_FNC(uintptr_t)	critical_section_thread_token()
+{
+	return uintptr_t(&tCriticalSectionToken);
+}
 
+DLL_FNC(critical_section_t&)	critical_section(const void* key)
+{
+	return gCriticalSections[section_index(uint64_t(uintptr_t(key)))];
+}
 
-DLL_FNC(void)	spinlock_init(volatile int* mutex)
+DLL_FNC(critical_section_t&)	critical_section(const char* name)
 {
-	*mutex = 0;
+	// FNV-1a del texto
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (const char* c = name; c && *c; ++c)
+		hash = (hash ^ uint8_t(*c)) * 0x100000001b3ull;
+	return gCriticalSections[section_index(hash)];
 }
 
-DLL_FNC(void)	spinlock_unlock(volatile int* mutex)
+DLL_FNC(size_t)	critical_section_count()
 {
-	atomic_store_release_i32(&mutex, 0u);
+	return kCriticalSections;
 }
 
-static FORCE_INLINE	bool	try_lock_spin(volatile int* mutex)	
+DLL_FNC(void)	critical_section_stats(critical_section_stats_t& stats)
 {
-	 return atomic_xchg_acq_rel_i32(&mutex, 1u) == 0u;
+	stats = critical_section_stats_t();
+	auto add = [&stats](const critical_section_t& section) {
+		const uint64_t contended = section.contended_count.load(std::memory_order_relaxed);
+		stats.enter_count += section.enter_count.load(std::memory_order_relaxed);
+		stats.contended_count += contended;
+		stats.busiest_contended_count = std::max(stats.busiest_contended_count, contended);
+	};
+	for (const critical_section_t& section : gCriticalSections)
+		add(section);
+	add(gLegacySection);
 }
 
-DLL_FNC(void)	spinlock_lock(volatile int* mutex)
+DLL_FNC(void)	enter_to_critical_section()
 {
-	for (;;)
-	{
-		if(try_lock_spin(mutex))
-			return;
-		else
-			thread_yield();
-	}
+	gLegacySection.lock();
 }
 
+DLL_FNC(void)	exit_from_critical_section()
+{
+	gLegacySection.unlock();
+}
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cerrojos por dirección
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
 
+	constexpr size_t kDefaultStripes = 256;
 
+	struct stripe_table_t
+	{
+		spinlock_aligned_t*	stripes;
+		size_t				mask;
+	};
 
+	spinlock_aligned_t					gDefaultStripes[kDefaultStripes];
+	const stripe_table_t				gDefaultTable{ gDefaultStripes, kDefaultStripes - 1 };
+	std::atomic<const stripe_table_t*>	gStripeTable{ &gDefaultTable };
+	std::atomic<bool>					gStripesUsed{ false };
+	spinlock_aligned_t					gGlobalLock;
 
+	spinlock_aligned_t& stripe(const void* address)
+	{
+		// Sólo se escribe una vez: después es una línea compartida en todas las cachés
+		if (!gStripesUsed.load(std::memory_order_relaxed))
+			gStripesUsed.store(true, std::memory_order_relaxed);
+		const stripe_table_t* table = gStripeTable.load(std::memory_order_acquire);
+		return table->stripes[mix(uint64_t(uintptr_t(address))) & table->mask];
+	}
 
-volatile	int	gObjectMutex[] = {
-	0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0,
-	0, 0, 0, 0, 0, 0, 0, 0};
+} // namespace
 
-DLL_FNC(void)	memory_lock(const void* i)
+DLL_FNC(bool)	memory_lock_configure(size_t stripe_count)
 {
-	spinlock_lock(&gObjectMutex[((uintptr_t)i) & 0x1F]);
+	if (gStripesUsed.load(std::memory_order_relaxed))
+		return false;
+	if (!stripe_count)
+		stripe_count = 4 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	stripe_count = std::bit_ceil(stripe_count);
+
+	const stripe_table_t* table = &gDefaultTable;
+	if (stripe_count != kDefaultStripes)
+		table = new stripe_table_t{ new spinlock_aligned_t[stripe_count], stripe_count - 1 };
+	const stripe_table_t* old = gStripeTable.exchange(table, std::memory_order_acq_rel);
+	if (old != &gDefaultTable) {
+		delete[] old->stripes;
+		delete old;
+	}
+	return true;
 }
 
-DLL_FNC(void)	memory_unlock(const void* i)
+DLL_FNC(size_t)	memory_lock_stripe_count()
 {
-	spinlock_unlock(&gObjectMutex[((uintptr_t)i) & 0x1F]);
+	return gStripeTable.load(std::memory_order_acquire)->mask + 1;
 }
 
-volatile int gInterfacesMutex = 0;
-DLL_FNC(void)	memory_lock_global()
+DLL_FNC(void)	memory_lock(const void* address)
 {
-	spinlock_lock(&gInterfacesMutex);
+	stripe(address).lock();
 }
 
-DLL_FNC(void)	memory_unlock_global()
+DLL_FNC(void)	memory_unlock(const void* address)
 {
-	spinlock_unlock(&gInterfacesMutex);
+	stripe(address).unlock();
 }
 
+DLL_FNC(void)	memory_lock()
+{
+	gGlobalLock.lock();
+}
 
+DLL_FNC(void)	memory_unlock()
+{
+	gGlobalLock.unlock();
+}
 
-
-
-
-
-
-
+DLL_FNC(void)	thread_yield()
+{
+	std::this_thread::yield();
+}
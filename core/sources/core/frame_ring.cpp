@@ -0,0 +1,188 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/frame_ring.h>
+#include <core/host_buffer.h>
+
+#include <algorithm>
+#include <new>
+
+namespace {
+
+	constexpr uint32_t kOffsetBits = 24;
+	constexpr uint64_t kOffsetMask = (1ull << kOffsetBits) - 1;
+	constexpr size_t kOwnAlignment = 4096;
+
+	std::atomic<uint32_t> gNextThread{ 0 };
+
+	uint32_t thread_index()
+	{
+		thread_local const uint32_t index = gNextThread.fetch_add(1, std::memory_order_relaxed);
+		return index;
+	}
+
+	// Reserva count chunks seguidos dentro del bloque; si no caben antes del final se salta el resto del bloque.
+	// Devuelve el número del primero o UINT64_MAX si el anillo está lleno.
+	uint64_t acquire_chunks(frame_ring_t& ring, uint64_t count)
+	{
+		uint64_t h = ring.head.load(std::memory_order_relaxed);
+		for (;;) {
+			const uint64_t at = h % ring.chunk_count;
+			const uint64_t skip = at + count > ring.chunk_count ? ring.chunk_count - at : 0;
+			if (h + skip + count > ring.limit.load(std::memory_order_acquire))
+				return UINT64_MAX;
+			if (ring.head.compare_exchange_weak(h, h + skip + count, std::memory_order_relaxed))
+				return h + skip;
+		}
+	}
+
+	uint64_t chunk_offset(const frame_ring_t& ring, uint64_t chunk)
+	{
+		return (chunk % ring.chunk_count) << ring.chunk_shift;
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(bool) frame_ring_init(frame_ring_t& ring, const frame_ring_config_t& config, void* memory)
+{
+	frame_ring_release(ring);
+	const uint32_t chunk = config.chunk_byte_count;
+	if (chunk < 256 || chunk > (8u << 20) || (chunk & (chunk - 1)) || config.byte_count < chunk || !config.frames_in_flight)
+		return false;
+
+	ring.chunk_shift = 0;
+	while ((1u << ring.chunk_shift) < chunk)
+		++ring.chunk_shift;
+	ring.chunk_count = config.byte_count >> ring.chunk_shift;
+	ring.byte_count = ring.chunk_count << ring.chunk_shift;
+	ring.frames_in_flight = config.frames_in_flight;
+	ring.cursor_count = config.cursor_count ? config.cursor_count : uint32_t(2 * parallel_thread_count());
+
+	ring.owns_data = !memory;
+	ring.data = static_cast<uint8_t*>(memory ? memory : ::operator new(size_t(ring.byte_count), std::align_val_t(kOwnAlignment), std::nothrow));
+	if (!ring.data)
+		return false;
+	ring.cursors.reset(new frame_ring_cursor_t[ring.cursor_count]);
+	ring.frame_starts.reset(new uint64_t[ring.frames_in_flight]());
+	ring.frame = config.first_frame;
+	ring.head.store(0, std::memory_order_relaxed);
+	ring.frame_start.store(0, std::memory_order_relaxed);
+	ring.failed_count.store(0, std::memory_order_relaxed);
+	ring.limit.store(ring.chunk_count, std::memory_order_release);
+	return true;
+}
+
+DLL_FNC(void) frame_ring_release(frame_ring_t& ring)
+{
+	if (ring.owns_data && ring.data)
+		::operator delete(ring.data, std::align_val_t(kOwnAlignment));
+	ring.data = nullptr;
+	ring.byte_count = ring.chunk_count = 0;
+	ring.owns_data = false;
+	ring.cursors.reset();
+	ring.frame_starts.reset();
+	ring.limit.store(0, std::memory_order_relaxed);
+}
+
+DLL_FNC(void*) frame_ring_alloc(frame_ring_t& ring, uint64_t byte_count, uint64_t alignment, uint64_t* offset)
+{
+	const uint64_t chunk_bytes = 1ull << ring.chunk_shift;
+	if (!alignment)
+		alignment = 16;
+	if (!ring.data || (alignment & (alignment - 1)) || alignment > chunk_bytes)
+		return nullptr;
+	byte_count = std::max<uint64_t>(byte_count, 1);
+
+	// Más de un chunk: chunks propios, alineados por estar al inicio de uno
+	if (byte_count > chunk_bytes) {
+		const uint64_t first = acquire_chunks(ring, (byte_count + chunk_bytes - 1) >> ring.chunk_shift);
+		if (first == UINT64_MAX) {
+			ring.failed_count.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		if (offset)
+			*offset = chunk_offset(ring, first);
+		return ring.data + chunk_offset(ring, first);
+	}
+
+	frame_ring_cursor_t& cursor = ring.cursors[thread_index() % ring.cursor_count];
+	const uint64_t frame_start = ring.frame_start.load(std::memory_order_acquire);
+	uint64_t state = cursor.state.load(std::memory_order_relaxed);
+	for (;;) {
+		// Chunk del frame actual con sitio
+		const uint64_t chunk = (state >> kOffsetBits) - 1;
+		if (state && chunk >= frame_start) {
+			const uint64_t base = chunk_offset(ring, chunk);
+			const uint64_t at = ((uintptr_t(ring.data) + base + (state & kOffsetMask) + alignment - 1) & ~(alignment - 1)) -
+								uintptr_t(ring.data);
+			if (at + byte_count <= base + chunk_bytes) {
+				if (cursor.state.compare_exchange_weak(state, ((chunk + 1) << kOffsetBits) | (at + byte_count - base),
+													   std::memory_order_relaxed))
+				{
+					if (offset)
+						*offset = at;
+					return ring.data + at;
+				}
+				continue;
+			}
+		}
+
+		// Chunk nuevo; si otra hebra del mismo cursor se adelanta, éste se pierde hasta que se recicle su frame
+		const uint64_t fresh = acquire_chunks(ring, 1);
+		if (fresh == UINT64_MAX) {
+			ring.failed_count.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		const uint64_t base = chunk_offset(ring, fresh);
+		const uint64_t at = ((uintptr_t(ring.data) + base + alignment - 1) & ~(alignment - 1)) - uintptr_t(ring.data);
+		if (at + byte_count > base + chunk_bytes) {
+			// Sólo con un bloque ajeno menos alineado que alignment
+			ring.failed_count.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+		if (cursor.state.compare_exchange_strong(state, ((fresh + 1) << kOffsetBits) | (at + byte_count - base),
+												 std::memory_order_relaxed))
+		{
+			if (offset)
+				*offset = at;
+			return ring.data + at;
+		}
+	}
+}
+
+DLL_FNC(bool) frame_ring_alloc(frame_ring_t& ring, const buffer_access_t& access, uint64_t byte_count, frame_ring_range_t& range)
+{
+	range = frame_ring_range_t();
+	if (!access.can_use_subregion ||
+		(access.location != buffer_location_t::HOST && access.location != buffer_location_t::UNKNOWN))
+		return false;
+	uint64_t offset = 0;
+	void* data = frame_ring_alloc(ring, byte_count, host_buffer_usage_alignment(access.usage), &offset);
+	if (!data)
+		return false;
+	range.data = data;
+	range.offset = offset;
+	range.byte_count = byte_count;
+	range.frame = ring.frame;
+	return true;
+}
+
+DLL_FNC(uint64_t) frame_ring_next_frame(frame_ring_t& ring)
+{
+	if (!ring.data)
+		return ring.frame;
+	const uint64_t start = ring.head.load(std::memory_order_relaxed);
+	++ring.frame;
+	ring.frame_starts[ring.frame % ring.frames_in_flight] = start;
+
+	// El frame más antiguo que sigue en vuelo marca hasta dónde se puede reservar
+	const uint64_t oldest = ring.frame + 1 >= ring.frames_in_flight ? ring.frame + 1 - ring.frames_in_flight : 0;
+	const uint64_t tail = oldest ? ring.frame_starts[oldest % ring.frames_in_flight] : 0;
+	ring.frame_start.store(start, std::memory_order_release);
+	ring.limit.store(tail + ring.chunk_count, std::memory_order_release);
+	return ring.frame;
+}
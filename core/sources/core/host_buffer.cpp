@@ -0,0 +1,471 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/host_buffer.h>
+#include <core/frame_ring.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if (OS & OS_WINDOWS)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#endif
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#endif
+
+namespace {
+
+	constexpr uint64_t kHugePage = 2ull << 20;
+	constexpr size_t kStrategies = size_t(host_buffer_strategy_t::COUNT);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Estadísticas
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct stats_t {
+		std::atomic<uint64_t>	bytes[kStrategies] = {};
+		std::atomic<uint64_t>	peak[kStrategies] = {};
+		std::atomic<uint64_t>	allocs[kStrategies] = {};
+	};
+
+	stats_t gStats;
+
+	void stats_add(host_buffer_strategy_t strategy, uint64_t byte_count)
+	{
+		const size_t s = size_t(strategy);
+		gStats.allocs[s].fetch_add(1, std::memory_order_relaxed);
+		const uint64_t now = gStats.bytes[s].fetch_add(byte_count, std::memory_order_relaxed) + byte_count;
+		uint64_t peak = gStats.peak[s].load(std::memory_order_relaxed);
+		while (peak < now && !gStats.peak[s].compare_exchange_weak(peak, now, std::memory_order_relaxed))
+			;
+	}
+
+	void stats_sub(host_buffer_strategy_t strategy, uint64_t byte_count)
+	{
+		gStats.bytes[size_t(strategy)].fetch_sub(byte_count, std::memory_order_relaxed);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Heap alineado: el puntero de malloc se guarda justo antes del bloque
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void* heap_alloc(uint64_t byte_count, uint64_t alignment)
+	{
+		alignment = std::max<uint64_t>(alignment, sizeof(void*));
+		if (byte_count > SIZE_MAX - alignment - sizeof(void*))
+			return nullptr;
+		void* raw = std::malloc(size_t(byte_count + alignment + sizeof(void*)));
+		if (!raw)
+			return nullptr;
+		const uintptr_t data = (uintptr_t(raw) + sizeof(void*) + alignment - 1) & ~uintptr_t(alignment - 1);
+		reinterpret_cast<void**>(data)[-1] = raw;
+		return reinterpret_cast<void*>(data);
+	}
+
+	void heap_free(void* data)
+	{
+		if (data)
+			std::free(static_cast<void**>(data)[-1]);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Páginas del sistema
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t pages_byte_count(uint64_t byte_count)
+	{
+		return (byte_count + kHugePage - 1) & ~(kHugePage - 1);
+	}
+
+#if (OS & OS_WINDOWS)
+
+	// Las páginas grandes necesitan SeLockMemoryPrivilege; VirtualAlloc alinea a 64 KiB
+	void* pages_alloc(uint64_t byte_count, uint64_t alignment)
+	{
+		if (alignment > (64u << 10))
+			return nullptr;
+		return VirtualAlloc(nullptr, SIZE_T(pages_byte_count(byte_count)), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	void pages_free(void* data, uint64_t)
+	{
+		VirtualFree(data, 0, MEM_RELEASE);
+	}
+
+#else
+
+	// Se pide un tramo de más para alinear a 2 MiB (o a alignment) y se devuelven los sobrantes
+	void* pages_alloc(uint64_t byte_count, uint64_t alignment)
+	{
+		const uint64_t size = pages_byte_count(byte_count);
+		const uint64_t align = std::max(alignment, kHugePage);
+		void* raw = mmap(nullptr, size_t(size + align), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED)
+			return nullptr;
+		uint8_t* begin = static_cast<uint8_t*>(raw);
+		uint8_t* data = reinterpret_cast<uint8_t*>((uintptr_t(begin) + align - 1) & ~uintptr_t(align - 1));
+		if (data > begin)
+			munmap(begin, size_t(data - begin));
+		if (uint8_t* tail = data + size; tail < begin + size + align)
+			munmap(tail, size_t(begin + size + align - tail));
+#if defined(MADV_HUGEPAGE)
+		madvise(data, size_t(size), MADV_HUGEPAGE);
+#endif
+		return data;
+	}
+
+	void pages_free(void* data, uint64_t byte_count)
+	{
+		munmap(data, size_t(pages_byte_count(byte_count)));
+	}
+
+#endif
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// FRAME: un frame_ring_t y, cuando se llena, bloques de frame_block_byte_count por frame en vuelo; ambos se vacían de
+	// golpe al volver a su frame
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct frame_block_t {
+		uint8_t*	data;
+		uint64_t	byte_count;
+		uint64_t	used;
+	};
+
+	struct frame_slot_t {
+		std::vector<frame_block_t>	blocks;				// de frame_block_byte_count; recibe reservas el último
+		std::vector<void*>			large;				// reservas que no caben en un bloque
+		uint64_t					large_byte_count = 0;
+		uint64_t					byte_count = 0;		// reservado en el frame fuera del anillo
+	};
+
+	struct frame_pool_t {
+		spinlock_t					lock;
+		host_buffer_config_t		config;
+		std::vector<frame_slot_t>	slots = std::vector<frame_slot_t>(3);
+		std::vector<frame_block_t>	free_blocks;
+		uint64_t					pool_byte_count = 0;
+		std::atomic<uint64_t>		frame{ 0 };
+
+		// El anillo se crea con la primera reserva; ring_bytes cuenta lo reservado en él por frame en vuelo
+		frame_ring_t				ring;
+		std::atomic<bool>			ring_ready{ false };
+		std::unique_ptr<std::atomic<uint64_t>[]>	ring_bytes;
+	};
+
+	frame_pool_t gFrames;
+	std::atomic<uint64_t> gHugePageByteCount{ host_buffer_config_t().huge_page_byte_count };
+
+	// Con el cerrojo tomado
+	void recycle_slot(frame_slot_t& slot)
+	{
+		for (frame_block_t& b : slot.blocks) {
+			b.used = 0;
+			gFrames.free_blocks.push_back(b);
+		}
+		for (void* data : slot.large)
+			heap_free(data);
+		gFrames.pool_byte_count -= slot.large_byte_count;
+		stats_sub(host_buffer_strategy_t::FRAME, slot.byte_count);
+		if (gFrames.ring_bytes) {
+			const size_t index = size_t(&slot - gFrames.slots.data());
+			stats_sub(host_buffer_strategy_t::FRAME, gFrames.ring_bytes[index].exchange(0, std::memory_order_relaxed));
+		}
+		slot.blocks.clear();
+		slot.large.clear();
+		slot.large_byte_count = slot.byte_count = 0;
+	}
+
+	void* bump(frame_block_t& b, uint64_t byte_count, uint64_t alignment)
+	{
+		const uint64_t offset = ((uintptr_t(b.data) + b.used + alignment - 1) & ~uint64_t(alignment - 1)) - uintptr_t(b.data);
+		if (offset + byte_count > b.byte_count)
+			return nullptr;
+		b.used = offset + byte_count;
+		return b.data + offset;
+	}
+
+	// Con el cerrojo tomado
+	void release_ring()
+	{
+		frame_ring_release(gFrames.ring);
+		gFrames.ring_bytes.reset();
+		gFrames.ring_ready.store(false, std::memory_order_release);
+	}
+
+	void* frame_ring_try(uint64_t byte_count, uint64_t alignment)
+	{
+		if (!gFrames.ring_ready.load(std::memory_order_acquire)) {
+			lock_guard_spin<spinlock_t> guard(gFrames.lock);
+			if (!gFrames.ring_ready.load(std::memory_order_relaxed)) {
+				frame_ring_config_t config;
+				config.byte_count = gFrames.config.frame_ring_byte_count;
+				config.frames_in_flight = uint32_t(gFrames.slots.size());
+				config.first_frame = gFrames.frame.load(std::memory_order_relaxed);
+				if (config.byte_count >= config.chunk_byte_count && frame_ring_init(gFrames.ring, config))
+					gFrames.ring_bytes.reset(new std::atomic<uint64_t>[gFrames.slots.size()]());
+				gFrames.ring_ready.store(true, std::memory_order_release);
+			}
+		}
+		if (!gFrames.ring_bytes)
+			return nullptr;
+		void* data = frame_ring_alloc(gFrames.ring, byte_count, alignment);
+		if (data) {
+			gFrames.ring_bytes[gFrames.frame.load(std::memory_order_relaxed) % gFrames.slots.size()].fetch_add(
+				byte_count, std::memory_order_relaxed);
+			stats_add(host_buffer_strategy_t::FRAME, byte_count);
+		}
+		return data;
+	}
+
+	void* frame_alloc(uint64_t byte_count, uint64_t alignment)
+	{
+		if (void* data = frame_ring_try(byte_count, alignment))
+			return data;
+
+		lock_guard_spin<spinlock_t> guard(gFrames.lock);
+		frame_slot_t& slot = gFrames.slots[gFrames.frame.load(std::memory_order_relaxed) % gFrames.slots.size()];
+		const uint64_t block_bytes = gFrames.config.frame_block_byte_count;
+
+		void* data = nullptr;
+		if (byte_count + alignment > block_bytes) {
+			if ((data = heap_alloc(byte_count, alignment))) {
+				slot.large.push_back(data);
+				slot.large_byte_count += byte_count;
+				gFrames.pool_byte_count += byte_count;
+			}
+		} else {
+			if (!slot.blocks.empty())
+				data = bump(slot.blocks.back(), byte_count, alignment);
+			if (!data) {
+				frame_block_t b = { nullptr, block_bytes, 0 };
+				if (!gFrames.free_blocks.empty()) {
+					b = gFrames.free_blocks.back();
+					gFrames.free_blocks.pop_back();
+				} else if ((b.data = static_cast<uint8_t*>(heap_alloc(block_bytes, 64)))) {
+					gFrames.pool_byte_count += block_bytes;
+				}
+				if (b.data) {
+					slot.blocks.push_back(b);
+					data = bump(slot.blocks.back(), byte_count, alignment);
+				}
+			}
+		}
+		if (!data)
+			return nullptr;
+		slot.byte_count += byte_count;
+		stats_add(host_buffer_strategy_t::FRAME, byte_count);
+		return data;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Copia no temporal
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(SIMD_KERNELS_X86)
+
+	// Cabeza hasta 16 bytes alineados con memcpy, cuerpo con movntdq de 64 en 64 bytes (una línea) y cola con memcpy
+	SIMD_TARGET("sse2")
+	void stream_copy_sse2(uint8_t* d, const uint8_t* s, uint64_t n)
+	{
+		const uint64_t head = std::min<uint64_t>(n, (16 - (uintptr_t(d) & 15)) & 15);
+		std::memcpy(d, s, size_t(head));
+		d += head, s += head, n -= head;
+		for (; n >= 64; n -= 64, d += 64, s += 64) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+			const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+		}
+		for (; n >= 16; n -= 16, d += 16, s += 16)
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+		std::memcpy(d, s, size_t(n));
+		_mm_sfence();
+	}
+
+#endif
+
+	void stream_copy(uint8_t* d, const uint8_t* s, uint64_t n)
+	{
+#if defined(SIMD_KERNELS_X86)
+		if (simd::kernels().isa != simd::isa_t::SCALAR) {
+			stream_copy_sse2(d, s, n);
+			return;
+		}
+#endif
+		std::memcpy(d, s, size_t(n));
+	}
+
+	uint8_t frequency(buffer_operation_frequency_t a, buffer_operation_frequency_t b)
+	{
+		return std::max(uint8_t(a), uint8_t(b));
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(void) host_buffer_configure(const host_buffer_config_t& config)
+{
+	lock_guard_spin<spinlock_t> guard(gFrames.lock);
+	const uint32_t frames = std::max<uint32_t>(1, config.frames_in_flight);
+	const uint64_t block_bytes = std::max<uint64_t>(4096, config.frame_block_byte_count);
+	if (frames != gFrames.slots.size() || block_bytes != gFrames.config.frame_block_byte_count ||
+		config.frame_ring_byte_count != gFrames.config.frame_ring_byte_count)
+	{
+		for (frame_slot_t& slot : gFrames.slots)
+			recycle_slot(slot);
+		release_ring();
+		for (frame_block_t& b : gFrames.free_blocks)
+			heap_free(b.data);
+		gFrames.free_blocks.clear();
+		gFrames.pool_byte_count = 0;
+		gFrames.slots.assign(frames, frame_slot_t());
+	}
+	gFrames.config = config;
+	gFrames.config.frames_in_flight = frames;
+	gFrames.config.frame_block_byte_count = block_bytes;
+	gHugePageByteCount.store(config.huge_page_byte_count, std::memory_order_relaxed);
+}
+
+DLL_FNC(uint64_t) host_buffer_usage_alignment(buffer_usage_t usage)
+{
+	const uint32_t bits = uint32_t(usage);
+	const uint32_t block = uint32_t(buffer_usage_t::UNIFORM_BUFFER) | uint32_t(buffer_usage_t::STORAGE_BUFFER) |
+						   uint32_t(buffer_usage_t::TEXTURE) | uint32_t(buffer_usage_t::TRANSFER_DST);
+	if (bits & block)
+		return 256;
+	if (bits & uint32_t(buffer_usage_t::INDIRECT_BUFFER))
+		return 64;
+	return 16;
+}
+
+DLL_FNC(host_buffer_strategy_t) host_buffer_strategy(const buffer_access_t& access, uint64_t byte_count)
+{
+	if (access.location != buffer_location_t::HOST && access.location != buffer_location_t::UNKNOWN)
+		return host_buffer_strategy_t::COUNT;
+
+	const uint8_t write = frequency(access.host_write, access.host_map_for_write);
+	const uint8_t read = frequency(access.host_read, access.host_map_for_read);
+	const bool write_only = read <= uint8_t(buffer_operation_frequency_t::ONCE);
+	if (write_only && write >= uint8_t(buffer_operation_frequency_t::MANY_TIMES_PER_FRAME) && access.can_use_subregion)
+		return host_buffer_strategy_t::FRAME;
+	if (write_only && write >= uint8_t(buffer_operation_frequency_t::EVERY_FRAME))
+		return host_buffer_strategy_t::STREAMING;
+	if (write <= uint8_t(buffer_operation_frequency_t::ONCE_EVERY_MANY_FRAMES) &&
+		byte_count >= gHugePageByteCount.load(std::memory_order_relaxed))
+		return host_buffer_strategy_t::PAGES;
+	return host_buffer_strategy_t::HEAP;
+}
+
+DLL_FNC(bool) host_buffer_alloc(const buffer_access_t& access, uint64_t byte_count, uint64_t alignment, host_buffer_t& buffer)
+{
+	buffer = host_buffer_t();
+	if (!alignment)
+		alignment = 16;
+	if (alignment & (alignment - 1))
+		return false;
+
+	host_buffer_strategy_t strategy = host_buffer_strategy(access, byte_count);
+	void* data = nullptr;
+	switch (strategy) {
+	case host_buffer_strategy_t::FRAME:
+		data = frame_alloc(byte_count, alignment);
+		break;
+	case host_buffer_strategy_t::STREAMING:
+		data = heap_alloc(byte_count, std::max<uint64_t>(alignment, 64));
+		break;
+	case host_buffer_strategy_t::PAGES:
+		data = pages_alloc(byte_count, alignment);
+		if (!data) {
+			strategy = host_buffer_strategy_t::HEAP;
+			data = heap_alloc(byte_count, alignment);
+		}
+		break;
+	case host_buffer_strategy_t::HEAP:
+		data = heap_alloc(byte_count, alignment);
+		break;
+	default:
+		return false;
+	}
+	if (!data)
+		return false;
+
+	// FRAME ya cuenta sus bytes con el cerrojo tomado
+	if (strategy != host_buffer_strategy_t::FRAME)
+		stats_add(strategy, byte_count);
+	buffer.data = data;
+	buffer.byte_count = byte_count;
+	buffer.strategy = strategy;
+	return true;
+}
+
+DLL_FNC(void) host_buffer_free(host_buffer_t& buffer)
+{
+	if (!buffer.data)
+		return;
+	switch (buffer.strategy) {
+	case host_buffer_strategy_t::PAGES:
+		pages_free(buffer.data, buffer.byte_count);
+		stats_sub(buffer.strategy, buffer.byte_count);
+		break;
+	case host_buffer_strategy_t::HEAP:
+	case host_buffer_strategy_t::STREAMING:
+		heap_free(buffer.data);
+		stats_sub(buffer.strategy, buffer.byte_count);
+		break;
+	default:
+		break;
+	}
+	buffer = host_buffer_t();
+}
+
+DLL_FNC(void) host_buffer_write(const host_buffer_t& buffer, uint64_t offset, const void* src, uint64_t byte_count)
+{
+	uint8_t* d = static_cast<uint8_t*>(buffer.data) + offset;
+	if (buffer.strategy == host_buffer_strategy_t::STREAMING)
+		stream_copy(d, static_cast<const uint8_t*>(src), byte_count);
+	else
+		std::memcpy(d, src, size_t(byte_count));
+}
+
+DLL_FNC(void) host_buffer_next_frame()
+{
+	lock_guard_spin<spinlock_t> guard(gFrames.lock);
+	const uint64_t frame = gFrames.frame.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (gFrames.ring_bytes)
+		frame_ring_next_frame(gFrames.ring);
+	recycle_slot(gFrames.slots[frame % gFrames.slots.size()]);
+}
+
+DLL_FNC(void) host_buffer_stats(host_buffer_stats_t& stats)
+{
+	for (size_t s = 0; s < kStrategies; ++s) {
+		stats.byte_count[s] = gStats.bytes[s].load(std::memory_order_relaxed);
+		stats.peak_byte_count[s] = gStats.peak[s].load(std::memory_order_relaxed);
+		stats.alloc_count[s] = gStats.allocs[s].load(std::memory_order_relaxed);
+	}
+	lock_guard_spin<spinlock_t> guard(gFrames.lock);
+	stats.frame_pool_byte_count = gFrames.pool_byte_count;
+	stats.frame_ring_failed_count = gFrames.ring.failed_count.load(std::memory_order_relaxed);
+	stats.frame = gFrames.frame.load(std::memory_order_relaxed);
+}
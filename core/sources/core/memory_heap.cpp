@@ -0,0 +1,328 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/memory_heap.h>
+#include <core/host_buffer.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+	using block_t = memory_heap_block_t;
+
+	constexpr uint32_t kNone = memory_heap_t::kNone;
+	constexpr uint32_t kSecondLevelLog2 = 5;
+	constexpr uint64_t kGranule = 16;
+
+	static_assert((1u << kSecondLevelLog2) == memory_heap_t::kSecondLevels, "32 subdivisiones por potencia de dos");
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Clases de tamaño (en gránulos de 16 bytes)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Los tamaños de menos de 32 gránulos van uno por clase en el primer nivel 0
+	void mapping(uint64_t granules, uint32_t& fl, uint32_t& sl)
+	{
+		if (granules < memory_heap_t::kSecondLevels) {
+			fl = 0;
+			sl = uint32_t(granules);
+			return;
+		}
+		const uint32_t msb = 63 - uint32_t(std::countl_zero(granules));
+		fl = msb - kSecondLevelLog2 + 1;
+		sl = uint32_t(granules >> (msb - kSecondLevelLog2)) - memory_heap_t::kSecondLevels;
+	}
+
+	// Primera clase cuyos bloques tienen todos al menos granules
+	void mapping_search(uint64_t granules, uint32_t& fl, uint32_t& sl)
+	{
+		if (granules >= memory_heap_t::kSecondLevels)
+			granules += (1ull << (63 - std::countl_zero(granules) - kSecondLevelLog2)) - 1;
+		mapping(granules, fl, sl);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Nodos y listas libres
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint32_t new_block(memory_heap_t& heap)
+	{
+		if (!heap.unused.empty()) {
+			const uint32_t b = heap.unused.back();
+			heap.unused.pop_back();
+			return b;
+		}
+		heap.blocks.push_back(block_t());
+		return uint32_t(heap.blocks.size() - 1);
+	}
+
+	void insert_free(memory_heap_t& heap, uint32_t b)
+	{
+		block_t& block = heap.blocks[b];
+		uint32_t fl, sl;
+		mapping(block.byte_count / kGranule, fl, sl);
+		block.free = true;
+		block.prev_free = kNone;
+		block.next_free = heap.free_heads[fl][sl];
+		if (block.next_free != kNone)
+			heap.blocks[block.next_free].prev_free = b;
+		heap.free_heads[fl][sl] = b;
+		heap.second_level_bitmap[fl] |= 1u << sl;
+		heap.first_level_bitmap |= 1ull << fl;
+		++heap.free_block_count;
+	}
+
+	void remove_free(memory_heap_t& heap, uint32_t b)
+	{
+		block_t& block = heap.blocks[b];
+		uint32_t fl, sl;
+		mapping(block.byte_count / kGranule, fl, sl);
+		if (block.prev_free != kNone)
+			heap.blocks[block.prev_free].next_free = block.next_free;
+		else
+			heap.free_heads[fl][sl] = block.next_free;
+		if (block.next_free != kNone)
+			heap.blocks[block.next_free].prev_free = block.prev_free;
+		if (heap.free_heads[fl][sl] == kNone) {
+			heap.second_level_bitmap[fl] &= ~(1u << sl);
+			if (!heap.second_level_bitmap[fl])
+				heap.first_level_bitmap &= ~(1ull << fl);
+		}
+		block.free = false;
+		--heap.free_block_count;
+	}
+
+	// Primer bloque libre de la clase (fl, sl) o de una mayor
+	uint32_t find_free(const memory_heap_t& heap, uint32_t fl, uint32_t sl)
+	{
+		if (fl >= memory_heap_t::kFirstLevels)
+			return kNone;
+		uint32_t sl_bits = heap.second_level_bitmap[fl] & (~0u << sl);
+		if (!sl_bits) {
+			const uint64_t fl_bits = fl + 1 < memory_heap_t::kFirstLevels ? heap.first_level_bitmap & (~0ull << (fl + 1)) : 0;
+			if (!fl_bits)
+				return kNone;
+			fl = uint32_t(std::countr_zero(fl_bits));
+			sl_bits = heap.second_level_bitmap[fl];
+		}
+		return heap.free_heads[fl][std::countr_zero(sl_bits)];
+	}
+
+	// Parte byte_count bytes del principio de b en un nodo nuevo, que queda delante en memoria
+	uint32_t split_front(memory_heap_t& heap, uint32_t b, uint64_t byte_count)
+	{
+		const uint32_t front = new_block(heap);
+		block_t& block = heap.blocks[b];
+		block_t& f = heap.blocks[front];
+		f = block_t{ block.offset, byte_count, block.prev_phys, b, kNone, kNone, 4, false };
+		if (block.prev_phys != kNone)
+			heap.blocks[block.prev_phys].next_phys = front;
+		else
+			heap.first_block = front;
+		block.prev_phys = front;
+		block.offset += byte_count;
+		block.byte_count -= byte_count;
+		return front;
+	}
+
+	// Parte lo que sobra de byte_count en b en un nodo nuevo, que queda detrás
+	uint32_t split_back(memory_heap_t& heap, uint32_t b, uint64_t byte_count)
+	{
+		const uint32_t back = new_block(heap);
+		block_t& block = heap.blocks[b];
+		block_t& k = heap.blocks[back];
+		k = block_t{ block.offset + byte_count, block.byte_count - byte_count, b, block.next_phys, kNone, kNone, 4, false };
+		if (block.next_phys != kNone)
+			heap.blocks[block.next_phys].prev_phys = back;
+		block.next_phys = back;
+		block.byte_count = byte_count;
+		return back;
+	}
+
+	// Une next (libre o no, ya fuera de las listas) a b y libera su nodo
+	void absorb_next(memory_heap_t& heap, uint32_t b)
+	{
+		block_t& block = heap.blocks[b];
+		const uint32_t next = block.next_phys;
+		block.byte_count += heap.blocks[next].byte_count;
+		block.next_phys = heap.blocks[next].next_phys;
+		if (block.next_phys != kNone)
+			heap.blocks[block.next_phys].prev_phys = b;
+		heap.unused.push_back(next);
+	}
+
+	void reset_lists(memory_heap_t& heap)
+	{
+		heap.first_level_bitmap = 0;
+		std::fill(std::begin(heap.second_level_bitmap), std::end(heap.second_level_bitmap), 0u);
+		for (auto& heads : heap.free_heads)
+			std::fill(std::begin(heads), std::end(heads), kNone);
+		heap.free_block_count = 0;
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(bool) memory_heap_init(memory_heap_t& heap, uint64_t byte_count)
+{
+	lock_guard_spin<spinlock_t> guard(heap.lock);
+	reset_lists(heap);
+	heap.blocks.clear();
+	heap.unused.clear();
+	heap.byte_count = byte_count & ~(kGranule - 1);
+	heap.used_byte_count = 0;
+	heap.alloc_count = 0;
+	heap.first_block = kNone;
+	if (!heap.byte_count)
+		return false;
+	heap.first_block = new_block(heap);
+	heap.blocks[heap.first_block] = block_t{ 0, heap.byte_count, kNone, kNone, kNone, kNone, 4, false };
+	insert_free(heap, heap.first_block);
+	return true;
+}
+
+DLL_FNC(bool) memory_heap_alloc(memory_heap_t& heap, uint64_t byte_count, uint64_t alignment, memory_heap_allocation_t& allocation)
+{
+	allocation = memory_heap_allocation_t();
+	alignment = std::max(alignment, kGranule);
+	if ((alignment & (alignment - 1)) || byte_count > heap.byte_count)
+		return false;
+	const uint64_t needed = (std::max<uint64_t>(byte_count, 1) + kGranule - 1) & ~(kGranule - 1);
+
+	uint32_t fl, sl;
+	mapping_search((needed + alignment - kGranule) / kGranule, fl, sl);
+
+	lock_guard_spin<spinlock_t> guard(heap.lock);
+	uint32_t b = find_free(heap, fl, sl);
+	if (b == kNone)
+		return false;
+	remove_free(heap, b);
+
+	// Los vecinos de un bloque libre nunca están libres: los trozos sobrantes no hay que unirlos
+	const uint64_t offset = heap.blocks[b].offset;
+	const uint64_t pad = ((offset + alignment - 1) & ~(alignment - 1)) - offset;
+	if (pad)
+		insert_free(heap, split_front(heap, b, pad));
+	if (heap.blocks[b].byte_count - needed >= kGranule)
+		insert_free(heap, split_back(heap, b, needed));
+
+	block_t& block = heap.blocks[b];
+	block.alignment_log2 = uint8_t(std::countr_zero(alignment));
+	heap.used_byte_count += block.byte_count;
+	++heap.alloc_count;
+
+	allocation.offset = block.offset;
+	allocation.byte_count = byte_count;
+	allocation.block = b;
+	return true;
+}
+
+DLL_FNC(bool) memory_heap_alloc(memory_heap_t& heap, buffer_usage_t usage, uint64_t byte_count, memory_heap_allocation_t& allocation)
+{
+	return memory_heap_alloc(heap, byte_count, host_buffer_usage_alignment(usage), allocation);
+}
+
+DLL_FNC(void) memory_heap_free(memory_heap_t& heap, memory_heap_allocation_t& allocation)
+{
+	if (allocation.block == kNone)
+		return;
+	lock_guard_spin<spinlock_t> guard(heap.lock);
+	uint32_t b = allocation.block;
+	heap.used_byte_count -= heap.blocks[b].byte_count;
+	--heap.alloc_count;
+
+	const uint32_t next = heap.blocks[b].next_phys;
+	if (next != kNone && heap.blocks[next].free) {
+		remove_free(heap, next);
+		absorb_next(heap, b);
+	}
+	const uint32_t prev = heap.blocks[b].prev_phys;
+	if (prev != kNone && heap.blocks[prev].free) {
+		remove_free(heap, prev);
+		absorb_next(heap, prev);
+		b = prev;
+	}
+	insert_free(heap, b);
+	allocation = memory_heap_allocation_t();
+}
+
+DLL_FNC(void) memory_heap_report(memory_heap_t& heap, memory_heap_report_t& report)
+{
+	lock_guard_spin<spinlock_t> guard(heap.lock);
+	report.byte_count = heap.byte_count;
+	report.used_byte_count = heap.used_byte_count;
+	report.free_byte_count = heap.byte_count - heap.used_byte_count;
+	report.alloc_count = heap.alloc_count;
+	report.free_block_count = heap.free_block_count;
+
+	// El hueco mayor está en la clase más alta que tiene alguno
+	report.largest_free_byte_count = 0;
+	if (heap.first_level_bitmap) {
+		const uint32_t fl = 63 - uint32_t(std::countl_zero(heap.first_level_bitmap));
+		const uint32_t sl = 31 - uint32_t(std::countl_zero(heap.second_level_bitmap[fl]));
+		for (uint32_t b = heap.free_heads[fl][sl]; b != kNone; b = heap.blocks[b].next_free)
+			report.largest_free_byte_count = std::max(report.largest_free_byte_count, heap.blocks[b].byte_count);
+	}
+	report.fragmentation = report.free_byte_count ?
+		1.0f - float(double(report.largest_free_byte_count) / double(report.free_byte_count)) : 0.0f;
+}
+
+DLL_FNC(uint64_t) memory_heap_compact(memory_heap_t& heap, std::vector<memory_heap_move_t>& moves)
+{
+	moves.clear();
+	lock_guard_spin<spinlock_t> guard(heap.lock);
+	if (!heap.byte_count)
+		return 0;
+
+	// Las reservas en orden de memoria; los nodos libres se descartan y se rehacen
+	std::vector<uint32_t> used;
+	used.reserve(heap.alloc_count);
+	for (uint32_t b = heap.first_block; b != kNone; b = heap.blocks[b].next_phys) {
+		if (heap.blocks[b].free)
+			heap.unused.push_back(b);
+		else
+			used.push_back(b);
+	}
+	reset_lists(heap);
+
+	uint64_t moved = 0, cursor = 0;
+	uint32_t prev = kNone;
+	auto link = [&](uint32_t b) {
+		heap.blocks[b].prev_phys = prev;
+		heap.blocks[b].next_phys = kNone;
+		if (prev != kNone)
+			heap.blocks[prev].next_phys = b;
+		else
+			heap.first_block = b;
+		prev = b;
+	};
+	auto gap = [&](uint64_t end) {
+		if (end == cursor)
+			return;
+		const uint32_t g = new_block(heap);
+		heap.blocks[g] = block_t{ cursor, end - cursor, kNone, kNone, kNone, kNone, 4, false };
+		link(g);
+		insert_free(heap, g);
+	};
+
+	// Cada reserva baja como mucho hasta su posición actual, así que los movimientos en orden no pisan datos vivos
+	for (uint32_t b : used) {
+		const uint64_t alignment = 1ull << heap.blocks[b].alignment_log2;
+		const uint64_t dst = (cursor + alignment - 1) & ~(alignment - 1);
+		gap(dst);
+		block_t& block = heap.blocks[b];
+		if (dst != block.offset) {
+			moves.push_back({ b, block.offset, dst, block.byte_count });
+			moved += block.byte_count;
+			block.offset = dst;
+		}
+		link(b);
+		cursor = dst + block.byte_count;
+	}
+	gap(heap.byte_count);
+	return moved;
+}
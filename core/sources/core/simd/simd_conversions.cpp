@@ -1,4 +1,5 @@
 #include <simd/simd_conversions.h>
+#include <simd/simd_dispatch.h>
 
 namespace simd {
 
@@ -7,76 +8,59 @@ namespace simd {
 // -----------------------------------------------------
 uint16_t float_to_half(float f) {
 	uint32_t x = _bit_cast<uint32_t>(f);
-	uint32_t s = (x >> 31) & 1u;
-	uint32_t e = (x >> 23) & 0xFFu;
-	uint32_t m = x & 0x7FFFFFu;
+	const uint32_t s = (x >> 16) & 0x8000u;
+	x &= 0x7FFFFFFFu;
 
-	// Inf/NaN
-	if (e == 0xFFu) {
-		return (uint16_t)((s << 15) | (0x1Fu << 10) | (m ? 0x200u : 0u));
+	// >= 65520 redondea a inf; NaN se silencia (bit 9) conservando la parte alta de la carga útil
+	if (x >= 0x477FF000u) {
+		if (x > 0x7F800000u) return (uint16_t)(s | 0x7E00u | ((x >> 13) & 0x3FFu));
+		return (uint16_t)(s | 0x7C00u);
 	}
 
-	// Cero/Subnormal en float
-	if (e == 0) {
-		if (!m) return (uint16_t)(s << 15);
-		// Normaliza mantisa para construir subnormal/normal en half
-		int sh = 0;
-		while ((m & 0x800000u) == 0u) { m <<= 1; ++sh; if (sh > 24) break; }
-		int E  = 1 - 127 - sh;
-		int he = E + 15;
-		if (he <= 0) {
-			if (he < -10) return (uint16_t)(s << 15);
-			uint32_t mm = (0x800000u | (m & 0x7FFFFFu)) >> (1 - he + 13);
-			return (uint16_t)((s << 15) | (mm & 0x3FFu));
-		} else {
-			uint16_t mm = (uint16_t)((m & 0x7FFFFFu) >> 13);
-			return (uint16_t)((s << 15) | ((uint16_t)he << 10) | mm);
-		}
+	// Normal en half: re-sesga el exponente y redondea los 13 bits descartados al par
+	if (x >= 0x38800000u) {
+		x += ((uint32_t)(15 - 127) << 23) + 0xFFFu + ((x >> 13) & 1u);
+		return (uint16_t)(s | (x >> 13));
 	}
 
-	// Normal
-	int E  = (int)e - 127;
-	int he = E + 15;
-	if (he >= 0x1F) return (uint16_t)((s << 15) | (0x1Fu << 10)); // overflow -> +inf
-	if (he <= 0) {
-		if (he < -10) return (uint16_t)(s << 15);
-		uint32_t mm = (0x800000u | m) >> (1 - he + 13);
-		return (uint16_t)((s << 15) | (mm & 0x3FFu));
-	}
-	// Redondeo a 10 bits con round-to-nearest-even
-	uint32_t mant = m >> 13;
-	if ((m & 0x1000u) && (((m & 0x1FFFu) != 0u) || (mant & 1u))) {
-		++mant;
-		if (mant == 0x400u) { mant = 0; ++he; if (he >= 0x1F) { he = 0x1F; mant = 0; } }
-	}
-	return (uint16_t)((s << 15) | ((uint16_t)he << 10) | (uint16_t)mant);
+	// Subnormal (o cero) en half: valor = m · 2^(e-126) unidades de 2^-24. Por debajo de 2^-25 siempre es cero
+	// (los subnormales float incluidos). q == 0x400 sale como el menor normal, que es lo correcto.
+	const uint32_t e = x >> 23;
+	if (e < 102) return (uint16_t)s;
+	const uint32_t m = (x & 0x7FFFFFu) | 0x800000u;
+	const uint32_t shift = 126 - e;
+	const uint32_t half = 1u << (shift - 1);
+	const uint32_t rem = m & ((half << 1) - 1u);
+	uint32_t q = m >> shift;
+	if (rem > half || (rem == half && (q & 1u))) ++q;
+	return (uint16_t)(s | q);
 }
 
 float half_to_float(uint16_t h) {
-	uint32_t s = (h >> 15) & 1u;
-	uint32_t e = (h >> 10) & 0x1Fu;
-	uint32_t m = h & 0x3FFu;
+	const uint32_t s = (uint32_t)(h & 0x8000u) << 16;
+	const uint32_t em = h & 0x7FFFu;
 
 	uint32_t out;
-	if (e == 0) {
-		if (!m) {
-			out = s << 31; // ±0
-		} else {
-			// subnormal: normaliza y ajusta exponente
-			int sh = 0;
-			while ((m & 0x400u) == 0u) { m <<= 1; ++sh; }
-			m &= 0x3FFu;
-			int E = 1 - 15 - sh;
-			out = (s << 31) | (uint32_t(E + 127) << 23) | (m << 13);
-		}
-	} else if (e == 0x1Fu) {
-		// Inf/NaN (propaga quiet NaN)
-		out = (s << 31) | (0xFFu << 23) | (m ? ((m << 13) | 0x400000u) : 0u);
+	if (em >= 0x7C00u) {
+		// Inf/NaN (NaN sale silenciado, como F16C)
+		out = s | 0x7F800000u | ((em & 0x3FFu) << 13) | ((em & 0x3FFu) ? 0x400000u : 0u);
+	} else if (em >= 0x0400u) {
+		out = s | ((em << 13) + ((uint32_t)(127 - 15) << 23));
 	} else {
-		// Normal
-		out = (s << 31) | (uint32_t(e - 15 + 127) << 23) | (m << 13);
+		// Subnormal o cero: em · 2^-24 es exacto en float
+		out = s | _bit_cast<uint32_t>((float)em * 5.9604644775390625e-8f);
 	}
 	return _bit_cast<float>(out);
 }
 
+void float_to_half(std::span<const float> in, std::span<uint16_t> out) {
+	assert(out.size() >= in.size());
+	kernels().f32_to_f16(in.data(), out.data(), in.size());
+}
+
+void half_to_float(std::span<const uint16_t> in, std::span<float> out) {
+	assert(out.size() >= in.size());
+	kernels().f16_to_f32(in.data(), out.data(), in.size());
+}
+
 } // namespace simd
@@ -0,0 +1,123 @@
+#include "simd_kernels.h"
+
+#include <pre/cpu_features.h>
+
+#include <atomic>
+
+namespace {
+
+	using namespace simd_internal;
+
+	std::atomic<const simd::kernels_t*> gActiveKernels{ nullptr };
+
+	// Tabla compilada para la ISA (nullptr si esta plataforma no la incluye); no comprueba la CPU
+	const simd::kernels_t* compiled_table(simd::isa_t isa) noexcept
+	{
+		switch (isa)
+		{
+		case simd::isa_t::SCALAR:	return &g_kernels_scalar;
+#if defined(SIMD_KERNELS_X86)
+		case simd::isa_t::SSE2:		return &g_kernels_sse2;
+		case simd::isa_t::SSE41:	return &g_kernels_sse41;
+		case simd::isa_t::AVX2:		return &g_kernels_avx2;
+		case simd::isa_t::AVX512:	return &g_kernels_avx512;
+#endif
+#if defined(SIMD_KERNELS_NEON)
+		case simd::isa_t::NEON:		return &g_kernels_neon;
+#endif
+#if defined(SIMD_KERNELS_SVE)
+		case simd::isa_t::SVE:		return &g_kernels_sve;
+#endif
+		default:					return nullptr;
+		}
+	}
+
+	bool cpu_supports(simd::isa_t isa) noexcept
+	{
+		switch (isa)
+		{
+		case simd::isa_t::SCALAR:	return true;
+		case simd::isa_t::SSE2:		return cpu_has(CPU_SSE2);
+		case simd::isa_t::SSE41:	return cpu_has(CPU_SSE41);
+		case simd::isa_t::AVX2:		return cpu_has(CPU_AVX2 | CPU_FMA_BIT | CPU_F16C_BIT);
+		case simd::isa_t::AVX512:	return cpu_has(CPU_AVX512 | CPU_FMA_BIT | CPU_F16C_BIT);
+		case simd::isa_t::NEON:		return cpu_has(CPU_NEON);
+		case simd::isa_t::SVE:		return cpu_has(CPU_SVE);
+		default:					return false;
+		}
+	}
+
+	const simd::kernels_t* select_best() noexcept
+	{
+		return simd::kernels_for(simd::best_isa());
+	}
+
+} // namespace
+
+
+namespace simd {
+
+	const char* isa_name(isa_t isa) noexcept
+	{
+		switch (isa)
+		{
+		case isa_t::SCALAR:	return "scalar";
+		case isa_t::SSE2:	return "sse2";
+		case isa_t::SSE41:	return "sse4.1";
+		case isa_t::AVX2:	return "avx2";
+		case isa_t::AVX512:	return "avx512";
+		case isa_t::NEON:	return "neon";
+		case isa_t::SVE:	return "sve";
+		default:			return "unknown";
+		}
+	}
+
+	isa_t best_isa() noexcept
+	{
+		// De más ancha a más estrecha (SVE es >= 128 bits, así que va antes que NEON)
+		static const isa_t order[] = { isa_t::AVX512, isa_t::AVX2, isa_t::SSE41, isa_t::SSE2, isa_t::SVE, isa_t::NEON };
+		for (isa_t isa : order)
+			if (kernels_for(isa))
+				return isa;
+		return isa_t::SCALAR;
+	}
+
+	const kernels_t* kernels_for(isa_t isa) noexcept
+	{
+		const kernels_t* table = compiled_table(isa);
+		return (table && cpu_supports(isa)) ? table : nullptr;
+	}
+
+	const kernels_t& kernels() noexcept
+	{
+		const kernels_t* k = gActiveKernels.load(std::memory_order_acquire);
+		if (!k)
+		{
+			// Varias hebras pueden llegar a la vez: todas calculan la misma tabla, gana la primera
+			const kernels_t* expected = nullptr;
+			k = select_best();
+			if (!gActiveKernels.compare_exchange_strong(expected, k, std::memory_order_acq_rel))
+				k = expected;
+		}
+		return *k;
+	}
+
+	int lanes_f32(const kernels_t& k) noexcept
+	{
+#if defined(SIMD_KERNELS_SVE)
+		if (k.isa == isa_t::SVE)
+			return sve_float_lanes();
+#endif
+		return k.float_lanes;
+	}
+
+	bool force_isa(isa_t isa) noexcept
+	{
+		const kernels_t* k = kernels_for(isa);
+		if (!k)
+			return false;
+		gActiveKernels.store(k, std::memory_order_release);
+		return true;
+	}
+
+} // namespace simd
@@ -0,0 +1,78 @@
+#pragma once
+
+// Cabecera privada: tablas de kernels por ISA para simd_dispatch.cpp.
+// Cada simd_kernels_<isa>.cpp se compila con las opciones de la ISA base; las funciones que usan una ISA superior
+// se marcan con SIMD_TARGET(...) para que el compilador genere ese código sin tocar el resto del binario.
+
+#include <simd/simd_dispatch.h>
+#include <simd/simd_conversions.h>
+
+#include <cstddef>
+#include <limits>
+
+#if defined(__GNUC__) || defined(__clang__)
+#	define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SIMD_TARGET(isa)
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define SIMD_KERNELS_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#	define SIMD_KERNELS_NEON 1
+#endif
+
+// SVE: el fichero fuerza "+sve" con #pragma GCC target si la TU no se compila ya con -march=...+sve
+// (arm_sve.h sólo admite el pragma a partir de GCC 14 / Clang 16).
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_SVE) || \
+	(defined(__clang__) && __clang_major__ >= 16) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 14))
+#	define SIMD_KERNELS_SVE 1
+#endif
+
+namespace simd_internal {
+
+	extern const simd::kernels_t g_kernels_scalar;
+
+#if defined(SIMD_KERNELS_X86)
+	extern const simd::kernels_t g_kernels_sse2;
+	extern const simd::kernels_t g_kernels_sse41;
+	extern const simd::kernels_t g_kernels_avx2;
+	extern const simd::kernels_t g_kernels_avx512;
+#endif
+
+#if defined(SIMD_KERNELS_NEON)
+	extern const simd::kernels_t g_kernels_neon;
+#endif
+
+#if defined(SIMD_KERNELS_SVE)
+	extern const simd::kernels_t g_kernels_sve;
+	// svcntw(): sólo se puede llamar si la CPU tiene SVE
+	int sve_float_lanes() noexcept;
+#endif
+
+	// ===============================
+	//  Colas escalares compartidas
+	// ===============================
+	// Las usan las ISAs sin carga enmascarada para los últimos n % lanes elementos.
+
+	inline void tail_add(const float* a, const float* b, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] + b[i]; }
+	inline void tail_sub(const float* a, const float* b, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] - b[i]; }
+	inline void tail_mul(const float* a, const float* b, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] * b[i]; }
+	inline void tail_min(const float* a, const float* b, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] < b[i] ? a[i] : b[i]; }
+	inline void tail_max(const float* a, const float* b, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] > b[i] ? a[i] : b[i]; }
+	inline void tail_fma(const float* a, const float* b, const float* c, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] * b[i] + c[i]; }
+	inline void tail_scale(const float* a, float s, float o, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = a[i] * s + o; }
+	inline void tail_f32_to_f16(const float* a, uint16_t* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = simd::float_to_half(a[i]); }
+	inline void tail_f16_to_f32(const uint16_t* a, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = simd::half_to_float(a[i]); }
+	inline void tail_u8_to_f32(const uint8_t* a, float s, float* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = (float)a[i] * s; }
+
+	// Mismo orden que las versiones vectoriales: max(v, 0) con NaN -> 0, min(v, 255), +0.5 y truncado
+	inline uint8_t sat_u8(float v) { v = v > 0.f ? v : 0.f; v = v < 255.f ? v : 255.f; return (uint8_t)(int32_t)(v + 0.5f); }
+	inline void tail_f32_to_u8(const float* a, float s, uint8_t* r, size_t i, size_t n) { for (; i < n; ++i) r[i] = sat_u8(a[i] * s); }
+
+	constexpr float kPosInf = std::numeric_limits<float>::infinity();
+	constexpr float kNegInf = -std::numeric_limits<float>::infinity();
+
+} // namespace simd_internal
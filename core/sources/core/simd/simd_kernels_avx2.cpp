@@ -0,0 +1,215 @@
+#include "simd_kernels.h"
+
+// AVX2 + FMA (+ F16C para half): 8 floats por registro, cola con _mm256_maskload_ps/_mm256_maskstore_ps.
+
+#if defined(SIMD_KERNELS_X86)
+
+#include <immintrin.h>
+
+#define SIMD_AVX2 SIMD_TARGET("avx2,fma")
+
+namespace {
+
+	using namespace simd_internal;
+
+	// Máscara de carga para los últimos rem (< 8) elementos
+	SIMD_AVX2 inline __m256i _tail_mask(size_t rem)
+	{
+		const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)rem), idx);
+	}
+
+#define SIMD_AVX2_BINARY(name, op)                                                     \
+	SIMD_AVX2 void name(const float* a, const float* b, float* r, size_t n)             \
+	{                                                                                  \
+		size_t i = 0;                                                                  \
+		for (; i + 16 <= n; i += 16) {                                                 \
+			__m256 a0 = _mm256_loadu_ps(a + i), a1 = _mm256_loadu_ps(a + i + 8);      \
+			__m256 b0 = _mm256_loadu_ps(b + i), b1 = _mm256_loadu_ps(b + i + 8);      \
+			_mm256_storeu_ps(r + i, op(a0, b0));                                       \
+			_mm256_storeu_ps(r + i + 8, op(a1, b1));                                   \
+		}                                                                              \
+		for (; i + 8 <= n; i += 8)                                                     \
+			_mm256_storeu_ps(r + i, op(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i))); \
+		if (i < n) {                                                                   \
+			const __m256i m = _tail_mask(n - i);                                       \
+			_mm256_maskstore_ps(r + i, m, op(_mm256_maskload_ps(a + i, m), _mm256_maskload_ps(b + i, m))); \
+		}                                                                              \
+	}
+
+	SIMD_AVX2_BINARY(add_f32, _mm256_add_ps)
+	SIMD_AVX2_BINARY(sub_f32, _mm256_sub_ps)
+	SIMD_AVX2_BINARY(mul_f32, _mm256_mul_ps)
+	SIMD_AVX2_BINARY(min_f32, _mm256_min_ps)
+	SIMD_AVX2_BINARY(max_f32, _mm256_max_ps)
+
+#undef SIMD_AVX2_BINARY
+
+	SIMD_AVX2 void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(r + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i)));
+		if (i < n) {
+			const __m256i m = _tail_mask(n - i);
+			_mm256_maskstore_ps(r + i, m, _mm256_fmadd_ps(_mm256_maskload_ps(a + i, m), _mm256_maskload_ps(b + i, m), _mm256_maskload_ps(c + i, m)));
+		}
+	}
+
+	SIMD_AVX2 void scale_f32(const float* a, float s, float o, float* r, size_t n)
+	{
+		const __m256 vs = _mm256_set1_ps(s), vo = _mm256_set1_ps(o);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(r + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), vs, vo));
+		if (i < n) {
+			const __m256i m = _tail_mask(n - i);
+			_mm256_maskstore_ps(r + i, m, _mm256_fmadd_ps(_mm256_maskload_ps(a + i, m), vs, vo));
+		}
+	}
+
+	SIMD_AVX2 inline float _hsum(__m256 v)
+	{
+		__m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_add_ss(s, _mm_movehdup_ps(s));
+		return _mm_cvtss_f32(s);
+	}
+
+	SIMD_AVX2 float hadd_f32(const float* a, size_t n)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			s0 = _mm256_add_ps(s0, _mm256_loadu_ps(a + i));
+			s1 = _mm256_add_ps(s1, _mm256_loadu_ps(a + i + 8));
+		}
+		if (i + 8 <= n) { s0 = _mm256_add_ps(s0, _mm256_loadu_ps(a + i)); i += 8; }
+		if (i < n) s1 = _mm256_add_ps(s1, _mm256_maskload_ps(a + i, _tail_mask(n - i)));  // lanes fuera -> 0
+		return _hsum(_mm256_add_ps(s0, s1));
+	}
+
+	SIMD_AVX2 float hmin_f32(const float* a, size_t n)
+	{
+		__m256 m = _mm256_set1_ps(kPosInf);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) m = _mm256_min_ps(m, _mm256_loadu_ps(a + i));
+		if (i < n) {
+			const __m256i mk = _tail_mask(n - i);
+			m = _mm256_min_ps(m, _mm256_blendv_ps(m, _mm256_maskload_ps(a + i, mk), _mm256_castsi256_ps(mk)));
+		}
+		__m128 s = _mm_min_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+		s = _mm_min_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_min_ss(s, _mm_movehdup_ps(s));
+		return _mm_cvtss_f32(s);
+	}
+
+	SIMD_AVX2 float hmax_f32(const float* a, size_t n)
+	{
+		__m256 m = _mm256_set1_ps(kNegInf);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) m = _mm256_max_ps(m, _mm256_loadu_ps(a + i));
+		if (i < n) {
+			const __m256i mk = _tail_mask(n - i);
+			m = _mm256_max_ps(m, _mm256_blendv_ps(m, _mm256_maskload_ps(a + i, mk), _mm256_castsi256_ps(mk)));
+		}
+		__m128 s = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+		s = _mm_max_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_max_ss(s, _mm_movehdup_ps(s));
+		return _mm_cvtss_f32(s);
+	}
+
+	SIMD_AVX2 float dot_f32(const float* a, const float* b, size_t n)
+	{
+		__m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+			s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), s1);
+		}
+		if (i + 8 <= n) { s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0); i += 8; }
+		if (i < n) {
+			const __m256i m = _tail_mask(n - i);
+			s1 = _mm256_fmadd_ps(_mm256_maskload_ps(a + i, m), _mm256_maskload_ps(b + i, m), s1);
+		}
+		return _hsum(_mm256_add_ps(s0, s1));
+	}
+
+	// F16C: vcvtps2ph con redondeo explícito al par más cercano (independiente de MXCSR.RC)
+	SIMD_TARGET("avx2,f16c") void f32_to_f16(const float* a, uint16_t* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm_storeu_si128((__m128i*)(r + i), _mm256_cvtps_ph(_mm256_loadu_ps(a + i), _MM_FROUND_TO_NEAREST_INT));
+			_mm_storeu_si128((__m128i*)(r + i + 8), _mm256_cvtps_ph(_mm256_loadu_ps(a + i + 8), _MM_FROUND_TO_NEAREST_INT));
+		}
+		for (; i + 8 <= n; i += 8)
+			_mm_storeu_si128((__m128i*)(r + i), _mm256_cvtps_ph(_mm256_loadu_ps(a + i), _MM_FROUND_TO_NEAREST_INT));
+		tail_f32_to_f16(a, r, i, n);
+	}
+
+	SIMD_TARGET("avx2,f16c") void f16_to_f32(const uint16_t* a, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm256_storeu_ps(r + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(a + i))));
+			_mm256_storeu_ps(r + i + 8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(a + i + 8))));
+		}
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(r + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(a + i))));
+		tail_f16_to_f32(a, r, i, n);
+	}
+
+	SIMD_AVX2 void u8_to_f32(const uint8_t* a, float s, float* r, size_t n)
+	{
+		const __m256 vs = _mm256_set1_ps(s);
+		size_t i = 0;
+		for (; i + 32 <= n; i += 32) {
+			const __m128i b0 = _mm_loadu_si128((const __m128i*)(a + i)), b1 = _mm_loadu_si128((const __m128i*)(a + i + 16));
+			_mm256_storeu_ps(r + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(b0)), vs));
+			_mm256_storeu_ps(r + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(b0, 8))), vs));
+			_mm256_storeu_ps(r + i + 16, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(b1)), vs));
+			_mm256_storeu_ps(r + i + 24, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(b1, 8))), vs));
+		}
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(r + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(a + i)))), vs));
+		tail_u8_to_f32(a, s, r, i, n);
+	}
+
+	SIMD_AVX2 inline __m256i _f32_to_i32_sat_u8(__m256 v, __m256 s)
+	{
+		v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v, s), _mm256_setzero_ps()), _mm256_set1_ps(255.f));
+		return _mm256_cvttps_epi32(_mm256_add_ps(v, _mm256_set1_ps(0.5f)));
+	}
+
+	// packs/packus trabajan por carril de 128 bits: la permutación final devuelve los grupos de 4 bytes a su sitio
+	SIMD_AVX2 void f32_to_u8(const float* a, float s, uint8_t* r, size_t n)
+	{
+		const __m256 vs = _mm256_set1_ps(s);
+		const __m256i fix = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+		size_t i = 0;
+		for (; i + 32 <= n; i += 32) {
+			const __m256i ab = _mm256_packs_epi32(_f32_to_i32_sat_u8(_mm256_loadu_ps(a + i), vs), _f32_to_i32_sat_u8(_mm256_loadu_ps(a + i + 8), vs));
+			const __m256i cd = _mm256_packs_epi32(_f32_to_i32_sat_u8(_mm256_loadu_ps(a + i + 16), vs), _f32_to_i32_sat_u8(_mm256_loadu_ps(a + i + 24), vs));
+			_mm256_storeu_si256((__m256i*)(r + i), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), fix));
+		}
+		tail_f32_to_u8(a, s, r, i, n);
+	}
+
+} // namespace
+
+namespace simd_internal {
+
+	const simd::kernels_t g_kernels_avx2 = {
+		simd::isa_t::AVX2, 8,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+} // namespace simd_internal
+
+#undef SIMD_AVX2
+
+#endif // SIMD_KERNELS_X86
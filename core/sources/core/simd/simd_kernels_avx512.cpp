@@ -0,0 +1,182 @@
+#include "simd_kernels.h"
+
+// AVX-512 F/DQ/BW/VL: 16 floats por registro, cola con máscaras __mmask16 (sin lecturas fuera de rango).
+
+#if defined(SIMD_KERNELS_X86)
+
+#include <immintrin.h>
+
+#define SIMD_AVX512 SIMD_TARGET("avx512f,avx512dq,avx512bw,avx512vl,fma")
+
+namespace {
+
+	using namespace simd_internal;
+
+	SIMD_AVX512 inline __mmask16 _tail_mask(size_t rem) { return (__mmask16)((1u << rem) - 1u); }
+
+#define SIMD_AVX512_BINARY(name, op)                                                   \
+	SIMD_AVX512 void name(const float* a, const float* b, float* r, size_t n)           \
+	{                                                                                  \
+		size_t i = 0;                                                                  \
+		for (; i + 32 <= n; i += 32) {                                                 \
+			__m512 a0 = _mm512_loadu_ps(a + i), a1 = _mm512_loadu_ps(a + i + 16);      \
+			__m512 b0 = _mm512_loadu_ps(b + i), b1 = _mm512_loadu_ps(b + i + 16);     \
+			_mm512_storeu_ps(r + i, op(a0, b0));                                       \
+			_mm512_storeu_ps(r + i + 16, op(a1, b1));                                  \
+		}                                                                              \
+		for (; i + 16 <= n; i += 16)                                                   \
+			_mm512_storeu_ps(r + i, op(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i))); \
+		if (i < n) {                                                                   \
+			const __mmask16 m = _tail_mask(n - i);                                     \
+			_mm512_mask_storeu_ps(r + i, m, op(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i))); \
+		}                                                                              \
+	}
+
+	SIMD_AVX512_BINARY(add_f32, _mm512_add_ps)
+	SIMD_AVX512_BINARY(sub_f32, _mm512_sub_ps)
+	SIMD_AVX512_BINARY(mul_f32, _mm512_mul_ps)
+	SIMD_AVX512_BINARY(min_f32, _mm512_min_ps)
+	SIMD_AVX512_BINARY(max_f32, _mm512_max_ps)
+
+#undef SIMD_AVX512_BINARY
+
+	SIMD_AVX512 void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(r + i, _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), _mm512_loadu_ps(c + i)));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm512_mask_storeu_ps(r + i, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), _mm512_maskz_loadu_ps(m, c + i)));
+		}
+	}
+
+	SIMD_AVX512 void scale_f32(const float* a, float s, float o, float* r, size_t n)
+	{
+		const __m512 vs = _mm512_set1_ps(s), vo = _mm512_set1_ps(o);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(r + i, _mm512_fmadd_ps(_mm512_loadu_ps(a + i), vs, vo));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm512_mask_storeu_ps(r + i, m, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), vs, vo));
+		}
+	}
+
+	SIMD_AVX512 float hadd_f32(const float* a, size_t n)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t i = 0;
+		for (; i + 32 <= n; i += 32) {
+			s0 = _mm512_add_ps(s0, _mm512_loadu_ps(a + i));
+			s1 = _mm512_add_ps(s1, _mm512_loadu_ps(a + i + 16));
+		}
+		if (i + 16 <= n) { s0 = _mm512_add_ps(s0, _mm512_loadu_ps(a + i)); i += 16; }
+		if (i < n) s1 = _mm512_add_ps(s1, _mm512_maskz_loadu_ps(_tail_mask(n - i), a + i));
+		return _mm512_reduce_add_ps(_mm512_add_ps(s0, s1));
+	}
+
+	SIMD_AVX512 float hmin_f32(const float* a, size_t n)
+	{
+		__m512 m = _mm512_set1_ps(kPosInf);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) m = _mm512_min_ps(m, _mm512_loadu_ps(a + i));
+		if (i < n) m = _mm512_mask_min_ps(m, _tail_mask(n - i), m, _mm512_maskz_loadu_ps(_tail_mask(n - i), a + i));
+		return _mm512_reduce_min_ps(m);
+	}
+
+	SIMD_AVX512 float hmax_f32(const float* a, size_t n)
+	{
+		__m512 m = _mm512_set1_ps(kNegInf);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) m = _mm512_max_ps(m, _mm512_loadu_ps(a + i));
+		if (i < n) m = _mm512_mask_max_ps(m, _tail_mask(n - i), m, _mm512_maskz_loadu_ps(_tail_mask(n - i), a + i));
+		return _mm512_reduce_max_ps(m);
+	}
+
+	SIMD_AVX512 float dot_f32(const float* a, const float* b, size_t n)
+	{
+		__m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+		size_t i = 0;
+		for (; i + 32 <= n; i += 32) {
+			s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), s0);
+			s1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), s1);
+		}
+		if (i + 16 <= n) { s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), s0); i += 16; }
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), s1);
+		}
+		return _mm512_reduce_add_ps(_mm512_add_ps(s0, s1));
+	}
+
+	SIMD_AVX512 void f32_to_f16(const float* a, uint16_t* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm256_storeu_si256((__m256i*)(r + i), _mm512_cvtps_ph(_mm512_loadu_ps(a + i), _MM_FROUND_TO_NEAREST_INT));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm256_mask_storeu_epi16(r + i, m, _mm512_cvtps_ph(_mm512_maskz_loadu_ps(m, a + i), _MM_FROUND_TO_NEAREST_INT));
+		}
+	}
+
+	SIMD_AVX512 void f16_to_f32(const uint16_t* a, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(r + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(a + i))));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm512_mask_storeu_ps(r + i, m, _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(m, a + i)));
+		}
+	}
+
+	SIMD_AVX512 void u8_to_f32(const uint8_t* a, float s, float* r, size_t n)
+	{
+		const __m512 vs = _mm512_set1_ps(s);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(r + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(a + i)))), vs));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm512_mask_storeu_ps(r + i, m, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(m, a + i))), vs));
+		}
+	}
+
+	// Ya saturado a [0, 255]: vpmovdb (truncado) basta
+	SIMD_AVX512 inline __m512i _f32_to_i32_sat_u8(__m512 v, __m512 s)
+	{
+		v = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(v, s), _mm512_setzero_ps()), _mm512_set1_ps(255.f));
+		return _mm512_cvttps_epi32(_mm512_add_ps(v, _mm512_set1_ps(0.5f)));
+	}
+
+	SIMD_AVX512 void f32_to_u8(const float* a, float s, uint8_t* r, size_t n)
+	{
+		const __m512 vs = _mm512_set1_ps(s);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm_storeu_si128((__m128i*)(r + i), _mm512_cvtepi32_epi8(_f32_to_i32_sat_u8(_mm512_loadu_ps(a + i), vs)));
+		if (i < n) {
+			const __mmask16 m = _tail_mask(n - i);
+			_mm512_mask_cvtepi32_storeu_epi8(r + i, m, _f32_to_i32_sat_u8(_mm512_maskz_loadu_ps(m, a + i), vs));
+		}
+	}
+
+} // namespace
+
+namespace simd_internal {
+
+	const simd::kernels_t g_kernels_avx512 = {
+		simd::isa_t::AVX512, 16,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+} // namespace simd_internal
+
+#undef SIMD_AVX512
+
+#endif // SIMD_KERNELS_X86
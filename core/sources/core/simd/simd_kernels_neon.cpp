@@ -0,0 +1,205 @@
+#include "simd_kernels.h"
+
+// NEON: 4 floats por registro. En AArch64 se usan las reducciones horizontales vaddvq/vminvq/vmaxvq.
+
+#if defined(SIMD_KERNELS_NEON)
+
+#include <arm_neon.h>
+
+namespace {
+
+	using namespace simd_internal;
+
+#define SIMD_NEON_BINARY(name, op, tail)                                        \
+	void name(const float* a, const float* b, float* r, size_t n)              \
+	{                                                                           \
+		size_t i = 0;                                                           \
+		for (; i + 8 <= n; i += 8) {                                            \
+			float32x4_t a0 = vld1q_f32(a + i), a1 = vld1q_f32(a + i + 4);       \
+			float32x4_t b0 = vld1q_f32(b + i), b1 = vld1q_f32(b + i + 4);       \
+			vst1q_f32(r + i, op(a0, b0));                                       \
+			vst1q_f32(r + i + 4, op(a1, b1));                                   \
+		}                                                                       \
+		for (; i + 4 <= n; i += 4)                                              \
+			vst1q_f32(r + i, op(vld1q_f32(a + i), vld1q_f32(b + i)));           \
+		tail(a, b, r, i, n);                                                    \
+	}
+
+	SIMD_NEON_BINARY(add_f32, vaddq_f32, tail_add)
+	SIMD_NEON_BINARY(sub_f32, vsubq_f32, tail_sub)
+	SIMD_NEON_BINARY(mul_f32, vmulq_f32, tail_mul)
+	SIMD_NEON_BINARY(min_f32, vminq_f32, tail_min)
+	SIMD_NEON_BINARY(max_f32, vmaxq_f32, tail_max)
+
+#undef SIMD_NEON_BINARY
+
+	inline float32x4_t _fma(float32x4_t a, float32x4_t b, float32x4_t c)
+	{
+#if defined(__aarch64__)
+		return vfmaq_f32(c, a, b);
+#else
+		return vmlaq_f32(c, a, b);
+#endif
+	}
+
+	inline float _hsum(float32x4_t v)
+	{
+#if defined(__aarch64__)
+		return vaddvq_f32(v);
+#else
+		float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+		return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+	}
+
+	void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			vst1q_f32(r + i, _fma(vld1q_f32(a + i), vld1q_f32(b + i), vld1q_f32(c + i)));
+		tail_fma(a, b, c, r, i, n);
+	}
+
+	void scale_f32(const float* a, float s, float o, float* r, size_t n)
+	{
+		const float32x4_t vs = vdupq_n_f32(s), vo = vdupq_n_f32(o);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			vst1q_f32(r + i, _fma(vld1q_f32(a + i), vs, vo));
+		tail_scale(a, s, o, r, i, n);
+	}
+
+	float hadd_f32(const float* a, size_t n)
+	{
+		float32x4_t s0 = vdupq_n_f32(0), s1 = vdupq_n_f32(0);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			s0 = vaddq_f32(s0, vld1q_f32(a + i));
+			s1 = vaddq_f32(s1, vld1q_f32(a + i + 4));
+		}
+		if (i + 4 <= n) { s0 = vaddq_f32(s0, vld1q_f32(a + i)); i += 4; }
+		float s = _hsum(vaddq_f32(s0, s1));
+		for (; i < n; ++i) s += a[i];
+		return s;
+	}
+
+	float hmin_f32(const float* a, size_t n)
+	{
+		float32x4_t m = vdupq_n_f32(kPosInf);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) m = vminq_f32(m, vld1q_f32(a + i));
+#if defined(__aarch64__)
+		float r = vminvq_f32(m);
+#else
+		float32x2_t h = vmin_f32(vget_low_f32(m), vget_high_f32(m));
+		float r = vget_lane_f32(vpmin_f32(h, h), 0);
+#endif
+		for (; i < n; ++i) r = a[i] < r ? a[i] : r;
+		return r;
+	}
+
+	float hmax_f32(const float* a, size_t n)
+	{
+		float32x4_t m = vdupq_n_f32(kNegInf);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) m = vmaxq_f32(m, vld1q_f32(a + i));
+#if defined(__aarch64__)
+		float r = vmaxvq_f32(m);
+#else
+		float32x2_t h = vmax_f32(vget_low_f32(m), vget_high_f32(m));
+		float r = vget_lane_f32(vpmax_f32(h, h), 0);
+#endif
+		for (; i < n; ++i) r = a[i] > r ? a[i] : r;
+		return r;
+	}
+
+	float dot_f32(const float* a, const float* b, size_t n)
+	{
+		float32x4_t s0 = vdupq_n_f32(0), s1 = vdupq_n_f32(0);
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			s0 = _fma(vld1q_f32(a + i), vld1q_f32(b + i), s0);
+			s1 = _fma(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4), s1);
+		}
+		if (i + 4 <= n) { s0 = _fma(vld1q_f32(a + i), vld1q_f32(b + i), s0); i += 4; }
+		float s = _hsum(vaddq_f32(s0, s1));
+		for (; i < n; ++i) s += a[i] * b[i];
+		return s;
+	}
+
+	// FCVTN/FCVTL: ARMv8 base en AArch64; ARMv7 sólo con la extensión fp16, si no queda la versión escalar
+	void f32_to_f16(const float* a, uint16_t* r, size_t n)
+	{
+		size_t i = 0;
+#if defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2))
+		for (; i + 8 <= n; i += 8) {
+			const float16x4_t lo = vcvt_f16_f32(vld1q_f32(a + i));
+			const float16x4_t hi = vcvt_f16_f32(vld1q_f32(a + i + 4));
+			vst1q_u16(r + i, vreinterpretq_u16_f16(vcombine_f16(lo, hi)));
+		}
+#endif
+		tail_f32_to_f16(a, r, i, n);
+	}
+
+	void f16_to_f32(const uint16_t* a, float* r, size_t n)
+	{
+		size_t i = 0;
+#if defined(__aarch64__) || (defined(__ARM_FP) && (__ARM_FP & 2))
+		for (; i + 8 <= n; i += 8) {
+			const float16x8_t h = vreinterpretq_f16_u16(vld1q_u16(a + i));
+			vst1q_f32(r + i, vcvt_f32_f16(vget_low_f16(h)));
+			vst1q_f32(r + i + 4, vcvt_f32_f16(vget_high_f16(h)));
+		}
+#endif
+		tail_f16_to_f32(a, r, i, n);
+	}
+
+	void u8_to_f32(const uint8_t* a, float s, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const uint8x16_t b = vld1q_u8(a + i);
+			const uint16x8_t lo = vmovl_u8(vget_low_u8(b)), hi = vmovl_u8(vget_high_u8(b));
+			vst1q_f32(r + i, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), s));
+			vst1q_f32(r + i + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), s));
+			vst1q_f32(r + i + 8, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), s));
+			vst1q_f32(r + i + 12, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), s));
+		}
+		tail_u8_to_f32(a, s, r, i, n);
+	}
+
+	// vmaxq_f32 propaga NaN: la comparación v > 0 (falsa con NaN) elige el 0
+	inline uint16x4_t _f32_to_u16_sat_u8(float32x4_t v, float s)
+	{
+		const float32x4_t z = vdupq_n_f32(0.f);
+		v = vmulq_n_f32(v, s);
+		v = vminq_f32(vbslq_f32(vcgtq_f32(v, z), v, z), vdupq_n_f32(255.f));
+		return vmovn_u32(vcvtq_u32_f32(vaddq_f32(v, vdupq_n_f32(0.5f))));
+	}
+
+	void f32_to_u8(const float* a, float s, uint8_t* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const uint16x8_t lo = vcombine_u16(_f32_to_u16_sat_u8(vld1q_f32(a + i), s), _f32_to_u16_sat_u8(vld1q_f32(a + i + 4), s));
+			const uint16x8_t hi = vcombine_u16(_f32_to_u16_sat_u8(vld1q_f32(a + i + 8), s), _f32_to_u16_sat_u8(vld1q_f32(a + i + 12), s));
+			vst1q_u8(r + i, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+		}
+		tail_f32_to_u8(a, s, r, i, n);
+	}
+
+} // namespace
+
+namespace simd_internal {
+
+	const simd::kernels_t g_kernels_neon = {
+		simd::isa_t::NEON, 4,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+} // namespace simd_internal
+
+#endif // SIMD_KERNELS_NEON
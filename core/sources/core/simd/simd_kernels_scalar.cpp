@@ -0,0 +1,67 @@
+#include "simd_kernels.h"
+
+// Referencia escalar: siempre disponible y usada como último recurso.
+
+namespace {
+
+	using namespace simd_internal;
+
+	void add_f32(const float* a, const float* b, float* r, size_t n) { tail_add(a, b, r, 0, n); }
+	void sub_f32(const float* a, const float* b, float* r, size_t n) { tail_sub(a, b, r, 0, n); }
+	void mul_f32(const float* a, const float* b, float* r, size_t n) { tail_mul(a, b, r, 0, n); }
+	void min_f32(const float* a, const float* b, float* r, size_t n) { tail_min(a, b, r, 0, n); }
+	void max_f32(const float* a, const float* b, float* r, size_t n) { tail_max(a, b, r, 0, n); }
+	void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n) { tail_fma(a, b, c, r, 0, n); }
+	void scale_f32(const float* a, float s, float o, float* r, size_t n) { tail_scale(a, s, o, r, 0, n); }
+
+	// 4 acumuladores: rompe la cadena de dependencias y da el mismo orden de suma que SSE
+	float hadd_f32(const float* a, size_t n)
+	{
+		float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) { s0 += a[i]; s1 += a[i + 1]; s2 += a[i + 2]; s3 += a[i + 3]; }
+		for (; i < n; ++i) s0 += a[i];
+		return (s0 + s1) + (s2 + s3);
+	}
+
+	float hmin_f32(const float* a, size_t n)
+	{
+		float m = kPosInf;
+		for (size_t i = 0; i < n; ++i) m = a[i] < m ? a[i] : m;
+		return m;
+	}
+
+	float hmax_f32(const float* a, size_t n)
+	{
+		float m = kNegInf;
+		for (size_t i = 0; i < n; ++i) m = a[i] > m ? a[i] : m;
+		return m;
+	}
+
+	float dot_f32(const float* a, const float* b, size_t n)
+	{
+		float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) { s0 += a[i] * b[i]; s1 += a[i + 1] * b[i + 1]; s2 += a[i + 2] * b[i + 2]; s3 += a[i + 3] * b[i + 3]; }
+		for (; i < n; ++i) s0 += a[i] * b[i];
+		return (s0 + s1) + (s2 + s3);
+	}
+
+	void f32_to_f16(const float* a, uint16_t* r, size_t n) { tail_f32_to_f16(a, r, 0, n); }
+	void f16_to_f32(const uint16_t* a, float* r, size_t n) { tail_f16_to_f32(a, r, 0, n); }
+	void u8_to_f32(const uint8_t* a, float s, float* r, size_t n) { tail_u8_to_f32(a, s, r, 0, n); }
+	void f32_to_u8(const float* a, float s, uint8_t* r, size_t n) { tail_f32_to_u8(a, s, r, 0, n); }
+
+} // namespace
+
+namespace simd_internal {
+
+	const simd::kernels_t g_kernels_scalar = {
+		simd::isa_t::SCALAR, 1,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+} // namespace simd_internal
@@ -0,0 +1,333 @@
+#include "simd_kernels.h"
+
+// SSE2 (línea base x86-64) y SSE4.1.
+// SSE4.1 no aporta nada a los kernels aritméticos ni a f32_to_u8 (_mm_round_ps redondea al par y la conversión
+// redondea hacia arriba), así que su tabla reutiliza esos punteros. Sí tiene conversiones propias: u8_to_f32 extiende
+// con pmovzxbd desde memoria en vez de desempaquetar, y las de half eligen con pblendvb en vez de and/andnot/or.
+
+#if defined(SIMD_KERNELS_X86)
+
+#include <smmintrin.h>
+
+#include <cstring>
+
+#define SIMD_SSE41 SIMD_TARGET("sse4.1")
+
+namespace {
+
+	using namespace simd_internal;
+
+#define SIMD_SSE2_BINARY(name, op, tail)                                        \
+	SIMD_TARGET("sse2") void name(const float* a, const float* b, float* r, size_t n) \
+	{                                                                           \
+		size_t i = 0;                                                           \
+		for (; i + 8 <= n; i += 8) {                                            \
+			__m128 a0 = _mm_loadu_ps(a + i), a1 = _mm_loadu_ps(a + i + 4);     \
+			__m128 b0 = _mm_loadu_ps(b + i), b1 = _mm_loadu_ps(b + i + 4);     \
+			_mm_storeu_ps(r + i, op(a0, b0));                                   \
+			_mm_storeu_ps(r + i + 4, op(a1, b1));                               \
+		}                                                                       \
+		for (; i + 4 <= n; i += 4)                                              \
+			_mm_storeu_ps(r + i, op(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))); \
+		tail(a, b, r, i, n);                                                    \
+	}
+
+	SIMD_SSE2_BINARY(add_f32, _mm_add_ps, tail_add)
+	SIMD_SSE2_BINARY(sub_f32, _mm_sub_ps, tail_sub)
+	SIMD_SSE2_BINARY(mul_f32, _mm_mul_ps, tail_mul)
+	SIMD_SSE2_BINARY(min_f32, _mm_min_ps, tail_min)
+	SIMD_SSE2_BINARY(max_f32, _mm_max_ps, tail_max)
+
+#undef SIMD_SSE2_BINARY
+
+	SIMD_TARGET("sse2") void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(r + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), _mm_loadu_ps(c + i)));
+		tail_fma(a, b, c, r, i, n);
+	}
+
+	SIMD_TARGET("sse2") void scale_f32(const float* a, float s, float o, float* r, size_t n)
+	{
+		const __m128 vs = _mm_set1_ps(s), vo = _mm_set1_ps(o);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(r + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), vs), vo));
+		tail_scale(a, s, o, r, i, n);
+	}
+
+	SIMD_TARGET("sse2") inline float _hsum(__m128 v)
+	{
+		__m128 sh = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 s = _mm_add_ps(v, sh);
+		sh = _mm_movehl_ps(sh, s);
+		return _mm_cvtss_f32(_mm_add_ss(s, sh));
+	}
+
+	SIMD_TARGET("sse2") float hadd_f32(const float* a, size_t n)
+	{
+		__m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			s0 = _mm_add_ps(s0, _mm_loadu_ps(a + i));
+			s1 = _mm_add_ps(s1, _mm_loadu_ps(a + i + 4));
+		}
+		if (i + 4 <= n) { s0 = _mm_add_ps(s0, _mm_loadu_ps(a + i)); i += 4; }
+		float s = _hsum(_mm_add_ps(s0, s1));
+		for (; i < n; ++i) s += a[i];
+		return s;
+	}
+
+	SIMD_TARGET("sse2") float hmin_f32(const float* a, size_t n)
+	{
+		__m128 m = _mm_set1_ps(kPosInf);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) m = _mm_min_ps(m, _mm_loadu_ps(a + i));
+		m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+		m = _mm_min_ps(m, _mm_movehl_ps(m, m));
+		float r = _mm_cvtss_f32(m);
+		for (; i < n; ++i) r = a[i] < r ? a[i] : r;
+		return r;
+	}
+
+	SIMD_TARGET("sse2") float hmax_f32(const float* a, size_t n)
+	{
+		__m128 m = _mm_set1_ps(kNegInf);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) m = _mm_max_ps(m, _mm_loadu_ps(a + i));
+		m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+		m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+		float r = _mm_cvtss_f32(m);
+		for (; i < n; ++i) r = a[i] > r ? a[i] : r;
+		return r;
+	}
+
+	SIMD_TARGET("sse2") float dot_f32(const float* a, const float* b, size_t n)
+	{
+		__m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+		}
+		if (i + 4 <= n) { s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))); i += 4; }
+		float s = _hsum(_mm_add_ps(s0, s1));
+		for (; i < n; ++i) s += a[i] * b[i];
+		return s;
+	}
+
+	// float -> half con enteros SSE2 (sin F16C), mismos bits que F16C en el modo de redondeo por defecto:
+	//  - normal: re-sesgo del exponente + 0xFFF + bit impar (redondeo al par)
+	//  - subnormal: suma del número mágico 2^-1 · 2^(127-14) deja la mantisa half redondeada en los bits bajos
+	//  - >= 65520: inf; NaN: silenciado con la parte alta de la carga útil
+	SIMD_TARGET("sse2") inline __m128i _f32_to_f16x4(__m128 f)
+	{
+		const __m128i x = _mm_and_si128(_mm_castps_si128(f), _mm_set1_epi32(0x7FFFFFFF));
+		const __m128i sign = _mm_srai_epi32(_mm_and_si128(_mm_castps_si128(f), _mm_set1_epi32(int(0x80000000u))), 16);
+
+		const __m128i magic = _mm_set1_epi32((127 - 15 + 23 - 10 + 1) << 23);
+		const __m128i sub = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(magic))), magic);
+
+		const __m128i odd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+		const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), odd), 13);
+
+		const __m128i is_sub = _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000));
+		const __m128i finite = _mm_or_si128(_mm_and_si128(is_sub, sub), _mm_andnot_si128(is_sub, normal));
+
+		const __m128i is_nan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x7F800000));
+		const __m128i nan = _mm_and_si128(is_nan, _mm_or_si128(_mm_set1_epi32(0x200), _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(0x3FF))));
+		const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), nan);
+
+		const __m128i is_big = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477FEFFF));
+		return _mm_or_si128(_mm_or_si128(_mm_and_si128(is_big, special), _mm_andnot_si128(is_big, finite)), sign);
+	}
+
+	// half -> float: normales y especiales por bits; subnormales como em · 2^-24 (exacto, sin depender de DAZ)
+	SIMD_TARGET("sse2") inline __m128 _f16x4_to_f32(__m128i h)
+	{
+		const __m128i em = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+		const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, em), 16);
+
+		const __m128i normal = _mm_add_epi32(_mm_slli_epi32(em, 13), _mm_set1_epi32((127 - 15) << 23));
+		const __m128i sub = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(em), _mm_set1_ps(5.9604644775390625e-8f)));
+
+		const __m128i is_special = _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7BFF));
+		const __m128i is_nan = _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7C00));
+		const __m128i special = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0x7F800000), _mm_slli_epi32(_mm_and_si128(em, _mm_set1_epi32(0x3FF)), 13)),
+		                                     _mm_and_si128(is_nan, _mm_set1_epi32(0x400000)));
+
+		const __m128i is_sub = _mm_cmplt_epi32(em, _mm_set1_epi32(0x400));
+		__m128i r = _mm_or_si128(_mm_and_si128(is_sub, sub), _mm_andnot_si128(is_sub, normal));
+		r = _mm_or_si128(_mm_and_si128(is_special, special), _mm_andnot_si128(is_special, r));
+		return _mm_castsi128_ps(_mm_or_si128(r, sign));
+	}
+
+	// _mm_packs_epi32 satura con signo: los valores con bit de signo ya vienen extendidos (0xFFFF8xxx) y caben
+	SIMD_TARGET("sse2") void f32_to_f16(const float* a, uint16_t* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128i lo = _f32_to_f16x4(_mm_loadu_ps(a + i));
+			const __m128i hi = _f32_to_f16x4(_mm_loadu_ps(a + i + 4));
+			_mm_storeu_si128((__m128i*)(r + i), _mm_packs_epi32(lo, hi));
+		}
+		tail_f32_to_f16(a, r, i, n);
+	}
+
+	SIMD_TARGET("sse2") void f16_to_f32(const uint16_t* a, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128i h = _mm_loadu_si128((const __m128i*)(a + i));
+			_mm_storeu_ps(r + i, _f16x4_to_f32(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+			_mm_storeu_ps(r + i + 4, _f16x4_to_f32(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+		}
+		tail_f16_to_f32(a, r, i, n);
+	}
+
+	SIMD_TARGET("sse2") void u8_to_f32(const uint8_t* a, float s, float* r, size_t n)
+	{
+		const __m128 vs = _mm_set1_ps(s);
+		const __m128i z = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const __m128i b = _mm_loadu_si128((const __m128i*)(a + i));
+			const __m128i lo = _mm_unpacklo_epi8(b, z), hi = _mm_unpackhi_epi8(b, z);
+			_mm_storeu_ps(r + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, z)), vs));
+			_mm_storeu_ps(r + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, z)), vs));
+			_mm_storeu_ps(r + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, z)), vs));
+			_mm_storeu_ps(r + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, z)), vs));
+		}
+		tail_u8_to_f32(a, s, r, i, n);
+	}
+
+	// maxps devuelve el segundo operando si hay NaN: max(v, 0) deja los NaN a 0
+	SIMD_TARGET("sse2") inline __m128i _f32_to_i32_sat_u8(__m128 v, __m128 s)
+	{
+		v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, s), _mm_setzero_ps()), _mm_set1_ps(255.f));
+		return _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f)));
+	}
+
+	SIMD_TARGET("sse2") void f32_to_u8(const float* a, float s, uint8_t* r, size_t n)
+	{
+		const __m128 vs = _mm_set1_ps(s);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const __m128i lo = _mm_packs_epi32(_f32_to_i32_sat_u8(_mm_loadu_ps(a + i), vs), _f32_to_i32_sat_u8(_mm_loadu_ps(a + i + 4), vs));
+			const __m128i hi = _mm_packs_epi32(_f32_to_i32_sat_u8(_mm_loadu_ps(a + i + 8), vs), _f32_to_i32_sat_u8(_mm_loadu_ps(a + i + 12), vs));
+			_mm_storeu_si128((__m128i*)(r + i), _mm_packus_epi16(lo, hi));
+		}
+		tail_f32_to_u8(a, s, r, i, n);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// SSE4.1: mismos resultados bit a bit que las versiones SSE2
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SIMD_SSE41 inline __m128i _f32_to_f16x4_sse41(__m128 f)
+	{
+		const __m128i x = _mm_and_si128(_mm_castps_si128(f), _mm_set1_epi32(0x7FFFFFFF));
+		const __m128i sign = _mm_srai_epi32(_mm_and_si128(_mm_castps_si128(f), _mm_set1_epi32(int(0x80000000u))), 16);
+
+		const __m128i magic = _mm_set1_epi32((127 - 15 + 23 - 10 + 1) << 23);
+		const __m128i sub = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(magic))), magic);
+
+		const __m128i odd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+		const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), odd), 13);
+		const __m128i finite = _mm_blendv_epi8(normal, sub, _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000)));
+
+		const __m128i is_nan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x7F800000));
+		const __m128i nan = _mm_and_si128(is_nan, _mm_or_si128(_mm_set1_epi32(0x200), _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(0x3FF))));
+		const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), nan);
+
+		return _mm_or_si128(_mm_blendv_epi8(finite, special, _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477FEFFF))), sign);
+	}
+
+	SIMD_SSE41 inline __m128 _f16x4_to_f32_sse41(__m128i h)
+	{
+		const __m128i em = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+		const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, em), 16);
+
+		const __m128i normal = _mm_add_epi32(_mm_slli_epi32(em, 13), _mm_set1_epi32((127 - 15) << 23));
+		const __m128i sub = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(em), _mm_set1_ps(5.9604644775390625e-8f)));
+
+		const __m128i is_nan = _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7C00));
+		const __m128i special = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0x7F800000), _mm_slli_epi32(_mm_and_si128(em, _mm_set1_epi32(0x3FF)), 13)),
+		                                     _mm_and_si128(is_nan, _mm_set1_epi32(0x400000)));
+
+		__m128i r = _mm_blendv_epi8(normal, sub, _mm_cmplt_epi32(em, _mm_set1_epi32(0x400)));
+		r = _mm_blendv_epi8(r, special, _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7BFF)));
+		return _mm_castsi128_ps(_mm_or_si128(r, sign));
+	}
+
+	SIMD_SSE41 void f32_to_f16_sse41(const float* a, uint16_t* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128i lo = _f32_to_f16x4_sse41(_mm_loadu_ps(a + i));
+			const __m128i hi = _f32_to_f16x4_sse41(_mm_loadu_ps(a + i + 4));
+			_mm_storeu_si128((__m128i*)(r + i), _mm_packs_epi32(lo, hi));
+		}
+		tail_f32_to_f16(a, r, i, n);
+	}
+
+	SIMD_SSE41 void f16_to_f32_sse41(const uint16_t* a, float* r, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			const __m128i h = _mm_loadu_si128((const __m128i*)(a + i));
+			_mm_storeu_ps(r + i, _f16x4_to_f32_sse41(_mm_cvtepu16_epi32(h)));
+			_mm_storeu_ps(r + i + 4, _f16x4_to_f32_sse41(_mm_cvtepu16_epi32(_mm_srli_si128(h, 8))));
+		}
+		tail_f16_to_f32(a, r, i, n);
+	}
+
+	// 4 bytes -> 4 int32; el compilador junta la carga y pmovzxbd en una sola instrucción
+	SIMD_SSE41 inline __m128i _u8x4_to_i32(const uint8_t* p)
+	{
+		int32_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(v));
+	}
+
+	SIMD_SSE41 void u8_to_f32_sse41(const uint8_t* a, float s, float* r, size_t n)
+	{
+		const __m128 vs = _mm_set1_ps(s);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			_mm_storeu_ps(r + i, _mm_mul_ps(_mm_cvtepi32_ps(_u8x4_to_i32(a + i)), vs));
+			_mm_storeu_ps(r + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_u8x4_to_i32(a + i + 4)), vs));
+			_mm_storeu_ps(r + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_u8x4_to_i32(a + i + 8)), vs));
+			_mm_storeu_ps(r + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_u8x4_to_i32(a + i + 12)), vs));
+		}
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(r + i, _mm_mul_ps(_mm_cvtepi32_ps(_u8x4_to_i32(a + i)), vs));
+		tail_u8_to_f32(a, s, r, i, n);
+	}
+
+} // namespace
+
+namespace simd_internal {
+
+	const simd::kernels_t g_kernels_sse2 = {
+		simd::isa_t::SSE2, 4,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+	const simd::kernels_t g_kernels_sse41 = {
+		simd::isa_t::SSE41, 4,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16_sse41, f16_to_f32_sse41,
+		u8_to_f32_sse41, f32_to_u8
+	};
+
+} // namespace simd_internal
+
+#undef SIMD_SSE41
+
+#endif // SIMD_KERNELS_X86
@@ -0,0 +1,195 @@
+#include "simd_kernels.h"
+
+// SVE: ancho de vector desconocido al compilar (128-2048 bits, 256 en Neoverse V1). Los bucles avanzan svcntw()
+// floats por iteración con predicado todo-verdadero y la cola es una única iteración predicada (svwhilelt), sin
+// bucle escalar. Las reducciones acumulan con merge (_m) para que los lanes inactivos de la cola no cuenten.
+
+#if defined(SIMD_KERNELS_SVE)
+
+#if !defined(__ARM_FEATURE_SVE)
+#	pragma GCC target("+sve")
+#endif
+
+#include <arm_sve.h>
+
+#include <cstdint>
+
+namespace {
+
+	using namespace simd_internal;
+
+	inline svbool_t _tail(size_t i, size_t n) { return svwhilelt_b32_u64((uint64_t)i, (uint64_t)n); }
+
+#define SIMD_SVE_BINARY(name, op)                                               \
+	void name(const float* a, const float* b, float* r, size_t n)              \
+	{                                                                           \
+		const size_t vl = svcntw();                                             \
+		const svbool_t all = svptrue_b32();                                     \
+		size_t i = 0;                                                           \
+		for (; i + vl <= n; i += vl)                                            \
+			svst1_f32(all, r + i, op(all, svld1_f32(all, a + i), svld1_f32(all, b + i))); \
+		if (i < n) {                                                            \
+			const svbool_t pg = _tail(i, n);                                    \
+			svst1_f32(pg, r + i, op(pg, svld1_f32(pg, a + i), svld1_f32(pg, b + i))); \
+		}                                                                       \
+	}
+
+	SIMD_SVE_BINARY(add_f32, svadd_f32_x)
+	SIMD_SVE_BINARY(sub_f32, svsub_f32_x)
+	SIMD_SVE_BINARY(mul_f32, svmul_f32_x)
+	SIMD_SVE_BINARY(min_f32, svmin_f32_x)
+	SIMD_SVE_BINARY(max_f32, svmax_f32_x)
+
+#undef SIMD_SVE_BINARY
+
+	void fma_f32(const float* a, const float* b, const float* c, float* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		size_t i = 0;
+		for (; i + vl <= n; i += vl)
+			svst1_f32(all, r + i, svmla_f32_x(all, svld1_f32(all, c + i), svld1_f32(all, a + i), svld1_f32(all, b + i)));
+		if (i < n) {
+			const svbool_t pg = _tail(i, n);
+			svst1_f32(pg, r + i, svmla_f32_x(pg, svld1_f32(pg, c + i), svld1_f32(pg, a + i), svld1_f32(pg, b + i)));
+		}
+	}
+
+	void scale_f32(const float* a, float s, float o, float* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		const svfloat32_t vs = svdup_n_f32(s), vo = svdup_n_f32(o);
+		size_t i = 0;
+		for (; i + vl <= n; i += vl)
+			svst1_f32(all, r + i, svmla_f32_x(all, vo, svld1_f32(all, a + i), vs));
+		if (i < n) {
+			const svbool_t pg = _tail(i, n);
+			svst1_f32(pg, r + i, svmla_f32_x(pg, vo, svld1_f32(pg, a + i), vs));
+		}
+	}
+
+	float hadd_f32(const float* a, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		svfloat32_t s0 = svdup_n_f32(0), s1 = svdup_n_f32(0);
+		size_t i = 0;
+		for (; i + 2 * vl <= n; i += 2 * vl) {
+			s0 = svadd_f32_x(all, s0, svld1_f32(all, a + i));
+			s1 = svadd_f32_x(all, s1, svld1_f32(all, a + i + vl));
+		}
+		for (; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			s0 = svadd_f32_m(pg, s0, svld1_f32(pg, a + i));
+		}
+		return svaddv_f32(all, svadd_f32_x(all, s0, s1));
+	}
+
+	float hmin_f32(const float* a, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		svfloat32_t m = svdup_n_f32(kPosInf);
+		size_t i = 0;
+		for (; i + vl <= n; i += vl) m = svmin_f32_x(all, m, svld1_f32(all, a + i));
+		if (i < n) {
+			const svbool_t pg = _tail(i, n);
+			m = svmin_f32_m(pg, m, svld1_f32(pg, a + i));
+		}
+		return svminv_f32(all, m);
+	}
+
+	float hmax_f32(const float* a, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		svfloat32_t m = svdup_n_f32(kNegInf);
+		size_t i = 0;
+		for (; i + vl <= n; i += vl) m = svmax_f32_x(all, m, svld1_f32(all, a + i));
+		if (i < n) {
+			const svbool_t pg = _tail(i, n);
+			m = svmax_f32_m(pg, m, svld1_f32(pg, a + i));
+		}
+		return svmaxv_f32(all, m);
+	}
+
+	float dot_f32(const float* a, const float* b, size_t n)
+	{
+		const size_t vl = svcntw();
+		const svbool_t all = svptrue_b32();
+		svfloat32_t s0 = svdup_n_f32(0), s1 = svdup_n_f32(0);
+		size_t i = 0;
+		for (; i + 2 * vl <= n; i += 2 * vl) {
+			s0 = svmla_f32_x(all, s0, svld1_f32(all, a + i), svld1_f32(all, b + i));
+			s1 = svmla_f32_x(all, s1, svld1_f32(all, a + i + vl), svld1_f32(all, b + i + vl));
+		}
+		for (; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			s0 = svmla_f32_m(pg, s0, svld1_f32(pg, a + i), svld1_f32(pg, b + i));
+		}
+		return svaddv_f32(all, svadd_f32_x(all, s0, s1));
+	}
+
+	// svcvt deja cada half en la mitad baja de su contenedor de 32 bits; st1h/ld1uh comprimen/expanden a 16 bits
+	void f32_to_f16(const float* a, uint16_t* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		for (size_t i = 0; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			svst1h_u32(pg, r + i, svreinterpret_u32_f16(svcvt_f16_f32_x(pg, svld1_f32(pg, a + i))));
+		}
+	}
+
+	void f16_to_f32(const uint16_t* a, float* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		for (size_t i = 0; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			svst1_f32(pg, r + i, svcvt_f32_f16_x(pg, svreinterpret_f16_u32(svld1uh_u32(pg, a + i))));
+		}
+	}
+
+	// ld1b/st1b ensanchan/estrechan byte <-> 32 bits en la propia carga/almacenamiento
+	void u8_to_f32(const uint8_t* a, float s, float* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		for (size_t i = 0; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			svst1_f32(pg, r + i, svmul_n_f32_x(pg, svcvt_f32_u32_x(pg, svld1ub_u32(pg, a + i)), s));
+		}
+	}
+
+	// maxnm devuelve el número si el otro operando es NaN: NaN -> 0
+	void f32_to_u8(const float* a, float s, uint8_t* r, size_t n)
+	{
+		const size_t vl = svcntw();
+		for (size_t i = 0; i < n; i += vl) {
+			const svbool_t pg = _tail(i, n);
+			svfloat32_t v = svmul_n_f32_x(pg, svld1_f32(pg, a + i), s);
+			v = svmin_n_f32_x(pg, svmaxnm_n_f32_x(pg, v, 0.f), 255.f);
+			svst1b_u32(pg, r + i, svcvt_u32_f32_x(pg, svadd_n_f32_x(pg, v, 0.5f)));
+		}
+	}
+
+} // namespace
+
+namespace simd_internal {
+
+	// float_lanes = 0: la anchura depende de la CPU (simd::lanes_f32)
+	const simd::kernels_t g_kernels_sve = {
+		simd::isa_t::SVE, 0,
+		add_f32, sub_f32, mul_f32, min_f32, max_f32, fma_f32, scale_f32,
+		hadd_f32, hmin_f32, hmax_f32, dot_f32,
+		f32_to_f16, f16_to_f32,
+		u8_to_f32, f32_to_u8
+	};
+
+	int sve_float_lanes() noexcept
+	{
+		return (int)svcntw();
+	}
+
+} // namespace simd_internal
+
+#endif // SIMD_KERNELS_SVE
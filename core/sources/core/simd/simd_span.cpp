@@ -0,0 +1,46 @@
+#include <simd/simd_span_ops.h>
+
+// Las funciones con nombre de simd_span_ops.h son inline y sólo se compilan donde se usan: esta tabla las instancia
+// todas con el ancho nativo de la compilación, de modo que un pack sin alguna operación rompe la compilación de la
+// biblioteca y no la del primer usuario.
+
+namespace {
+
+	template<typename T>
+	using span_unary_t = void (*)(std::span<const T>, std::span<T>, simd::exec_t);
+
+	template<typename T>
+	using span_binary_t = void (*)(std::span<const T>, std::span<const T>, std::span<T>, simd::exec_t);
+
+	template<typename T>
+	struct span_ops_t
+	{
+		span_binary_t<T>	binary[4];
+		span_unary_t<T>		unary[10];
+	};
+
+	template<typename T>
+	constexpr span_ops_t<T> kSpanOps = {
+		{ &simd::add, &simd::sub, &simd::mul, &simd::div },
+		{ &simd::exp, &simd::exp2, &simd::log, &simd::log2, &simd::sqrt, &simd::sin, &simd::cos, &simd::atan,
+		  &simd::sigmoid, &simd::softplus },
+	};
+
+	[[maybe_unused]] constexpr const span_ops_t<float>* kSpanOpsFloat = &kSpanOps<float>;
+	[[maybe_unused]] constexpr const span_ops_t<double>* kSpanOpsDouble = &kSpanOps<double>;
+
+	// Operadores del pack nativo (simd_reg_ops.h); con -mavx512f tienen que ser los de 16 floats / 8 doubles
+	template<typename T>
+	concept pack_arithmetic = requires(simd_pack_t<simd::native_lanes_v<T>, T> a, T s) {
+		a + a; a - a; a * a; a / a; -a; a * s; s - a; simd::min(a, a); simd::max(a, a);
+	};
+
+	static_assert(simd::native_lanes_v<float> == 1 || pack_arithmetic<float>, "faltan operadores del pack nativo de float");
+	static_assert(simd::native_lanes_v<double> == 1 || pack_arithmetic<double>, "faltan operadores del pack nativo de double");
+#if defined(__AVX512F__)
+	static_assert(simd::native_lanes_v<float> == 16 && simd::native_lanes_v<double> == 8, "AVX-512F sin packs de 512 bits");
+	static_assert(requires(simd_pack_t<16, int> a) { a + a; a - a; a * a; simd::min(a, a); simd::max(a, a); },
+				  "faltan operadores de los packs de 16 enteros");
+#endif
+
+} // namespace
@@ -0,0 +1,393 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/threading.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#if (OS & OS_WINDOWS)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif (OS & OS_APPLE)
+#	include <sys/sysctl.h>
+#elif (OS & OS_LINUX)
+#	include <sched.h>
+#	include <cstdio>
+#endif
+
+namespace {
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Topología
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Núcleos físicos que el proceso puede usar; las hebras SMT de un núcleo comparten sus unidades SIMD
+	size_t physical_core_count()
+	{
+		const size_t logical = std::max<size_t>(1, std::thread::hardware_concurrency());
+#if (OS & OS_WINDOWS)
+		DWORD bytes = 0;
+		GetLogicalProcessorInformation(nullptr, &bytes);
+		std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(bytes / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+		if (info.empty() || !GetLogicalProcessorInformation(info.data(), &bytes))
+			return logical;
+		DWORD_PTR process_mask = 0, system_mask = 0;
+		GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask);
+		size_t cores = 0;
+		for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& i : info)
+			if (i.Relationship == RelationProcessorCore && (!process_mask || (i.ProcessorMask & process_mask)))
+				++cores;
+		return std::max<size_t>(1, cores);
+#elif (OS & OS_APPLE)
+		int cores = 0;
+		size_t size = sizeof(cores);
+		if (sysctlbyname("hw.physicalcpu", &cores, &size, nullptr, 0) || cores <= 0)
+			return logical;
+		return size_t(cores);
+#elif (OS & OS_LINUX)
+		cpu_set_t set;
+		if (sched_getaffinity(0, sizeof(set), &set))
+			return logical;
+		auto read_id = [](int cpu, const char* name) -> long {
+			char path[128];
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+			long id = -1;
+			if (FILE* f = std::fopen(path, "r")) {
+				if (std::fscanf(f, "%ld", &id) != 1)
+					id = -1;
+				std::fclose(f);
+			}
+			return id;
+		};
+		// (paquete, núcleo) distintos; sin sysfs cada CPU cuenta como un núcleo
+		std::vector<uint64_t> cores;
+		for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+			if (!CPU_ISSET(cpu, &set))
+				continue;
+			const long package = read_id(cpu, "physical_package_id"), core = read_id(cpu, "core_id");
+			cores.push_back(package < 0 || core < 0 ? (1ull << 63) | uint64_t(cpu) : uint64_t(package) << 32 | uint64_t(core));
+		}
+		std::sort(cores.begin(), cores.end());
+		const size_t count = size_t(std::unique(cores.begin(), cores.end()) - cores.begin());
+		return std::max<size_t>(1, count);
+#else
+		return logical;
+#endif
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Cola Chase-Lev de capacidad fija
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	constexpr int64_t kDequeCapacity = 4096;
+	constexpr uint32_t kIdleSpins = 4096;
+
+	// Campos atómicos: un ladrón puede leer la casilla mientras el propietario escribe otra vuelta del anillo, y en ese
+	// caso su CAS sobre top falla y descarta lo leído
+	struct job_slot_t {
+		std::atomic<job_function_t>	function;
+		std::atomic<void*>			data;
+		std::atomic<size_t>			begin;
+		std::atomic<size_t>			end;
+		std::atomic<job_counter_t*>	counter;
+
+		void store(const job_t& job)
+		{
+			function.store(job.function, std::memory_order_relaxed);
+			data.store(job.data, std::memory_order_relaxed);
+			begin.store(job.begin, std::memory_order_relaxed);
+			end.store(job.end, std::memory_order_relaxed);
+			counter.store(job.counter, std::memory_order_relaxed);
+		}
+
+		void load(job_t& job) const
+		{
+			job.function = function.load(std::memory_order_relaxed);
+			job.data = data.load(std::memory_order_relaxed);
+			job.begin = begin.load(std::memory_order_relaxed);
+			job.end = end.load(std::memory_order_relaxed);
+			job.counter = counter.load(std::memory_order_relaxed);
+		}
+	};
+
+	struct job_deque_t {
+		alignas(CACHELINE) std::atomic<int64_t>	top{ 0 };
+		alignas(CACHELINE) std::atomic<int64_t>	bottom{ 0 };
+		alignas(CACHELINE) job_slot_t			slots[kDequeCapacity];
+
+		// Sólo el propietario
+		bool push(const job_t& job)
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_acquire);
+			if (b - t >= kDequeCapacity)
+				return false;
+			slots[b % kDequeCapacity].store(job);
+			bottom.store(b + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Sólo el propietario; compite con los ladrones únicamente por la última tarea
+		bool pop(job_t& job)
+		{
+			// bottom y top seq_cst: el orden total hace de barrera entre el store y el load (xchg en x86)
+			const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_seq_cst);
+			if (t > b) {
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+			slots[b % kDequeCapacity].load(job);
+			if (t == b) {
+				const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return won;
+			}
+			return true;
+		}
+
+		bool steal(job_t& job)
+		{
+			int64_t t = top.load(std::memory_order_seq_cst);
+			const int64_t b = bottom.load(std::memory_order_seq_cst);
+			if (t >= b)
+				return false;
+			slots[t % kDequeCapacity].load(job);
+			return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Pool
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::atomic<size_t> gRequestedThreads{ 0 };
+	std::atomic<bool> gPoolStarted{ false };
+
+	thread_local int tWorker = -1;
+	thread_local uint32_t tRandom = 0;
+
+	size_t configured_thread_count()
+	{
+		static const size_t cores = physical_core_count();
+		const size_t requested = gRequestedThreads.load(std::memory_order_relaxed);
+		return requested ? requested : cores;
+	}
+
+	struct job_pool_t {
+		size_t							thread_count;		// hebras del pool más la que espera
+		size_t							worker_count;
+		std::unique_ptr<job_deque_t[]>	deques;
+		std::vector<std::thread>		workers;
+
+		// Cola de las hebras de fuera del pool
+		spinlock_aligned_t				shared_lock;
+		std::deque<job_t>				shared;
+		std::atomic<size_t>				shared_count{ 0 };
+
+		// Las hebras dormidas esperan a que cambie epoch; sólo se despierta si sleepers dice que hay alguna
+		alignas(CACHELINE) std::atomic<uint32_t>	epoch{ 0 };
+		std::atomic<uint32_t>			sleepers{ 0 };
+		std::atomic<bool>				quit{ false };
+
+		job_pool_t()
+			: thread_count(configured_thread_count()), worker_count(thread_count - 1), deques(new job_deque_t[std::max<size_t>(1, worker_count)])
+		{
+			gPoolStarted.store(true, std::memory_order_release);
+			workers.reserve(worker_count);
+			for (size_t i = 0; i < worker_count; ++i)
+				workers.emplace_back([this, i]() { worker_main(int(i)); });
+		}
+
+		~job_pool_t()
+		{
+			quit.store(true, std::memory_order_seq_cst);
+			epoch.fetch_add(1, std::memory_order_seq_cst);
+			epoch.notify_all();
+			for (std::thread& t : workers)
+				t.join();
+		}
+
+		bool find(job_t& job)
+		{
+			if (tWorker >= 0 && deques[tWorker].pop(job))
+				return true;
+			if (shared_count.load(std::memory_order_acquire)) {
+				lock_guard_spin<spinlock_t> guard(shared_lock);
+				if (!shared.empty()) {
+					job = shared.front();
+					shared.pop_front();
+					shared_count.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+			}
+			// Robo empezando por una víctima al azar (xorshift por hebra)
+			if (!tRandom)
+				tRandom = uint32_t(reinterpret_cast<uintptr_t>(&tRandom) >> 4) | 1u;
+			tRandom ^= tRandom << 13;
+			tRandom ^= tRandom >> 17;
+			tRandom ^= tRandom << 5;
+			for (size_t i = 0, first = tRandom % std::max<size_t>(1, worker_count); i < worker_count; ++i) {
+				const size_t victim = (first + i) % worker_count;
+				if (int(victim) != tWorker && deques[victim].steal(job))
+					return true;
+			}
+			return false;
+		}
+
+		static void execute(const job_t& job)
+		{
+			job.function(job);
+			job.counter->pending.fetch_sub(1, std::memory_order_release);
+		}
+
+		void wake()
+		{
+			epoch.fetch_add(1, std::memory_order_seq_cst);
+			if (sleepers.load(std::memory_order_seq_cst))
+				epoch.notify_one();
+		}
+
+		void worker_main(int index)
+		{
+			tWorker = index;
+			uint32_t idle = 0;
+			while (!quit.load(std::memory_order_relaxed)) {
+				job_t job;
+				if (find(job)) {
+					execute(job);
+					idle = 0;
+					continue;
+				}
+				if (++idle < kIdleSpins) {
+					cpu_relax();
+					continue;
+				}
+				// Se anota como dormida antes de mirar por última vez: o ve la tarea o quien la encola ve sleepers
+				sleepers.fetch_add(1, std::memory_order_seq_cst);
+				const uint32_t seen = epoch.load(std::memory_order_seq_cst);
+				const bool found = find(job);
+				if (!found && !quit.load(std::memory_order_seq_cst))
+					epoch.wait(seen, std::memory_order_seq_cst);
+				sleepers.fetch_sub(1, std::memory_order_relaxed);
+				if (found)
+					execute(job);
+				idle = 0;
+			}
+		}
+	};
+
+	job_pool_t& pool()
+	{
+		static job_pool_t instance;
+		return instance;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// parallel_for
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct parallel_range_t {
+		const parallel_body_t*	body;
+		size_t					min_chunk;
+		job_counter_t			counter;
+	};
+
+	void parallel_range_job(const job_t& job)
+	{
+		parallel_range_t& range = *static_cast<parallel_range_t*>(job.data);
+		size_t begin = job.begin, end = job.end;
+		while (end - begin >= 2 * range.min_chunk) {
+			const size_t mid = begin + (end - begin) / 2;
+			job_run(parallel_range_job, &range, mid, end, range.counter);
+			end = mid;
+		}
+		(*range.body)(begin, end);
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sistema de tareas
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(bool)	job_system_configure(size_t thread_count)
+{
+	if (gPoolStarted.load(std::memory_order_acquire))
+		return false;
+	gRequestedThreads.store(thread_count, std::memory_order_relaxed);
+	return true;
+}
+
+DLL_FNC(void)	job_run(job_function_t function, void* data, size_t begin, size_t end, job_counter_t& counter)
+{
+	job_pool_t& p = pool();
+	const job_t job = { function, data, begin, end, &counter };
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+	if (tWorker >= 0) {
+		if (!p.deques[tWorker].push(job)) {
+			job_pool_t::execute(job);
+			return;
+		}
+	} else {
+		lock_guard_spin<spinlock_t> guard(p.shared_lock);
+		p.shared.push_back(job);
+		p.shared_count.fetch_add(1, std::memory_order_release);
+	}
+	p.wake();
+}
+
+DLL_FNC(void)	job_wait(job_counter_t& counter)
+{
+	job_pool_t& p = pool();
+	uint32_t idle = 0;
+	while (counter.pending.load(std::memory_order_acquire)) {
+		job_t job;
+		if (p.find(job)) {
+			job_pool_t::execute(job);
+			idle = 0;
+		} else if (++idle < kIdleSpins) {
+			cpu_relax();
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+DLL_FNC(int)	job_worker_index()
+{
+	return tWorker;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Paralelismo de datos
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(size_t)	parallel_thread_count()
+{
+	return gPoolStarted.load(std::memory_order_acquire) ? pool().thread_count : configured_thread_count();
+}
+
+DLL_FNC(void)	parallel_for(size_t count, size_t grain, const parallel_body_t& body)
+{
+	if (count == 0)
+		return;
+	if (grain == 0)
+		grain = 1;
+
+	const size_t threads = parallel_thread_count();
+	if (count <= grain || threads <= 1)
+	{
+		body(0, count);
+		return;
+	}
+
+	// La hebra llamante hace de primera tarea y luego ayuda hasta que acaban todas
+	parallel_range_t range = { &body, std::max(grain, count / (8 * threads)), {} };
+	parallel_range_job(job_t{ parallel_range_job, &range, 0, count, &range.counter });
+	job_wait(range.counter);
+}
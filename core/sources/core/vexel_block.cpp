@@ -0,0 +1,804 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_block.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+#include "vexel_block_internal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#elif defined(__aarch64__)
+#	include <arm_neon.h>
+#endif
+
+// Cada bloque se decodifica a una tesela del tamaño de su huella (4x4, o la de ASTC) en su formato decodificado
+// (vexel_block_decoded_format) y las filas de teselas pasan al destino con un vexel_converter_t. BC1-BC5 resuelven sus índices con dos búsquedas de 16 vexels
+// (color de 2 bits sobre 4 RGBA8 y canal de 3 bits sobre 8 bytes) elegidas según el procesador; BC6H y BC7 leen los
+// campos del bloque con un lector de 128 bits y ETC2 como un entero de 64 bits. ASTC está en vexel_block_astc.cpp.
+// Las tablas y paletas compartidas con el codificador están en vexel_block_internal.h.
+
+namespace {
+
+	using namespace vexel_block_internal;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Búsquedas de BC1-BC5
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// 16 índices -> 16 valores en el orden de los vexels (fila a fila)
+	struct bc_kernels_t {
+		void (*color)(const uint32_t* palette, uint32_t indices, uint32_t* out);	// 4 RGBA8, índices de 2 bits
+		void (*alpha)(const uint8_t* palette, uint64_t indices, uint8_t* out);		// 8 bytes, índices de 3 bits
+	};
+
+	void color_lookup_scalar(const uint32_t* palette, uint32_t indices, uint32_t* out)
+	{
+		for (int i = 0; i < 16; ++i, indices >>= 2) out[i] = palette[indices & 3];
+	}
+
+	void alpha_lookup_scalar(const uint8_t* palette, uint64_t indices, uint8_t* out)
+	{
+		for (int i = 0; i < 16; ++i, indices >>= 3) out[i] = palette[indices & 7];
+	}
+
+#if defined(SIMD_KERNELS_X86)
+
+	// Desplazamiento variable por carril y permutación de dwords entre carriles: 8 vexels por instrucción
+	SIMD_TARGET("avx2")
+	void color_lookup_avx2(const uint32_t* palette, uint32_t indices, uint32_t* out)
+	{
+		const __m256i pal = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(palette)));
+		const __m256i shifts = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+		const __m256i mask = _mm256_set1_epi32(3);
+		const __m256i lo = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int)indices), shifts), mask);
+		const __m256i hi = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int)(indices >> 16)), shifts), mask);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(pal, lo));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_permutevar8x32_epi32(pal, hi));
+	}
+
+	SIMD_TARGET("avx2")
+	void alpha_lookup_avx2(const uint8_t* palette, uint64_t indices, uint8_t* out)
+	{
+		const __m256i pal = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(palette)));
+		const __m256i shifts = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+		const __m256i mask = _mm256_set1_epi32(7);
+		const __m256i lo = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int)(uint32_t)indices), shifts), mask);
+		const __m256i hi = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int)(uint32_t)(indices >> 24)), shifts), mask);
+		// packus trabaja por carriles de 128 bits: se reordenan los cuartos antes de bajar a bytes
+		const __m256i w = _mm256_permute4x64_epi64(
+			_mm256_packus_epi32(_mm256_permutevar8x32_epi32(pal, lo), _mm256_permutevar8x32_epi32(pal, hi)), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm256_castsi256_si128(w), _mm256_extracti128_si256(w, 1)));
+	}
+
+#elif defined(__aarch64__)
+
+	// tbl sobre la paleta de 16 bytes: el índice i de cada vexel selecciona los bytes 4i..4i+3
+	void color_lookup_neon(const uint32_t* palette, uint32_t indices, uint32_t* out)
+	{
+		const uint8x16_t pal = vld1q_u8(reinterpret_cast<const uint8_t*>(palette));
+		const int32x4_t shifts = { 0, -2, -4, -6 };
+		const uint32x4_t mask = vdupq_n_u32(3);
+		const uint32x4_t base = vdupq_n_u32(0x03020100), step = vdupq_n_u32(0x04040404);
+		for (int r = 0; r < 4; ++r) {
+			const uint32x4_t idx = vandq_u32(vshlq_u32(vdupq_n_u32(indices >> (8 * r)), shifts), mask);
+			vst1q_u8(reinterpret_cast<uint8_t*>(out + 4 * r), vqtbl1q_u8(pal, vreinterpretq_u8_u32(vmlaq_u32(base, idx, step))));
+		}
+	}
+
+	void alpha_lookup_neon(const uint8_t* palette, uint64_t indices, uint8_t* out)
+	{
+		const uint8x16_t pal = vcombine_u8(vld1_u8(palette), vdup_n_u8(0));
+		const int32x4_t shifts = { 0, -3, -6, -9 };
+		const uint32x4_t mask = vdupq_n_u32(7);
+		uint16x4_t q[4];
+		for (int r = 0; r < 4; ++r)
+			q[r] = vmovn_u32(vandq_u32(vshlq_u32(vdupq_n_u32((uint32_t)(indices >> (12 * r))), shifts), mask));
+		const uint8x16_t idx = vcombine_u8(vmovn_u16(vcombine_u16(q[0], q[1])), vmovn_u16(vcombine_u16(q[2], q[3])));
+		vst1q_u8(out, vqtbl1q_u8(pal, idx));
+	}
+
+#endif
+
+	// Se resuelve en cada llamada pública para respetar simd::force_isa()
+	bc_kernels_t select_bc_kernels()
+	{
+#if defined(SIMD_KERNELS_X86)
+		const simd::isa_t isa = simd::kernels().isa;
+		if (isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512)
+			return { color_lookup_avx2, alpha_lookup_avx2 };
+#elif defined(__aarch64__)
+		return { color_lookup_neon, alpha_lookup_neon };
+#endif
+		return { color_lookup_scalar, alpha_lookup_scalar };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC1-BC5
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	using block_fn = void (*)(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch);
+
+	void store_tile(const void* texels, size_t texel_bytes, uint8_t* out, size_t pitch)
+	{
+		const uint8_t* t = static_cast<const uint8_t*>(texels);
+		for (int y = 0; y < 4; ++y) std::memcpy(out + y * pitch, t + y * 4 * texel_bytes, 4 * texel_bytes);
+	}
+
+	uint64_t load_indices48(const uint8_t* p)
+	{
+		uint64_t v = 0;
+		std::memcpy(&v, p, 6);
+		return v;
+	}
+
+	uint32_t load_u32(const uint8_t* p)
+	{
+		uint32_t v;
+		std::memcpy(&v, p, 4);
+		return v;
+	}
+
+	void decode_bc1(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint32_t palette[4], texels[16];
+		color_palette(block, false, palette);
+		k.color(palette, load_u32(block + 4), texels);
+		store_tile(texels, 4, out, pitch);
+	}
+
+	void decode_bc2(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint32_t palette[4], texels[16];
+		color_palette(block + 8, true, palette);
+		k.color(palette, load_u32(block + 12), texels);
+		uint64_t alpha;
+		std::memcpy(&alpha, block, 8);
+		for (int i = 0; i < 16; ++i, alpha >>= 4)
+			texels[i] = (texels[i] & 0x00ffffff) | (uint32_t)((alpha & 15) * 17) << 24;
+		store_tile(texels, 4, out, pitch);
+	}
+
+	void decode_bc3(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint32_t palette[4], texels[16];
+		uint8_t alpha_palette[8], alpha[16];
+		color_palette(block + 8, true, palette);
+		k.color(palette, load_u32(block + 12), texels);
+		channel_palette<false>(block, alpha_palette);
+		k.alpha(alpha_palette, load_indices48(block + 2), alpha);
+		for (int i = 0; i < 16; ++i) texels[i] = (texels[i] & 0x00ffffff) | (uint32_t)alpha[i] << 24;
+		store_tile(texels, 4, out, pitch);
+	}
+
+	template<bool Signed>
+	void decode_bc4(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint8_t palette[8], texels[16];
+		channel_palette<Signed>(block, palette);
+		k.alpha(palette, load_indices48(block + 2), texels);
+		store_tile(texels, 1, out, pitch);
+	}
+
+	template<bool Signed>
+	void decode_bc5(const bc_kernels_t& k, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint8_t palette[8], r[16], g[16], texels[32];
+		channel_palette<Signed>(block, palette);
+		k.alpha(palette, load_indices48(block + 2), r);
+		channel_palette<Signed>(block + 8, palette);
+		k.alpha(palette, load_indices48(block + 10), g);
+		for (int i = 0; i < 16; ++i) {
+			texels[2 * i] = r[i];
+			texels[2 * i + 1] = g[i];
+		}
+		store_tile(texels, 2, out, pitch);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC6H
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Extremos: región 0 = (W, X), región 1 = (Y, Z); D es la partición
+	enum : uint8_t { RW, GW, BW, RX, GX, BX, RY, GY, BY, RZ, GZ, BZ, D };
+
+	// count bits leídos seguidos que van a [shift, shift + count) del campo
+	struct bc6h_field_t {
+		uint8_t field;
+		uint8_t shift;
+		uint8_t count;
+	};
+
+	struct bc6h_mode_t {
+		bool			transformed;	// X, Y, Z son diferencias respecto a W
+		uint8_t			regions;
+		uint8_t			endpoint_bits;
+		uint8_t			delta_bits[3];
+		uint8_t			field_count;
+		bc6h_field_t	fields[24];
+	};
+
+	// Orden de los campos tras los bits de modo (tablas de formato de BC6H de D3D11). Los campos invertidos de los
+	// modos 13 y 14 se leen bit a bit.
+	constexpr bc6h_mode_t kBC6HModes[14] = {
+		{ true, 2, 10, { 5, 5, 5 }, 20, {
+			{GY,4,1},{BY,4,1},{BZ,4,1},{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,5},{GZ,4,1},{GY,0,4},{GX,0,5},
+			{BZ,0,1},{GZ,0,4},{BX,0,5},{BZ,1,1},{BY,0,4},{RY,0,5},{BZ,2,1},{RZ,0,5},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 7, { 6, 6, 6 }, 24, {
+			{GY,5,1},{GZ,4,1},{GZ,5,1},{RW,0,7},{BZ,0,1},{BZ,1,1},{BY,4,1},{GW,0,7},{BY,5,1},{BZ,2,1},{GY,4,1},{BW,0,7},
+			{BZ,3,1},{BZ,5,1},{BZ,4,1},{RX,0,6},{GY,0,4},{GX,0,6},{GZ,0,4},{BX,0,6},{BY,0,4},{RY,0,6},{RZ,0,6},{D,0,5} } },
+		{ true, 2, 11, { 5, 4, 4 }, 19, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,5},{RW,10,1},{GY,0,4},{GX,0,4},{GW,10,1},{BZ,0,1},{GZ,0,4},
+			{BX,0,4},{BW,10,1},{BZ,1,1},{BY,0,4},{RY,0,5},{BZ,2,1},{RZ,0,5},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 11, { 4, 5, 4 }, 21, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,4},{RW,10,1},{GZ,4,1},{GY,0,4},{GX,0,5},{GW,10,1},{GZ,0,4},
+			{BX,0,4},{BW,10,1},{BZ,1,1},{BY,0,4},{RY,0,4},{BZ,0,1},{BZ,2,1},{RZ,0,4},{GY,4,1},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 11, { 4, 4, 5 }, 21, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,4},{RW,10,1},{BY,4,1},{GY,0,4},{GX,0,4},{GW,10,1},{BZ,0,1},
+			{GZ,0,4},{BX,0,5},{BW,10,1},{BY,0,4},{RY,0,4},{BZ,1,1},{BZ,2,1},{RZ,0,4},{BZ,4,1},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 9, { 5, 5, 5 }, 20, {
+			{RW,0,9},{BY,4,1},{GW,0,9},{GY,4,1},{BW,0,9},{BZ,4,1},{RX,0,5},{GZ,4,1},{GY,0,4},{GX,0,5},
+			{BZ,0,1},{GZ,0,4},{BX,0,5},{BZ,1,1},{BY,0,4},{RY,0,5},{BZ,2,1},{RZ,0,5},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 8, { 6, 5, 5 }, 20, {
+			{RW,0,8},{GZ,4,1},{BY,4,1},{GW,0,8},{BZ,2,1},{GY,4,1},{BW,0,8},{BZ,3,1},{BZ,4,1},{RX,0,6},
+			{GY,0,4},{GX,0,5},{BZ,0,1},{GZ,0,4},{BX,0,5},{BZ,1,1},{BY,0,4},{RY,0,6},{RZ,0,6},{D,0,5} } },
+		{ true, 2, 8, { 5, 6, 5 }, 22, {
+			{RW,0,8},{BZ,0,1},{BY,4,1},{GW,0,8},{GY,5,1},{GY,4,1},{BW,0,8},{GZ,5,1},{BZ,4,1},{RX,0,5},{GZ,4,1},
+			{GY,0,4},{GX,0,6},{GZ,0,4},{BX,0,5},{BZ,1,1},{BY,0,4},{RY,0,5},{BZ,2,1},{RZ,0,5},{BZ,3,1},{D,0,5} } },
+		{ true, 2, 8, { 5, 5, 6 }, 22, {
+			{RW,0,8},{BZ,1,1},{BY,4,1},{GW,0,8},{BY,5,1},{GY,4,1},{BW,0,8},{BZ,5,1},{BZ,4,1},{RX,0,5},{GZ,4,1},
+			{GY,0,4},{GX,0,5},{BZ,0,1},{GZ,0,4},{BX,0,6},{BY,0,4},{RY,0,5},{BZ,2,1},{RZ,0,5},{BZ,3,1},{D,0,5} } },
+		{ false, 2, 6, { 6, 6, 6 }, 24, {
+			{RW,0,6},{GZ,4,1},{BZ,0,1},{BZ,1,1},{BY,4,1},{GW,0,6},{GY,5,1},{BY,5,1},{BZ,2,1},{GY,4,1},{BW,0,6},{GZ,5,1},
+			{BZ,3,1},{BZ,5,1},{BZ,4,1},{RX,0,6},{GY,0,4},{GX,0,6},{GZ,0,4},{BX,0,6},{BY,0,4},{RY,0,6},{RZ,0,6},{D,0,5} } },
+		{ false, 1, 10, { 10, 10, 10 }, 6, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,10},{GX,0,10},{BX,0,10} } },
+		{ true, 1, 11, { 9, 9, 9 }, 9, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,9},{RW,10,1},{GX,0,9},{GW,10,1},{BX,0,9},{BW,10,1} } },
+		{ true, 1, 12, { 8, 8, 8 }, 12, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,8},{RW,11,1},{RW,10,1},{GX,0,8},{GW,11,1},{GW,10,1},{BX,0,8},{BW,11,1},{BW,10,1} } },
+		{ true, 1, 16, { 4, 4, 4 }, 24, {
+			{RW,0,10},{GW,0,10},{BW,0,10},{RX,0,4},{RW,15,1},{RW,14,1},{RW,13,1},{RW,12,1},{RW,11,1},{RW,10,1},
+			{GX,0,4},{GW,15,1},{GW,14,1},{GW,13,1},{GW,12,1},{GW,11,1},{GW,10,1},
+			{BX,0,4},{BW,15,1},{BW,14,1},{BW,13,1},{BW,12,1},{BW,11,1},{BW,10,1} } },
+	};
+
+	// Bits de modo (2, o 5 si los dos primeros son 10 u 11) -> índice en kBC6HModes; -1 reservado
+	constexpr int8_t kBC6HModeIndex[32] = {
+		0, 1, 2, 10, 0, 1, 3, 11, 0, 1, 4, 12, 0, 1, 5, 13,
+		0, 1, 6, -1, 0, 1, 7, -1, 0, 1, 8, -1, 0, 1, 9, -1,
+	};
+
+	SIMD_FORCEINLINE int sign_extend(int v, int bits) { const int s = 1 << (bits - 1); return ((v & ((s << 1) - 1)) ^ s) - s; }
+
+	int bc6h_unquantize(int v, int bits, bool is_signed)
+	{
+		if (!is_signed) {
+			if (bits >= 15 || v == 0) return v;
+			if (v == (1 << bits) - 1) return 0xffff;
+			return ((v << 16) + 0x8000) >> bits;
+		}
+		if (bits >= 16) return v;
+		const bool negative = v < 0;
+		if (negative) v = -v;
+		int r;
+		if (v == 0) r = 0;
+		else if (v >= (1 << (bits - 1)) - 1) r = 0x7fff;
+		else r = ((v << 15) + 0x4000) >> (bits - 1);
+		return negative ? -r : r;
+	}
+
+	// Escala final a los bits de half (31/64 del rango sin signo, 31/32 con signo)
+	SIMD_FORCEINLINE uint16_t bc6h_finish(int v, bool is_signed)
+	{
+		if (!is_signed) return (uint16_t)((v * 31) >> 6);
+		return v < 0 ? (uint16_t)(0x8000 | ((-v * 31) >> 5)) : (uint16_t)((v * 31) >> 5);
+	}
+
+	template<bool Signed>
+	void decode_bc6h(const bc_kernels_t&, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		constexpr uint16_t kOne = 0x3c00;
+		uint16_t texels[64];
+		block_bits_t bits(block);
+		uint32_t code = bits.read(2);
+		if (code > 1) code |= bits.read(3) << 2;
+		const int index = kBC6HModeIndex[code];
+		if (index < 0) {
+			for (int i = 0; i < 16; ++i) {
+				texels[4 * i] = texels[4 * i + 1] = texels[4 * i + 2] = 0;
+				texels[4 * i + 3] = kOne;
+			}
+			store_tile(texels, 8, out, pitch);
+			return;
+		}
+
+		const bc6h_mode_t& m = kBC6HModes[index];
+		int f[13] = {};
+		for (int i = 0; i < m.field_count; ++i)
+			f[m.fields[i].field] |= (int)bits.read(m.fields[i].count) << m.fields[i].shift;
+
+		const int epb = m.endpoint_bits;
+		const int count = 2 * m.regions;
+		int ep[4][3];
+		for (int c = 0; c < 3; ++c) {
+			for (int e = 0; e < count; ++e) ep[e][c] = f[3 * e + c];
+			if (Signed) ep[0][c] = sign_extend(ep[0][c], epb);
+			for (int e = 1; e < count; ++e) {
+				if (m.transformed || Signed) ep[e][c] = sign_extend(ep[e][c], m.transformed ? m.delta_bits[c] : epb);
+				if (m.transformed) {
+					ep[e][c] = (ep[0][c] + ep[e][c]) & ((1 << epb) - 1);
+					if (Signed) ep[e][c] = sign_extend(ep[e][c], epb);
+				}
+			}
+			for (int e = 0; e < count; ++e) ep[e][c] = bc6h_unquantize(ep[e][c], epb, Signed);
+		}
+
+		const int partition = m.regions == 2 ? f[D] : 0;
+		const int index_bits = m.regions == 2 ? 3 : 4;
+		const uint8_t* weights = weights_for(index_bits);
+		for (int i = 0; i < 16; ++i) {
+			const int w = weights[bits.read(index_bits - is_anchor(m.regions, partition, i))];
+			const int s = subset_of(m.regions, partition, i);
+			for (int c = 0; c < 3; ++c) texels[4 * i + c] = bc6h_finish(interpolate(ep[2 * s][c], ep[2 * s + 1][c], w), Signed);
+			texels[4 * i + 3] = kOne;
+		}
+		store_tile(texels, 8, out, pitch);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC7
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void decode_bc7(const bc_kernels_t&, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint32_t texels[16];
+		block_bits_t bits(block);
+		int mode = 0;
+		while (mode < 8 && !bits.read(1)) ++mode;
+		if (mode == 8) {
+			std::memset(texels, 0, sizeof(texels));
+			store_tile(texels, 4, out, pitch);
+			return;
+		}
+
+		const bc7_mode_t& m = kBC7Modes[mode];
+		const int partition = (int)bits.read(m.partition_bits);
+		const int rotation = (int)bits.read(m.rotation_bits);
+		const int selector = (int)bits.read(m.selector_bits);
+		const int count = 2 * m.subsets;
+
+		int ep[6][4];
+		for (int c = 0; c < 3; ++c)
+			for (int e = 0; e < count; ++e) ep[e][c] = (int)bits.read(m.color_bits);
+		for (int e = 0; e < count; ++e) ep[e][3] = m.alpha_bits ? (int)bits.read(m.alpha_bits) : 255;
+
+		int color_bits = m.color_bits, alpha_bits = m.alpha_bits;
+		if (m.endpoint_pbits || m.shared_pbits) {
+			int p[6];
+			if (m.endpoint_pbits)
+				for (int e = 0; e < count; ++e) p[e] = (int)bits.read(1);
+			else
+				for (int s = 0; s < m.subsets; ++s) p[2 * s] = p[2 * s + 1] = (int)bits.read(1);
+			for (int e = 0; e < count; ++e) {
+				for (int c = 0; c < 3; ++c) ep[e][c] = ep[e][c] << 1 | p[e];
+				if (alpha_bits) ep[e][3] = ep[e][3] << 1 | p[e];
+			}
+			++color_bits;
+			if (alpha_bits) ++alpha_bits;
+		}
+		for (int e = 0; e < count; ++e) {
+			for (int c = 0; c < 3; ++c) ep[e][c] = (ep[e][c] << (8 - color_bits)) | (ep[e][c] >> (2 * color_bits - 8));
+			if (alpha_bits) ep[e][3] = (ep[e][3] << (8 - alpha_bits)) | (ep[e][3] >> (2 * alpha_bits - 8));
+		}
+
+		uint8_t index[16], index2[16];
+		for (int i = 0; i < 16; ++i) index[i] = (uint8_t)bits.read(m.index_bits - is_anchor(m.subsets, partition, i));
+		if (m.index_bits2)
+			for (int i = 0; i < 16; ++i) index2[i] = (uint8_t)bits.read(m.index_bits2 - (i == 0));
+
+		const uint8_t* color_index = index;
+		const uint8_t* alpha_index = index;
+		const uint8_t* color_weights = weights_for(m.index_bits);
+		const uint8_t* alpha_weights = color_weights;
+		if (m.index_bits2) {
+			const uint8_t* weights2 = weights_for(m.index_bits2);
+			if (selector) {
+				color_index = index2;
+				color_weights = weights2;
+			} else {
+				alpha_index = index2;
+				alpha_weights = weights2;
+			}
+		}
+
+		for (int i = 0; i < 16; ++i) {
+			const int s = subset_of(m.subsets, partition, i);
+			const int* e0 = ep[2 * s];
+			const int* e1 = ep[2 * s + 1];
+			const int wc = color_weights[color_index[i]], wa = alpha_weights[alpha_index[i]];
+			int v[4] = { interpolate(e0[0], e1[0], wc), interpolate(e0[1], e1[1], wc), interpolate(e0[2], e1[2], wc), interpolate(e0[3], e1[3], wa) };
+			if (rotation) std::swap(v[3], v[rotation - 1]);
+			texels[i] = rgba8(v[0], v[1], v[2], v[3]);
+		}
+		store_tile(texels, 4, out, pitch);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ETC2 RGB
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// El bloque es un entero de 64 bits en big endian: bits 63..32 con colores y modo, 31..16 los bits altos de los
+	// índices y 15..0 los bajos, con los vexels por columnas (bit 4x + y). Un modo diferencial cuyo segundo color se
+	// sale de 0..31 en R, G o B es en realidad el modo T, H o plano.
+	void decode_etc2(const bc_kernels_t&, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		uint64_t b = 0;
+		for (int i = 0; i < 8; ++i) b = b << 8 | block[i];
+		// count bits que terminan en el bit top
+		const auto field = [b](int top, int count) { return (int)((b >> (top - count + 1)) & ((1u << count) - 1)); };
+		const auto index = [b](int i) { const int k = 4 * (i & 3) + (i >> 2); return (int)((b >> (16 + k) & 1) << 1 | (b >> k & 1)); };
+		uint32_t texels[16];
+
+		const bool diff = field(33, 1);
+		int c1[3], d[3] = {};
+		for (int c = 0; c < 3; ++c) {
+			c1[c] = field(63 - 8 * c, 5);
+			d[c] = sign_extend(field(58 - 8 * c, 3), 3);
+		}
+		const auto overflow = [&](int c) { return diff && (c1[c] + d[c] < 0 || c1[c] + d[c] > 31); };
+
+		if (overflow(0) || overflow(1)) {
+			int p[4][3];
+			if (overflow(0)) {
+				// T: el primer color solo y el segundo desplazado +-distancia
+				const int a[3] = { extend4(field(60, 2) << 2 | field(57, 2)), extend4(field(55, 4)), extend4(field(51, 4)) };
+				const int e[3] = { extend4(field(47, 4)), extend4(field(43, 4)), extend4(field(39, 4)) };
+				const int dist = kETC2Distances[field(35, 2) << 1 | field(32, 1)];
+				for (int c = 0; c < 3; ++c) {
+					p[0][c] = a[c];
+					p[1][c] = clamp8(e[c] + dist);
+					p[2][c] = e[c];
+					p[3][c] = clamp8(e[c] - dist);
+				}
+			} else {
+				// H: los dos colores +-distancia; el orden de los colores aporta el bit bajo de la distancia
+				const int a4[3] = { field(62, 4), field(58, 3) << 1 | field(52, 1), field(51, 1) << 3 | field(49, 3) };
+				const int e4[3] = { field(46, 4), field(42, 4), field(38, 4) };
+				const bool order = (a4[0] << 8 | a4[1] << 4 | a4[2]) >= (e4[0] << 8 | e4[1] << 4 | e4[2]);
+				const int dist = kETC2Distances[field(34, 1) << 2 | field(32, 1) << 1 | (order ? 1 : 0)];
+				for (int c = 0; c < 3; ++c) {
+					p[0][c] = clamp8(extend4(a4[c]) + dist);
+					p[1][c] = clamp8(extend4(a4[c]) - dist);
+					p[2][c] = clamp8(extend4(e4[c]) + dist);
+					p[3][c] = clamp8(extend4(e4[c]) - dist);
+				}
+			}
+			for (int i = 0; i < 16; ++i) {
+				const int* q = p[index(i)];
+				texels[i] = rgba8(q[0], q[1], q[2], 255);
+			}
+		} else if (overflow(2)) {
+			// Plano: colores en (0, 0), (4, 0) y (0, 4) interpolados a todo el bloque
+			const int o[3] = { extend6(field(62, 6)), extend7(field(56, 1) << 6 | field(54, 6)), extend6(field(48, 1) << 5 | field(44, 2) << 3 | field(41, 3)) };
+			const int h[3] = { extend6(field(38, 5) << 1 | field(32, 1)), extend7(field(31, 7)), extend6(field(24, 6)) };
+			const int v[3] = { extend6(field(18, 6)), extend7(field(12, 7)), extend6(field(5, 6)) };
+			for (int i = 0; i < 16; ++i) {
+				const int x = i & 3, y = i >> 2;
+				int q[3];
+				for (int c = 0; c < 3; ++c) q[c] = clamp8((x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2) >> 2);
+				texels[i] = rgba8(q[0], q[1], q[2], 255);
+			}
+		} else {
+			// Individual (4 + 4 bits) o diferencial (5 bits + diferencia de 3); flip separa en 4x2 en lugar de 2x4
+			int base[2][3];
+			for (int c = 0; c < 3; ++c) {
+				base[0][c] = diff ? extend5(c1[c]) : extend4(field(63 - 8 * c, 4));
+				base[1][c] = diff ? extend5(c1[c] + d[c]) : extend4(field(59 - 8 * c, 4));
+			}
+			const int table[2] = { field(39, 3), field(36, 3) };
+			const bool flip = field(32, 1);
+			for (int i = 0; i < 16; ++i) {
+				const int s = flip ? (i >> 3) : ((i & 3) >> 1);
+				const int m = kETC1Modifiers[table[s]][index(i)];
+				texels[i] = rgba8(clamp8(base[s][0] + m), clamp8(base[s][1] + m), clamp8(base[s][2] + m), 255);
+			}
+		}
+		store_tile(texels, 4, out, pitch);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ASTC
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Un vexel (x, y) del bloque sin decodificar el resto
+	using fetch_fn = void (*)(const uint8_t* block, int x, int y, uint8_t* out);
+
+	template<int W, int H, astc_profile_t P>
+	void decode_astc(const bc_kernels_t&, const uint8_t* block, uint8_t* out, size_t pitch)
+	{
+		decode_astc_block(block, W, H, P, out, pitch);
+	}
+
+	template<int W, int H, astc_profile_t P>
+	void fetch_astc(const uint8_t* block, int x, int y, uint8_t* out)
+	{
+		fetch_astc_texel(block, W, H, P, x, y, out);
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Imágenes
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct block_codec_t {
+		block_fn		decode;
+		vexel_format_t	decoded;
+		uint8_t			texel_bytes;
+		uint8_t			block_bytes;
+		uint8_t			width = 4;			// vexels por bloque
+		uint8_t			height = 4;
+		fetch_fn		fetch = nullptr;	// nullptr: fetch_block_vexel decodifica el bloque entero
+	};
+
+	// Formatos float con el perfil HDR (a half), el resto con el LDR (a RGBA8), en sRGB si el espacio lo es
+	template<int W, int H>
+	block_codec_t astc_codec(vexel_format_t format)
+	{
+		const vexel_space_t space = format.space();
+		if (format.number_format() == vexel_number_format_t::FLOAT)
+			return { decode_astc<W, H, astc_profile_t::HDR>, vexel_format_t::VECx_Fx(4, vexel_bit_format_t::UNIFORM_16).space(space),
+					 8, 16, W, H, fetch_astc<W, H, astc_profile_t::HDR> };
+		if (space == vexel_space_t::SRGB)
+			return { decode_astc<W, H, astc_profile_t::LDR_SRGB>, vexel_format_t::VEC4_UN8().space(space), 4, 16, W, H,
+					 fetch_astc<W, H, astc_profile_t::LDR_SRGB> };
+		return { decode_astc<W, H, astc_profile_t::LDR>, vexel_format_t::VEC4_UN8().space(space), 4, 16, W, H,
+				 fetch_astc<W, H, astc_profile_t::LDR> };
+	}
+
+	bool resolve_codec(vexel_format_t format, block_codec_t& c)
+	{
+		const vexel_space_t space = format.space();
+		const bool is_signed = format.is_signed();
+		const vexel_format_t rgba = vexel_format_t::VEC4_UN8().space(space);
+		switch (format.layout()) {
+		case vexel_layout_t::BLOCK_BC1:	c = { decode_bc1, rgba, 4, 8 }; break;
+		case vexel_layout_t::BLOCK_BC2:	c = { decode_bc2, rgba, 4, 16 }; break;
+		case vexel_layout_t::BLOCK_BC3:	c = { decode_bc3, rgba, 4, 16 }; break;
+		case vexel_layout_t::BLOCK_BC7:	c = { decode_bc7, rgba, 4, 16 }; break;
+		case vexel_layout_t::BLOCK_ETC2:	c = { decode_etc2, rgba, 4, 8 }; break;
+		case vexel_layout_t::BLOCK_BC4:
+			c = { is_signed ? decode_bc4<true> : decode_bc4<false>, vexel_format_t::VEC1_UN8().is_signed(is_signed).space(space), 1, 8 };
+			break;
+		case vexel_layout_t::BLOCK_BC5:
+			c = { is_signed ? decode_bc5<true> : decode_bc5<false>, vexel_format_t::VEC2_UN8().is_signed(is_signed).space(space), 2, 16 };
+			break;
+		case vexel_layout_t::BLOCK_BC6H:
+			c = { is_signed ? decode_bc6h<true> : decode_bc6h<false>, vexel_format_t::VECx_Fx(4, vexel_bit_format_t::UNIFORM_16).space(space), 8, 16 };
+			break;
+		case vexel_layout_t::BLOCK_ASTC_4x4:	c = astc_codec<4, 4>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_5x4:	c = astc_codec<5, 4>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_5x5:	c = astc_codec<5, 5>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_6x5:	c = astc_codec<6, 5>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_6x6:	c = astc_codec<6, 6>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_8x5:	c = astc_codec<8, 5>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_8x6:	c = astc_codec<8, 6>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_8x8:	c = astc_codec<8, 8>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_10x5:	c = astc_codec<10, 5>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_10x6:	c = astc_codec<10, 6>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_10x8:	c = astc_codec<10, 8>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_10x10:	c = astc_codec<10, 10>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_12x10:	c = astc_codec<12, 10>(format); break;
+		case vexel_layout_t::BLOCK_ASTC_12x12:	c = astc_codec<12, 12>(format); break;
+		default:
+			return false;
+		}
+		return true;
+	}
+
+	// Una imagen 2D de bloques; first_row numera sus filas de bloques dentro de todo el trabajo
+	struct block_image_t {
+		const uint8_t*	src;
+		uint8_t*		dst;
+		uint64_t		src_pitch;
+		uint64_t		dst_pitch;
+		uint32_t		width;
+		uint32_t		height;
+		size_t			first_row;
+	};
+
+	void decode_rows(const block_codec_t& codec, const bc_kernels_t& k, const vexel_converter_t& converter,
+					 const block_image_t& image, size_t begin, size_t end, std::vector<uint8_t>& tiles)
+	{
+		const size_t blocks = (image.width + codec.width - 1) / codec.width;
+		const size_t pitch = blocks * codec.width * codec.texel_bytes;
+		tiles.resize(pitch * codec.height);
+		for (size_t by = begin; by < end; ++by) {
+			const uint8_t* row = image.src + by * image.src_pitch;
+			for (size_t bx = 0; bx < blocks; ++bx)
+				codec.decode(k, row + bx * codec.block_bytes, tiles.data() + bx * codec.width * codec.texel_bytes, pitch);
+			const size_t rows = std::min<size_t>(codec.height, image.height - by * codec.height);
+			for (size_t r = 0; r < rows; ++r)
+				convert(converter, tiles.data() + r * pitch, image.dst + (by * codec.height + r) * image.dst_pitch, image.width);
+		}
+	}
+
+	size_t block_rows(const block_codec_t& codec, uint32_t height) { return (height + codec.height - 1) / codec.height; }
+
+	void decode_images(const block_codec_t& codec, const vexel_converter_t& converter, const std::vector<block_image_t>& images, size_t rows)
+	{
+		const bc_kernels_t k = select_bc_kernels();
+		parallel_for(rows, 8, [&](size_t begin, size_t end) {
+			std::vector<uint8_t> tiles;
+			size_t i = std::upper_bound(images.begin(), images.end(), begin,
+										[](size_t r, const block_image_t& image) { return r < image.first_row; }) - images.begin() - 1;
+			while (begin < end) {
+				const block_image_t& image = images[i++];
+				const size_t stop = std::min(end, image.first_row + block_rows(codec, image.height));
+				decode_rows(codec, k, converter, image, begin - image.first_row, stop - image.first_row, tiles);
+				begin = stop;
+			}
+		});
+	}
+
+	uint64_t block_row_bytes(const block_codec_t& codec, uint64_t width) { return (width + codec.width - 1) / codec.width * codec.block_bytes; }
+
+} // namespace
+
+DLL_FNC(bool) vexel_block_info(vexel_layout_t layout, vexel_block_info_t& info)
+{
+	switch (layout) {
+	case vexel_layout_t::BLOCK_BC1:
+	case vexel_layout_t::BLOCK_BC4:
+	case vexel_layout_t::BLOCK_ETC2:
+	case vexel_layout_t::BLOCK_EAC_R11:			info = { 4, 4, 8 }; return true;
+	case vexel_layout_t::BLOCK_BC2:
+	case vexel_layout_t::BLOCK_BC3:
+	case vexel_layout_t::BLOCK_BC5:
+	case vexel_layout_t::BLOCK_BC6H:
+	case vexel_layout_t::BLOCK_BC7:
+	case vexel_layout_t::BLOCK_EAC_R11G11:		info = { 4, 4, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_4x4:		info = { 4, 4, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_5x4:		info = { 5, 4, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_5x5:		info = { 5, 5, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_6x5:		info = { 6, 5, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_6x6:		info = { 6, 6, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_8x5:		info = { 8, 5, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_8x6:		info = { 8, 6, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_8x8:		info = { 8, 8, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_10x5:		info = { 10, 5, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_10x6:		info = { 10, 6, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_10x8:		info = { 10, 8, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_10x10:		info = { 10, 10, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_12x10:		info = { 12, 10, 16 }; return true;
+	case vexel_layout_t::BLOCK_ASTC_12x12:		info = { 12, 12, 16 }; return true;
+	case vexel_layout_t::BLOCK_PVRTC1_2BPP:
+	case vexel_layout_t::BLOCK_PVRTC2_2BPP:		info = { 8, 4, 8 }; return true;
+	case vexel_layout_t::BLOCK_PVRTC1_4BPP:
+	case vexel_layout_t::BLOCK_PVRTC2_4BPP:		info = { 4, 4, 8 }; return true;
+	default:									return false;
+	}
+}
+
+DLL_FNC(vexel_format_t) vexel_block_decoded_format(vexel_format_t format)
+{
+	block_codec_t codec;
+	return resolve_codec(format, codec) ? codec.decoded : vexel_format_t(0);
+}
+
+DLL_FNC(bool) decode_block(vexel_format_t format, const void* block, void* dst, size_t row_byte_count)
+{
+	block_codec_t codec;
+	if (!resolve_codec(format, codec))
+		return false;
+	codec.decode(select_bc_kernels(), static_cast<const uint8_t*>(block), static_cast<uint8_t*>(dst), row_byte_count);
+	return true;
+}
+
+DLL_FNC(bool) decode_blocks(const vexel_surface_t& src, const vexel_surface_t& dst)
+{
+	block_codec_t codec;
+	if (!resolve_codec(src.format, codec))
+		return false;
+	const uint64_t w = src.layout.object_size.width;
+	const uint32_t h = src.layout.object_size.height;
+	if (w != dst.layout.object_size.width || h != dst.layout.object_size.height)
+		return false;
+	const vexel_converter_t* converter = vexel_converter(codec.decoded, dst.format);
+	if (!converter)
+		return false;
+	if (!w || !h)
+		return true;
+
+	const block_image_t image = {
+		static_cast<const uint8_t*>(src.planes[0]),
+		static_cast<uint8_t*>(dst.planes[0]),
+		src.row_byte_count[0] ? src.row_byte_count[0] : block_row_bytes(codec, w),
+		dst.row_byte_count[0] ? dst.row_byte_count[0] : w * vexel_byte_count(dst.format),
+		(uint32_t)w,
+		h,
+		0,
+	};
+	decode_images(codec, *converter, { image }, block_rows(codec, h));
+	return true;
+}
+
+DLL_FNC(bool) decode_block_lods(vexel_format_t format, const buffer_layout_t& layout, const void* src,
+								vexel_format_t dst_format, void* dst)
+{
+	block_codec_t codec;
+	if (!resolve_codec(format, codec))
+		return false;
+	const vexel_converter_t* converter = vexel_converter(codec.decoded, dst_format);
+	if (!converter)
+		return false;
+
+	const uint64_t width = layout.object_size.width;
+	if (!width)
+		return true;
+	const uint32_t height = std::max<uint32_t>(1, layout.object_size.height);
+	const uint32_t depth = std::max<uint32_t>(1, layout.object_size.depth);
+	const bool volume = layout.object_layout == buffer_object_layout_t::LAYOUT_3D;
+	const uint32_t faces = layout.object_layout == buffer_object_layout_t::CUBE ? 6 : 1;
+	const uint32_t elements = std::max<uint32_t>(1, layout.array_count);
+	const uint32_t lods = std::max<uint32_t>(1, layout.lod_count);
+	const uint64_t dst_vexel = vexel_byte_count(dst_format);
+
+	// Todas las imágenes de la cadena se reparten juntas por filas de bloques
+	std::vector<block_image_t> images;
+	uint64_t src_offset = 0, dst_offset = 0;
+	size_t rows = 0;
+	for (uint32_t e = 0; e < elements * faces; ++e)
+		for (uint32_t l = 0; l < lods; ++l) {
+			const uint64_t w = std::max<uint64_t>(1, width >> l);
+			const uint32_t h = std::max<uint32_t>(1, height >> l);
+			const uint32_t d = volume ? std::max<uint32_t>(1, depth >> l) : 1;
+			const uint64_t src_pitch = block_row_bytes(codec, w);
+			for (uint32_t z = 0; z < d; ++z) {
+				images.push_back({
+					static_cast<const uint8_t*>(src) + src_offset,
+					static_cast<uint8_t*>(dst) + dst_offset,
+					src_pitch,
+					w * dst_vexel,
+					(uint32_t)w,
+					h,
+					rows,
+				});
+				rows += block_rows(codec, h);
+				src_offset += src_pitch * block_rows(codec, h);
+				dst_offset += w * h * dst_vexel;
+			}
+		}
+	if (layout.byte_count && src_offset > layout.byte_count)
+		return false;
+
+	decode_images(codec, *converter, images, rows);
+	return true;
+}
+
+DLL_FNC(bool) fetch_block_vexel(const vexel_surface_t& src, uint32_t x, uint32_t y, float rgba[4])
+{
+	block_codec_t codec;
+	if (!resolve_codec(src.format, codec) || x >= src.layout.object_size.width || y >= src.layout.object_size.height)
+		return false;
+	const vexel_converter_t* converter = vexel_converter(codec.decoded, vexel_format_t::VEC4_F32().space(codec.decoded.space()));
+	if (!converter)
+		return false;
+
+	const uint64_t pitch = src.row_byte_count[0] ? src.row_byte_count[0] : block_row_bytes(codec, src.layout.object_size.width);
+	const uint8_t* block = static_cast<const uint8_t*>(src.planes[0]) + (y / codec.height) * pitch + (x / codec.width) * codec.block_bytes;
+	alignas(16) uint8_t tile[16 * 8];
+	if (codec.fetch) {
+		codec.fetch(block, x % codec.width, y % codec.height, tile);
+		convert(*converter, tile, rgba, 1);
+		return true;
+	}
+	codec.decode(select_bc_kernels(), block, tile, 4 * codec.texel_bytes);
+	convert(*converter, tile + ((y & 3) * 4 + (x & 3)) * codec.texel_bytes, rgba, 1);
+	return true;
+}
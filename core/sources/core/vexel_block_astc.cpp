@@ -0,0 +1,1117 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <simd/simd_conversions.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+#include "vexel_block_internal.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#elif defined(__aarch64__)
+#	include <arm_neon.h>
+#endif
+
+// Decodificador ASTC 2D (perfiles LDR y HDR de Khronos). Cada bloque se lee a un astc_block_t (extremos de 16 bits
+// por partición y pesos de la rejilla ya descuantizados) y después se evalúan sus vexels en dos pasos por SIMD: el
+// infill bilineal de la rejilla de pesos (gather de AVX2) y la interpolación de los extremos de la partición de cada
+// vexel (permutación de AVX2 o tbl de NEON). Lo que sólo depende de la huella se calcula una vez y se guarda en
+// astc_footprint_t: los 2048 modos de bloque, las tablas de infill de cada tamaño de rejilla y, al primer uso de
+// cada número de particiones, las 1024 tablas de partición.
+
+namespace {
+
+	using namespace vexel_block_internal;
+
+	constexpr int kMaxTexels = 144;						// 12x12
+	constexpr int kTexelStride = kMaxTexels + 8;		// lecturas vectoriales de 8 vexels más allá del último
+	constexpr int kMaxWeights = 64;
+	constexpr int kWeightStride = kMaxWeights + 16;		// vecinos (+1, +ancho, +ancho+1) de la última fila
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Lectura de bits
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint64_t reverse64(uint64_t v)
+	{
+		v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+		v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+		v = ((v >> 4) & 0x0f0f0f0f0f0f0f0full) | ((v & 0x0f0f0f0f0f0f0f0full) << 4);
+		v = ((v >> 8) & 0x00ff00ff00ff00ffull) | ((v & 0x00ff00ff00ff00ffull) << 8);
+		v = ((v >> 16) & 0x0000ffff0000ffffull) | ((v & 0x0000ffff0000ffffull) << 16);
+		return (v >> 32) | (v << 32);
+	}
+
+	// 128 bits con acceso por posición; más allá del bit 127 se lee 0
+	struct astc_bits_t {
+		uint64_t	lo = 0;
+		uint64_t	hi = 0;
+
+		uint32_t get(int pos, int n) const
+		{
+			if (pos >= 128 || n == 0) return 0;
+			const uint64_t v = pos >= 64 ? hi >> (pos - 64) : (lo >> pos) | (pos ? hi << (64 - pos) : 0);
+			return (uint32_t)(v & ((1ull << n) - 1));
+		}
+
+		// Los bits desde end valen 0 (los valores de una secuencia incompleta)
+		astc_bits_t below(int end) const
+		{
+			astc_bits_t r = *this;
+			if (end < 64) {
+				r.lo &= (1ull << end) - 1;
+				r.hi = 0;
+			} else if (end < 128) {
+				r.hi &= (1ull << (end - 64)) - 1;
+			}
+			return r;
+		}
+
+		// Los pesos se guardan desde el bit 127 hacia abajo
+		astc_bits_t reversed() const { return { reverse64(hi), reverse64(lo) }; }
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Secuencias de enteros (ISE)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// n bits más, opcionalmente, un trit (x3) o un quint (x5) por valor; en orden creciente de niveles (2..256)
+	struct ise_range_t {
+		uint8_t bits;
+		uint8_t trits;
+		uint8_t quints;
+	};
+
+	constexpr ise_range_t kRanges[21] = {
+		{ 1, 0, 0 }, { 0, 1, 0 }, { 2, 0, 0 }, { 0, 0, 1 }, { 1, 1, 0 }, { 3, 0, 0 }, { 1, 0, 1 },
+		{ 2, 1, 0 }, { 4, 0, 0 }, { 2, 0, 1 }, { 3, 1, 0 }, { 5, 0, 0 }, { 3, 0, 1 }, { 4, 1, 0 },
+		{ 6, 0, 0 }, { 4, 0, 1 }, { 5, 1, 0 }, { 7, 0, 0 }, { 5, 0, 1 }, { 6, 1, 0 }, { 8, 0, 0 },
+	};
+
+	constexpr int kMinColorRange = 4;	// 0..5: con menos niveles el bloque no es válido
+
+	constexpr int ise_bit_count(int range, int count)
+	{
+		const ise_range_t& r = kRanges[range];
+		return r.bits * count + (r.trits ? (8 * count + 4) / 5 : 0) + (r.quints ? (7 * count + 2) / 3 : 0);
+	}
+
+	// 8 bits -> 5 trits y 7 bits -> 3 quints (tablas de decodificación de la especificación)
+	struct ise_tables_t {
+		uint8_t trits[256][5];
+		uint8_t quints[128][3];
+	};
+
+	constexpr ise_tables_t make_ise_tables()
+	{
+		ise_tables_t t = {};
+		for (int T = 0; T < 256; ++T) {
+			int C, t4, t3, t2, t1, t0;
+			if (((T >> 2) & 7) == 7) {
+				C = ((T >> 5) & 7) << 2 | (T & 3);
+				t4 = t3 = 2;
+			} else {
+				C = T & 31;
+				if (((T >> 5) & 3) == 3) {
+					t4 = 2;
+					t3 = (T >> 7) & 1;
+				} else {
+					t4 = (T >> 7) & 1;
+					t3 = (T >> 5) & 3;
+				}
+			}
+			if ((C & 3) == 3) {
+				t2 = 2;
+				t1 = (C >> 4) & 1;
+				t0 = ((C >> 3) & 1) << 1 | (((C >> 2) & 1) & ~(C >> 3) & 1);
+			} else if (((C >> 2) & 3) == 3) {
+				t2 = t1 = 2;
+				t0 = C & 3;
+			} else {
+				t2 = (C >> 4) & 1;
+				t1 = (C >> 2) & 3;
+				t0 = ((C >> 1) & 1) << 1 | (C & 1 & ~(C >> 1));
+			}
+			const int v[5] = { t0, t1, t2, t3, t4 };
+			for (int i = 0; i < 5; ++i) t.trits[T][i] = (uint8_t)v[i];
+		}
+		for (int Q = 0; Q < 128; ++Q) {
+			int q2, q1, q0;
+			if (((Q >> 1) & 3) == 3 && ((Q >> 5) & 3) == 0) {
+				q2 = (Q & 1) << 2 | (((Q >> 4) & 1) & ~Q & 1) << 1 | (((Q >> 3) & 1) & ~Q & 1);
+				q1 = q0 = 4;
+			} else {
+				int C;
+				if (((Q >> 1) & 3) == 3) {
+					q2 = 4;
+					C = ((Q >> 3) & 3) << 3 | (~(Q >> 5) & 3) << 1 | (Q & 1);
+				} else {
+					q2 = (Q >> 5) & 3;
+					C = Q & 31;
+				}
+				if ((C & 7) == 5) {
+					q1 = 4;
+					q0 = (C >> 3) & 3;
+				} else {
+					q1 = (C >> 3) & 3;
+					q0 = C & 7;
+				}
+			}
+			t.quints[Q][0] = (uint8_t)q0;
+			t.quints[Q][1] = (uint8_t)q1;
+			t.quints[Q][2] = (uint8_t)q2;
+		}
+		return t;
+	}
+
+	constexpr ise_tables_t kISE = make_ise_tables();
+
+	// count valores desde el bit pos; los bloques de trits / quints intercalan sus bits con los de cada valor
+	void decode_ise(int range, int count, const astc_bits_t& bits, int pos, uint8_t* out)
+	{
+		const ise_range_t& r = kRanges[range];
+		const int n = r.bits;
+		const auto read = [&](int k) { const uint32_t v = bits.get(pos, k); pos += k; return v; };
+		if (r.trits) {
+			constexpr uint8_t kBits[5] = { 2, 2, 1, 2, 1 };
+			for (int i = 0; i < count; i += 5) {
+				uint32_t m[5], T = 0;
+				for (int j = 0, s = 0; j < 5; s += kBits[j++]) {
+					m[j] = read(n);
+					T |= read(kBits[j]) << s;
+				}
+				for (int j = 0; j < 5 && i + j < count; ++j) out[i + j] = (uint8_t)(kISE.trits[T][j] << n | m[j]);
+			}
+		} else if (r.quints) {
+			constexpr uint8_t kBits[3] = { 3, 2, 2 };
+			for (int i = 0; i < count; i += 3) {
+				uint32_t m[3], Q = 0;
+				for (int j = 0, s = 0; j < 3; s += kBits[j++]) {
+					m[j] = read(n);
+					Q |= read(kBits[j]) << s;
+				}
+				for (int j = 0; j < 3 && i + j < count; ++j) out[i + j] = (uint8_t)(kISE.quints[Q][j] << n | m[j]);
+			}
+		} else {
+			for (int i = 0; i < count; ++i) out[i] = (uint8_t)read(n);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Descuantización
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Con trits y quints el valor es D * C + B, con B formado por los bits del valor según el patrón (de bit alto a
+	// bajo, 'b' = bit 1, 'c' = bit 2...) y el bit 0 invirtiéndolo todo (A)
+	struct unquantize_rule_t {
+		uint8_t		range;
+		uint16_t	c;
+		const char*	b;
+	};
+
+	constexpr unquantize_rule_t kColorRules[] = {
+		{ 4, 204, "000000000" }, { 6, 113, "000000000" }, { 7, 93, "b000b0bb0" }, { 9, 54, "b0000bb00" },
+		{ 10, 44, "cb000cbcb" }, { 12, 26, "cb0000cbc" }, { 13, 22, "dcb000dcb" }, { 15, 13, "dcb0000dc" },
+		{ 16, 11, "edcb000ed" }, { 18, 6, "edcb0000e" }, { 19, 5, "fedcb000f" },
+	};
+
+	constexpr unquantize_rule_t kWeightRules[] = {
+		{ 4, 50, "0000000" }, { 6, 28, "0000000" }, { 7, 23, "b000b0b" }, { 9, 13, "b0000b0" }, { 10, 11, "cb000cb" },
+	};
+
+	constexpr int pattern_bits(const char* pattern, int m)
+	{
+		int v = 0;
+		for (; *pattern; ++pattern) v = v << 1 | (*pattern == '0' ? 0 : (m >> (*pattern - 'a')) & 1);
+		return v;
+	}
+
+	struct unquantize_tables_t {
+		uint8_t color[21][256];		// 0..255
+		uint8_t weight[12][32];		// 0..64
+	};
+
+	constexpr unquantize_tables_t make_unquantize_tables()
+	{
+		unquantize_tables_t t = {};
+		for (int range = 0; range < 21; ++range) {
+			const int n = kRanges[range].bits;
+			if (kRanges[range].trits || kRanges[range].quints) continue;
+			for (int v = 0; v < (1 << n); ++v) {
+				int c = 0, w = 0;
+				for (int s = 8 - n; s > -n; s -= n) c |= s >= 0 ? v << s : v >> -s;
+				for (int s = 6 - n; s > -n; s -= n) w |= s >= 0 ? v << s : v >> -s;
+				t.color[range][v] = (uint8_t)c;
+				if (range < 12) t.weight[range][v] = (uint8_t)(w > 32 ? w + 1 : w);
+			}
+		}
+		for (const unquantize_rule_t& r : kColorRules) {
+			const int n = kRanges[r.range].bits;
+			const int d = kRanges[r.range].trits ? 3 : 5;
+			for (int v = 0; v < (d << n); ++v) {
+				const int m = v & ((1 << n) - 1);
+				const int a = (m & 1) ? 0x1ff : 0;
+				const int u = ((v >> n) * r.c + pattern_bits(r.b, m)) ^ a;
+				t.color[r.range][v] = (uint8_t)((a & 0x80) | (u >> 2));
+			}
+		}
+		for (const unquantize_rule_t& r : kWeightRules) {
+			const int n = kRanges[r.range].bits;
+			const int d = kRanges[r.range].trits ? 3 : 5;
+			for (int v = 0; v < (d << n); ++v) {
+				const int m = v & ((1 << n) - 1);
+				const int a = (m & 1) ? 0x7f : 0;
+				const int u = (a & 0x20) | ((((v >> n) * r.c + pattern_bits(r.b, m)) ^ a) >> 2);
+				t.weight[r.range][v] = (uint8_t)(u > 32 ? u + 1 : u);
+			}
+		}
+		// Sin bits: los trits y quints se reparten directamente en 0..64
+		for (int v = 0; v < 3; ++v) t.weight[1][v] = (uint8_t)(32 * v);
+		for (int v = 0; v < 5; ++v) t.weight[3][v] = (uint8_t)(16 * v);
+		return t;
+	}
+
+	constexpr unquantize_tables_t kUnquantize = make_unquantize_tables();
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Huellas: modos de bloque, infill y particiones
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct astc_mode_t {
+		uint8_t	grid_width;		// 0: modo reservado o que no cabe en la huella
+		uint8_t	grid_height;
+		uint8_t	range;			// de los pesos, índice en kRanges
+		uint8_t	bit_count;
+		bool	dual_plane;
+	};
+
+	// Peso de cada vexel: rejilla[base] * f0 + [base + 1] * f1 + [base + ancho] * f2 + [base + ancho + 1] * f3, /16
+	struct astc_grid_t {
+		alignas(16) uint8_t	base[kTexelStride];
+		alignas(16) uint8_t	factor[4][kTexelStride];
+		uint8_t				width;
+	};
+
+	struct astc_footprint_t {
+		uint8_t							width;
+		uint8_t							height;
+		uint8_t							texels;
+		astc_mode_t						modes[2048];
+		std::unique_ptr<astc_grid_t>	grids[11][11];		// [ancho - 2][alto - 2] de la rejilla
+		std::once_flag					partition_once[3];
+		std::unique_ptr<uint8_t[]>		partitions[3];		// 2..4 particiones: 1024 semillas x texels (+8)
+	};
+
+	// Campos del modo de bloque (bits 0..10) según la tabla de la especificación
+	astc_mode_t decode_block_mode(uint32_t mode, int width, int height)
+	{
+		const int a = (mode >> 5) & 3;
+		int r = (mode >> 4) & 1, h = (mode >> 9) & 1, d = (mode >> 10) & 1, gw = 0, gh = 0;
+		if (mode & 3) {
+			r |= (mode & 3) << 1;
+			const int b = (mode >> 7) & 3;
+			switch ((mode >> 2) & 3) {
+			case 0:	gw = b + 4; gh = a + 2; break;
+			case 1:	gw = b + 8; gh = a + 2; break;
+			case 2:	gw = a + 2; gh = b + 8; break;
+			default:
+				if (mode & 0x100) {
+					gw = (b & 1) + 2;
+					gh = a + 2;
+				} else {
+					gw = a + 2;
+					gh = (b & 1) + 6;
+				}
+				break;
+			}
+		} else {
+			r |= ((mode >> 2) & 3) << 1;
+			if (!((mode >> 2) & 3)) return {};
+			const int b = (mode >> 9) & 3;
+			switch ((mode >> 7) & 3) {
+			case 0:	gw = 12; gh = a + 2; break;
+			case 1:	gw = a + 2; gh = 12; break;
+			case 2:	gw = a + 6; gh = b + 6; d = h = 0; break;
+			default:
+				if (a > 1) return {};
+				gw = a ? 10 : 6;
+				gh = a ? 6 : 10;
+				break;
+			}
+		}
+		const int range = r - 2 + 6 * h;
+		const int count = gw * gh * (d + 1);
+		const int bits = ise_bit_count(range, count);
+		if (gw > width || gh > height || count > kMaxWeights || bits < 24 || bits > 96)
+			return {};
+		return { (uint8_t)gw, (uint8_t)gh, (uint8_t)range, (uint8_t)bits, d != 0 };
+	}
+
+	std::unique_ptr<astc_grid_t> make_grid(int width, int height, int gw, int gh)
+	{
+		auto g = std::make_unique<astc_grid_t>();
+		std::memset(g.get(), 0, sizeof(astc_grid_t));
+		g->width = (uint8_t)gw;
+		const int ds = (1024 + width / 2) / (width - 1);
+		const int dt = (1024 + height / 2) / (height - 1);
+		for (int t = 0; t < height; ++t)
+			for (int s = 0; s < width; ++s) {
+				const int i = t * width + s;
+				const int gs = (ds * s * (gw - 1) + 32) >> 6;
+				const int gt = (dt * t * (gh - 1) + 32) >> 6;
+				const int fs = gs & 15, ft = gt & 15;
+				const int w11 = (fs * ft + 8) >> 4;
+				g->base[i] = (uint8_t)((gs >> 4) + (gt >> 4) * gw);
+				g->factor[0][i] = (uint8_t)(16 - fs - ft + w11);
+				g->factor[1][i] = (uint8_t)(fs - w11);
+				g->factor[2][i] = (uint8_t)(ft - w11);
+				g->factor[3][i] = (uint8_t)w11;
+			}
+		return g;
+	}
+
+	void build_footprint(astc_footprint_t& f, int width, int height)
+	{
+		f.width = (uint8_t)width;
+		f.height = (uint8_t)height;
+		f.texels = (uint8_t)(width * height);
+		for (uint32_t m = 0; m < 2048; ++m) {
+			const astc_mode_t mode = decode_block_mode(m, width, height);
+			f.modes[m] = mode;
+			if (!mode.grid_width) continue;
+			std::unique_ptr<astc_grid_t>& grid = f.grids[mode.grid_width - 2][mode.grid_height - 2];
+			if (!grid) grid = make_grid(width, height, mode.grid_width, mode.grid_height);
+		}
+	}
+
+	uint32_t hash52(uint32_t v)
+	{
+		v ^= v >> 15;
+		v *= 0xeede0891;
+		v ^= v >> 5;
+		v += v << 16;
+		v ^= v >> 7;
+		v ^= v >> 3;
+		v ^= v << 6;
+		v ^= v >> 17;
+		return v;
+	}
+
+	// Partición del vexel (x, y) según el hash de la especificación; los bloques de menos de 31 vexels duplican
+	// las coordenadas
+	int select_partition(int seed, int x, int y, int partitions, bool small)
+	{
+		if (small) {
+			x <<= 1;
+			y <<= 1;
+		}
+		seed += (partitions - 1) * 1024;
+		const uint32_t rnum = hash52((uint32_t)seed);
+		uint8_t s[8];
+		for (int i = 0; i < 8; ++i) s[i] = (uint8_t)((rnum >> (4 * i)) & 15);
+		for (uint8_t& v : s) v = (uint8_t)(v * v);
+
+		int sh1, sh2;
+		if (seed & 1) {
+			sh1 = (seed & 2) ? 4 : 5;
+			sh2 = partitions == 3 ? 6 : 5;
+		} else {
+			sh1 = partitions == 3 ? 6 : 5;
+			sh2 = (seed & 2) ? 4 : 5;
+		}
+		for (int i = 0; i < 8; ++i) s[i] >>= (i & 1) ? sh2 : sh1;
+
+		// Los seeds 9..12 sólo afectan a z, que en 2D es 0
+		const int a = (s[0] * x + s[1] * y + (int)(rnum >> 14)) & 0x3f;
+		const int b = (s[2] * x + s[3] * y + (int)(rnum >> 10)) & 0x3f;
+		const int c = partitions < 3 ? 0 : (s[4] * x + s[5] * y + (int)(rnum >> 6)) & 0x3f;
+		const int d = partitions < 4 ? 0 : (s[6] * x + s[7] * y + (int)(rnum >> 2)) & 0x3f;
+		if (a >= b && a >= c && a >= d) return 0;
+		if (b >= c && b >= d) return 1;
+		return c >= d ? 2 : 3;
+	}
+
+	const uint8_t* partition_table(astc_footprint_t& f, int partitions, int seed)
+	{
+		std::call_once(f.partition_once[partitions - 2], [&] {
+			const int n = f.texels;
+			auto table = std::make_unique<uint8_t[]>(1024 * n + 8);
+			for (int p = 0; p < 1024; ++p)
+				for (int i = 0; i < n; ++i)
+					table[p * n + i] = (uint8_t)select_partition(p, i % f.width, i / f.width, partitions, n < 31);
+			std::memset(table.get() + 1024 * n, 0, 8);
+			f.partitions[partitions - 2] = std::move(table);
+		});
+		return f.partitions[partitions - 2].get() + seed * f.texels;
+	}
+
+	constexpr uint8_t kFootprints[14][2] = {
+		{ 4, 4 }, { 5, 4 }, { 5, 5 }, { 6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 },
+		{ 8, 8 }, { 10, 5 }, { 10, 6 }, { 10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 },
+	};
+
+	astc_footprint_t* find_footprint(int width, int height)
+	{
+		static astc_footprint_t footprints[14];
+		static std::once_flag once[14];
+		for (int i = 0; i < 14; ++i)
+			if (kFootprints[i][0] == width && kFootprints[i][1] == height) {
+				std::call_once(once[i], build_footprint, std::ref(footprints[i]), width, height);
+				return &footprints[i];
+			}
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Extremos
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Extremos de 16 bits de una partición por canal: LDR como unorm16, HDR como LNS (12 bits << 4)
+	struct astc_endpoints_t {
+		int		e0[4];
+		int		e1[4];
+		bool	hdr_rgb;
+		bool	hdr_alpha;
+	};
+
+	void bit_transfer_signed(int& a, int& b)
+	{
+		b = (b >> 1) | (a & 0x80);
+		a = (a >> 1) & 0x3f;
+		if (a & 0x20) a -= 0x40;
+	}
+
+	void blue_contract(int* c)
+	{
+		c[0] = (c[0] + c[2]) >> 1;
+		c[1] = (c[1] + c[2]) >> 1;
+	}
+
+	void set_ldr(astc_endpoints_t& e, int r0, int g0, int b0, int a0, int r1, int g1, int b1, int a1)
+	{
+		const int v0[4] = { r0, g0, b0, a0 }, v1[4] = { r1, g1, b1, a1 };
+		for (int c = 0; c < 4; ++c) {
+			e.e0[c] = clamp8(v0[c]);
+			e.e1[c] = clamp8(v1[c]);
+		}
+	}
+
+	// RGB directo (modos 8 y 12) y base + desplazamiento (9 y 13); el orden de los extremos activa blue_contract
+	void ldr_rgb(astc_endpoints_t& e, int* v, bool offset, bool alpha)
+	{
+		int a0 = alpha ? v[6] : 255, a1 = alpha ? v[7] : 255;
+		int c0[3], c1[3];
+		bool swap;
+		if (offset) {
+			bit_transfer_signed(v[1], v[0]);
+			bit_transfer_signed(v[3], v[2]);
+			bit_transfer_signed(v[5], v[4]);
+			if (alpha) {
+				bit_transfer_signed(v[7], v[6]);
+				a0 = v[6];
+				a1 = v[6] + v[7];
+			}
+			for (int c = 0; c < 3; ++c) {
+				c0[c] = v[2 * c];
+				c1[c] = v[2 * c] + v[2 * c + 1];
+			}
+			swap = v[1] + v[3] + v[5] < 0;
+		} else {
+			for (int c = 0; c < 3; ++c) {
+				c0[c] = v[2 * c];
+				c1[c] = v[2 * c + 1];
+			}
+			swap = c1[0] + c1[1] + c1[2] < c0[0] + c0[1] + c0[2];
+		}
+		if (swap) {
+			std::swap(c0, c1);
+			std::swap(a0, a1);
+			blue_contract(c0);
+			blue_contract(c1);
+		}
+		set_ldr(e, c0[0], c0[1], c0[2], a0, c1[0], c1[1], c1[2], a1);
+	}
+
+	void hdr_rgb_scale(astc_endpoints_t& e, const int* v)
+	{
+		const int modeval = ((v[0] & 0xc0) >> 6) | ((v[1] & 0x80) >> 7) << 2 | ((v[2] & 0x80) >> 7) << 3;
+		int major, mode;
+		if ((modeval & 0xc) != 0xc) {
+			major = modeval >> 2;
+			mode = modeval & 3;
+		} else if (modeval != 0xf) {
+			major = modeval & 3;
+			mode = 4;
+		} else {
+			major = 0;
+			mode = 5;
+		}
+
+		int red = v[0] & 0x3f, green = v[1] & 0x1f, blue = v[2] & 0x1f, scale = v[3] & 0x1f;
+		const int bit0 = (v[1] >> 6) & 1, bit1 = (v[1] >> 5) & 1, bit2 = (v[2] >> 6) & 1, bit3 = (v[2] >> 5) & 1;
+		const int bit4 = (v[3] >> 7) & 1, bit5 = (v[3] >> 6) & 1, bit6 = (v[3] >> 5) & 1;
+		const int oh = 1 << mode;
+		if (oh & 0x30) green |= bit0 << 6;
+		if (oh & 0x3a) green |= bit1 << 5;
+		if (oh & 0x30) blue |= bit2 << 6;
+		if (oh & 0x3a) blue |= bit3 << 5;
+		if (oh & 0x3d) scale |= bit6 << 5;
+		if (oh & 0x2d) scale |= bit5 << 6;
+		if (oh & 0x04) scale |= bit4 << 7;
+		if (oh & 0x3b) red |= bit4 << 6;
+		if (oh & 0x04) red |= bit3 << 6;
+		if (oh & 0x10) red |= bit5 << 7;
+		if (oh & 0x0f) red |= bit2 << 7;
+		if (oh & 0x05) red |= bit1 << 8;
+		if (oh & 0x0a) red |= bit0 << 8;
+		if (oh & 0x05) red |= bit0 << 9;
+		if (oh & 0x02) red |= bit6 << 9;
+		if (oh & 0x01) red |= bit3 << 10;
+		if (oh & 0x02) red |= bit5 << 10;
+
+		constexpr int kShift[6] = { 1, 1, 2, 3, 4, 5 };
+		red <<= kShift[mode];
+		green <<= kShift[mode];
+		blue <<= kShift[mode];
+		scale <<= kShift[mode];
+		if (mode != 5) {
+			green = red - green;
+			blue = red - blue;
+		}
+		if (major == 1) std::swap(red, green);
+		else if (major == 2) std::swap(red, blue);
+
+		const int c1[3] = { red, green, blue };
+		for (int c = 0; c < 3; ++c) {
+			e.e0[c] = std::max(c1[c] - scale, 0) << 4;
+			e.e1[c] = std::max(c1[c], 0) << 4;
+		}
+	}
+
+	void hdr_rgb_direct(astc_endpoints_t& e, const int* v)
+	{
+		const int modeval = ((v[1] & 0x80) >> 7) | ((v[2] & 0x80) >> 7) << 1 | ((v[3] & 0x80) >> 7) << 2;
+		const int major = ((v[4] & 0x80) >> 7) | ((v[5] & 0x80) >> 7) << 1;
+		if (major == 3) {
+			const int c0[3] = { v[0] << 8, v[2] << 8, (v[4] & 0x7f) << 9 };
+			const int c1[3] = { v[1] << 8, v[3] << 8, (v[5] & 0x7f) << 9 };
+			for (int c = 0; c < 3; ++c) {
+				e.e0[c] = c0[c];
+				e.e1[c] = c1[c];
+			}
+			return;
+		}
+
+		int a = v[0] | ((v[1] & 0x40) << 2), b0 = v[2] & 0x3f, b1 = v[3] & 0x3f, c = v[1] & 0x3f;
+		int d0 = v[4] & 0x7f, d1 = v[5] & 0x7f;
+		constexpr int kDBits[8] = { 7, 6, 7, 6, 5, 6, 5, 6 };
+		const int bit0 = (v[2] >> 6) & 1, bit1 = (v[3] >> 6) & 1, bit2 = (v[4] >> 6) & 1;
+		const int bit3 = (v[5] >> 6) & 1, bit4 = (v[4] >> 5) & 1, bit5 = (v[5] >> 5) & 1;
+		const int oh = 1 << modeval;
+		if (oh & 0xa4) a |= bit0 << 9;
+		if (oh & 0x08) a |= bit2 << 9;
+		if (oh & 0x50) a |= bit4 << 9;
+		if (oh & 0x50) a |= bit5 << 10;
+		if (oh & 0xa0) a |= bit1 << 10;
+		if (oh & 0xc0) a |= bit2 << 11;
+		if (oh & 0x04) c |= bit1 << 6;
+		if (oh & 0xe8) c |= bit3 << 6;
+		if (oh & 0x20) c |= bit2 << 7;
+		if (oh & 0x5b) b0 |= bit0 << 6;
+		if (oh & 0x5b) b1 |= bit1 << 6;
+		if (oh & 0x12) b0 |= bit2 << 7;
+		if (oh & 0x12) b1 |= bit3 << 7;
+		if (oh & 0xaf) d0 |= bit4 << 5;
+		if (oh & 0xaf) d1 |= bit5 << 5;
+		if (oh & 0x05) d0 |= bit2 << 6;
+		if (oh & 0x05) d1 |= bit3 << 6;
+		const int sign = 1 << (kDBits[modeval] - 1);
+		d0 = ((d0 & (2 * sign - 1)) ^ sign) - sign;
+		d1 = ((d1 & (2 * sign - 1)) ^ sign) - sign;
+
+		// Todo a 12 bits; se desplaza multiplicando para no desplazar negativos
+		const int scale = 1 << ((modeval >> 1) ^ 3);
+		a *= scale;
+		b0 *= scale;
+		b1 *= scale;
+		c *= scale;
+		d0 *= scale;
+		d1 *= scale;
+
+		int c0[3] = { a - c, a - b0 - c - d0, a - b1 - c - d1 };
+		int c1[3] = { a, a - b0, a - b1 };
+		if (major == 1) {
+			std::swap(c0[0], c0[1]);
+			std::swap(c1[0], c1[1]);
+		} else if (major == 2) {
+			std::swap(c0[0], c0[2]);
+			std::swap(c1[0], c1[2]);
+		}
+		for (int i = 0; i < 3; ++i) {
+			e.e0[i] = std::clamp(c0[i], 0, 0xfff) << 4;
+			e.e1[i] = std::clamp(c1[i], 0, 0xfff) << 4;
+		}
+	}
+
+	void hdr_alpha(astc_endpoints_t& e, int v6, int v7)
+	{
+		const int selector = ((v6 >> 7) & 1) | ((v7 >> 6) & 2);
+		v6 &= 0x7f;
+		v7 &= 0x7f;
+		if (selector == 3) {
+			e.e0[3] = v6 << 9;
+			e.e1[3] = v7 << 9;
+			return;
+		}
+		v6 |= (v7 << (selector + 1)) & 0x780;
+		v7 &= 0x3f >> selector;
+		v7 ^= 32 >> selector;
+		v7 -= 32 >> selector;
+		v6 <<= 4 - selector;
+		v7 = v6 + v7 * (1 << (4 - selector));
+		e.e0[3] = v6 << 4;
+		e.e1[3] = std::clamp(v7, 0, 0xfff) << 4;
+	}
+
+	void hdr_luminance(astc_endpoints_t& e, int y0, int y1)
+	{
+		for (int c = 0; c < 3; ++c) {
+			e.e0[c] = y0 << 4;
+			e.e1[c] = y1 << 4;
+		}
+		e.e0[3] = e.e1[3] = 0x7800;		// 1.0 en LNS
+		e.hdr_alpha = true;
+	}
+
+	// Los valores ya descuantizados a 0..255 de un modo de color -> extremos de 16 bits
+	void unpack_endpoints(int cem, const uint8_t* values, bool srgb, astc_endpoints_t& e)
+	{
+		int v[8];
+		for (int i = 0; i < 2 * (cem / 4 + 1); ++i) v[i] = values[i];
+		e.hdr_rgb = e.hdr_alpha = false;
+		switch (cem) {
+		case 0:		set_ldr(e, v[0], v[0], v[0], 255, v[1], v[1], v[1], 255); break;
+		case 1: {
+			const int l0 = (v[0] >> 2) | (v[1] & 0xc0);
+			set_ldr(e, l0, l0, l0, 255, std::min(l0 + (v[1] & 0x3f), 255), std::min(l0 + (v[1] & 0x3f), 255), std::min(l0 + (v[1] & 0x3f), 255), 255);
+			break;
+		}
+		case 2:
+			e.hdr_rgb = true;
+			if (v[1] >= v[0]) hdr_luminance(e, v[0] << 4, v[1] << 4);
+			else hdr_luminance(e, (v[1] << 4) + 8, (v[0] << 4) - 8);
+			break;
+		case 3: {
+			e.hdr_rgb = true;
+			int y0, d;
+			if (v[0] & 0x80) {
+				y0 = ((v[1] & 0xe0) << 4) | ((v[0] & 0x7f) << 2);
+				d = (v[1] & 0x1f) << 2;
+			} else {
+				y0 = ((v[1] & 0xf0) << 4) | ((v[0] & 0x7f) << 1);
+				d = (v[1] & 0x0f) << 1;
+			}
+			hdr_luminance(e, y0, std::min(y0 + d, 0xfff));
+			break;
+		}
+		case 4:		set_ldr(e, v[0], v[0], v[0], v[2], v[1], v[1], v[1], v[3]); break;
+		case 5:
+			bit_transfer_signed(v[1], v[0]);
+			bit_transfer_signed(v[3], v[2]);
+			set_ldr(e, v[0], v[0], v[0], v[2], v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+			break;
+		case 6:
+			set_ldr(e, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, 255, v[0], v[1], v[2], 255);
+			break;
+		case 7:
+			e.hdr_rgb = true;
+			hdr_rgb_scale(e, v);
+			e.e0[3] = e.e1[3] = 0x7800;
+			e.hdr_alpha = true;
+			break;
+		case 8:		ldr_rgb(e, v, false, false); break;
+		case 9:		ldr_rgb(e, v, true, false); break;
+		case 10:
+			set_ldr(e, (v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, v[4], v[0], v[1], v[2], v[5]);
+			break;
+		case 11:
+			e.hdr_rgb = true;
+			hdr_rgb_direct(e, v);
+			e.e0[3] = e.e1[3] = 0x7800;
+			e.hdr_alpha = true;
+			break;
+		case 12:	ldr_rgb(e, v, false, true); break;
+		case 13:	ldr_rgb(e, v, true, true); break;
+		case 14:
+			e.hdr_rgb = true;
+			hdr_rgb_direct(e, v);
+			e.e0[3] = v[6];
+			e.e1[3] = v[7];
+			break;
+		default:
+			e.hdr_rgb = e.hdr_alpha = true;
+			hdr_rgb_direct(e, v);
+			hdr_alpha(e, v[6], v[7]);
+			break;
+		}
+
+		// LDR a unorm16: replicando el byte, o con 0x80 abajo en sRGB
+		for (int c = 0; c < 4; ++c) {
+			if (c < 3 ? e.hdr_rgb : e.hdr_alpha) continue;
+			e.e0[c] = srgb ? e.e0[c] << 8 | 0x80 : e.e0[c] * 257;
+			e.e1[c] = srgb ? e.e1[c] << 8 | 0x80 : e.e1[c] * 257;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Bloques
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	alignas(16) constexpr uint8_t kNoPartition[kTexelStride] = {};
+
+	// Bloque leído. Los extremos van por canal para que cada vector tome los de sus vexels con una permutación.
+	struct astc_block_t {
+		bool				error;
+		bool				constant;			// void extent: todos los vexels valen color
+		bool				constant_hdr;		// color en half en lugar de unorm16
+		uint16_t			color[4];
+		const astc_grid_t*	grid;
+		const uint8_t*		partition;			// partición de cada vexel
+		int					plane2;				// canal con el segundo plano de pesos; -1 sin él
+		alignas(32) int32_t	weights[2][kWeightStride];
+		alignas(16) int32_t	e0[4][4];			// [canal][partición]
+		alignas(16) int32_t	e1[4][4];
+		bool				hdr[4][4];			// [canal][partición]: extremos en LNS
+	};
+
+	void read_block(const uint8_t* data, astc_footprint_t& f, astc_profile_t profile, astc_block_t& b)
+	{
+		b.error = b.constant = false;
+		astc_bits_t bits;
+		std::memcpy(&bits.lo, data, 8);
+		std::memcpy(&bits.hi, data + 8, 8);
+
+		const uint32_t mode_bits = bits.get(0, 11);
+		if ((mode_bits & 0x1ff) == 0x1fc) {
+			// Void extent: las coordenadas sólo sirven para validar el bloque
+			const int s0 = (int)bits.get(12, 13), s1 = (int)bits.get(25, 13), t0 = (int)bits.get(38, 13), t1 = (int)bits.get(51, 13);
+			const bool all_ones = s0 == 0x1fff && s1 == 0x1fff && t0 == 0x1fff && t1 == 0x1fff;
+			b.constant_hdr = (mode_bits >> 9) & 1;
+			b.error = bits.get(10, 2) != 3 || (!all_ones && (s0 >= s1 || t0 >= t1)) ||
+					  (b.constant_hdr && profile != astc_profile_t::HDR);
+			b.constant = true;
+			for (int c = 0; c < 4; ++c) b.color[c] = (uint16_t)bits.get(64 + 16 * c, 16);
+			return;
+		}
+
+		const astc_mode_t& m = f.modes[mode_bits];
+		const int partitions = (int)bits.get(11, 2) + 1;
+		if (!m.grid_width || (partitions == 4 && m.dual_plane)) {
+			b.error = true;
+			return;
+		}
+		b.grid = f.grids[m.grid_width - 2][m.grid_height - 2].get();
+
+		// Modos de color: uno común, o clase base + un bit y dos bits por partición con los bits altos bajo los pesos
+		int below = 128 - m.bit_count, cem[4], color_start = 29;
+		if (partitions == 1) {
+			cem[0] = (int)bits.get(13, 4);
+			color_start = 17;
+			b.partition = kNoPartition;
+		} else {
+			b.partition = partition_table(f, partitions, (int)bits.get(13, 10));
+			const uint32_t selector = bits.get(23, 2);
+			if (!selector) {
+				for (int p = 0; p < partitions; ++p) cem[p] = (int)bits.get(25, 4);
+			} else {
+				const int extra = 3 * partitions - 4;
+				below -= extra;
+				const uint32_t type = bits.get(23, 6) | bits.get(below, extra) << 6;
+				int pos = 2;
+				for (int p = 0; p < partitions; ++p, ++pos) cem[p] = (int)(((type >> pos) & 1) + selector - 1) << 2;
+				for (int p = 0; p < partitions; ++p, pos += 2) cem[p] |= (int)(type >> pos) & 3;
+			}
+		}
+		b.plane2 = -1;
+		if (m.dual_plane) {
+			below -= 2;
+			b.plane2 = (int)bits.get(below, 2);
+		}
+
+		// Los colores usan el mayor rango que cabe entre el modo y los pesos
+		int count = 0;
+		for (int p = 0; p < partitions; ++p) count += 2 * (cem[p] / 4 + 1);
+		int range = 20;
+		while (range >= 0 && ise_bit_count(range, count) > below - color_start) --range;
+		if (count > 18 || range < kMinColorRange) {
+			b.error = true;
+			return;
+		}
+		uint8_t values[18];
+		decode_ise(range, count, bits.below(below), color_start, values);
+		for (int i = 0; i < count; ++i) values[i] = kUnquantize.color[range][values[i]];
+
+		const bool srgb = profile == astc_profile_t::LDR_SRGB;
+		for (int p = 0, v = 0; p < partitions; v += 2 * (cem[p] / 4 + 1), ++p) {
+			astc_endpoints_t e;
+			unpack_endpoints(cem[p], values + v, srgb, e);
+			if ((e.hdr_rgb || e.hdr_alpha) && profile != astc_profile_t::HDR) {
+				b.error = true;
+				return;
+			}
+			for (int c = 0; c < 4; ++c) {
+				b.e0[c][p] = e.e0[c];
+				b.e1[c][p] = e.e1[c];
+				b.hdr[c][p] = c < 3 ? e.hdr_rgb : e.hdr_alpha;
+			}
+		}
+
+		// Pesos: intercalados por plano en la secuencia
+		const int planes = m.dual_plane ? 2 : 1;
+		const int grid_count = m.grid_width * m.grid_height;
+		uint8_t weights[kMaxWeights];
+		decode_ise(m.range, grid_count * planes, bits.reversed().below(m.bit_count), 0, weights);
+		for (int p = 0; p < planes; ++p) {
+			for (int i = 0; i < grid_count; ++i) b.weights[p][i] = kUnquantize.weight[m.range][weights[i * planes + p]];
+			std::fill(b.weights[p] + grid_count, b.weights[p] + kWeightStride, 0);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Kernels
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Entrada de la interpolación: partición y peso de cada vexel (por canal, para el segundo plano)
+	struct astc_lerp_t {
+		const uint8_t*	partition;
+		const uint8_t*	weights[4];
+		const int32_t	(*e0)[4];
+		const int32_t	(*e1)[4];
+	};
+
+	struct astc_kernels_t {
+		void (*infill)(const astc_grid_t& grid, const int32_t* weights, int texels, uint8_t* out);
+		void (*interpolate)(const astc_lerp_t& in, int texels, uint16_t (*out)[kTexelStride]);
+	};
+
+	SIMD_FORCEINLINE int infill_texel(const astc_grid_t& grid, const int32_t* weights, int i)
+	{
+		const int32_t* w = weights + grid.base[i];
+		return (w[0] * grid.factor[0][i] + w[1] * grid.factor[1][i] + w[grid.width] * grid.factor[2][i] +
+				w[grid.width + 1] * grid.factor[3][i] + 8) >> 4;
+	}
+
+	void infill_scalar(const astc_grid_t& grid, const int32_t* weights, int texels, uint8_t* out)
+	{
+		for (int i = 0; i < texels; ++i) out[i] = (uint8_t)infill_texel(grid, weights, i);
+	}
+
+	void interpolate_scalar(const astc_lerp_t& in, int texels, uint16_t (*out)[kTexelStride])
+	{
+		for (int c = 0; c < 4; ++c)
+			for (int i = 0; i < texels; ++i) {
+				const int p = in.partition[i];
+				out[c][i] = (uint16_t)interpolate(in.e0[c][p], in.e1[c][p], in.weights[c][i]);
+			}
+	}
+
+#if defined(SIMD_KERNELS_X86)
+
+	SIMD_TARGET("avx2")
+	inline __m256i load8(const uint8_t* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+
+	// 8 vexels por iteración: los cuatro vecinos de la rejilla con gather
+	SIMD_TARGET("avx2")
+	void infill_avx2(const astc_grid_t& grid, const int32_t* weights, int texels, uint8_t* out)
+	{
+		const __m256i width = _mm256_set1_epi32(grid.width), one = _mm256_set1_epi32(1), round = _mm256_set1_epi32(8);
+		const __m256i order = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+		for (int i = 0; i < texels; i += 8) {
+			const __m256i b0 = load8(grid.base + i), b2 = _mm256_add_epi32(b0, width);
+			__m256i sum = _mm256_mullo_epi32(_mm256_i32gather_epi32(weights, b0, 4), load8(grid.factor[0] + i));
+			sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_i32gather_epi32(weights, _mm256_add_epi32(b0, one), 4), load8(grid.factor[1] + i)));
+			sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_i32gather_epi32(weights, b2, 4), load8(grid.factor[2] + i)));
+			sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_i32gather_epi32(weights, _mm256_add_epi32(b2, one), 4), load8(grid.factor[3] + i)));
+			sum = _mm256_srli_epi32(_mm256_add_epi32(sum, round), 4);
+			// packs por carriles de 128 bits: los bytes 0..3 y 4..7 quedan en los dwords 0 y 4
+			const __m256i bytes = _mm256_packus_epi16(_mm256_packus_epi32(sum, sum), _mm256_setzero_si256());
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(bytes, order)));
+		}
+	}
+
+	// Los extremos de las (hasta 4) particiones se eligen por vexel con una permutación de dwords
+	SIMD_TARGET("avx2")
+	void interpolate_avx2(const astc_lerp_t& in, int texels, uint16_t (*out)[kTexelStride])
+	{
+		__m256i e0[4], e1[4];
+		for (int c = 0; c < 4; ++c) {
+			e0[c] = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in.e0[c])));
+			e1[c] = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in.e1[c])));
+		}
+		const __m256i full = _mm256_set1_epi32(64), round = _mm256_set1_epi32(32);
+		for (int i = 0; i < texels; i += 8) {
+			const __m256i p = load8(in.partition + i);
+			for (int c = 0; c < 4; ++c) {
+				const __m256i w = load8(in.weights[c] + i);
+				const __m256i a = _mm256_mullo_epi32(_mm256_permutevar8x32_epi32(e0[c], p), _mm256_sub_epi32(full, w));
+				const __m256i b = _mm256_mullo_epi32(_mm256_permutevar8x32_epi32(e1[c], p), w);
+				const __m256i v = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(a, b), round), 6);
+				const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out[c] + i), _mm256_castsi256_si128(packed));
+			}
+		}
+	}
+
+#elif defined(__aarch64__)
+
+	// tbl sobre los 4 extremos de 32 bits de cada canal, como las búsquedas de BC1
+	void interpolate_neon(const astc_lerp_t& in, int texels, uint16_t (*out)[kTexelStride])
+	{
+		uint8x16_t e0[4], e1[4];
+		for (int c = 0; c < 4; ++c) {
+			e0[c] = vreinterpretq_u8_s32(vld1q_s32(in.e0[c]));
+			e1[c] = vreinterpretq_u8_s32(vld1q_s32(in.e1[c]));
+		}
+		const uint32x4_t base = vdupq_n_u32(0x03020100), step = vdupq_n_u32(0x04040404), full = vdupq_n_u32(64);
+		const auto load4 = [](const uint8_t* p) { return vmovl_u16(vget_low_u16(vmovl_u8(vld1_u8(p)))); };
+		for (int i = 0; i < texels; i += 4) {
+			const uint8x16_t idx = vreinterpretq_u8_u32(vmlaq_u32(base, load4(in.partition + i), step));
+			for (int c = 0; c < 4; ++c) {
+				const uint32x4_t w = load4(in.weights[c] + i);
+				uint32x4_t v = vmulq_u32(vreinterpretq_u32_u8(vqtbl1q_u8(e0[c], idx)), vsubq_u32(full, w));
+				v = vmlaq_u32(v, vreinterpretq_u32_u8(vqtbl1q_u8(e1[c], idx)), w);
+				vst1_u16(out[c] + i, vmovn_u32(vshrq_n_u32(vaddq_u32(v, vdupq_n_u32(32)), 6)));
+			}
+		}
+	}
+
+#endif
+
+	astc_kernels_t select_astc_kernels()
+	{
+#if defined(SIMD_KERNELS_X86)
+		const simd::isa_t isa = simd::kernels().isa;
+		if (isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512)
+			return { infill_avx2, interpolate_avx2 };
+#elif defined(__aarch64__)
+		return { infill_scalar, interpolate_neon };
+#endif
+		return { infill_scalar, interpolate_scalar };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Salida
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// LNS de 16 bits -> half (curva por tramos de la especificación, sin llegar a infinito)
+	uint16_t lns_to_half(int v)
+	{
+		const int mantissa = v & 0x7ff, exponent = (v >> 11) & 0x1f;
+		const int m = mantissa < 512 ? 3 * mantissa : mantissa >= 1536 ? 5 * mantissa - 2048 : 4 * mantissa - 512;
+		return (uint16_t)std::min((exponent << 10) + (m >> 3), 0x7bff);
+	}
+
+	SIMD_FORCEINLINE uint16_t unorm16_to_half(int v) { return simd::float_to_half((float)v / 65535.0f); }
+
+	// Un vexel en el formato decodificado: RGBA8 con los 8 bits altos en LDR, RGBA half en HDR
+	void store_texel(astc_profile_t profile, const uint16_t* c, const bool* hdr, uint8_t* out)
+	{
+		if (profile != astc_profile_t::HDR) {
+			for (int i = 0; i < 4; ++i) out[i] = (uint8_t)(c[i] >> 8);
+			return;
+		}
+		uint16_t h[4];
+		for (int i = 0; i < 4; ++i) h[i] = hdr[i] ? lns_to_half(c[i]) : unorm16_to_half(c[i]);
+		std::memcpy(out, h, 8);
+	}
+
+	// Magenta opaco para los bloques no válidos; el color del void extent
+	void constant_texel(const astc_block_t& b, astc_profile_t profile, uint8_t* out)
+	{
+		constexpr uint16_t kError[4] = { 0xffff, 0, 0xffff, 0xffff };
+		constexpr bool kUnorm[4] = {};
+		if (b.error) {
+			store_texel(profile, kError, kUnorm, out);
+		} else if (b.constant_hdr) {
+			std::memcpy(out, b.color, 8);
+		} else {
+			store_texel(profile, b.color, kUnorm, out);
+		}
+	}
+
+	size_t texel_bytes(astc_profile_t profile) { return profile == astc_profile_t::HDR ? 8 : 4; }
+
+} // namespace
+
+void vexel_block_internal::decode_astc_block(const uint8_t* block, int width, int height, astc_profile_t profile,
+											 uint8_t* out, size_t pitch)
+{
+	astc_footprint_t* f = find_footprint(width, height);
+	if (!f) return;
+	const size_t bytes = texel_bytes(profile);
+	astc_block_t b;
+	read_block(block, *f, profile, b);
+	if (b.error || b.constant) {
+		uint8_t texel[8];
+		constant_texel(b, profile, texel);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x) std::memcpy(out + y * pitch + x * bytes, texel, bytes);
+		return;
+	}
+
+	const astc_kernels_t k = select_astc_kernels();
+	alignas(32) uint8_t weights[2][kTexelStride];
+	k.infill(*b.grid, b.weights[0], f->texels, weights[0]);
+	astc_lerp_t in = { b.partition, { weights[0], weights[0], weights[0], weights[0] }, b.e0, b.e1 };
+	if (b.plane2 >= 0) {
+		k.infill(*b.grid, b.weights[1], f->texels, weights[1]);
+		in.weights[b.plane2] = weights[1];
+	}
+	alignas(32) uint16_t c[4][kTexelStride];
+	k.interpolate(in, f->texels, c);
+
+	if (profile != astc_profile_t::HDR) {
+		for (int y = 0; y < height; ++y)
+			for (int x = 0, i = y * width; x < width; ++x, ++i) {
+				const uint32_t v = rgba8(c[0][i] >> 8, c[1][i] >> 8, c[2][i] >> 8, c[3][i] >> 8);
+				std::memcpy(out + y * pitch + 4 * x, &v, 4);
+			}
+		return;
+	}
+	for (int i = 0; i < f->texels; ++i) {
+		const int p = b.partition[i];
+		const uint16_t v[4] = { c[0][i], c[1][i], c[2][i], c[3][i] };
+		const bool hdr[4] = { b.hdr[0][p], b.hdr[1][p], b.hdr[2][p], b.hdr[3][p] };
+		store_texel(profile, v, hdr, out + (i / width) * pitch + (i % width) * bytes);
+	}
+}
+
+void vexel_block_internal::fetch_astc_texel(const uint8_t* block, int width, int height, astc_profile_t profile,
+											int x, int y, uint8_t* out)
+{
+	astc_footprint_t* f = find_footprint(width, height);
+	if (!f) return;
+	astc_block_t b;
+	read_block(block, *f, profile, b);
+	if (b.error || b.constant) {
+		constant_texel(b, profile, out);
+		return;
+	}
+
+	// Sólo los cuatro pesos de la rejilla alrededor del vexel y su partición
+	const int i = y * width + x, p = b.partition[i];
+	const int w = infill_texel(*b.grid, b.weights[0], i);
+	const int w2 = b.plane2 >= 0 ? infill_texel(*b.grid, b.weights[1], i) : w;
+	uint16_t c[4];
+	bool hdr[4];
+	for (int ch = 0; ch < 4; ++ch) {
+		c[ch] = (uint16_t)interpolate(b.e0[ch][p], b.e1[ch][p], ch == b.plane2 ? w2 : w);
+		hdr[ch] = b.hdr[ch][p];
+	}
+	store_texel(profile, c, hdr, out);
+}
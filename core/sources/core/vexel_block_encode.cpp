@@ -0,0 +1,929 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_block.h>
+#include <core/threading.h>
+#include <simd/simd_reg_ops.h>
+
+#include "vexel_block_internal.h"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define VEXEL_BLOCK_VOP4 1
+#	include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define VEXEL_BLOCK_VOP4 1
+#	include <arm_neon.h>
+#endif
+
+// Todos los codificadores siguen el mismo esquema: extremos iniciales por el eje principal de los vexels, cuantización
+// al formato, índices por la entrada más cercana de la paleta que calcularía el decodificador y, según la calidad,
+// refinado por mínimos cuadrados con los índices fijos y búsqueda local sobre los extremos cuantizados. fit_palette()
+// es el bucle caliente: se escribe sobre scalar_ops / vec4_ops (interfaz de simd_internal::vop) y evalúa 4 vexels
+// contra cada entrada de la paleta por iteración.
+
+namespace {
+
+	using namespace vexel_block_internal;
+
+	struct scalar_ops {
+		using v_t = float;
+		using m_t = bool;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return s; }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return a + b; }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return a - b; }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return a * b; }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return a < b; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return m ? a : b; }
+		static SIMD_FORCEINLINE v_t load(const float* p) { return *p; }
+		static SIMD_FORCEINLINE void store(float* p, v_t a) { *p = a; }
+	};
+
+#if defined(VEXEL_BLOCK_VOP4)
+	struct vec4_ops : simd_internal::vop<float, 4> {
+#	if defined(__ARM_NEON) || defined(__ARM_NEON__)
+		static SIMD_FORCEINLINE v_t load(const float* p) { return vld1q_f32(p); }
+		static SIMD_FORCEINLINE void store(float* p, v_t a) { vst1q_f32(p, a); }
+#	else
+		static SIMD_FORCEINLINE v_t load(const float* p) { return _mm_loadu_ps(p); }
+		static SIMD_FORCEINLINE void store(float* p, v_t a) { _mm_storeu_ps(p, a); }
+#	endif
+	};
+	using fit_ops = vec4_ops;
+#else
+	using fit_ops = scalar_ops;
+#endif
+
+	// Vexels de un bloque por canales, en la escala de los bytes de la paleta
+	struct block_t {
+		alignas(16) float	px[4][16];
+		alignas(16) float	opaque[16];		// 1 si el vexel cuenta para el color (BC1 con transparencia: alfa >= 128)
+	};
+
+	alignas(16) constexpr float kAll[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Ajuste de paletas
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Entrada de palette (count entradas de C canales) más cercana a cada vexel de px (C filas de 16); devuelve la
+	// suma de los errores cuadráticos de los vexels con mask a 1. index recibe también los vexels fuera de mask.
+	template<typename O, int C>
+	float fit_palette(const float* px, const float* mask, const float* palette, int count, uint8_t* index)
+	{
+		using v_t = typename O::v_t;
+		constexpr int L = sizeof(v_t) / sizeof(float);
+		float total = 0;
+		for (int i = 0; i < 16; i += L) {
+			v_t v[C];
+			for (int c = 0; c < C; ++c) v[c] = O::load(px + 16 * c + i);
+			v_t best = O::set1(FLT_MAX), best_index = O::set1(0.f);
+			for (int e = 0; e < count; ++e) {
+				v_t d = O::set1(0.f);
+				for (int c = 0; c < C; ++c) {
+					const v_t t = O::sub(v[c], O::set1(palette[e * C + c]));
+					d = O::add(d, O::mul(t, t));
+				}
+				const auto closer = O::lt(d, best);
+				best = O::select(closer, d, best);
+				best_index = O::select(closer, O::set1((float)e), best_index);
+			}
+			alignas(16) float error[L], k[L];
+			O::store(error, O::mul(best, O::load(mask + i)));
+			O::store(k, best_index);
+			for (int j = 0; j < L; ++j) {
+				total += error[j];
+				index[i + j] = (uint8_t)k[j];
+			}
+		}
+		return total;
+	}
+
+	// Recta de mínimos cuadrados de los vexels con mask: media, eje principal (iteración de potencia sobre la
+	// covarianza) y suma de los cuadrados de las distancias a la recta
+	struct line_t {
+		float	mean[4];
+		float	axis[4];
+		float	residual;
+		float	count;
+	};
+
+	template<int C>
+	line_t fit_line(const float* px, const float* mask)
+	{
+		line_t line = {};
+		for (int i = 0; i < 16; ++i) {
+			line.count += mask[i];
+			for (int c = 0; c < C; ++c) line.mean[c] += mask[i] * px[16 * c + i];
+		}
+		if (line.count == 0)
+			return line;
+		for (int c = 0; c < C; ++c) line.mean[c] /= line.count;
+
+		float cov[C][C] = {};
+		for (int i = 0; i < 16; ++i) {
+			if (mask[i] == 0) continue;
+			float d[C];
+			for (int c = 0; c < C; ++c) d[c] = px[16 * c + i] - line.mean[c];
+			for (int a = 0; a < C; ++a)
+				for (int b = a; b < C; ++b) cov[a][b] += d[a] * d[b];
+		}
+		float trace = 0;
+		int k = 0;
+		for (int a = 0; a < C; ++a) {
+			for (int b = 0; b < a; ++b) cov[a][b] = cov[b][a];
+			trace += cov[a][a];
+			if (cov[a][a] > cov[k][k]) k = a;
+		}
+
+		// Arranque en la fila de mayor varianza: nunca es ortogonal al eje principal salvo con covarianza nula
+		float* axis = line.axis;
+		for (int c = 0; c < C; ++c) axis[c] = cov[k][c];
+		for (int it = 0; it < 8; ++it) {
+			float v[C] = {}, m = 0;
+			for (int a = 0; a < C; ++a)
+				for (int b = 0; b < C; ++b) v[a] += cov[a][b] * axis[b];
+			for (int c = 0; c < C; ++c) m = std::max(m, std::fabs(v[c]));
+			if (m == 0) break;
+			for (int c = 0; c < C; ++c) axis[c] = v[c] / m;
+		}
+		float length = 0;
+		for (int c = 0; c < C; ++c) length += axis[c] * axis[c];
+		if (length == 0)
+			return line;
+		length = 1.f / std::sqrt(length);
+		float lambda = 0;
+		for (int c = 0; c < C; ++c) axis[c] *= length;
+		for (int a = 0; a < C; ++a)
+			for (int b = 0; b < C; ++b) lambda += axis[a] * cov[a][b] * axis[b];
+		line.residual = std::max(0.f, trace - lambda);
+		return line;
+	}
+
+	// Extremos en la proyección mínima y máxima de los vexels sobre la recta
+	template<int C>
+	void line_endpoints(const line_t& line, const float* px, const float* mask, float lo, float hi, float e[2][4])
+	{
+		float tmin = 0, tmax = 0;
+		for (int i = 0; i < 16; ++i) {
+			if (mask[i] == 0) continue;
+			float t = 0;
+			for (int c = 0; c < C; ++c) t += (px[16 * c + i] - line.mean[c]) * line.axis[c];
+			tmin = std::min(tmin, t);
+			tmax = std::max(tmax, t);
+		}
+		for (int c = 0; c < C; ++c) {
+			e[0][c] = std::clamp(line.mean[c] + tmin * line.axis[c], lo, hi);
+			e[1][c] = std::clamp(line.mean[c] + tmax * line.axis[c], lo, hi);
+		}
+	}
+
+	// Extremos por mínimos cuadrados con el peso de cada vexel hacia e[1] fijo (w en [0, 1]); false si el sistema es
+	// singular (todos los vexels en el mismo índice)
+	template<int C>
+	bool least_squares(const float* px, const float* mask, const float* w, float lo, float hi, float e[2][4])
+	{
+		float aa = 0, ab = 0, bb = 0, x[C] = {}, y[C] = {};
+		for (int i = 0; i < 16; ++i) {
+			if (mask[i] == 0) continue;
+			const float u = 1 - w[i], v = w[i];
+			aa += u * u;
+			ab += u * v;
+			bb += v * v;
+			for (int c = 0; c < C; ++c) {
+				x[c] += u * px[16 * c + i];
+				y[c] += v * px[16 * c + i];
+			}
+		}
+		const float det = aa * bb - ab * ab;
+		if (std::fabs(det) < 1e-4f)
+			return false;
+		for (int c = 0; c < C; ++c) {
+			e[0][c] = std::clamp((bb * x[c] - ab * y[c]) / det, lo, hi);
+			e[1][c] = std::clamp((aa * y[c] - ab * x[c]) / det, lo, hi);
+		}
+		return true;
+	}
+
+	int refine_iterations(block_quality_t quality) { return quality == block_quality_t::FAST ? 0 : quality == block_quality_t::NORMAL ? 2 : 4; }
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC1 / color de BC3
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	uint16_t pack565(const float e[4])
+	{
+		const int r = std::clamp((int)std::lround(e[0] * (31.f / 255.f)), 0, 31);
+		const int g = std::clamp((int)std::lround(e[1] * (63.f / 255.f)), 0, 63);
+		const int b = std::clamp((int)std::lround(e[2] * (31.f / 255.f)), 0, 31);
+		return (uint16_t)(r << 11 | g << 5 | b);
+	}
+
+	// Escribe el bloque con el orden de extremos que pide el modo (c0 > c1 cuatro colores, c0 <= c1 tres colores y
+	// transparente) y los índices más cercanos; devuelve el error
+	float color_try(const block_t& b, uint16_t c0, uint16_t c1, bool transparent, bool four, uint8_t* out)
+	{
+		if (transparent ? c0 > c1 : c0 < c1) std::swap(c0, c1);
+		out[0] = (uint8_t)c0;
+		out[1] = (uint8_t)(c0 >> 8);
+		out[2] = (uint8_t)c1;
+		out[3] = (uint8_t)(c1 >> 8);
+		uint32_t palette[4];
+		color_palette(out, four, palette);
+		alignas(16) float p[12];
+		for (int e = 0; e < 4; ++e)
+			for (int c = 0; c < 3; ++c) p[3 * e + c] = (float)(palette[e] >> (8 * c) & 255);
+		uint8_t index[16];
+		const float error = fit_palette<fit_ops, 3>(b.px[0], b.opaque, p, four || c0 > c1 ? 4 : 3, index);
+		uint32_t bits = 0;
+		for (int i = 0; i < 16; ++i) bits |= (uint32_t)(b.opaque[i] != 0 ? index[i] : 3) << (2 * i);
+		std::memcpy(out + 4, &bits, 4);
+		return error;
+	}
+
+	// transparent: modo de tres colores con el índice 3 en los vexels sin opaque; four: BC3 (siempre cuatro colores)
+	void color_block(const block_t& b, bool transparent, bool four, block_quality_t quality, uint8_t* out)
+	{
+		float e[2][4];
+		line_endpoints<3>(fit_line<3>(b.px[0], b.opaque), b.px[0], b.opaque, 0.f, 255.f, e);
+		float best = color_try(b, pack565(e[0]), pack565(e[1]), transparent, four, out);
+
+		uint8_t trial[8];
+		for (int it = refine_iterations(quality); it > 0 && best > 0; --it) {
+			const uint16_t c0 = (uint16_t)(out[0] | out[1] << 8), c1 = (uint16_t)(out[2] | out[3] << 8);
+			const bool three = !four && c0 <= c1;
+			uint32_t bits;
+			std::memcpy(&bits, out + 4, 4);
+			float w[16];
+			for (int i = 0; i < 16; ++i) {
+				const int k = bits >> (2 * i) & 3;
+				w[i] = k == 0 ? 0.f : k == 1 ? 1.f : three ? 0.5f : k == 2 ? 1.f / 3 : 2.f / 3;
+			}
+			if (!least_squares<3>(b.px[0], b.opaque, w, 0.f, 255.f, e))
+				break;
+			const float error = color_try(b, pack565(e[0]), pack565(e[1]), transparent, four, trial);
+			if (error >= best)
+				break;
+			best = error;
+			std::memcpy(out, trial, 8);
+		}
+
+		// Búsqueda local: +-1 en cada componente 5:6:5 de los dos extremos mientras mejore
+		if (quality != block_quality_t::HIGH)
+			return;
+		for (int pass = 0; pass < 4 && best > 0; ++pass) {
+			bool improved = false;
+			for (int k = 0; k < 2; ++k)
+				for (int f = 0; f < 3; ++f)
+					for (int d = -1; d <= 1; d += 2) {
+						uint16_t c[2] = { (uint16_t)(out[0] | out[1] << 8), (uint16_t)(out[2] | out[3] << 8) };
+						const int shift = f == 0 ? 11 : f == 1 ? 5 : 0, top = f == 1 ? 63 : 31;
+						const int v = (c[k] >> shift & top) + d;
+						if (v < 0 || v > top) continue;
+						c[k] = (uint16_t)((c[k] & ~(top << shift)) | v << shift);
+						const float error = color_try(b, c[0], c[1], transparent, four, trial);
+						if (error < best) {
+							best = error;
+							std::memcpy(out, trial, 8);
+							improved = true;
+						}
+					}
+			if (!improved) break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC4 / BC5 / alfa de BC3
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template<bool Signed>
+	float channel_try(const float* v, int a0, int a1, uint8_t* out)
+	{
+		out[0] = (uint8_t)a0;
+		out[1] = (uint8_t)a1;
+		uint8_t palette[8];
+		channel_palette<Signed>(out, palette);
+		alignas(16) float p[8];
+		for (int e = 0; e < 8; ++e) p[e] = Signed ? (float)(int8_t)palette[e] : (float)palette[e];
+		uint8_t index[16];
+		const float error = fit_palette<fit_ops, 1>(v, kAll, p, 8, index);
+		uint64_t bits = 0;
+		for (int i = 0; i < 16; ++i) bits |= (uint64_t)index[i] << (3 * i);
+		std::memcpy(out + 2, &bits, 6);
+		return error;
+	}
+
+	// v: 16 valores en la escala de los bytes (-127..127 con signo)
+	template<bool Signed>
+	void channel_block(const float* v, block_quality_t quality, uint8_t* out)
+	{
+		constexpr int lo = Signed ? -127 : 0, hi = Signed ? 127 : 255;
+		int mn = hi, mx = lo, inner_mn = hi, inner_mx = lo;
+		for (int i = 0; i < 16; ++i) {
+			const int x = (int)v[i];
+			mn = std::min(mn, x);
+			mx = std::max(mx, x);
+			if (x > lo && x < hi) {
+				inner_mn = std::min(inner_mn, x);
+				inner_mx = std::max(inner_mx, x);
+			}
+		}
+
+		// Ocho valores (a0 > a1); con a0 == a1 el bloque es constante en cualquier modo
+		float best = channel_try<Signed>(v, mx, mn, out);
+		if (quality == block_quality_t::FAST || best == 0)
+			return;
+
+		// Seis valores entre los que no son extremos del rango, más lo y hi fijos
+		uint8_t trial[8];
+		if (inner_mn < inner_mx && (mn == lo || mx == hi)) {
+			const float error = channel_try<Signed>(v, inner_mn, inner_mx, trial);
+			if (error < best) {
+				best = error;
+				std::memcpy(out, trial, 8);
+			}
+		}
+
+		const int passes = quality == block_quality_t::HIGH ? 8 : 2;
+		for (int pass = 0; pass < passes && best > 0; ++pass) {
+			bool improved = false;
+			for (int k = 0; k < 2; ++k)
+				for (int d = -1; d <= 1; d += 2) {
+					int a[2] = { Signed ? (int)(int8_t)out[0] : out[0], Signed ? (int)(int8_t)out[1] : out[1] };
+					a[k] += d;
+					if (a[k] < lo || a[k] > hi) continue;
+					const float error = channel_try<Signed>(v, a[0], a[1], trial);
+					if (error < best) {
+						best = error;
+						std::memcpy(out, trial, 8);
+						improved = true;
+					}
+				}
+			if (!improved) break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BC7
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Extremos de un subconjunto sin el bit P; los modos 1 y 6 codifican el alfa con los mismos bits que el color
+	struct bc7_endpoints_t {
+		int	code[2][4];
+		int	p[2];
+	};
+
+	SIMD_FORCEINLINE int bc7_expand(int code, int p, int bits)
+	{
+		const int x = code << 1 | p, n = bits + 1;
+		return (x << (8 - n)) | (x >> (2 * n - 8));
+	}
+
+	int bc7_quantize(float v, int p, int bits)
+	{
+		const int top = (1 << bits) - 1;
+		const int guess = std::clamp((int)std::lround((v * ((2 << bits) - 1) / 255.f - p) * 0.5f), 0, top);
+		int best = guess;
+		float best_d = FLT_MAX;
+		for (int c = std::max(0, guess - 1); c <= std::min(top, guess + 1); ++c) {
+			const float d = std::fabs(bc7_expand(c, p, bits) - v);
+			if (d < best_d) {
+				best_d = d;
+				best = c;
+			}
+		}
+		return best;
+	}
+
+	template<int C>
+	void bc7_quantize_endpoints(const bc7_mode_t& m, const float e[2][4], bc7_endpoints_t& q)
+	{
+		int code[2][2][4] = {};		// [p][extremo][canal]
+		float error[2][2] = {};
+		for (int p = 0; p < 2; ++p)
+			for (int k = 0; k < 2; ++k)
+				for (int c = 0; c < C; ++c) {
+					code[p][k][c] = bc7_quantize(e[k][c], p, m.color_bits);
+					const float d = bc7_expand(code[p][k][c], p, m.color_bits) - e[k][c];
+					error[p][k] += d * d;
+				}
+		if (m.shared_pbits)
+			q.p[0] = q.p[1] = error[0][0] + error[0][1] <= error[1][0] + error[1][1] ? 0 : 1;
+		else
+			for (int k = 0; k < 2; ++k) q.p[k] = error[0][k] <= error[1][k] ? 0 : 1;
+		for (int k = 0; k < 2; ++k) std::memcpy(q.code[k], code[q.p[k]][k], sizeof(q.code[k]));
+	}
+
+	template<int C>
+	float bc7_eval(const block_t& b, const float* mask, const bc7_mode_t& m, const bc7_endpoints_t& q, uint8_t* index)
+	{
+		int e[2][4];
+		for (int k = 0; k < 2; ++k)
+			for (int c = 0; c < C; ++c) e[k][c] = bc7_expand(q.code[k][c], q.p[k], m.color_bits);
+		const uint8_t* weights = weights_for(m.index_bits);
+		const int count = 1 << m.index_bits;
+		alignas(16) float p[16 * 4];
+		for (int j = 0; j < count; ++j)
+			for (int c = 0; c < C; ++c) p[C * j + c] = (float)interpolate(e[0][c], e[1][c], weights[j]);
+		return fit_palette<fit_ops, C>(b.px[0], mask, p, count, index);
+	}
+
+	// Un subconjunto: recta, cuantización con el mejor bit P y refinado por mínimos cuadrados
+	template<int C>
+	float bc7_fit(const block_t& b, const float* mask, const bc7_mode_t& m, int iterations, bc7_endpoints_t& q, uint8_t* index)
+	{
+		float e[2][4];
+		line_endpoints<C>(fit_line<C>(b.px[0], mask), b.px[0], mask, 0.f, 255.f, e);
+		bc7_quantize_endpoints<C>(m, e, q);
+		float best = bc7_eval<C>(b, mask, m, q, index);
+
+		const uint8_t* weights = weights_for(m.index_bits);
+		for (; iterations > 0 && best > 0; --iterations) {
+			float w[16];
+			for (int i = 0; i < 16; ++i) w[i] = weights[index[i]] * (1.f / 64);
+			if (!least_squares<C>(b.px[0], mask, w, 0.f, 255.f, e))
+				break;
+			bc7_endpoints_t t;
+			uint8_t trial[16];
+			bc7_quantize_endpoints<C>(m, e, t);
+			const float error = bc7_eval<C>(b, mask, m, t, trial);
+			if (error >= best)
+				break;
+			best = error;
+			q = t;
+			std::memcpy(index, trial, 16);
+		}
+		return best;
+	}
+
+	// Escritura de campos de 128 bits del bit menos significativo al más significativo (inversa de block_bits_t)
+	struct block_writer_t {
+		uint64_t	lo = 0;
+		uint64_t	hi = 0;
+		int			pos = 0;
+
+		void write(uint32_t v, int n)
+		{
+			const uint64_t x = v & ((1ull << n) - 1);
+			if (pos < 64) {
+				lo |= x << pos;
+				if (pos + n > 64) hi |= x >> (64 - pos);
+			} else {
+				hi |= x << (pos - 64);
+			}
+			pos += n;
+		}
+
+		void store(uint8_t* out) const
+		{
+			std::memcpy(out, &lo, 8);
+			std::memcpy(out + 8, &hi, 8);
+		}
+	};
+
+	// Modos sin rotación de uno o dos subconjuntos. Los anclas deben tener el bit alto del índice a 0: si no, se
+	// intercambian los extremos del subconjunto y se invierten sus índices.
+	void bc7_pack(int mode, int partition, bc7_endpoints_t* q, uint8_t* index, uint8_t* out)
+	{
+		const bc7_mode_t& m = kBC7Modes[mode];
+		const int top = (1 << m.index_bits) - 1;
+		for (int s = 0; s < m.subsets; ++s) {
+			const int anchor = s == 0 ? 0 : kAnchor2[partition];
+			if (index[anchor] <= top >> 1) continue;
+			std::swap(q[s].code[0], q[s].code[1]);
+			std::swap(q[s].p[0], q[s].p[1]);
+			for (int i = 0; i < 16; ++i)
+				if (subset_of(m.subsets, partition, i) == s) index[i] = (uint8_t)(top - index[i]);
+		}
+
+		block_writer_t w;
+		w.write(1u << mode, mode + 1);
+		w.write(partition, m.partition_bits);
+		for (int c = 0; c < 3; ++c)
+			for (int s = 0; s < m.subsets; ++s)
+				for (int k = 0; k < 2; ++k) w.write(q[s].code[k][c], m.color_bits);
+		if (m.alpha_bits)
+			for (int s = 0; s < m.subsets; ++s)
+				for (int k = 0; k < 2; ++k) w.write(q[s].code[k][3], m.alpha_bits);
+		if (m.endpoint_pbits)
+			for (int s = 0; s < m.subsets; ++s)
+				for (int k = 0; k < 2; ++k) w.write(q[s].p[k], 1);
+		else if (m.shared_pbits)
+			for (int s = 0; s < m.subsets; ++s) w.write(q[s].p[0], 1);
+		for (int i = 0; i < 16; ++i) w.write(index[i], m.index_bits - is_anchor(m.subsets, partition, i));
+		w.store(out);
+	}
+
+	// Momentos RGB de un grupo de vexels: con ellos se ordenan las 64 particiones sin recorrer los vexels de cada una
+	struct moments_t {
+		float	n;
+		float	s[3];
+		float	ss[6];		// rr rg rb gg gb bb
+
+		moments_t& operator+=(const moments_t& o)
+		{
+			n += o.n;
+			for (int c = 0; c < 3; ++c) s[c] += o.s[c];
+			for (int c = 0; c < 6; ++c) ss[c] += o.ss[c];
+			return *this;
+		}
+
+		moments_t& operator-=(const moments_t& o)
+		{
+			n -= o.n;
+			for (int c = 0; c < 3; ++c) s[c] -= o.s[c];
+			for (int c = 0; c < 6; ++c) ss[c] -= o.ss[c];
+			return *this;
+		}
+	};
+
+	moments_t moments_of(float r, float g, float b) { return { 1, { r, g, b }, { r * r, r * g, r * b, g * g, g * b, b * b } }; }
+
+	// Lo mismo que fit_line().residual con cuatro pasos de la iteración de potencia
+	float line_residual(const moments_t& m)
+	{
+		if (m.n == 0)
+			return 0;
+		const float inv = 1.f / m.n;
+		const float c[3][3] = {
+			{ m.ss[0] - m.s[0] * m.s[0] * inv, m.ss[1] - m.s[0] * m.s[1] * inv, m.ss[2] - m.s[0] * m.s[2] * inv },
+			{ m.ss[1] - m.s[0] * m.s[1] * inv, m.ss[3] - m.s[1] * m.s[1] * inv, m.ss[4] - m.s[1] * m.s[2] * inv },
+			{ m.ss[2] - m.s[0] * m.s[2] * inv, m.ss[4] - m.s[1] * m.s[2] * inv, m.ss[5] - m.s[2] * m.s[2] * inv },
+		};
+		const float trace = c[0][0] + c[1][1] + c[2][2];
+		const int k = c[0][0] >= c[1][1] ? (c[0][0] >= c[2][2] ? 0 : 2) : (c[1][1] >= c[2][2] ? 1 : 2);
+		float v[3] = { c[k][0], c[k][1], c[k][2] };
+		for (int it = 0; it < 4; ++it) {
+			const float x[3] = {
+				c[0][0] * v[0] + c[0][1] * v[1] + c[0][2] * v[2],
+				c[1][0] * v[0] + c[1][1] * v[1] + c[1][2] * v[2],
+				c[2][0] * v[0] + c[2][1] * v[1] + c[2][2] * v[2],
+			};
+			const float m = std::max({ std::fabs(x[0]), std::fabs(x[1]), std::fabs(x[2]) });
+			if (m == 0) return 0;
+			for (int i = 0; i < 3; ++i) v[i] = x[i] / m;
+		}
+		float vcv = 0, vv = 0;
+		for (int a = 0; a < 3; ++a) {
+			vv += v[a] * v[a];
+			for (int b = 0; b < 3; ++b) vcv += v[a] * c[a][b] * v[b];
+		}
+		return std::max(0.f, trace - vcv / vv);
+	}
+
+	void bc7_block(const block_t& b, block_quality_t quality, uint8_t* out)
+	{
+		const int iterations = refine_iterations(quality);
+		bc7_endpoints_t q[2];
+		uint8_t index[16];
+		float best = bc7_fit<4>(b, kAll, kBC7Modes[6], iterations, q[0], index);
+		bc7_pack(6, 0, q, index, out);
+
+		bool opaque = true;
+		for (int i = 0; i < 16; ++i) opaque &= b.px[3][i] == 255;
+		if (quality == block_quality_t::FAST || !opaque || best == 0)
+			return;
+
+		// Modo 1 en las particiones cuyas dos rectas dejan menos residuo
+		moments_t texel[16], total = {};
+		for (int i = 0; i < 16; ++i) {
+			texel[i] = moments_of(b.px[0][i], b.px[1][i], b.px[2][i]);
+			total += texel[i];
+		}
+		float residual[64];
+		int order[64];
+		for (int p = 0; p < 64; ++p) {
+			moments_t one = {};
+			for (uint32_t bits = kPartition2[p]; bits; bits &= bits - 1) one += texel[std::countr_zero(bits)];
+			moments_t zero = total;
+			zero -= one;
+			residual[p] = line_residual(zero) + line_residual(one);
+			order[p] = p;
+		}
+		const int candidates = quality == block_quality_t::NORMAL ? 4 : 16;
+		std::partial_sort(order, order + candidates, order + 64, [&](int a, int c) { return residual[a] < residual[c]; });
+
+		for (int n = 0; n < candidates; ++n) {
+			const int p = order[n];
+			float mask[2][16];
+			for (int i = 0; i < 16; ++i) {
+				const int s = subset_of(2, p, i);
+				mask[s][i] = 1;
+				mask[1 - s][i] = 0;
+			}
+			bc7_endpoints_t t[2];
+			uint8_t subset_index[2][16], merged[16];
+			float error = 0;
+			for (int s = 0; s < 2 && error < best; ++s) error += bc7_fit<3>(b, mask[s], kBC7Modes[1], iterations, t[s], subset_index[s]);
+			if (error >= best)
+				continue;
+			best = error;
+			for (int i = 0; i < 16; ++i) merged[i] = subset_index[subset_of(2, p, i)][i];
+			bc7_pack(1, p, t, merged, out);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ETC2 (modos de ETC1)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct etc_candidate_t {
+		bool	flip;
+		bool	diff;
+		int		color[2][3];	// 4 bits (individual) o 5 bits (diferencial)
+	};
+
+	bool etc_valid(const etc_candidate_t& e)
+	{
+		const int top = e.diff ? 31 : 15;
+		for (int c = 0; c < 3; ++c) {
+			if (e.color[0][c] < 0 || e.color[0][c] > top || e.color[1][c] < 0 || e.color[1][c] > top)
+				return false;
+			// Fuera de -4..3 el decodificador de ETC2 lo leería como modo T, H o plano
+			if (e.diff && (e.color[1][c] - e.color[0][c] < -4 || e.color[1][c] - e.color[0][c] > 3))
+				return false;
+		}
+		return true;
+	}
+
+	void etc_masks(bool flip, float mask[2][16])
+	{
+		for (int i = 0; i < 16; ++i) {
+			const int s = flip ? (i >> 3) : ((i & 3) >> 1);
+			mask[s][i] = 1;
+			mask[1 - s][i] = 0;
+		}
+	}
+
+	// Bloque big endian con los índices por columnas (ver decode_etc2)
+	void etc_pack(const etc_candidate_t& e, const int table[2], const uint8_t* index, uint8_t* out)
+	{
+		uint64_t v = 0;
+		for (int c = 0; c < 3; ++c) {
+			if (e.diff)
+				v |= (uint64_t)e.color[0][c] << (59 - 8 * c) | (uint64_t)((e.color[1][c] - e.color[0][c]) & 7) << (56 - 8 * c);
+			else
+				v |= (uint64_t)e.color[0][c] << (60 - 8 * c) | (uint64_t)e.color[1][c] << (56 - 8 * c);
+		}
+		v |= (uint64_t)table[0] << 37 | (uint64_t)table[1] << 34 | (uint64_t)e.diff << 33 | (uint64_t)e.flip << 32;
+		for (int i = 0; i < 16; ++i) {
+			const int k = 4 * (i & 3) + (i >> 2);
+			v |= (uint64_t)(index[i] >> 1) << (16 + k) | (uint64_t)(index[i] & 1) << k;
+		}
+		for (int j = 0; j < 8; ++j) out[j] = (uint8_t)(v >> (56 - 8 * j));
+	}
+
+	// Las ocho tablas de modificadores para cada subbloque; se queda con la de menor error
+	float etc_try(const block_t& b, const etc_candidate_t& e, uint8_t* out)
+	{
+		float mask[2][16];
+		etc_masks(e.flip, mask);
+		int table[2];
+		uint8_t index[16];
+		float total = 0;
+		for (int s = 0; s < 2; ++s) {
+			int base[3];
+			for (int c = 0; c < 3; ++c) base[c] = e.diff ? extend5(e.color[s][c]) : extend4(e.color[s][c]);
+			float best = FLT_MAX;
+			for (int t = 0; t < 8 && best > 0; ++t) {
+				alignas(16) float p[12];
+				for (int j = 0; j < 4; ++j)
+					for (int c = 0; c < 3; ++c) p[3 * j + c] = (float)clamp8(base[c] + kETC1Modifiers[t][j]);
+				uint8_t trial[16];
+				const float error = fit_palette<fit_ops, 3>(b.px[0], mask[s], p, 4, trial);
+				if (error >= best) continue;
+				best = error;
+				table[s] = t;
+				for (int i = 0; i < 16; ++i)
+					if (mask[s][i] != 0) index[i] = trial[i];
+			}
+			total += best;
+		}
+		etc_pack(e, table, index, out);
+		return total;
+	}
+
+	void etc2_block(const block_t& b, block_quality_t quality, uint8_t* out)
+	{
+		float best = FLT_MAX;
+		etc_candidate_t best_candidate = {};
+		uint8_t trial[8];
+		const auto consider = [&](const etc_candidate_t& e) {
+			const float error = etc_try(b, e, trial);
+			if (error >= best)
+				return false;
+			best = error;
+			best_candidate = e;
+			std::memcpy(out, trial, 8);
+			return true;
+		};
+
+		for (int flip = 0; flip < 2; ++flip) {
+			float mask[2][16], mean[2][3] = {};
+			etc_masks(flip, mask);
+			for (int s = 0; s < 2; ++s)
+				for (int c = 0; c < 3; ++c) {
+					for (int i = 0; i < 16; ++i) mean[s][c] += mask[s][i] * b.px[c][i];
+					mean[s][c] *= 1.f / 8;
+				}
+			// Diferencial si las medias caben a 5 bits a -4..3 una de otra; individual si no o con calidad NORMAL
+			etc_candidate_t e = { flip != 0, true, {} };
+			for (int s = 0; s < 2; ++s)
+				for (int c = 0; c < 3; ++c) e.color[s][c] = (int)std::lround(mean[s][c] * (31.f / 255.f));
+			const bool diff = etc_valid(e);
+			if (diff) consider(e);
+			if (!diff || quality != block_quality_t::FAST) {
+				e.diff = false;
+				for (int s = 0; s < 2; ++s)
+					for (int c = 0; c < 3; ++c) e.color[s][c] = (int)std::lround(mean[s][c] * (15.f / 255.f));
+				consider(e);
+			}
+		}
+
+		// Búsqueda local: +-1 en cada componente de los dos colores base sin salir del modo
+		if (quality != block_quality_t::HIGH)
+			return;
+		for (int pass = 0; pass < 4 && best > 0; ++pass) {
+			bool improved = false;
+			for (int s = 0; s < 2; ++s)
+				for (int c = 0; c < 3; ++c)
+					for (int d = -1; d <= 1; d += 2) {
+						etc_candidate_t e = best_candidate;
+						e.color[s][c] += d;
+						if (etc_valid(e)) improved |= consider(e);
+					}
+			if (!improved) break;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Formatos
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// src: 4x4 vexels del formato decodificado separados pitch bytes
+	using encode_fn = void (*)(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out);
+
+	block_t load_rgba(const uint8_t* src, size_t pitch)
+	{
+		block_t b;
+		for (int i = 0; i < 16; ++i) {
+			const uint8_t* t = src + (i >> 2) * pitch + (i & 3) * 4;
+			for (int c = 0; c < 4; ++c) b.px[c][i] = t[c];
+			b.opaque[i] = 1;
+		}
+		return b;
+	}
+
+	template<bool Signed>
+	void load_channel(const uint8_t* src, size_t pitch, size_t stride, float* v)
+	{
+		for (int i = 0; i < 16; ++i) {
+			const uint8_t x = src[(i >> 2) * pitch + (i & 3) * stride];
+			v[i] = Signed ? (float)std::max<int>((int8_t)x, -127) : (float)x;
+		}
+	}
+
+	void encode_bc1(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		block_t b = load_rgba(src, pitch);
+		bool transparent = false;
+		for (int i = 0; i < 16; ++i)
+			if (b.px[3][i] < 128) {
+				b.opaque[i] = 0;
+				transparent = true;
+			}
+		color_block(b, transparent, false, quality, out);
+	}
+
+	void encode_bc3(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		const block_t b = load_rgba(src, pitch);
+		channel_block<false>(b.px[3], quality, out);
+		color_block(b, false, true, quality, out + 8);
+	}
+
+	template<bool Signed>
+	void encode_bc4(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		alignas(16) float v[16];
+		load_channel<Signed>(src, pitch, 1, v);
+		channel_block<Signed>(v, quality, out);
+	}
+
+	template<bool Signed>
+	void encode_bc5(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		alignas(16) float v[16];
+		load_channel<Signed>(src, pitch, 2, v);
+		channel_block<Signed>(v, quality, out);
+		load_channel<Signed>(src + 1, pitch, 2, v);
+		channel_block<Signed>(v, quality, out + 8);
+	}
+
+	void encode_bc7(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		bc7_block(load_rgba(src, pitch), quality, out);
+	}
+
+	void encode_etc2(const uint8_t* src, size_t pitch, block_quality_t quality, uint8_t* out)
+	{
+		etc2_block(load_rgba(src, pitch), quality, out);
+	}
+
+	struct block_encoder_t {
+		encode_fn		encode;
+		vexel_format_t	input;			// vexel_block_decoded_format()
+		uint8_t			texel_bytes;
+		uint8_t			block_bytes;
+	};
+
+	bool resolve_encoder(vexel_format_t format, block_encoder_t& e)
+	{
+		const bool is_signed = format.is_signed();
+		encode_fn fn;
+		switch (format.layout()) {
+		case vexel_layout_t::BLOCK_BC1:		fn = encode_bc1; break;
+		case vexel_layout_t::BLOCK_BC3:		fn = encode_bc3; break;
+		case vexel_layout_t::BLOCK_BC4:		fn = is_signed ? encode_bc4<true> : encode_bc4<false>; break;
+		case vexel_layout_t::BLOCK_BC5:		fn = is_signed ? encode_bc5<true> : encode_bc5<false>; break;
+		case vexel_layout_t::BLOCK_BC7:		fn = encode_bc7; break;
+		case vexel_layout_t::BLOCK_ETC2:	fn = encode_etc2; break;
+		default:							return false;
+		}
+		vexel_block_info_t info;
+		vexel_block_info(format.layout(), info);
+		const vexel_format_t input = vexel_block_decoded_format(format);
+		e = { fn, input, (uint8_t)vexel_byte_count(input), info.byte_count };
+		return true;
+	}
+
+} // namespace
+
+DLL_FNC(vexel_format_t) vexel_block_encoded_format(vexel_layout_t layout, vexel_format_t src_format)
+{
+	const bool channel = layout == vexel_layout_t::BLOCK_BC4 || layout == vexel_layout_t::BLOCK_BC5;
+	const vexel_format_t format = vexel_format_t::VEC4_UN8().layout(layout).space(src_format.space()).is_signed(channel && src_format.is_signed());
+	block_encoder_t encoder;
+	return resolve_encoder(format, encoder) ? format : vexel_format_t(0);
+}
+
+DLL_FNC(bool) encode_block(vexel_format_t format, const void* src, size_t row_byte_count, void* block, const block_encode_params_t& params)
+{
+	block_encoder_t encoder;
+	if (!resolve_encoder(format, encoder))
+		return false;
+	encoder.encode(static_cast<const uint8_t*>(src), row_byte_count, params.quality, static_cast<uint8_t*>(block));
+	return true;
+}
+
+DLL_FNC(bool) encode_blocks(const vexel_surface_t& src, const vexel_surface_t& dst, const block_encode_params_t& params)
+{
+	block_encoder_t encoder;
+	if (!resolve_encoder(dst.format, encoder))
+		return false;
+	const uint64_t w = dst.layout.object_size.width;
+	const uint32_t h = dst.layout.object_size.height;
+	if (w != src.layout.object_size.width || h != src.layout.object_size.height)
+		return false;
+	const vexel_converter_t* converter = vexel_converter(src.format, encoder.input);
+	if (!converter)
+		return false;
+	if (!w || !h)
+		return true;
+
+	const uint64_t src_vexel = vexel_byte_count(src.format);
+	const uint64_t src_pitch = src.row_byte_count[0] ? src.row_byte_count[0] : w * src_vexel;
+	const uint64_t blocks_x = (w + 3) / 4;
+	const uint64_t dst_pitch = dst.row_byte_count[0] ? dst.row_byte_count[0] : blocks_x * encoder.block_bytes;
+	const uint8_t* in = static_cast<const uint8_t*>(src.planes[0]);
+	uint8_t* out = static_cast<uint8_t*>(dst.planes[0]);
+	const size_t tb = encoder.texel_bytes;
+
+	// Un solo reparto por bloques de toda la imagen; cada rango convierte sólo las columnas de sus bloques
+	parallel_for(blocks_x * ((h + 3) / 4), 16, [&](size_t begin, size_t end) {
+		std::vector<uint8_t> rows;
+		while (begin < end) {
+			const uint64_t by = begin / blocks_x, bx0 = begin % blocks_x;
+			const uint64_t bx1 = std::min<uint64_t>(blocks_x, bx0 + (end - begin));
+			const uint64_t x0 = bx0 * 4, count = std::min<uint64_t>(w, bx1 * 4) - x0, span = (bx1 - bx0) * 4;
+			rows.resize(4 * span * tb);
+			for (uint64_t r = 0; r < 4; ++r) {
+				const uint64_t y = std::min<uint64_t>(by * 4 + r, h - 1);
+				uint8_t* row = rows.data() + r * span * tb;
+				convert(*converter, in + y * src_pitch + x0 * src_vexel, row, count);
+				for (uint64_t x = count; x < span; ++x) std::memcpy(row + x * tb, row + (count - 1) * tb, tb);
+			}
+			for (uint64_t bx = bx0; bx < bx1; ++bx)
+				encoder.encode(rows.data() + (bx - bx0) * 4 * tb, span * tb, params.quality, out + by * dst_pitch + bx * encoder.block_bytes);
+			begin += bx1 - bx0;
+		}
+	});
+	return true;
+}
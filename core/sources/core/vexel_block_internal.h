@@ -0,0 +1,228 @@
+#pragma once
+
+// Cabecera privada: tablas y paletas de los formatos por bloques compartidas por el decodificador (vexel_block.cpp)
+// y el codificador (vexel_block_encode.cpp), y la entrada al decodificador ASTC (vexel_block_astc.cpp). Las paletas
+// se calculan con la misma aritmética entera en los dos lados, así que el codificador mide el error exacto de lo que
+// se va a decodificar.
+
+#include <simd/simd_types.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace vexel_block_internal {
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Tablas de BC6H / BC7
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Subconjunto de cada vexel: bit i con 2 subconjuntos, bits 2i..2i+1 con 3
+	inline constexpr uint16_t kPartition2[64] = {
+		0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80, 0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+		0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce, 0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+		0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a, 0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+		0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c, 0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+	};
+
+	inline constexpr uint32_t kPartition3[64] = {
+		0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0, 0x5a5a5050,
+		0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4, 0xa9a59450, 0x2a0a4250,
+		0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454, 0x6a6a4040, 0xa4a45000, 0x1a1a0500,
+		0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400, 0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200,
+		0xa9a58000, 0x5090a0a8, 0xa8a09050, 0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50,
+		0x500aa550, 0xaaaa4444, 0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600,
+		0xaa444444, 0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+		0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44, 0x2a4a5254,
+	};
+
+	// Vexel ancla del segundo subconjunto (2 subconjuntos) y del segundo y tercero (3 subconjuntos)
+	inline constexpr uint8_t kAnchor2[64] = {
+		15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+		15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+		15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+		 6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+	};
+
+	inline constexpr uint8_t kAnchor3a[64] = {
+		 3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+		 3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+		 8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+		 3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+	};
+
+	inline constexpr uint8_t kAnchor3b[64] = {
+		15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+		15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+		15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+		15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+	};
+
+	inline constexpr uint8_t kWeights2[4] = { 0, 21, 43, 64 };
+	inline constexpr uint8_t kWeights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+	inline constexpr uint8_t kWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	inline const uint8_t* weights_for(int bits) { return bits == 2 ? kWeights2 : bits == 3 ? kWeights3 : kWeights4; }
+
+	inline int subset_of(int subsets, int partition, int i)
+	{
+		if (subsets == 2) return (kPartition2[partition] >> i) & 1;
+		if (subsets == 3) return (kPartition3[partition] >> (2 * i)) & 3;
+		return 0;
+	}
+
+	// Los índices de los anclas tienen un bit menos (el más alto es 0 por construcción)
+	inline bool is_anchor(int subsets, int partition, int i)
+	{
+		if (i == 0) return true;
+		if (subsets == 2) return i == kAnchor2[partition];
+		if (subsets == 3) return i == kAnchor3a[partition] || i == kAnchor3b[partition];
+		return false;
+	}
+
+	SIMD_FORCEINLINE int interpolate(int e0, int e1, int w) { return (e0 * (64 - w) + e1 * w + 32) >> 6; }
+
+	struct bc7_mode_t {
+		uint8_t subsets;
+		uint8_t partition_bits;
+		uint8_t rotation_bits;
+		uint8_t selector_bits;		// modo 4: qué juego de índices va al color
+		uint8_t color_bits;
+		uint8_t alpha_bits;
+		uint8_t endpoint_pbits;		// un bit P por extremo
+		uint8_t shared_pbits;		// un bit P por subconjunto
+		uint8_t index_bits;
+		uint8_t index_bits2;
+	};
+
+	inline constexpr bc7_mode_t kBC7Modes[8] = {
+		{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+		{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+		{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+		{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+		{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+		{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+		{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+		{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+	};
+
+	// Campos de un bloque de 128 bits, del bit menos significativo al más significativo
+	struct block_bits_t {
+		uint64_t	lo;
+		uint64_t	hi;
+		int			pos = 0;
+
+		explicit block_bits_t(const uint8_t* block)
+		{
+			std::memcpy(&lo, block, 8);
+			std::memcpy(&hi, block + 8, 8);
+		}
+
+		uint32_t read(int n)
+		{
+			const uint64_t v = pos >= 64 ? hi >> (pos - 64) : (lo >> pos) | (pos ? hi << (64 - pos) : 0);
+			pos += n;
+			return (uint32_t)(v & ((1ull << n) - 1));
+		}
+	};
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Tablas de ETC2
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Modificadores de los modos individual y diferencial: índice (msb, lsb) -> { +a, +b, -a, -b }
+	inline constexpr int16_t kETC1Modifiers[8][4] = {
+		{ 2, 8, -2, -8 }, { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 },
+		{ 18, 60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 },
+	};
+
+	// Distancias de los modos T y H
+	inline constexpr uint8_t kETC2Distances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+	// Colores base de n bits -> 8 bits repitiendo los bits altos
+	SIMD_FORCEINLINE int extend4(int v) { return v << 4 | v; }
+	SIMD_FORCEINLINE int extend5(int v) { return v << 3 | v >> 2; }
+	SIMD_FORCEINLINE int extend6(int v) { return v << 2 | v >> 4; }
+	SIMD_FORCEINLINE int extend7(int v) { return v << 1 | v >> 6; }
+
+	SIMD_FORCEINLINE int clamp8(int v) { return std::clamp(v, 0, 255); }
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Paletas de BC1-BC5
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SIMD_FORCEINLINE uint32_t rgba8(uint32_t r, uint32_t g, uint32_t b, uint32_t a) { return r | (g << 8) | (b << 16) | (a << 24); }
+
+	// four: BC2 y BC3 ignoran el orden de los extremos y usan siempre cuatro colores
+	inline void color_palette(const uint8_t* block, bool four, uint32_t* palette)
+	{
+		const uint32_t c0 = block[0] | block[1] << 8, c1 = block[2] | block[3] << 8;
+		const auto expand = [](uint32_t c, int e[3]) {
+			const uint32_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+			e[0] = (int)(r << 3 | r >> 2);
+			e[1] = (int)(g << 2 | g >> 4);
+			e[2] = (int)(b << 3 | b >> 2);
+		};
+		int a[3], b[3];
+		expand(c0, a);
+		expand(c1, b);
+		palette[0] = rgba8(a[0], a[1], a[2], 255);
+		palette[1] = rgba8(b[0], b[1], b[2], 255);
+		if (four || c0 > c1) {
+			palette[2] = rgba8((2 * a[0] + b[0] + 1) / 3, (2 * a[1] + b[1] + 1) / 3, (2 * a[2] + b[2] + 1) / 3, 255);
+			palette[3] = rgba8((a[0] + 2 * b[0] + 1) / 3, (a[1] + 2 * b[1] + 1) / 3, (a[2] + 2 * b[2] + 1) / 3, 255);
+		} else {
+			palette[2] = rgba8((a[0] + b[0] + 1) / 2, (a[1] + b[1] + 1) / 2, (a[2] + b[2] + 1) / 2, 255);
+			palette[3] = 0;
+		}
+	}
+
+	// Paleta de BC3 alfa / BC4 / BC5; con signo se guardan los bytes en complemento a 2
+	template<bool Signed>
+	void channel_palette(const uint8_t* block, uint8_t* palette)
+	{
+		int a0, a1, lo, hi;
+		if constexpr (Signed) {
+			a0 = std::max<int>((int8_t)block[0], -127);
+			a1 = std::max<int>((int8_t)block[1], -127);
+			lo = -127;
+			hi = 127;
+		} else {
+			a0 = block[0];
+			a1 = block[1];
+			lo = 0;
+			hi = 255;
+		}
+		// División con redondeo al más cercano también para negativos
+		const auto div = [](int v, int d) { return (v + (v >= 0 ? d / 2 : -(d / 2))) / d; };
+		palette[0] = (uint8_t)a0;
+		palette[1] = (uint8_t)a1;
+		if (a0 > a1) {
+			for (int i = 1; i < 7; ++i) palette[i + 1] = (uint8_t)div((7 - i) * a0 + i * a1, 7);
+		} else {
+			for (int i = 1; i < 5; ++i) palette[i + 1] = (uint8_t)div((5 - i) * a0 + i * a1, 5);
+			palette[6] = (uint8_t)lo;
+			palette[7] = (uint8_t)hi;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// ASTC (vexel_block_astc.cpp)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// LDR decodifica a RGBA8 (los 8 bits altos del resultado de 16 bits) y HDR a RGBA half
+	enum class astc_profile_t : uint8_t
+	{
+		LDR,
+		LDR_SRGB,	// extremos expandidos a 16 bits con 0x80 en lugar de replicando el byte
+		HDR,
+	};
+
+	// Un bloque de width x height vexels separados pitch bytes; los bloques no válidos dan magenta
+	void decode_astc_block(const uint8_t* block, int width, int height, astc_profile_t profile, uint8_t* out, size_t pitch);
+
+	// Sólo el vexel (x, y) del bloque
+	void fetch_astc_texel(const uint8_t* block, int width, int height, astc_profile_t profile, int x, int y, uint8_t* out);
+
+} // namespace vexel_block_internal
@@ -0,0 +1,340 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_color.h>
+#include <simd/simd_exp_ops.h>
+
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define VEXEL_COLOR_VOP4 1
+#	include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define VEXEL_COLOR_VOP4 1
+#	include <arm_neon.h>
+#endif
+
+// Las curvas se escriben una vez sobre un juego de operaciones (scalar_ops o vec4_ops) con la interfaz de
+// simd_internal::vop: el bucle principal va de 4 en 4 con registros y la cola usa la misma aritmética en escalar.
+
+namespace {
+
+	struct scalar_ops {
+		using v_t = float;
+		using m_t = bool;
+
+		static SIMD_FORCEINLINE v_t set1(float s) { return s; }
+		static SIMD_FORCEINLINE v_t add(v_t a, v_t b) { return a + b; }
+		static SIMD_FORCEINLINE v_t sub(v_t a, v_t b) { return a - b; }
+		static SIMD_FORCEINLINE v_t mul(v_t a, v_t b) { return a * b; }
+		static SIMD_FORCEINLINE v_t div(v_t a, v_t b) { return a / b; }
+		// Como minps/maxps: con NaN devuelven el segundo operando
+		static SIMD_FORCEINLINE v_t min(v_t a, v_t b) { return a < b ? a : b; }
+		static SIMD_FORCEINLINE v_t max(v_t a, v_t b) { return a > b ? a : b; }
+		static SIMD_FORCEINLINE v_t sqrt(v_t a) { return std::sqrt(a); }
+		static SIMD_FORCEINLINE v_t abs(v_t a) { return std::fabs(a); }
+		static SIMD_FORCEINLINE v_t sign(v_t a) { return std::bit_cast<float>(std::bit_cast<uint32_t>(a) & 0x80000000u); }
+		static SIMD_FORCEINLINE v_t xor_(v_t a, v_t b) { return std::bit_cast<float>(std::bit_cast<uint32_t>(a) ^ std::bit_cast<uint32_t>(b)); }
+		static SIMD_FORCEINLINE m_t gt(v_t a, v_t b) { return a > b; }
+		static SIMD_FORCEINLINE m_t lt(v_t a, v_t b) { return a < b; }
+		static SIMD_FORCEINLINE v_t select(m_t m, v_t a, v_t b) { return m ? a : b; }
+
+		static SIMD_FORCEINLINE v_t log2(v_t a) { return simd::fast_log2<float>(a); }
+		static SIMD_FORCEINLINE v_t exp2(v_t a) { return simd::fast_exp2<float>(a); }
+	};
+
+#if defined(VEXEL_COLOR_VOP4)
+	struct vec4_ops : simd_internal::vop<float, 4> {
+		static SIMD_FORCEINLINE v_t log2(v_t a) { return simd::exp_detail::v_log<float, 4, false, true>(a); }
+		static SIMD_FORCEINLINE v_t exp2(v_t a) { return simd::exp_detail::v_exp2<float, 4, false>(a); }
+#	if defined(__ARM_NEON) || defined(__ARM_NEON__)
+		static SIMD_FORCEINLINE v_t load(const float* p) { return vld1q_f32(p); }
+		static SIMD_FORCEINLINE void store(float* p, v_t a) { vst1q_f32(p, a); }
+#	else
+		static SIMD_FORCEINLINE v_t load(const float* p) { return _mm_loadu_ps(p); }
+		static SIMD_FORCEINLINE void store(float* p, v_t a) { _mm_storeu_ps(p, a); }
+#	endif
+	};
+#endif
+
+	// x^p para x >= 0; x = 0 da log2 = -inf y exp2 satura a 0
+	template<typename O>
+	SIMD_FORCEINLINE typename O::v_t pow_pos(typename O::v_t x, float p) { return O::exp2(O::mul(O::log2(x), O::set1(p))); }
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Curvas: decode (codificado -> lineal) y encode (lineal -> codificado)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct srgb_curve {
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x)
+		{
+			const auto lin = O::mul(x, O::set1(1.f / 12.92f));
+			const auto pw = pow_pos<O>(O::mul(O::add(x, O::set1(0.055f)), O::set1(1.f / 1.055f)), 2.4f);
+			return O::select(O::gt(x, O::set1(0.04045f)), pw, lin);
+		}
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x)
+		{
+			const auto lin = O::mul(x, O::set1(12.92f));
+			const auto pw = O::sub(O::mul(pow_pos<O>(x, 1.f / 2.4f), O::set1(1.055f)), O::set1(0.055f));
+			return O::select(O::gt(x, O::set1(0.0031308f)), pw, lin);
+		}
+	};
+
+	// sRGB reflejada: f(x) = sign(x)·f(|x|) (scRGB / extended sRGB)
+	struct ext_srgb_curve {
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x) { return O::xor_(srgb_curve::decode<O>(O::abs(x)), O::sign(x)); }
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x) { return O::xor_(srgb_curve::encode<O>(O::abs(x)), O::sign(x)); }
+	};
+
+	// Constantes exactas de BT.2020 (alfa y beta hacen la curva continua); con 0.018/1.099 queda un salto de 2e-4
+	struct bt709_curve {
+		static constexpr float alpha = 1.09929682680944f, beta = 0.018053968510807f;
+
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x)
+		{
+			const auto lin = O::mul(x, O::set1(1.f / 4.5f));
+			const auto pw = pow_pos<O>(O::mul(O::add(x, O::set1(alpha - 1.f)), O::set1(1.f / alpha)), 1.f / 0.45f);
+			return O::select(O::lt(x, O::set1(4.5f * beta)), lin, pw);
+		}
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x)
+		{
+			const auto lin = O::mul(x, O::set1(4.5f));
+			const auto pw = O::sub(O::mul(pow_pos<O>(x, 0.45f), O::set1(alpha)), O::set1(alpha - 1.f));
+			return O::select(O::lt(x, O::set1(beta)), lin, pw);
+		}
+	};
+
+	template<int Num, int Den>
+	struct power_curve {
+		static constexpr float g = (float)Num / (float)Den;
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x) { return pow_pos<O>(O::max(x, O::set1(0.f)), g); }
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x) { return pow_pos<O>(O::max(x, O::set1(0.f)), 1.f / g); }
+	};
+
+	// SMPTE ST 2084; lineal 1.0 = 203 cd/m²
+	struct pq_curve {
+		static constexpr float m1 = 2610.f / 16384.f, m2 = 2523.f / 4096.f * 128.f;
+		static constexpr float c1 = 3424.f / 4096.f, c2 = 2413.f / 4096.f * 32.f, c3 = 2392.f / 4096.f * 32.f;
+		static constexpr float kPeak = 10000.f / 203.f;
+
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x)
+		{
+			const auto zero = O::set1(0.f);
+			const auto p = pow_pos<O>(O::max(x, zero), 1.f / m2);
+			const auto y = O::div(O::max(O::sub(p, O::set1(c1)), zero), O::sub(O::set1(c2), O::mul(O::set1(c3), p)));
+			return O::mul(pow_pos<O>(y, 1.f / m1), O::set1(kPeak));
+		}
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x)
+		{
+			const auto y = pow_pos<O>(O::mul(O::max(x, O::set1(0.f)), O::set1(1.f / kPeak)), m1);
+			return pow_pos<O>(O::div(O::add(O::set1(c1), O::mul(O::set1(c2), y)), O::add(O::set1(1.f), O::mul(O::set1(c3), y))), m2);
+		}
+	};
+
+	// BT.2100 HLG (OETF y su inversa, sin OOTF); lineal 1.0 = señal 0.75
+	struct hlg_curve {
+		static constexpr float a = 0.17883277f, b = 0.28466892f, c = 0.55991073f;
+		static constexpr float kRef = 0.26496256f;		// E tal que OETF(E) = 0.75
+		static constexpr float kLog2e = 1.44269504088896341f, kLn2 = 0.69314718055994531f;
+
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t decode(typename O::v_t x)
+		{
+			x = O::max(x, O::set1(0.f));
+			const auto lo = O::mul(O::mul(x, x), O::set1(1.f / 3.f));
+			const auto hi = O::mul(O::add(O::exp2(O::mul(O::sub(x, O::set1(c)), O::set1(kLog2e / a))), O::set1(b)), O::set1(1.f / 12.f));
+			return O::mul(O::select(O::gt(x, O::set1(0.5f)), hi, lo), O::set1(1.f / kRef));
+		}
+		template<typename O> static SIMD_FORCEINLINE typename O::v_t encode(typename O::v_t x)
+		{
+			x = O::mul(O::max(x, O::set1(0.f)), O::set1(kRef));
+			const auto lo = O::sqrt(O::mul(x, O::set1(3.f)));
+			const auto hi = O::add(O::mul(O::log2(O::sub(O::mul(x, O::set1(12.f)), O::set1(b))), O::set1(a * kLn2)), O::set1(c));
+			return O::select(O::gt(x, O::set1(1.f / 12.f)), hi, lo);
+		}
+	};
+
+	template<typename C, bool Encode>
+	void run_curve(const float* s, float* d, size_t n)
+	{
+		size_t i = 0;
+#if defined(VEXEL_COLOR_VOP4)
+		for (; i + 4 <= n; i += 4) {
+			const auto v = vec4_ops::load(s + i);
+			vec4_ops::store(d + i, Encode ? C::template encode<vec4_ops>(v) : C::template decode<vec4_ops>(v));
+		}
+#endif
+		for (; i < n; ++i)
+			d[i] = Encode ? C::template encode<scalar_ops>(s[i]) : C::template decode<scalar_ops>(s[i]);
+	}
+
+	using curve_fn = void (*)(const float* s, float* d, size_t n);
+
+	// Indexado por vexel_transfer_t; LINEAR no tiene curva
+	constexpr curve_fn kDecode[] = {
+		nullptr, run_curve<srgb_curve, false>, run_curve<ext_srgb_curve, false>, run_curve<bt709_curve, false>,
+		run_curve<power_curve<563, 256>, false>, run_curve<power_curve<26, 10>, false>, run_curve<pq_curve, false>, run_curve<hlg_curve, false>
+	};
+	constexpr curve_fn kEncode[] = {
+		nullptr, run_curve<srgb_curve, true>, run_curve<ext_srgb_curve, true>, run_curve<bt709_curve, true>,
+		run_curve<power_curve<563, 256>, true>, run_curve<power_curve<26, 10>, true>, run_curve<pq_curve, true>, run_curve<hlg_curve, true>
+	};
+
+	void run_transfer(const curve_fn* table, vexel_transfer_t transfer, const float* src, float* dst, size_t n)
+	{
+		if (curve_fn fn = table[(int)transfer])
+			fn(src, dst, n);
+		else if (src != dst)
+			std::memmove(dst, src, n * sizeof(float));
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Gamuts
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct mat3_t { double m[3][3]; };
+
+	mat3_t mul(const mat3_t& a, const mat3_t& b)
+	{
+		mat3_t r = {};
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				for (int k = 0; k < 3; ++k)
+					r.m[i][j] += a.m[i][k] * b.m[k][j];
+		return r;
+	}
+
+	mat3_t inverse(const mat3_t& a)
+	{
+		const auto& m = a.m;
+		const double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+		const double inv_det = 1.0 / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+		mat3_t r;
+		r.m[0][0] = c00 * inv_det;
+		r.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+		r.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+		r.m[1][0] = c01 * inv_det;
+		r.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+		r.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+		r.m[2][0] = c02 * inv_det;
+		r.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+		r.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+		return r;
+	}
+
+	// Cromaticidades xy de R, G, B y blanco
+	struct primaries_t { double x[4], y[4]; };
+
+	constexpr primaries_t kPrimaries[] = {
+		{ {}, {} },																				// NONE
+		{ { 0.640, 0.300, 0.150, 0.3127 }, { 0.330, 0.600, 0.060, 0.3290 } },					// BT709
+		{ { 0.640, 0.210, 0.150, 0.3127 }, { 0.330, 0.710, 0.060, 0.3290 } },					// ADOBE_RGB
+		{ { 0.680, 0.265, 0.150, 0.3127 }, { 0.320, 0.690, 0.060, 0.3290 } },					// DISPLAY_P3
+		{ { 0.680, 0.265, 0.150, 0.3140 }, { 0.320, 0.690, 0.060, 0.3510 } },					// DCI_P3
+		{ { 0.708, 0.170, 0.131, 0.3127 }, { 0.292, 0.797, 0.046, 0.3290 } },					// BT2020
+	};
+
+	void white_xyz(const primaries_t& p, double w[3])
+	{
+		w[0] = p.x[3] / p.y[3];
+		w[1] = 1.0;
+		w[2] = (1.0 - p.x[3] - p.y[3]) / p.y[3];
+	}
+
+	// RGB lineal -> XYZ: columnas xyz de cada primaria escaladas para que RGB = 1 dé el blanco con Y = 1
+	mat3_t rgb_to_xyz(const primaries_t& p)
+	{
+		mat3_t m;
+		for (int c = 0; c < 3; ++c) {
+			m.m[0][c] = p.x[c] / p.y[c];
+			m.m[1][c] = 1.0;
+			m.m[2][c] = (1.0 - p.x[c] - p.y[c]) / p.y[c];
+		}
+		double w[3];
+		white_xyz(p, w);
+		const mat3_t inv = inverse(m);
+		for (int c = 0; c < 3; ++c) {
+			const double s = inv.m[c][0] * w[0] + inv.m[c][1] * w[1] + inv.m[c][2] * w[2];
+			for (int r = 0; r < 3; ++r) m.m[r][c] *= s;
+		}
+		return m;
+	}
+
+	// Adaptación cromática de Bradford entre dos blancos
+	mat3_t bradford(const primaries_t& src, const primaries_t& dst)
+	{
+		constexpr mat3_t kB = { { { 0.8951, 0.2664, -0.1614 }, { -0.7502, 1.7135, 0.0367 }, { 0.0389, -0.0685, 1.0296 } } };
+		double ws[3], wd[3];
+		white_xyz(src, ws);
+		white_xyz(dst, wd);
+		mat3_t d = {};
+		for (int i = 0; i < 3; ++i) {
+			const double cs = kB.m[i][0] * ws[0] + kB.m[i][1] * ws[1] + kB.m[i][2] * ws[2];
+			const double cd = kB.m[i][0] * wd[0] + kB.m[i][1] * wd[1] + kB.m[i][2] * wd[2];
+			d.m[i][i] = cd / cs;
+		}
+		return mul(inverse(kB), mul(d, kB));
+	}
+
+} // namespace
+
+DLL_FNC(vexel_transfer_t) vexel_transfer(vexel_space_t space)
+{
+	switch (space) {
+	case vexel_space_t::SRGB:
+	case vexel_space_t::DISPLAY_P3:		return vexel_transfer_t::SRGB;
+	case vexel_space_t::EXTENDED_SRGB:	return vexel_transfer_t::EXTENDED_SRGB;
+	case vexel_space_t::ADOBE_RGB:		return vexel_transfer_t::GAMMA_ADOBE;
+	case vexel_space_t::BT709:
+	case vexel_space_t::BT2020:			return vexel_transfer_t::BT709;
+	case vexel_space_t::HDR10_ST2084:	return vexel_transfer_t::PQ;
+	case vexel_space_t::HDR10_HLG:		return vexel_transfer_t::HLG;
+	case vexel_space_t::DCI_P3:			return vexel_transfer_t::GAMMA_26;
+	default:							return vexel_transfer_t::LINEAR;
+	}
+}
+
+DLL_FNC(vexel_gamut_t) vexel_gamut(vexel_space_t space)
+{
+	switch (space) {
+	case vexel_space_t::RGB:
+	case vexel_space_t::SRGB:
+	case vexel_space_t::EXTENDED_SRGB:
+	case vexel_space_t::BT709:			return vexel_gamut_t::BT709;
+	case vexel_space_t::ADOBE_RGB:		return vexel_gamut_t::ADOBE_RGB;
+	case vexel_space_t::DISPLAY_P3:		return vexel_gamut_t::DISPLAY_P3;
+	case vexel_space_t::DCI_P3:			return vexel_gamut_t::DCI_P3;
+	case vexel_space_t::BT2020:
+	case vexel_space_t::HDR10_ST2084:
+	case vexel_space_t::HDR10_HLG:		return vexel_gamut_t::BT2020;
+	default:							return vexel_gamut_t::NONE;
+	}
+}
+
+DLL_FNC(void) vexel_transfer_decode(vexel_transfer_t transfer, const float* src, float* dst, size_t n)
+{
+	run_transfer(kDecode, transfer, src, dst, n);
+}
+
+DLL_FNC(void) vexel_transfer_encode(vexel_transfer_t transfer, const float* src, float* dst, size_t n)
+{
+	run_transfer(kEncode, transfer, src, dst, n);
+}
+
+DLL_FNC(bool) vexel_gamut_matrix(vexel_gamut_t src, vexel_gamut_t dst, float m[9])
+{
+	if (src == vexel_gamut_t::NONE || dst == vexel_gamut_t::NONE)
+		return false;
+	const primaries_t& ps = kPrimaries[(int)src];
+	const primaries_t& pd = kPrimaries[(int)dst];
+	mat3_t xyz = rgb_to_xyz(ps);
+	if (ps.x[3] != pd.x[3] || ps.y[3] != pd.y[3])
+		xyz = mul(bradford(ps, pd), xyz);
+	const mat3_t r = mul(inverse(rgb_to_xyz(pd)), xyz);
+	for (int i = 0; i < 9; ++i)
+		m[i] = (float)r.m[i / 3][i % 3];
+	return true;
+}
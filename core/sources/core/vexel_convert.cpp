@@ -0,0 +1,980 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_convert.h>
+#include <core/vexel_color.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#elif defined(__aarch64__)
+#	include <arm_neon.h>
+#endif
+
+// Cada par (origen, destino) se resuelve a una de tres rutas:
+//   1) copia: misma representación y mismo orden.
+//   2) permutación: misma representación de componente, distinto orden o número de canales (RGBA8 <-> BGRA8,
+//      RGB8 -> RGBA8...). Con bytes usa pshufb/tbl, 16-32 bytes por instrucción.
+//   3) tubería por bloques: decodifica a floats y codifica al destino con bucles planos (kernels de simd::kernels()
+//      para half y 8 bits). El reordenado de canales se hace con la permutación de 2) sobre el lado uniforme (antes
+//      de decodificar o después de codificar), así que sólo entre dos empaquetados se reordena en float.
+//      Las etapas que no hacen falta se omiten: float32 se lee/escribe en su sitio.
+// Si los espacios son distintos y ambos gestionados (ver vexel_color.h) siempre se toma la tubería, con una etapa de
+// color entre la decodificación y la codificación. Con unorm8 la transferencia se funde con la lectura (tabla de
+// 256 entradas) y, para sRGB/BT.709, con la escritura (tabla por tramos indexada por los bits del float).
+
+namespace {
+
+	constexpr size_t kBlock = 256;	// vexels por bloque de la tubería: 4 KB de floats por buffer, cabe en L1
+
+	enum class num_t : uint8_t { UINT, SINT, UNORM, SNORM, FLOAT };
+
+	enum class pack_t : uint8_t { NONE, P4_4, P4_4_4_4, P5_6_5, P1_5_5_5, P5_5_5_1, P2_10_10_10, P10_11_11, P5_9_9_9 };
+
+	struct desc_t {
+		pack_t		pack;
+		num_t		num;
+		uint8_t		elem_bytes;		// bytes por componente (uniformes) o por vexel (empaquetados)
+		uint8_t		channels;
+		uint32_t	stride;			// bytes por vexel
+		uint8_t		chan[4];		// canal RGBA (0..3) de cada componente en memoria
+
+		bool same_encoding(const desc_t& o) const { return pack == o.pack && num == o.num && elem_bytes == o.elem_bytes; }
+	};
+
+	using decode_fn	= void (*)(const void* src, float* r, size_t n);
+	using encode_fn	= void (*)(const float* f, void* dst, size_t n);
+	using remap_fn	= void (*)(const float* f, float* r, size_t n, const uint8_t* map);
+
+	// Tramos de la tabla lineal -> 8 bits: 13 octavas desde 2^-13 por 8 subdivisiones
+	constexpr int kEncodeLutSize = 104;
+
+} // namespace
+
+struct vexel_converter_t {
+	using run_fn = void (*)(const vexel_converter_t& c, const uint8_t* src, uint8_t* dst, size_t n);
+	using decode8_fn = void (*)(const vexel_converter_t& c, const uint8_t* src, float* r, size_t n);
+	using color_fn = void (*)(const vexel_converter_t& c, const float* f, float* r, size_t n);
+	using encode8_fn = void (*)(const vexel_converter_t& c, const float* f, uint8_t* dst, size_t n);
+
+	run_fn		run;
+	uint32_t	src_stride;
+	uint32_t	dst_stride;
+
+	// Tubería: pre -> decode -> remap -> color -> encode -> post; sólo una de pre/post/remap reordena
+	run_fn		pre;			// permutación en el tipo de origen (destino empaquetado)
+	decode_fn	decode;			// nullptr: el origen ya es float32
+	decode8_fn	decode8;		// unorm8 con transferencia por tabla (sustituye a decode)
+	remap_fn	remap;			// reordenado en float (origen y destino empaquetados)
+	color_fn	color;			// transferencia de origen -> gamut -> transferencia de destino
+	encode_fn	encode;			// nullptr: el destino es float32
+	encode8_fn	encode8;		// unorm8 con transferencia por tabla (sustituye a encode)
+	run_fn		post;			// permutación en el tipo de destino
+	uint8_t		src_units;		// elementos que procesa decode/encode por vexel (canales, o 1 si es empaquetado)
+	uint8_t		dst_units;
+	uint8_t		float_channels;	// canales por vexel en el tramo float
+
+	// Color. Las transferencias que ya aplican las tablas de 8 bits quedan en LINEAR.
+	vexel_transfer_t	src_transfer;
+	vexel_transfer_t	dst_transfer;
+	bool				has_matrix;
+	uint8_t				rgb[3];			// componente de R, G y B en el tramo float
+	uint8_t				alpha;			// componente de A en el tramo float; 4 si no hay
+	float				matrix[9];
+	float				decode_lut[2][256];			// unorm8 -> float: [0] color (con transferencia), [1] alfa
+	uint32_t			encode_lut[kEncodeLutSize][2];	// base y pendiente en 16.16 de cada tramo
+
+	// map[j]: componente de origen del componente j de destino; 4 = cero, 5 = uno
+	uint8_t		map[4];
+	uint64_t	one;			// "1" en la representación de componente (permutación)
+
+	// pshufb/tbl para permutaciones de bytes; 0x80 pone el byte a cero, fill aporta las constantes
+	alignas(32) uint8_t shuffle[32];
+	alignas(32) uint8_t fill[32];
+};
+
+namespace {
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Descripción del formato
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Componente en memoria -> canal RGBA para cada vexel_order_t
+	constexpr uint8_t kOrder[4][4] = { {0, 1, 2, 3}, {2, 1, 0, 3}, {3, 0, 1, 2}, {3, 2, 1, 0} };
+
+	bool pack_info(vexel_bit_format_t bits, pack_t& pack, int& channels, int& bytes)
+	{
+		switch (bits) {
+		case vexel_bit_format_t::PACK_4_4:			pack = pack_t::P4_4;		channels = 2; bytes = 1; return true;
+		case vexel_bit_format_t::PACK_4_4_4_4:		pack = pack_t::P4_4_4_4;	channels = 4; bytes = 2; return true;
+		case vexel_bit_format_t::PACK_5_6_5:		pack = pack_t::P5_6_5;		channels = 3; bytes = 2; return true;
+		case vexel_bit_format_t::PACK_1_5_5_5:		pack = pack_t::P1_5_5_5;	channels = 4; bytes = 2; return true;
+		case vexel_bit_format_t::PACK_5_5_5_1:		pack = pack_t::P5_5_5_1;	channels = 4; bytes = 2; return true;
+		case vexel_bit_format_t::PACK_2_10_10_10:	pack = pack_t::P2_10_10_10;	channels = 4; bytes = 4; return true;
+		case vexel_bit_format_t::PACK_10_11_11:		pack = pack_t::P10_11_11;	channels = 3; bytes = 4; return true;
+		case vexel_bit_format_t::PACK_5_9_9_9:		pack = pack_t::P5_9_9_9;	channels = 3; bytes = 4; return true;
+		default: return false;
+		}
+	}
+
+	bool describe(vexel_format_t f, desc_t& d)
+	{
+		const int layout = (int)f.layout();
+		const int order = (int)f.order();
+		if (layout < (int)vexel_layout_t::VECTOR_1 || layout > (int)vexel_layout_t::VECTOR_4 || order > 3)
+			return false;
+
+		const vexel_number_format_t nf = f.number_format();
+		const vexel_bit_format_t bits = f.bit_count();
+		const num_t inum = f.is_normalized() ? (f.is_signed() ? num_t::SNORM : num_t::UNORM)
+											 : (f.is_signed() ? num_t::SINT : num_t::UINT);
+		d.channels = (uint8_t)layout;
+
+		pack_t pack;
+		int channels, bytes;
+		if (pack_info(bits, pack, channels, bytes)) {
+			if (channels != layout)
+				return false;
+			const bool is_float = pack == pack_t::P10_11_11 || pack == pack_t::P5_9_9_9;
+			if (nf != (is_float ? vexel_number_format_t::FLOAT : vexel_number_format_t::INTEGER))
+				return false;
+			d.pack = pack;
+			d.num = is_float ? num_t::FLOAT : inum;
+			d.elem_bytes = (uint8_t)bytes;
+			d.stride = (uint32_t)bytes;
+		} else {
+			int b;
+			switch (bits) {
+			case vexel_bit_format_t::UNIFORM_8:		b = 1; break;
+			case vexel_bit_format_t::UNIFORM_16:	b = 2; break;
+			case vexel_bit_format_t::UNIFORM_32:	b = 4; break;
+			case vexel_bit_format_t::UNIFORM_64:	b = 8; break;
+			default: return false;
+			}
+			if (nf == vexel_number_format_t::FLOAT) {
+				if (b == 1)
+					return false;
+				d.num = num_t::FLOAT;
+			} else if (nf == vexel_number_format_t::INTEGER) {
+				if (b == 8)
+					return false;
+				d.num = inum;
+			} else {
+				return false;
+			}
+			d.pack = pack_t::NONE;
+			d.elem_bytes = (uint8_t)b;
+			d.stride = (uint32_t)(b * layout);
+		}
+
+		// Orden sin los canales que no existen
+		int k = 0;
+		for (int i = 0; i < 4; ++i)
+			if (kOrder[order][i] < layout)
+				d.chan[k++] = kOrder[order][i];
+		return true;
+	}
+
+	// Valor "1" de un componente uniforme en su representación binaria
+	uint64_t one_bits(const desc_t& d)
+	{
+		if (d.num == num_t::FLOAT) {
+			if (d.elem_bytes == 2) return 0x3C00u;
+			if (d.elem_bytes == 4) return std::bit_cast<uint32_t>(1.0f);
+			return std::bit_cast<uint64_t>(1.0);
+		}
+		if (d.num == num_t::UNORM) return (d.elem_bytes == 8) ? ~0ull : ((1ull << (8 * d.elem_bytes)) - 1);
+		if (d.num == num_t::SNORM) return (1ull << (8 * d.elem_bytes - 1)) - 1;
+		return 1;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Componentes uniformes
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Como clampT pero NaN -> 0
+	SIMD_FORCEINLINE float clamp_nan0(float v, float lo, float hi) { return v >= lo ? (v <= hi ? v : hi) : (v < lo ? lo : 0.f); }
+	SIMD_FORCEINLINE double clamp_nan0(double v, double lo, double hi) { return v >= lo ? (v <= hi ? v : hi) : (v < lo ? lo : 0.0); }
+
+	template<typename T, num_t N>
+	void decode_flat(const void* src, float* r, size_t n)
+	{
+		const T* s = static_cast<const T*>(src);
+		if constexpr (N == num_t::UNORM) {
+			constexpr float k = (float)(1.0 / (double)std::numeric_limits<T>::max());
+			for (size_t i = 0; i < n; ++i) r[i] = (float)s[i] * k;
+		} else if constexpr (N == num_t::SNORM) {
+			constexpr float k = (float)(1.0 / (double)std::numeric_limits<T>::max());
+			for (size_t i = 0; i < n; ++i) r[i] = std::max((float)s[i] * k, -1.f);
+		} else {
+			for (size_t i = 0; i < n; ++i) r[i] = (float)s[i];
+		}
+	}
+
+	void decode_f16(const void* src, float* r, size_t n) { simd::kernels().f16_to_f32(static_cast<const uint16_t*>(src), r, n); }
+	void decode_un8(const void* src, float* r, size_t n) { simd::kernels().u8_to_f32(static_cast<const uint8_t*>(src), 1.f / 255.f, r, n); }
+	void decode_u8(const void* src, float* r, size_t n) { simd::kernels().u8_to_f32(static_cast<const uint8_t*>(src), 1.f, r, n); }
+
+	template<typename T, num_t N>
+	void encode_flat(const float* f, void* dst, size_t n)
+	{
+		T* d = static_cast<T*>(dst);
+		if constexpr (N == num_t::FLOAT) {
+			for (size_t i = 0; i < n; ++i) d[i] = (T)f[i];
+		} else {
+			// 32 bits no caben en la mantisa de float: se satura y redondea en double
+			using F = std::conditional_t<(sizeof(T) < 4), float, double>;
+			using I = std::conditional_t<(sizeof(T) < 4), int32_t, int64_t>;
+			constexpr bool norm = N == num_t::UNORM || N == num_t::SNORM;
+			constexpr F hi = norm ? F(1) : F(std::numeric_limits<T>::max());
+			constexpr F lo = (N == num_t::SNORM) ? F(-1) : F(std::numeric_limits<T>::min());
+			constexpr F scale = norm ? F(std::numeric_limits<T>::max()) : F(1);
+			for (size_t i = 0; i < n; ++i) {
+				const F v = clamp_nan0(F(f[i]), lo, hi) * scale;
+				d[i] = (T)(I)(v + (v >= F(0) ? F(0.5) : F(-0.5)));
+			}
+		}
+	}
+
+	void encode_f16(const float* f, void* dst, size_t n) { simd::kernels().f32_to_f16(f, static_cast<uint16_t*>(dst), n); }
+	void encode_un8(const float* f, void* dst, size_t n) { simd::kernels().f32_to_u8(f, 255.f, static_cast<uint8_t*>(dst), n); }
+	void encode_u8(const float* f, void* dst, size_t n) { simd::kernels().f32_to_u8(f, 1.f, static_cast<uint8_t*>(dst), n); }
+
+	template<num_t N>
+	decode_fn uniform_decoder(int bytes)
+	{
+		if constexpr (N == num_t::FLOAT) {
+			return bytes == 2 ? decode_f16 : bytes == 4 ? nullptr : decode_flat<double, N>;
+		} else if constexpr (N == num_t::UINT || N == num_t::UNORM) {
+			return bytes == 1 ? (N == num_t::UNORM ? decode_un8 : decode_u8) : bytes == 2 ? decode_flat<uint16_t, N> : decode_flat<uint32_t, N>;
+		} else {
+			return bytes == 1 ? decode_flat<int8_t, N> : bytes == 2 ? decode_flat<int16_t, N> : decode_flat<int32_t, N>;
+		}
+	}
+
+	template<num_t N>
+	encode_fn uniform_encoder(int bytes)
+	{
+		if constexpr (N == num_t::FLOAT) {
+			return bytes == 2 ? encode_f16 : bytes == 4 ? nullptr : encode_flat<double, N>;
+		} else if constexpr (N == num_t::UINT || N == num_t::UNORM) {
+			return bytes == 1 ? (N == num_t::UNORM ? encode_un8 : encode_u8) : bytes == 2 ? encode_flat<uint16_t, N> : encode_flat<uint32_t, N>;
+		} else {
+			return bytes == 1 ? encode_flat<int8_t, N> : bytes == 2 ? encode_flat<int16_t, N> : encode_flat<int32_t, N>;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Empaquetados enteros: campos de anchura fija, del bit 0 hacia arriba
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template<num_t N, int... W>
+	struct packed_int_t {
+		static constexpr int C = sizeof...(W);
+		static constexpr int width[C] = { W... };
+		static constexpr int bits = (W + ...);
+		using U = std::conditional_t<(bits <= 8), uint8_t, std::conditional_t<(bits <= 16), uint16_t, uint32_t>>;
+
+		static constexpr int shift(int c) { int s = 0; for (int i = 0; i < c; ++i) s += width[i]; return s; }
+
+		static void decode(const void* src, float* r, size_t n)
+		{
+			const U* s = static_cast<const U*>(src);
+			for (size_t p = 0; p < n; ++p, r += C) {
+				const uint32_t v = s[p];
+				for (int c = 0; c < C; ++c) {
+					const int w = width[c];
+					const uint32_t raw = (v >> shift(c)) & ((1u << w) - 1);
+					if constexpr (N == num_t::UNORM) {
+						r[c] = (float)raw * (1.f / (float)((1u << w) - 1));
+					} else if constexpr (N == num_t::UINT) {
+						r[c] = (float)raw;
+					} else {
+						const int32_t x = (int32_t)(raw << (32 - w)) >> (32 - w);
+						r[c] = (N == num_t::SNORM) ? std::max((float)x * (1.f / (float)((1u << (w - 1)) - 1)), -1.f) : (float)x;
+					}
+				}
+			}
+		}
+
+		static void encode(const float* f, void* dst, size_t n)
+		{
+			U* d = static_cast<U*>(dst);
+			for (size_t p = 0; p < n; ++p, f += C) {
+				uint32_t v = 0;
+				for (int c = 0; c < C; ++c) {
+					const int w = width[c];
+					const float umax = (float)((1u << w) - 1), smax = (float)((1u << (w - 1)) - 1);
+					float x;
+					if constexpr (N == num_t::UNORM)		x = clamp_nan0(f[c], 0.f, 1.f) * umax;
+					else if constexpr (N == num_t::SNORM)	x = clamp_nan0(f[c], -1.f, 1.f) * smax;
+					else if constexpr (N == num_t::UINT)	x = clamp_nan0(f[c], 0.f, umax);
+					else									x = clamp_nan0(f[c], -smax - 1.f, smax);
+					const int32_t q = (int32_t)(x + (x >= 0.f ? 0.5f : -0.5f));
+					v |= ((uint32_t)q & ((1u << w) - 1)) << shift(c);
+				}
+				d[p] = (U)v;
+			}
+		}
+	};
+
+	template<num_t N>
+	bool packed_int_fns(pack_t pack, decode_fn& dec, encode_fn& enc)
+	{
+		switch (pack) {
+		case pack_t::P4_4:			dec = packed_int_t<N, 4, 4>::decode;			enc = packed_int_t<N, 4, 4>::encode;			return true;
+		case pack_t::P4_4_4_4:		dec = packed_int_t<N, 4, 4, 4, 4>::decode;		enc = packed_int_t<N, 4, 4, 4, 4>::encode;		return true;
+		case pack_t::P5_6_5:		dec = packed_int_t<N, 5, 6, 5>::decode;			enc = packed_int_t<N, 5, 6, 5>::encode;			return true;
+		case pack_t::P1_5_5_5:		dec = packed_int_t<N, 5, 5, 5, 1>::decode;		enc = packed_int_t<N, 5, 5, 5, 1>::encode;		return true;
+		case pack_t::P5_5_5_1:		dec = packed_int_t<N, 1, 5, 5, 5>::decode;		enc = packed_int_t<N, 1, 5, 5, 5>::encode;		return true;
+		case pack_t::P2_10_10_10:	dec = packed_int_t<N, 10, 10, 10, 2>::decode;	enc = packed_int_t<N, 10, 10, 10, 2>::encode;	return true;
+		default: return false;
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Empaquetados float: r11g11b10 y rgb9e5
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Float sin signo con exponente de 5 bits (sesgo 15) y M bits de mantisa: es un half sin signo truncado, así que
+	// se decodifica desplazando a half y pasando por el kernel f16_to_f32.
+	void decode_r11g11b10f(const void* src, float* r, size_t n)
+	{
+		const uint32_t* s = static_cast<const uint32_t*>(src);
+		uint16_t h[kBlock * 3];
+		for (size_t p = 0; p < n; ++p) {
+			const uint32_t v = s[p];
+			h[3 * p + 0] = (uint16_t)((v & 0x7FFu) << 4);
+			h[3 * p + 1] = (uint16_t)(((v >> 11) & 0x7FFu) << 4);
+			h[3 * p + 2] = (uint16_t)((v >> 22) << 5);
+		}
+		simd::kernels().f16_to_f32(h, r, n * 3);
+	}
+
+	// Redondeo al par; negativos -> 0, finitos fuera de rango -> máximo, inf/NaN se conservan
+	template<int M>
+	uint32_t float_to_ufloat(float f)
+	{
+		constexpr uint32_t kInf = 31u << M;
+		constexpr uint32_t kMax = (30u << M) | ((1u << M) - 1);
+		const uint32_t x = std::bit_cast<uint32_t>(f);
+		if ((x & 0x7FFFFFFFu) > 0x7F800000u) return kInf | (1u << (M - 1));
+		if (x & 0x80000000u) return 0;
+		if (x == 0x7F800000u) return kInf;
+		if (x >= 0x38800000u) {
+			const uint32_t r = (x + ((uint32_t)(15 - 127) << 23) + ((1u << (22 - M)) - 1) + ((x >> (23 - M)) & 1u)) >> (23 - M);
+			return r < kMax ? r : kMax;
+		}
+		// Subnormal: unidades de 2^-(14+M); el producto es exacto y nearbyint redondea al par
+		return (uint32_t)std::nearbyint(f * (float)(1u << (14 + M)));
+	}
+
+	void encode_r11g11b10f(const float* f, void* dst, size_t n)
+	{
+		uint32_t* d = static_cast<uint32_t*>(dst);
+		for (size_t p = 0; p < n; ++p, f += 3)
+			d[p] = float_to_ufloat<6>(f[0]) | (float_to_ufloat<6>(f[1]) << 11) | (float_to_ufloat<5>(f[2]) << 22);
+	}
+
+	// rgb9e5: valor = mantisa · 2^(e - 15 - 9)
+	void decode_rgb9e5(const void* src, float* r, size_t n)
+	{
+		const uint32_t* s = static_cast<const uint32_t*>(src);
+		for (size_t p = 0; p < n; ++p, r += 3) {
+			const uint32_t v = s[p];
+			const float scale = std::bit_cast<float>(((v >> 27) + 127 - 24) << 23);
+			r[0] = (float)(v & 0x1FFu) * scale;
+			r[1] = (float)((v >> 9) & 0x1FFu) * scale;
+			r[2] = (float)((v >> 18) & 0x1FFu) * scale;
+		}
+	}
+
+	// Codificación de EXT_texture_shared_exponent
+	void encode_rgb9e5(const float* f, void* dst, size_t n)
+	{
+		constexpr float kMax = 65408.f;		// (511/512) · 2^16
+		uint32_t* d = static_cast<uint32_t*>(dst);
+		for (size_t p = 0; p < n; ++p, f += 3) {
+			const float r = clamp_nan0(f[0], 0.f, kMax), g = clamp_nan0(f[1], 0.f, kMax), b = clamp_nan0(f[2], 0.f, kMax);
+			const float m = std::max(r, std::max(g, b));
+			const int log2_floor = (int)(std::bit_cast<uint32_t>(m) >> 23) - 127;
+			int e = std::max(-16, log2_floor) + 16;
+			float scale = std::bit_cast<float>((uint32_t)(127 + 24 - e) << 23);		// 2^(24 - e)
+			if ((uint32_t)(m * scale + 0.5f) == 512) {
+				++e;
+				scale *= 0.5f;
+			}
+			d[p] = (uint32_t)(r * scale + 0.5f) | ((uint32_t)(g * scale + 0.5f) << 9) | ((uint32_t)(b * scale + 0.5f) << 18) | ((uint32_t)e << 27);
+		}
+	}
+
+	bool pipeline_fns(const desc_t& d, decode_fn& dec, encode_fn& enc)
+	{
+		switch (d.pack) {
+		case pack_t::NONE:
+			switch (d.num) {
+			case num_t::UINT:	dec = uniform_decoder<num_t::UINT>(d.elem_bytes);	enc = uniform_encoder<num_t::UINT>(d.elem_bytes);	return true;
+			case num_t::SINT:	dec = uniform_decoder<num_t::SINT>(d.elem_bytes);	enc = uniform_encoder<num_t::SINT>(d.elem_bytes);	return true;
+			case num_t::UNORM:	dec = uniform_decoder<num_t::UNORM>(d.elem_bytes);	enc = uniform_encoder<num_t::UNORM>(d.elem_bytes);	return true;
+			case num_t::SNORM:	dec = uniform_decoder<num_t::SNORM>(d.elem_bytes);	enc = uniform_encoder<num_t::SNORM>(d.elem_bytes);	return true;
+			case num_t::FLOAT:	dec = uniform_decoder<num_t::FLOAT>(d.elem_bytes);	enc = uniform_encoder<num_t::FLOAT>(d.elem_bytes);	return true;
+			}
+			return false;
+		case pack_t::P10_11_11:	dec = decode_r11g11b10f;	enc = encode_r11g11b10f;	return true;
+		case pack_t::P5_9_9_9:	dec = decode_rgb9e5;		enc = encode_rgb9e5;		return true;
+		default:
+			switch (d.num) {
+			case num_t::UINT:	return packed_int_fns<num_t::UINT>(d.pack, dec, enc);
+			case num_t::SINT:	return packed_int_fns<num_t::SINT>(d.pack, dec, enc);
+			case num_t::UNORM:	return packed_int_fns<num_t::UNORM>(d.pack, dec, enc);
+			case num_t::SNORM:	return packed_int_fns<num_t::SNORM>(d.pack, dec, enc);
+			default:			return false;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Reordenación de canales
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template<int Cs, int Cd>
+	void remap_flat(const float* f, float* r, size_t n, const uint8_t* map)
+	{
+		uint8_t m[Cd];
+		for (int j = 0; j < Cd; ++j) m[j] = map[j];
+		for (size_t p = 0; p < n; ++p, f += Cs, r += Cd) {
+			float e[6];
+			for (int k = 0; k < Cs; ++k) e[k] = f[k];
+			e[4] = 0.f;
+			e[5] = 1.f;
+			for (int j = 0; j < Cd; ++j) r[j] = e[m[j]];
+		}
+	}
+
+	template<typename U, int Cs, int Cd>
+	void run_permute(const vexel_converter_t& c, const uint8_t* src, uint8_t* dst, size_t n)
+	{
+		const U* s = reinterpret_cast<const U*>(src);
+		U* d = reinterpret_cast<U*>(dst);
+		uint8_t m[Cd];
+		for (int j = 0; j < Cd; ++j) m[j] = c.map[j];
+		for (size_t p = 0; p < n; ++p, s += Cs, d += Cd) {
+			U e[6];
+			for (int k = 0; k < Cs; ++k) e[k] = s[k];
+			e[4] = 0;
+			e[5] = (U)c.one;
+			for (int j = 0; j < Cd; ++j) d[j] = e[m[j]];
+		}
+	}
+
+#define VEXEL_PERMUTE_ROW(_type, _cs) { run_permute<_type, _cs, 1>, run_permute<_type, _cs, 2>, run_permute<_type, _cs, 3>, run_permute<_type, _cs, 4> }
+#define VEXEL_PERMUTE_TABLE(_type) { VEXEL_PERMUTE_ROW(_type, 1), VEXEL_PERMUTE_ROW(_type, 2), VEXEL_PERMUTE_ROW(_type, 3), VEXEL_PERMUTE_ROW(_type, 4) }
+
+	constexpr vexel_converter_t::run_fn kPermute[4][4][4] = {
+		VEXEL_PERMUTE_TABLE(uint8_t), VEXEL_PERMUTE_TABLE(uint16_t), VEXEL_PERMUTE_TABLE(uint32_t), VEXEL_PERMUTE_TABLE(uint64_t)
+	};
+
+#undef VEXEL_PERMUTE_TABLE
+#undef VEXEL_PERMUTE_ROW
+
+#define VEXEL_REMAP_ROW(_cs) { remap_flat<_cs, 1>, remap_flat<_cs, 2>, remap_flat<_cs, 3>, remap_flat<_cs, 4> }
+
+	constexpr remap_fn kRemap[4][4] = { VEXEL_REMAP_ROW(1), VEXEL_REMAP_ROW(2), VEXEL_REMAP_ROW(3), VEXEL_REMAP_ROW(4) };
+
+#undef VEXEL_REMAP_ROW
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Permutación de bytes: 4 -> 4, 3 -> 4 y 4 -> 3 canales
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Tablas para 16 bytes de destino (4 vexels de 4 bytes o 4 de 3 bytes + 4 a cero); la copia alta es para AVX2
+	void build_shuffle(vexel_converter_t& c, int cs, int cd)
+	{
+		std::memset(c.shuffle, 0x80, sizeof(c.shuffle));
+		std::memset(c.fill, 0, sizeof(c.fill));
+		for (int p = 0; p < 4; ++p)
+			for (int j = 0; j < cd; ++j) {
+				const uint8_t m = c.map[j];
+				if (m < 4) c.shuffle[p * cd + j] = (uint8_t)(p * cs + m);
+				else if (m == 5) c.fill[p * cd + j] = (uint8_t)c.one;
+			}
+		std::memcpy(c.shuffle + 16, c.shuffle, 16);
+		std::memcpy(c.fill + 16, c.fill, 16);
+	}
+
+#if defined(SIMD_KERNELS_X86)
+
+	SIMD_TARGET("ssse3")
+	void run_shuffle44_ssse3(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const __m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(c.shuffle));
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * i), _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * i)), m));
+		run_permute<uint8_t, 4, 4>(c, s + 4 * i, d + 4 * i, n - i);
+	}
+
+	SIMD_TARGET("avx2")
+	void run_shuffle44_avx2(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const __m256i m = _mm256_load_si256(reinterpret_cast<const __m256i*>(c.shuffle));
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16) {
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * i + 32));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * i), _mm256_shuffle_epi8(a, m));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * i + 32), _mm256_shuffle_epi8(b, m));
+		}
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * i), _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * i)), m));
+		run_permute<uint8_t, 4, 4>(c, s + 4 * i, d + 4 * i, n - i);
+	}
+
+	// Se leen 16 bytes para 12 útiles: el bucle para a 2 vexels del final para no salirse del origen
+	SIMD_TARGET("ssse3")
+	void run_shuffle34_ssse3(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const __m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(c.shuffle));
+		const __m128i f = _mm_load_si128(reinterpret_cast<const __m128i*>(c.fill));
+		size_t i = 0;
+		for (; i + 6 <= n; i += 4)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * i),
+				_mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 3 * i)), m), f));
+		run_permute<uint8_t, 3, 4>(c, s + 3 * i, d + 4 * i, n - i);
+	}
+
+	SIMD_TARGET("ssse3")
+	void run_shuffle43_ssse3(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const __m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(c.shuffle));
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * i)), m);
+			const uint32_t hi = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(d + 3 * i), v);
+			std::memcpy(d + 3 * i + 8, &hi, 4);
+		}
+		run_permute<uint8_t, 4, 3>(c, s + 4 * i, d + 3 * i, n - i);
+	}
+
+#elif defined(__aarch64__)
+
+	void run_shuffle44_neon(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const uint8x16_t m = vld1q_u8(c.shuffle);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			vst1q_u8(d + 4 * i, vqtbl1q_u8(vld1q_u8(s + 4 * i), m));
+		run_permute<uint8_t, 4, 4>(c, s + 4 * i, d + 4 * i, n - i);
+	}
+
+	void run_shuffle34_neon(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const uint8x16_t m = vld1q_u8(c.shuffle), f = vld1q_u8(c.fill);
+		size_t i = 0;
+		for (; i + 6 <= n; i += 4)
+			vst1q_u8(d + 4 * i, vorrq_u8(vqtbl1q_u8(vld1q_u8(s + 3 * i), m), f));
+		run_permute<uint8_t, 3, 4>(c, s + 3 * i, d + 4 * i, n - i);
+	}
+
+	void run_shuffle43_neon(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		const uint8x16_t m = vld1q_u8(c.shuffle);
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			const uint8x16_t v = vqtbl1q_u8(vld1q_u8(s + 4 * i), m);
+			const uint32_t hi = vgetq_lane_u32(vreinterpretq_u32_u8(v), 2);
+			vst1_u8(d + 3 * i, vget_low_u8(v));
+			std::memcpy(d + 3 * i + 8, &hi, 4);
+		}
+		run_permute<uint8_t, 4, 3>(c, s + 4 * i, d + 3 * i, n - i);
+	}
+
+#endif
+
+	vexel_converter_t::run_fn byte_shuffle(int cs, int cd)
+	{
+#if defined(SIMD_KERNELS_X86)
+		const simd::isa_t isa = simd::kernels().isa;
+		const bool ssse3 = isa == simd::isa_t::SSE41 || isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512;
+		const bool avx2 = isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512;
+		if (cs == 4 && cd == 4 && avx2) return run_shuffle44_avx2;
+		if (ssse3) {
+			if (cs == 4 && cd == 4) return run_shuffle44_ssse3;
+			if (cs == 3 && cd == 4) return run_shuffle34_ssse3;
+			if (cs == 4 && cd == 3) return run_shuffle43_ssse3;
+		}
+#elif defined(__aarch64__)
+		if (cs == 4 && cd == 4) return run_shuffle44_neon;
+		if (cs == 3 && cd == 4) return run_shuffle34_neon;
+		if (cs == 4 && cd == 3) return run_shuffle43_neon;
+#endif
+		return nullptr;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Color
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Alfa se guarda antes y se restaura después: las curvas se aplican al bloque entero sin mirar el canal
+	void run_color(const vexel_converter_t& c, const float* f, float* r, size_t n)
+	{
+		const size_t fc = c.float_channels;
+		float alpha[kBlock];
+		if (c.alpha < 4)
+			for (size_t p = 0; p < n; ++p) alpha[p] = f[p * fc + c.alpha];
+
+		vexel_transfer_decode(c.src_transfer, f, r, n * fc);
+		if (c.has_matrix) {
+			const float* m = c.matrix;
+			const size_t ri = c.rgb[0], gi = c.rgb[1], bi = c.rgb[2];
+			float* v = r;
+			for (size_t p = 0; p < n; ++p, v += fc) {
+				const float x = v[ri], y = v[gi], z = v[bi];
+				v[ri] = m[0] * x + m[1] * y + m[2] * z;
+				v[gi] = m[3] * x + m[4] * y + m[5] * z;
+				v[bi] = m[6] * x + m[7] * y + m[8] * z;
+			}
+		}
+		vexel_transfer_encode(c.dst_transfer, r, r, n * fc);
+
+		if (c.alpha < 4)
+			for (size_t p = 0; p < n; ++p) r[p * fc + c.alpha] = alpha[p];
+	}
+
+	template<int C>
+	void run_decode8(const vexel_converter_t& c, const uint8_t* s, float* r, size_t n)
+	{
+		const float* lut[C];
+		for (int k = 0; k < C; ++k) lut[k] = c.decode_lut[k == c.alpha];
+		for (size_t p = 0; p < n; ++p, s += C, r += C)
+			for (int k = 0; k < C; ++k) r[k] = lut[k][s[k]];
+	}
+
+	// Tramo: exponente y 3 bits altos de la mantisa; t: los 8 bits siguientes. NaN y lo que queda por debajo de
+	// 2^-13 van al primer tramo (0 en sRGB y BT.709), lo que pasa de 1 al último.
+	constexpr uint32_t kEncodeLutMin = 0x39000000u;		// 2^-13
+	constexpr uint32_t kEncodeLutMax = 0x3F7FFFFFu;		// 1 - 2^-24
+
+	SIMD_FORCEINLINE uint8_t encode_lut8(const uint32_t (*lut)[2], float v)
+	{
+		uint32_t x = std::bit_cast<uint32_t>(v);
+		x = (v > std::bit_cast<float>(kEncodeLutMin)) ? x : kEncodeLutMin;
+		x = x < kEncodeLutMax ? x : kEncodeLutMax;
+		const uint32_t* e = lut[(x - kEncodeLutMin) >> 20];
+		return (uint8_t)((e[0] + e[1] * ((x >> 12) & 0xFFu)) >> 16);
+	}
+
+	template<int C>
+	void run_encode8(const vexel_converter_t& c, const float* f, uint8_t* d, size_t n)
+	{
+		for (size_t p = 0; p < n; ++p, f += C, d += C)
+			for (int k = 0; k < C; ++k)
+				d[k] = (k == c.alpha) ? simd_internal::sat_u8(f[k] * 255.f) : encode_lut8(c.encode_lut, f[k]);
+	}
+
+	constexpr vexel_converter_t::decode8_fn kDecode8[4] = { run_decode8<1>, run_decode8<2>, run_decode8<3>, run_decode8<4> };
+	constexpr vexel_converter_t::encode8_fn kEncode8[4] = { run_encode8<1>, run_encode8<2>, run_encode8<3>, run_encode8<4> };
+
+	void build_decode_lut(vexel_converter_t& c, vexel_transfer_t transfer)
+	{
+		for (int i = 0; i < 256; ++i)
+			c.decode_lut[1][i] = (float)i * (1.f / 255.f);
+		vexel_transfer_decode(transfer, c.decode_lut[1], c.decode_lut[0], 256);
+	}
+
+	// Cuerda de cada tramo desplazada media desviación hacia la curva en el punto medio: error < 0.05 unidades antes de
+	// redondear (en sRGB, el 2% de los valores cae en el entero vecino del redondeo exacto)
+	void build_encode_lut(vexel_converter_t& c, vexel_transfer_t transfer)
+	{
+		float x[kEncodeLutSize * 3], y[kEncodeLutSize * 3];
+		for (int i = 0; i < kEncodeLutSize; ++i) {
+			const uint32_t b = kEncodeLutMin + ((uint32_t)i << 20);
+			x[3 * i + 0] = std::bit_cast<float>(b);
+			x[3 * i + 1] = std::bit_cast<float>(b + (1u << 19));
+			x[3 * i + 2] = std::bit_cast<float>(b + (1u << 20));
+		}
+		vexel_transfer_encode(transfer, x, y, kEncodeLutSize * 3);
+		for (int i = 0; i < kEncodeLutSize; ++i) {
+			const double a = 255.0 * y[3 * i], m = 255.0 * y[3 * i + 1], e = 255.0 * y[3 * i + 2];
+			const double base = a + 0.5 + 0.5 * (m - 0.5 * (a + e));
+			c.encode_lut[i][0] = (uint32_t)(std::max(base, 0.0) * 65536.0 + 0.5);
+			c.encode_lut[i][1] = (uint32_t)(std::max(e - a, 0.0) * 256.0 + 0.5);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Rutas
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void run_copy(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		std::memcpy(d, s, n * c.src_stride);
+	}
+
+	void run_pipeline(const vexel_converter_t& c, const uint8_t* s, uint8_t* d, size_t n)
+	{
+		alignas(64) float a[kBlock * 4];
+		alignas(64) float b[kBlock * 4];
+		alignas(64) uint8_t t[kBlock * 4 * 8];		// salida de pre o entrada de post (nunca ambas)
+		while (n) {
+			const size_t m = std::min(n, kBlock);
+
+			const uint8_t* in = s;
+			if (c.pre) {
+				c.pre(c, s, t, m);
+				in = t;
+			}
+			uint8_t* out = c.post ? t : d;
+
+			// Cada etapa float escribe directamente en out si es la última y el destino es float32
+			const bool encodes = c.encode || c.encode8;
+			const float* f = reinterpret_cast<const float*>(in);
+			if (c.decode || c.decode8) {
+				float* o = (!c.remap && !c.color && !encodes) ? reinterpret_cast<float*>(out) : a;
+				if (c.decode8)
+					c.decode8(c, in, o, m);
+				else
+					c.decode(in, o, m * c.src_units);
+				f = o;
+			}
+			if (c.remap) {
+				float* o = (c.color || encodes) ? b : reinterpret_cast<float*>(out);
+				c.remap(f, o, m, c.map);
+				f = o;
+			}
+			if (c.color) {
+				float* o = encodes ? (f == b ? b : a) : reinterpret_cast<float*>(out);
+				c.color(c, f, o, m);
+				f = o;
+			}
+			if (c.encode8)
+				c.encode8(c, f, out, m);
+			else if (c.encode)
+				c.encode(f, out, m * c.dst_units);
+			else if (reinterpret_cast<const uint8_t*>(f) != out)
+				std::memcpy(out, f, m * c.float_channels * sizeof(float));
+
+			if (c.post)
+				c.post(c, t, d, m);
+
+			s += m * c.src_stride;
+			d += m * c.dst_stride;
+			n -= m;
+		}
+	}
+
+	// Permutación sobre componentes uniformes del tipo de desc; con bytes, pshufb/tbl si la ISA lo permite
+	vexel_converter_t::run_fn permute_fn(vexel_converter_t& c, const desc_t& desc, int cs, int cd)
+	{
+		c.one = one_bits(desc);
+		if (desc.elem_bytes == 1) {
+			build_shuffle(c, cs, cd);
+			if (auto fn = byte_shuffle(cs, cd))
+				return fn;
+		}
+		return kPermute[std::countr_zero((unsigned)desc.elem_bytes) & 3][cs - 1][cd - 1];
+	}
+
+	// Sólo entre espacios distintos, gestionados y con componentes normalizados o float
+	bool needs_color(vexel_space_t ss, vexel_space_t ds, const desc_t& s, const desc_t& d)
+	{
+		const auto managed = [](vexel_space_t sp, const desc_t& x) {
+			return vexel_gamut(sp) != vexel_gamut_t::NONE && x.num != num_t::UINT && x.num != num_t::SINT;
+		};
+		if (ss == ds || !managed(ss, s) || !managed(ds, d))
+			return false;
+		return vexel_gamut(ss) != vexel_gamut(ds) || vexel_transfer(ss) != vexel_transfer(ds);
+	}
+
+	// layout: canal RGBA de cada componente del tramo float
+	void setup_color(vexel_converter_t& c, vexel_space_t ss, vexel_space_t ds, const desc_t& s, const desc_t& d, const uint8_t* layout)
+	{
+		c.src_transfer = vexel_transfer(ss);
+		c.dst_transfer = vexel_transfer(ds);
+
+		uint8_t pos[4] = { 4, 4, 4, 4 };
+		for (int k = 0; k < c.float_channels; ++k) pos[layout[k]] = (uint8_t)k;
+		c.rgb[0] = pos[0];
+		c.rgb[1] = pos[1];
+		c.rgb[2] = pos[2];
+		c.alpha = pos[3];
+		// Sin los tres canales de color sólo se aplican las transferencias
+		c.has_matrix = pos[0] < 4 && pos[1] < 4 && pos[2] < 4 && vexel_gamut(ss) != vexel_gamut(ds)
+					&& vexel_gamut_matrix(vexel_gamut(ss), vexel_gamut(ds), c.matrix);
+
+		if (s.pack == pack_t::NONE && s.num == num_t::UNORM && s.elem_bytes == 1 && c.src_transfer != vexel_transfer_t::LINEAR) {
+			build_decode_lut(c, c.src_transfer);
+			c.decode8 = kDecode8[c.float_channels - 1];
+			c.decode = nullptr;
+			c.src_transfer = vexel_transfer_t::LINEAR;
+		}
+		// La tabla por tramos empieza en 2^-13: sólo vale para curvas que ahí todavía dan 0 en 8 bits
+		const bool lut_encode = c.dst_transfer == vexel_transfer_t::SRGB || c.dst_transfer == vexel_transfer_t::EXTENDED_SRGB
+							 || c.dst_transfer == vexel_transfer_t::BT709;
+		if (d.pack == pack_t::NONE && d.num == num_t::UNORM && d.elem_bytes == 1 && lut_encode) {
+			build_encode_lut(c, c.dst_transfer);
+			c.encode8 = kEncode8[c.float_channels - 1];
+			c.encode = nullptr;
+			c.dst_transfer = vexel_transfer_t::LINEAR;
+		}
+
+		if (c.has_matrix || c.src_transfer != vexel_transfer_t::LINEAR || c.dst_transfer != vexel_transfer_t::LINEAR)
+			c.color = run_color;
+	}
+
+	std::unique_ptr<vexel_converter_t> resolve(vexel_format_t src_format, vexel_format_t dst_format)
+	{
+		desc_t s, d;
+		if (!describe(src_format, s) || !describe(dst_format, d))
+			return nullptr;
+
+		auto c = std::make_unique<vexel_converter_t>();
+		c->src_stride = s.stride;
+		c->dst_stride = d.stride;
+
+		bool identity = s.channels == d.channels;
+		for (int j = 0; j < d.channels; ++j) {
+			const uint8_t ch = d.chan[j];
+			uint8_t m = (ch == 3) ? 5 : 4;
+			for (int k = 0; k < s.channels; ++k)
+				if (s.chan[k] == ch) m = (uint8_t)k;
+			c->map[j] = m;
+			identity &= m == j;
+		}
+
+		const bool color = needs_color(src_format.space(), dst_format.space(), s, d);
+		if (s.same_encoding(d) && !color) {
+			if (identity) {
+				c->run = run_copy;
+				return c;
+			}
+			if (s.pack == pack_t::NONE) {
+				c->run = permute_fn(*c, s, s.channels, d.channels);
+				return c;
+			}
+		}
+
+		encode_fn unused_enc;
+		decode_fn unused_dec;
+		if (!pipeline_fns(s, c->decode, unused_enc) || !pipeline_fns(d, unused_dec, c->encode))
+			return nullptr;
+
+		// Reordenado: con el destino uniforme se codifica en el orden del origen y se permuta después; con el origen
+		// uniforme se permuta antes de decodificar; entre dos empaquetados se reordena en float
+		int fc = d.channels;
+		if (!identity) {
+			if (d.pack == pack_t::NONE) {
+				c->post = permute_fn(*c, d, s.channels, d.channels);
+				fc = s.channels;
+			} else if (s.pack == pack_t::NONE) {
+				c->pre = permute_fn(*c, s, s.channels, d.channels);
+			} else {
+				c->remap = kRemap[s.channels - 1][d.channels - 1];
+			}
+		}
+		c->float_channels = (uint8_t)fc;
+		c->src_units = s.pack == pack_t::NONE ? (uint8_t)(c->pre ? d.channels : s.channels) : 1;
+		c->dst_units = d.pack == pack_t::NONE ? (uint8_t)fc : 1;
+		if (color)
+			setup_color(*c, src_format.space(), dst_format.space(), s, d, c->post ? s.chan : d.chan);
+		c->run = run_pipeline;
+		return c;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Caché por par de códigos
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Sólo cuentan los campos que cambian el resultado: recurso, LODs o interpolación no crean conversores nuevos
+	constexpr uint64_t kKeyMask = vexel_format_t::SPACE_MASK | vexel_format_t::ORDER_MASK | vexel_format_t::STR_MASK;
+
+	struct cache_key_t {
+		uint64_t src, dst;
+		bool operator==(const cache_key_t& o) const { return src == o.src && dst == o.dst; }
+	};
+
+	struct cache_hash_t {
+		size_t operator()(const cache_key_t& k) const noexcept { return std::hash<uint64_t>{}(k.src * 0x9E3779B97F4A7C15ull ^ k.dst); }
+	};
+
+	struct cache_t {
+		std::shared_mutex lock;
+		std::unordered_map<cache_key_t, std::unique_ptr<vexel_converter_t>, cache_hash_t> map;	// nullptr = no soportado
+	};
+
+	cache_t& cache()
+	{
+		static cache_t c;
+		return c;
+	}
+
+} // namespace
+
+DLL_FNC(uint32_t) vexel_byte_count(vexel_format_t format)
+{
+	desc_t d;
+	return describe(format, d) ? d.stride : 0;
+}
+
+DLL_FNC(const vexel_converter_t*) vexel_converter(vexel_format_t src_format, vexel_format_t dst_format)
+{
+	const cache_key_t key = { src_format.code & kKeyMask, dst_format.code & kKeyMask };
+
+	// La subida de texturas repite el mismo par: el último acierto por hilo evita incluso el lock compartido
+	thread_local cache_key_t last_key = { ~0ull, ~0ull };
+	thread_local const vexel_converter_t* last = nullptr;
+	if (key == last_key)
+		return last;
+
+	cache_t& c = cache();
+	const vexel_converter_t* r;
+	{
+		std::shared_lock<std::shared_mutex> lock(c.lock);
+		auto it = c.map.find(key);
+		if (it != c.map.end()) {
+			r = it->second.get();
+			last_key = key;
+			last = r;
+			return r;
+		}
+	}
+
+	auto resolved = resolve(vexel_format_t(key.src), vexel_format_t(key.dst));
+	{
+		std::unique_lock<std::shared_mutex> lock(c.lock);
+		auto it = c.map.try_emplace(key, std::move(resolved)).first;
+		r = it->second.get();
+	}
+	last_key = key;
+	last = r;
+	return r;
+}
+
+DLL_FNC(void) convert(const vexel_converter_t& converter, const void* src, void* dst, size_t count)
+{
+	if (count)
+		converter.run(converter, static_cast<const uint8_t*>(src), static_cast<uint8_t*>(dst), count);
+}
+
+DLL_FNC(size_t) convert(vexel_format_t src_format, vexel_format_t dst_format, std::span<const std::byte> src, std::span<std::byte> dst)
+{
+	const vexel_converter_t* c = vexel_converter(src_format, dst_format);
+	if (!c)
+		return 0;
+	const size_t count = std::min(src.size() / c->src_stride, dst.size() / c->dst_stride);
+	convert(*c, src.data(), dst.data(), count);
+	return count;
+}
@@ -0,0 +1,402 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_mip.h>
+#include <core/vexel_color.h>
+#include <core/vexel_tiling.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#elif defined(__aarch64__)
+#	include <arm_neon.h>
+#endif
+
+// Cada nivel se guarda en RGBA float (VEC4_F32, RGB lineal si el espacio está gestionado) para todas las caras y
+// elementos a la vez. El paso x filtra cada fila del nivel anterior a la anchura nueva con un registro de 4 floats por
+// vexel; el paso y/z combina las filas ya estrechadas con los pesos de los dos ejes multiplicados y vuelve al formato
+// de origen fila a fila. Los pesos de cada eje se calculan una vez por nivel, con los taps fuera del borde sumados al
+// último vexel, de modo que los bucles internos no comprueban límites.
+
+namespace {
+
+	constexpr double kPi = 3.14159265358979323846;
+	constexpr double kSincRadius = 3.0;		// radio de Kaiser y Lanczos en vexels de destino
+	constexpr size_t kRowGrain = 16;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Pesos
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	double sinc(double x)
+	{
+		if (std::fabs(x) < 1e-9)
+			return 1.0;
+		return std::sin(kPi * x) / (kPi * x);
+	}
+
+	// Bessel modificada de primera especie y orden 0 (serie de potencias; converge de sobra para alpha < 20)
+	double bessel_i0(double x)
+	{
+		double sum = 1.0, term = 1.0;
+		const double q = x * x * 0.25;
+		for (int k = 1; k < 32; ++k) {
+			term *= q / (double(k) * double(k));
+			sum += term;
+			if (term < sum * 1e-12)
+				break;
+		}
+		return sum;
+	}
+
+	// Para cada vexel de destino, primer vexel de origen y stride pesos normalizados (ceros al final si sobran)
+	struct mip_taps_t {
+		std::vector<uint32_t>	first;
+		std::vector<uint32_t>	count;
+		std::vector<float>		weights;
+		uint32_t				stride = 0;
+	};
+
+	mip_taps_t build_taps(uint64_t src_count, uint64_t dst_count, const mip_params_t& params)
+	{
+		const double scale = double(src_count) / double(dst_count);
+		const double radius = params.filter == mip_filter_t::BOX ? 0.5 * scale : kSincRadius * scale;
+		const double kaiser_norm = 1.0 / bessel_i0(params.kaiser_alpha);
+		const int64_t last = int64_t(src_count) - 1;
+
+		mip_taps_t t;
+		t.first.resize(dst_count);
+		t.count.resize(dst_count);
+		t.stride = uint32_t(std::min<int64_t>(int64_t(std::ceil(2.0 * radius)) + 2, int64_t(src_count)));
+		t.weights.assign(dst_count * t.stride, 0.0f);
+
+		std::vector<double> w(t.stride);
+		for (uint64_t i = 0; i < dst_count; ++i) {
+			const double center = (double(i) + 0.5) * scale;
+			const int64_t lo = int64_t(std::floor(center - radius));
+			const int64_t hi = int64_t(std::ceil(center + radius));
+			const int64_t first = std::clamp<int64_t>(lo, 0, last);
+			const int64_t end = std::clamp<int64_t>(hi - 1, 0, last) + 1;
+
+			std::fill(w.begin(), w.end(), 0.0);
+			double sum = 0.0;
+			for (int64_t j = lo; j < hi; ++j) {
+				double v;
+				if (params.filter == mip_filter_t::BOX) {
+					v = std::min(double(j + 1), center + radius) - std::max(double(j), center - radius);
+					v = std::max(v, 0.0);
+				} else {
+					const double x = (double(j) + 0.5 - center) / scale;
+					if (std::fabs(x) >= kSincRadius)
+						continue;
+					if (params.filter == mip_filter_t::LANCZOS)
+						v = sinc(x) * sinc(x / kSincRadius);
+					else {
+						const double r = x / kSincRadius;
+						v = sinc(x) * bessel_i0(params.kaiser_alpha * std::sqrt(1.0 - r * r)) * kaiser_norm;
+					}
+				}
+				w[size_t(std::clamp<int64_t>(j, 0, last) - first)] += v;
+				sum += v;
+			}
+
+			t.first[i] = uint32_t(first);
+			t.count[i] = uint32_t(end - first);
+			float* dst = &t.weights[i * t.stride];
+			for (int64_t k = 0; k < end - first; ++k)
+				dst[k] = float(w[size_t(k)] / sum);
+		}
+		return t;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Kernels
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Fila RGBA de src a t.first.size() vexels de dst
+	using filter_x_fn = void (*)(const float* src, const mip_taps_t& t, float* dst);
+	// dst[i] = sum(weights[k] * rows[k][i]) para n floats
+	using filter_y_fn = void (*)(const float* const* rows, const float* weights, size_t count, float* dst, size_t n);
+
+	struct mip_kernels_t {
+		filter_x_fn	filter_x;
+		filter_y_fn	filter_y;
+	};
+
+	void filter_x_scalar(const float* src, const mip_taps_t& t, float* dst)
+	{
+		for (size_t i = 0; i < t.first.size(); ++i) {
+			const float* s = src + size_t(t.first[i]) * 4;
+			const float* w = &t.weights[i * t.stride];
+			float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+			for (uint32_t k = 0; k < t.count[i]; ++k, s += 4) {
+				r += w[k] * s[0];
+				g += w[k] * s[1];
+				b += w[k] * s[2];
+				a += w[k] * s[3];
+			}
+			dst[i * 4 + 0] = r;
+			dst[i * 4 + 1] = g;
+			dst[i * 4 + 2] = b;
+			dst[i * 4 + 3] = a;
+		}
+	}
+
+	void filter_y_scalar(const float* const* rows, const float* weights, size_t count, float* dst, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i) {
+			float acc = 0.0f;
+			for (size_t k = 0; k < count; ++k)
+				acc += weights[k] * rows[k][i];
+			dst[i] = acc;
+		}
+	}
+
+#if defined(SIMD_KERNELS_X86)
+
+	SIMD_TARGET("sse2")
+	void filter_x_sse2(const float* src, const mip_taps_t& t, float* dst)
+	{
+		for (size_t i = 0; i < t.first.size(); ++i) {
+			const float* s = src + size_t(t.first[i]) * 4;
+			const float* w = &t.weights[i * t.stride];
+			__m128 acc = _mm_setzero_ps();
+			for (uint32_t k = 0; k < t.count[i]; ++k, s += 4)
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(s), _mm_set1_ps(w[k])));
+			_mm_storeu_ps(dst + i * 4, acc);
+		}
+	}
+
+	SIMD_TARGET("avx2,fma")
+	void filter_y_avx2(const float* const* rows, const float* weights, size_t count, float* dst, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m256 acc = _mm256_mul_ps(_mm256_loadu_ps(rows[0] + i), _mm256_set1_ps(weights[0]));
+			for (size_t k = 1; k < count; ++k)
+				acc = _mm256_fmadd_ps(_mm256_loadu_ps(rows[k] + i), _mm256_set1_ps(weights[k]), acc);
+			_mm256_storeu_ps(dst + i, acc);
+		}
+		for (; i < n; ++i) {
+			float acc = 0.0f;
+			for (size_t k = 0; k < count; ++k)
+				acc += weights[k] * rows[k][i];
+			dst[i] = acc;
+		}
+	}
+
+#elif defined(__aarch64__)
+
+	void filter_x_neon(const float* src, const mip_taps_t& t, float* dst)
+	{
+		for (size_t i = 0; i < t.first.size(); ++i) {
+			const float* s = src + size_t(t.first[i]) * 4;
+			const float* w = &t.weights[i * t.stride];
+			float32x4_t acc = vdupq_n_f32(0.0f);
+			for (uint32_t k = 0; k < t.count[i]; ++k, s += 4)
+				acc = vfmaq_n_f32(acc, vld1q_f32(s), w[k]);
+			vst1q_f32(dst + i * 4, acc);
+		}
+	}
+
+	void filter_y_neon(const float* const* rows, const float* weights, size_t count, float* dst, size_t n)
+	{
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			float32x4_t acc = vmulq_n_f32(vld1q_f32(rows[0] + i), weights[0]);
+			for (size_t k = 1; k < count; ++k)
+				acc = vfmaq_n_f32(acc, vld1q_f32(rows[k] + i), weights[k]);
+			vst1q_f32(dst + i, acc);
+		}
+		for (; i < n; ++i) {
+			float acc = 0.0f;
+			for (size_t k = 0; k < count; ++k)
+				acc += weights[k] * rows[k][i];
+			dst[i] = acc;
+		}
+	}
+
+#endif
+
+	mip_kernels_t select_mip_kernels()
+	{
+#if defined(SIMD_KERNELS_X86)
+		const simd::isa_t isa = simd::kernels().isa;
+		if (isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512)
+			return { filter_x_sse2, filter_y_avx2 };
+		if (isa != simd::isa_t::SCALAR)
+			return { filter_x_sse2, filter_y_scalar };
+#elif defined(__aarch64__)
+		if (simd::kernels().isa != simd::isa_t::SCALAR)
+			return { filter_x_neon, filter_y_neon };
+#endif
+		return { filter_x_scalar, filter_y_scalar };
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Cadena
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	struct mip_chain_t {
+		uint64_t	width;
+		uint32_t	height;
+		uint32_t	depth;
+		uint32_t	chains;		// caras x elementos
+		uint32_t	lods;
+		bool		volume;
+
+		explicit mip_chain_t(const buffer_layout_t& layout)
+			: width(layout.object_size.width)
+			, height(std::max<uint32_t>(1, layout.object_size.height))
+			, depth(std::max<uint32_t>(1, layout.object_size.depth))
+			, chains(std::max<uint32_t>(1, layout.array_count) * (layout.object_layout == buffer_object_layout_t::CUBE ? 6 : 1))
+			, lods(std::max<uint32_t>(1, layout.lod_count))
+			, volume(layout.object_layout == buffer_object_layout_t::LAYOUT_3D)
+		{
+		}
+
+		uint64_t w(uint32_t l) const { return std::max<uint64_t>(1, width >> l); }
+		uint32_t h(uint32_t l) const { return std::max<uint32_t>(1, height >> l); }
+		uint32_t d(uint32_t l) const { return volume ? std::max<uint32_t>(1, depth >> l) : 1; }
+	};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(uint64_t) vexel_lod_padding(const buffer_layout_t& layout, uint32_t vexel_byte_count, uint32_t row_alignment,
+								   buffer_object_padding_t* lods)
+{
+	const mip_chain_t chain(layout);
+	const uint64_t align = std::max<uint32_t>(1, row_alignment);
+	vexel_tile_info_t tile;
+	if (!vexel_tile_info(layout.tiling, vexel_byte_count, tile))
+		return 0;
+
+	uint64_t chain_bytes = 0;
+	for (uint32_t l = 0; l < chain.lods; ++l) {
+		buffer_object_padding_t& p = lods[l];
+		const uint64_t tiles_x = (chain.w(l) + tile.width - 1) / tile.width;
+		const uint64_t tiles_y = (chain.h(l) + tile.height - 1) / tile.height;
+		p.row_byte_count = (tiles_x * tile.byte_count + align - 1) / align * align;
+		p.surface_byte_count = p.row_byte_count * tiles_y;
+		p.volume_byte_count = p.surface_byte_count * chain.d(l);
+		p.vexel_byte_count = vexel_byte_count;
+		chain_bytes += p.volume_byte_count;
+	}
+	for (uint32_t l = 0; l < chain.lods; ++l)
+		lods[l].object_byte_count = chain_bytes;
+	return chain_bytes * chain.chains;
+}
+
+DLL_FNC(bool) generate_lods(vexel_format_t format, const buffer_layout_t& layout, const buffer_object_padding_t* lods,
+							void* data, const mip_params_t& params)
+{
+	const uint32_t vexel_bytes = vexel_byte_count(format);
+	if (!vexel_bytes || !lods || layout.tiling != buffer_tiling_t::LINEAR)
+		return false;
+
+	// Los espacios gestionados se filtran en lineal; vexel_converter() se encarga de la transferencia y el gamut
+	const vexel_space_t work_space = vexel_gamut(format.space()) != vexel_gamut_t::NONE ? vexel_space_t::RGB : format.space();
+	const vexel_format_t work = vexel_format_t::VEC4_F32().space(work_space);
+	const vexel_converter_t* to_work = vexel_converter(format, work);
+	const vexel_converter_t* from_work = vexel_converter(work, format);
+	if (!to_work || !from_work)
+		return false;
+
+	const mip_chain_t chain(layout);
+	if (!chain.width)
+		return true;
+
+	std::vector<uint64_t> level_offset(chain.lods);
+	uint64_t chain_bytes = 0;
+	for (uint32_t l = 0; l < chain.lods; ++l) {
+		const buffer_object_padding_t& p = lods[l];
+		if (p.row_byte_count < chain.w(l) * vexel_bytes || p.surface_byte_count < p.row_byte_count * chain.h(l) ||
+			p.volume_byte_count < p.surface_byte_count * chain.d(l))
+			return false;
+		level_offset[l] = chain_bytes;
+		chain_bytes += p.volume_byte_count;
+	}
+	const uint64_t chain_stride = lods[0].object_byte_count;
+	if (chain.chains > 1 && chain_stride < chain_bytes)
+		return false;
+	if (layout.byte_count && chain_stride * (chain.chains - 1) + chain_bytes > layout.byte_count)
+		return false;
+	if (chain.lods == 1)
+		return true;
+
+	uint8_t* base = static_cast<uint8_t*>(data);
+	const mip_kernels_t k = select_mip_kernels();
+
+	// Nivel 0 de todas las cadenas a float; fila r = (cadena, corte, fila)
+	std::vector<float> prev(chain.chains * chain.d(0) * chain.h(0) * chain.w(0) * 4);
+	{
+		const uint64_t w = chain.w(0);
+		const uint32_t h = chain.h(0), d = chain.d(0);
+		const buffer_object_padding_t& p = lods[0];
+		parallel_for(size_t(chain.chains) * d * h, kRowGrain, [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r) {
+				const size_t c = r / (size_t(d) * h), z = r / h % d, y = r % h;
+				const uint8_t* src = base + c * chain_stride + z * p.surface_byte_count + y * p.row_byte_count;
+				convert(*to_work, src, &prev[r * w * 4], w);
+			}
+		});
+	}
+
+	std::vector<float> narrow, cur;
+	for (uint32_t l = 1; l < chain.lods; ++l) {
+		const uint64_t src_w = chain.w(l - 1), dst_w = chain.w(l);
+		const uint32_t src_h = chain.h(l - 1), dst_h = chain.h(l);
+		const uint32_t src_d = chain.d(l - 1), dst_d = chain.d(l);
+		const mip_taps_t taps_x = build_taps(src_w, dst_w, params);
+		const mip_taps_t taps_y = build_taps(src_h, dst_h, params);
+		const mip_taps_t taps_z = build_taps(src_d, dst_d, params);
+
+		// x: cada fila del nivel anterior a la anchura nueva
+		const size_t src_rows = size_t(chain.chains) * src_d * src_h;
+		narrow.resize(src_rows * dst_w * 4);
+		parallel_for(src_rows, kRowGrain, [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r)
+				k.filter_x(&prev[r * src_w * 4], taps_x, &narrow[r * dst_w * 4]);
+		});
+
+		// y/z: cada fila nueva combina taps_z x taps_y filas estrechadas; se escribe en data con los pasos del nivel
+		const size_t dst_rows = size_t(chain.chains) * dst_d * dst_h;
+		cur.resize(dst_rows * dst_w * 4);
+		const buffer_object_padding_t& p = lods[l];
+		parallel_for(dst_rows, kRowGrain, [&](size_t begin, size_t end) {
+			std::vector<const float*> rows(size_t(taps_z.stride) * taps_y.stride);
+			std::vector<float> weights(rows.size());
+			for (size_t r = begin; r < end; ++r) {
+				const size_t c = r / (size_t(dst_d) * dst_h), z = r / dst_h % dst_d, y = r % dst_h;
+				size_t count = 0;
+				for (uint32_t tz = 0; tz < taps_z.count[z]; ++tz) {
+					const float wz = taps_z.weights[z * taps_z.stride + tz];
+					const size_t slice = (c * src_d + taps_z.first[z] + tz) * src_h;
+					for (uint32_t ty = 0; ty < taps_y.count[y]; ++ty) {
+						rows[count] = &narrow[(slice + taps_y.first[y] + ty) * dst_w * 4];
+						weights[count++] = wz * taps_y.weights[y * taps_y.stride + ty];
+					}
+				}
+				float* row = &cur[r * dst_w * 4];
+				k.filter_y(rows.data(), weights.data(), count, row, dst_w * 4);
+
+				uint8_t* dst = base + c * chain_stride + level_offset[l] + z * p.surface_byte_count + y * p.row_byte_count;
+				convert(*from_work, row, dst, dst_w);
+			}
+		});
+		std::swap(prev, cur);
+	}
+	return true;
+}
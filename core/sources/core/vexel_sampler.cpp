@@ -0,0 +1,503 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_sampler.h>
+#include <core/vexel_block.h>
+#include <core/vexel_color.h>
+#include <core/vexel_mip.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+#include <simd/simd_memory_ops.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#endif
+
+// Cada lote de 8 lanes se resuelve en dos pasos: primero los vecinos (índice en floats del canal rojo y peso, hasta
+// 2 niveles x 2^3 vecinos) y después la acumulación, con un gather por canal y vecino. Los índices y pesos de fuera
+// del borde en CLAMP_TO_BORDER valen 0 y lo que falta hasta 1 se rellena con el color de borde. La ruta AVX2 hace las
+// mismas operaciones en el mismo orden, así que elige los mismos vexels que la escalar.
+
+namespace {
+
+	constexpr float kCoordLimit = 16777216.0f;		// 2^24: los vexels siguen siendo enteros exactos en float
+	constexpr size_t kBatchGrain = 256;				// lotes de 8 coordenadas por tarea
+	constexpr int kMaxTaps = 16;
+
+	// Lo que no cambia entre lotes de una llamada
+	struct sample_plan_t {
+		const float*		texels;
+		const int32_t*		sizes;
+		const int32_t*		offsets;		// niveles de la capa
+		int					axes;
+		int					taps;			// vecinos por eje: 1 si ningún filtro es LINEAR
+		int					levels;			// 2 con mip_filter LINEAR
+		bool				min_linear;
+		bool				mag_linear;
+		bool				border;
+		sampler_read_t		mip;
+		sampler_wrap_mode_t	wrap[3];
+		int32_t				max_level;
+		float				border_rgba[4];
+	};
+
+	bool make_plan(const sampler_texture_t& t, const buffer_sampler_t& s, uint32_t layer, const float* border,
+				   sample_plan_t& p)
+	{
+		if (!t.lod_count || layer >= t.layer_count)
+			return false;
+		p.texels = t.texels.data();
+		p.sizes = t.sizes.data();
+		p.offsets = t.offsets.data() + size_t(layer) * t.lod_count;
+		p.axes = t.object_layout == buffer_object_layout_t::LAYOUT_3D ? 3 : t.object_layout == buffer_object_layout_t::LAYOUT_1D ? 1 : 2;
+		p.min_linear = s.min_filter == sampler_read_t::LINEAR;
+		p.mag_linear = s.mag_filter == sampler_read_t::LINEAR;
+		p.taps = p.min_linear || p.mag_linear ? 2 : 1;
+		p.mip = t.lod_count > 1 ? s.mip_filter : sampler_read_t::NONE;
+		p.levels = p.mip == sampler_read_t::LINEAR ? 2 : 1;
+		p.wrap[0] = s.wrap_x;
+		p.wrap[1] = s.wrap_y;
+		p.wrap[2] = s.wrap_z;
+		p.border = false;
+		for (int a = 0; a < p.axes; ++a)
+			p.border |= p.wrap[a] == sampler_wrap_mode_t::CLAMP_TO_BORDER;
+		p.max_level = int32_t(t.lod_count - 1);
+		for (int c = 0; c < 4; ++c)
+			p.border_rgba[c] = border ? border[c] : 0.0f;
+		return true;
+	}
+
+	// Vecinos de un lote: índice del canal rojo en texels y peso, por vecino y lane
+	struct sample_taps_t {
+		alignas(32) int32_t	index[kMaxTaps][8];
+		alignas(32) float	weight[kMaxTaps][8];
+		int					count;
+	};
+
+	// Salida de un lote por canales: r[8] g[8] b[8] a[8]
+	using sample_batch_fn = void (*)(const sample_plan_t& p, const float* u, const float* v, const float* w,
+									 const float* lod, float* out);
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Escalar
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int32_t wrap_index(int32_t i, int32_t n, sampler_wrap_mode_t mode, bool& valid)
+	{
+		valid = true;
+		switch (mode) {
+		case sampler_wrap_mode_t::REPEAT: {
+			const int32_t r = i % n;
+			return r < 0 ? r + n : r;
+		}
+		case sampler_wrap_mode_t::MIRRORED_REPEAT: {
+			const int32_t period = 2 * n;
+			int32_t r = i % period;
+			if (r < 0)
+				r += period;
+			return r < n ? r : period - 1 - r;
+		}
+		case sampler_wrap_mode_t::MIRROR:
+			return std::min(i < 0 ? -1 - i : i, n - 1);
+		case sampler_wrap_mode_t::CLAMP_TO_BORDER:
+			valid = i >= 0 && i < n;
+			[[fallthrough]];
+		default:
+			return std::clamp(i, 0, n - 1);
+		}
+	}
+
+	// Los dos vecinos de un eje (el segundo pesa 0 con NEAREST)
+	void axis_taps(float coord, int32_t n, bool linear, sampler_wrap_mode_t mode, int32_t idx[2], float wt[2])
+	{
+		float t = coord * float(n) - (linear ? 0.5f : 0.0f);
+		t = t > -kCoordLimit ? t : -kCoordLimit;		// NaN -> límite inferior, como max/min de SSE
+		t = t < kCoordLimit ? t : kCoordLimit;
+		const float fl = std::floor(t);
+		const int32_t i = int32_t(fl);
+		const float f = linear ? t - fl : 0.0f;
+		wt[0] = 1.0f - f;
+		wt[1] = f;
+		for (int k = 0; k < 2; ++k) {
+			bool valid;
+			idx[k] = wrap_index(i + k, n, mode, valid);
+			if (!valid)
+				wt[k] = 0.0f;
+		}
+	}
+
+	void lane_taps(const sample_plan_t& p, int lane, float u, float v, float w, float lod, sample_taps_t& t)
+	{
+		float l = lod > 0.0f ? lod : 0.0f;
+		const bool linear = l <= 0.0f ? p.mag_linear : p.min_linear;
+		l = l < float(p.max_level) ? l : float(p.max_level);
+
+		int32_t level[2] = { 0, 0 };
+		float level_w[2] = { 1.0f, 0.0f };
+		if (p.mip == sampler_read_t::NEAREST)
+			level[0] = int32_t(std::ceil(l + 0.5f) - 1.0f);
+		else if (p.mip == sampler_read_t::LINEAR) {
+			const float fl = std::floor(l);
+			level[0] = int32_t(fl);
+			level[1] = std::min(level[0] + 1, p.max_level);
+			level_w[1] = l - fl;
+			level_w[0] = 1.0f - level_w[1];
+		}
+
+		const float coord[3] = { u, v, w };
+		const int tx = p.taps, ty = p.axes > 1 ? p.taps : 1, tz = p.axes > 2 ? p.taps : 1;
+		int c = 0;
+		for (int li = 0; li < p.levels; ++li) {
+			const int32_t* size = p.sizes + level[li] * 4;
+			int32_t idx[3][2] = {};
+			float wt[3][2] = { { 1.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 0.0f } };
+			for (int a = 0; a < p.axes; ++a)
+				axis_taps(coord[a], size[a], linear, p.wrap[a], idx[a], wt[a]);
+
+			const int32_t row = size[0] * 4, slice = row * size[1], base = p.offsets[level[li]];
+			for (int z = 0; z < tz; ++z)
+				for (int y = 0; y < ty; ++y)
+					for (int x = 0; x < tx; ++x, ++c) {
+						t.index[c][lane] = base + idx[2][z] * slice + idx[1][y] * row + idx[0][x] * 4;
+						t.weight[c][lane] = level_w[li] * wt[2][z] * wt[1][y] * wt[0][x];
+					}
+		}
+		t.count = c;
+	}
+
+	void sample_batch_scalar(const sample_plan_t& p, const float* u, const float* v, const float* w, const float* lod,
+							 float* out)
+	{
+		sample_taps_t t;
+		for (int lane = 0; lane < 8; ++lane)
+			lane_taps(p, lane, u[lane], v[lane], w[lane], lod[lane], t);
+
+		float sum[8] = {};
+		std::fill(out, out + 32, 0.0f);
+		for (int c = 0; c < t.count; ++c) {
+			for (int k = 0; k < 4; ++k) {
+				const simd_pack_t<8, float> g = simd::gather<8>(p.texels + k, t.index[c]);
+				for (int lane = 0; lane < 8; ++lane)
+					out[k * 8 + lane] += g[lane] * t.weight[c][lane];
+			}
+			for (int lane = 0; lane < 8; ++lane)
+				sum[lane] += t.weight[c][lane];
+		}
+		if (p.border)
+			for (int k = 0; k < 4; ++k)
+				for (int lane = 0; lane < 8; ++lane)
+					out[k * 8 + lane] += (1.0f - sum[lane]) * p.border_rgba[k];
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// AVX2
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(SIMD_KERNELS_X86)
+
+	// i mod n en [0, n) para |i| <= 2^24 + 1; el cociente en float puede fallar en uno y se corrige después
+	SIMD_TARGET("avx2")
+	inline __m256i mod_avx2(__m256i i, __m256i n)
+	{
+		const __m256 q = _mm256_floor_ps(_mm256_div_ps(_mm256_cvtepi32_ps(i), _mm256_cvtepi32_ps(n)));
+		__m256i r = _mm256_sub_epi32(i, _mm256_mullo_epi32(_mm256_cvttps_epi32(q), n));
+		r = _mm256_add_epi32(r, _mm256_and_si256(n, _mm256_cmpgt_epi32(_mm256_setzero_si256(), r)));
+		r = _mm256_sub_epi32(r, _mm256_andnot_si256(_mm256_cmpgt_epi32(n, r), n));
+		return r;
+	}
+
+	SIMD_TARGET("avx2")
+	inline __m256i wrap_avx2(__m256i i, __m256i n, sampler_wrap_mode_t mode, __m256& valid)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i last = _mm256_sub_epi32(n, _mm256_set1_epi32(1));
+		valid = _mm256_castsi256_ps(_mm256_cmpeq_epi32(zero, zero));
+		switch (mode) {
+		case sampler_wrap_mode_t::REPEAT:
+			return mod_avx2(i, n);
+		case sampler_wrap_mode_t::MIRRORED_REPEAT: {
+			const __m256i period = _mm256_add_epi32(n, n);
+			const __m256i r = mod_avx2(i, period);
+			const __m256i mirrored = _mm256_sub_epi32(_mm256_sub_epi32(period, _mm256_set1_epi32(1)), r);
+			return _mm256_blendv_epi8(mirrored, r, _mm256_cmpgt_epi32(n, r));
+		}
+		case sampler_wrap_mode_t::MIRROR:
+			return _mm256_min_epi32(_mm256_xor_si256(i, _mm256_srai_epi32(i, 31)), last);
+		case sampler_wrap_mode_t::CLAMP_TO_BORDER:
+			valid = _mm256_castsi256_ps(_mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi32(zero, i), _mm256_cmpgt_epi32(i, last)),
+															_mm256_cmpeq_epi32(zero, zero)));
+			[[fallthrough]];
+		default:
+			return _mm256_max_epi32(_mm256_min_epi32(i, last), zero);
+		}
+	}
+
+	SIMD_TARGET("avx2")
+	inline void axis_avx2(__m256 coord, __m256i n, __m256 linear, sampler_wrap_mode_t mode, __m256i idx[2], __m256 wt[2])
+	{
+		__m256 t = _mm256_sub_ps(_mm256_mul_ps(coord, _mm256_cvtepi32_ps(n)), _mm256_and_ps(linear, _mm256_set1_ps(0.5f)));
+		t = _mm256_max_ps(t, _mm256_set1_ps(-kCoordLimit));
+		t = _mm256_min_ps(t, _mm256_set1_ps(kCoordLimit));
+		const __m256 fl = _mm256_floor_ps(t);
+		const __m256i i = _mm256_cvttps_epi32(fl);
+		const __m256 f = _mm256_and_ps(_mm256_sub_ps(t, fl), linear);
+		wt[0] = _mm256_sub_ps(_mm256_set1_ps(1.0f), f);
+		wt[1] = f;
+		for (int k = 0; k < 2; ++k) {
+			__m256 valid;
+			idx[k] = wrap_avx2(_mm256_add_epi32(i, _mm256_set1_epi32(k)), n, mode, valid);
+			wt[k] = _mm256_and_ps(wt[k], valid);
+		}
+	}
+
+	SIMD_TARGET("avx2,fma")
+	void sample_batch_avx2(const sample_plan_t& p, const float* u, const float* v, const float* w, const float* lod,
+						   float* out)
+	{
+		const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+		const __m256i ones = _mm256_set1_epi32(-1);
+
+		__m256 l = _mm256_max_ps(_mm256_loadu_ps(lod), zero);
+		const __m256 magnify = _mm256_cmp_ps(l, zero, _CMP_LE_OQ);
+		const __m256 linear = _mm256_blendv_ps(_mm256_castsi256_ps(p.min_linear ? ones : _mm256_setzero_si256()),
+											   _mm256_castsi256_ps(p.mag_linear ? ones : _mm256_setzero_si256()), magnify);
+		l = _mm256_min_ps(l, _mm256_set1_ps(float(p.max_level)));
+
+		__m256i level[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+		__m256 level_w[2] = { one, zero };
+		if (p.mip == sampler_read_t::NEAREST)
+			level[0] = _mm256_cvttps_epi32(_mm256_sub_ps(_mm256_ceil_ps(_mm256_add_ps(l, _mm256_set1_ps(0.5f))), one));
+		else if (p.mip == sampler_read_t::LINEAR) {
+			const __m256 fl = _mm256_floor_ps(l);
+			level[0] = _mm256_cvttps_epi32(fl);
+			level[1] = _mm256_min_epi32(_mm256_add_epi32(level[0], _mm256_set1_epi32(1)), _mm256_set1_epi32(p.max_level));
+			level_w[1] = _mm256_sub_ps(l, fl);
+			level_w[0] = _mm256_sub_ps(one, level_w[1]);
+		}
+
+		const __m256 coord[3] = { _mm256_loadu_ps(u), _mm256_loadu_ps(v), _mm256_loadu_ps(w) };
+		const int tx = p.taps, ty = p.axes > 1 ? p.taps : 1, tz = p.axes > 2 ? p.taps : 1;
+		__m256 acc[4] = { zero, zero, zero, zero };
+		__m256 sum = zero;
+		for (int li = 0; li < p.levels; ++li) {
+			const __m256i size_index = _mm256_slli_epi32(level[li], 2);
+			__m256i n[3], idx[3][2];
+			__m256 wt[3][2];
+			for (int a = 0; a < 3; ++a) {
+				n[a] = _mm256_i32gather_epi32(p.sizes + a, size_index, 4);
+				idx[a][0] = idx[a][1] = _mm256_setzero_si256();
+				wt[a][0] = one;
+				wt[a][1] = zero;
+			}
+			for (int a = 0; a < p.axes; ++a)
+				axis_avx2(coord[a], n[a], linear, p.wrap[a], idx[a], wt[a]);
+
+			const __m256i row = _mm256_slli_epi32(n[0], 2);
+			const __m256i slice = _mm256_mullo_epi32(row, n[1]);
+			const __m256i base = _mm256_i32gather_epi32(p.offsets, level[li], 4);
+			for (int z = 0; z < tz; ++z) {
+				const __m256i iz = _mm256_add_epi32(base, _mm256_mullo_epi32(idx[2][z], slice));
+				const __m256 wz = _mm256_mul_ps(level_w[li], wt[2][z]);
+				for (int y = 0; y < ty; ++y) {
+					const __m256i iy = _mm256_add_epi32(iz, _mm256_mullo_epi32(idx[1][y], row));
+					const __m256 wy = _mm256_mul_ps(wz, wt[1][y]);
+					for (int x = 0; x < tx; ++x) {
+						const __m256i index = _mm256_add_epi32(iy, _mm256_slli_epi32(idx[0][x], 2));
+						const __m256 weight = _mm256_mul_ps(wy, wt[0][x]);
+						for (int k = 0; k < 4; ++k)
+							acc[k] = _mm256_fmadd_ps(_mm256_i32gather_ps(p.texels + k, index, 4), weight, acc[k]);
+						sum = _mm256_add_ps(sum, weight);
+					}
+				}
+			}
+		}
+		if (p.border) {
+			const __m256 rest = _mm256_sub_ps(one, sum);
+			for (int k = 0; k < 4; ++k)
+				acc[k] = _mm256_fmadd_ps(rest, _mm256_set1_ps(p.border_rgba[k]), acc[k]);
+		}
+		for (int k = 0; k < 4; ++k)
+			_mm256_storeu_ps(out + k * 8, acc[k]);
+	}
+
+#endif
+
+	sample_batch_fn select_sample_kernel()
+	{
+#if defined(SIMD_KERNELS_X86)
+		const simd::isa_t isa = simd::kernels().isa;
+		if (isa == simd::isa_t::AVX2 || isa == simd::isa_t::AVX512)
+			return sample_batch_avx2;
+#endif
+		return sample_batch_scalar;
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(bool) make_sampler_texture(vexel_format_t format, const buffer_layout_t& layout, const buffer_object_padding_t* lods,
+								   const void* data, sampler_texture_t& texture)
+{
+	const vexel_space_t space = vexel_gamut(format.space()) != vexel_gamut_t::NONE ? vexel_space_t::RGB : format.space();
+	const vexel_format_t work = vexel_format_t::VEC4_F32().space(space);
+
+	const uint64_t width = layout.object_size.width;
+	if (!width || layout.tiling != buffer_tiling_t::LINEAR)
+		return false;
+	const uint32_t height = std::max<uint32_t>(1, layout.object_size.height);
+	const uint32_t depth = std::max<uint32_t>(1, layout.object_size.depth);
+	const bool volume = layout.object_layout == buffer_object_layout_t::LAYOUT_3D;
+	const uint32_t layers = std::max<uint32_t>(1, layout.array_count) * (layout.object_layout == buffer_object_layout_t::CUBE ? 6 : 1);
+	const uint32_t lod_count = std::max<uint32_t>(1, layout.lod_count);
+
+	// Niveles de cada capa seguidos, como decode_block_lods()
+	std::vector<int32_t> sizes(size_t(lod_count) * 4);
+	std::vector<int32_t> offsets(size_t(layers) * lod_count);
+	uint64_t layer_floats = 0;
+	for (uint32_t l = 0; l < lod_count; ++l) {
+		const uint64_t w = std::max<uint64_t>(1, width >> l);
+		const uint32_t h = std::max<uint32_t>(1, height >> l);
+		const uint32_t d = volume ? std::max<uint32_t>(1, depth >> l) : 1;
+		if (w > uint64_t(INT32_MAX))
+			return false;
+		sizes[l * 4 + 0] = int32_t(w);
+		sizes[l * 4 + 1] = int32_t(h);
+		sizes[l * 4 + 2] = int32_t(d);
+		offsets[l] = int32_t(std::min<uint64_t>(layer_floats, INT32_MAX));
+		layer_floats += w * h * d * 4;
+	}
+	const uint64_t total = layer_floats * layers;
+	if (total > uint64_t(INT32_MAX))
+		return false;
+	for (uint32_t c = 1; c < layers; ++c)
+		for (uint32_t l = 0; l < lod_count; ++l)
+			offsets[size_t(c) * lod_count + l] = int32_t(c * layer_floats + uint64_t(offsets[l]));
+
+	std::vector<float> texels(total);
+	vexel_block_info_t info;
+	if (vexel_block_info(format.layout(), info)) {
+		if (!decode_block_lods(format, layout, data, work, texels.data()))
+			return false;
+	} else {
+		const vexel_converter_t* converter = vexel_converter(format, work);
+		const uint32_t vexel_bytes = vexel_byte_count(format);
+		if (!converter)
+			return false;
+		std::vector<buffer_object_padding_t> packed;
+		if (!lods) {
+			packed.resize(lod_count);
+			vexel_lod_padding(layout, vexel_bytes, 0, packed.data());
+			lods = packed.data();
+		}
+
+		// Una entrada por corte de cada nivel y capa; las filas de todas se reparten juntas
+		struct slice_t {
+			const uint8_t*	src;
+			uint64_t		pitch;
+			uint64_t		first_row;
+			int32_t			level;
+			int32_t			offset;		// en floats
+		};
+		std::vector<slice_t> slices;
+		uint64_t rows = 0;
+		for (uint32_t c = 0; c < layers; ++c) {
+			uint64_t level_offset = 0;
+			for (uint32_t l = 0; l < lod_count; ++l) {
+				const buffer_object_padding_t& p = lods[l];
+				const int32_t* size = &sizes[l * 4];
+				if (p.row_byte_count < uint64_t(size[0]) * vexel_bytes || p.surface_byte_count < p.row_byte_count * uint64_t(size[1]))
+					return false;
+				for (int32_t z = 0; z < size[2]; ++z) {
+					slices.push_back({
+						static_cast<const uint8_t*>(data) + c * lods[0].object_byte_count + level_offset + z * p.surface_byte_count,
+						p.row_byte_count,
+						rows,
+						int32_t(l),
+						offsets[size_t(c) * lod_count + l] + z * size[0] * size[1] * 4,
+					});
+					rows += uint64_t(size[1]);
+				}
+				level_offset += p.volume_byte_count;
+			}
+		}
+
+		parallel_for(rows, 64, [&](size_t begin, size_t end) {
+			auto it = std::upper_bound(slices.begin(), slices.end(), uint64_t(begin),
+									   [](uint64_t r, const slice_t& s) { return r < s.first_row; }) - 1;
+			for (size_t r = begin; r < end; ++r) {
+				while (it + 1 != slices.end() && (it + 1)->first_row <= r)
+					++it;
+				const int32_t* size = &sizes[it->level * 4];
+				const uint64_t y = r - it->first_row;
+				convert(*converter, it->src + y * it->pitch, &texels[it->offset + y * size[0] * 4], size_t(size[0]));
+			}
+		});
+	}
+
+	texture.object_layout = layout.object_layout;
+	texture.space = space;
+	texture.layer_count = layers;
+	texture.lod_count = lod_count;
+	texture.sizes = std::move(sizes);
+	texture.offsets = std::move(offsets);
+	texture.texels = std::move(texels);
+	return true;
+}
+
+DLL_FNC(bool) sample_texture(const sampler_texture_t& texture, const buffer_sampler_t& sampler, uint32_t layer,
+							 const simd_pack_t<8, float>& u, const simd_pack_t<8, float>& v, const simd_pack_t<8, float>& w,
+							 const simd_pack_t<8, float>& lod, sampler_rgba_t& out, const float* border)
+{
+	sample_plan_t plan;
+	if (!make_plan(texture, sampler, layer, border, plan))
+		return false;
+
+	alignas(32) float result[32];
+	select_sample_kernel()(plan, &u[0], &v[0], &w[0], &lod[0], result);
+	for (int lane = 0; lane < 8; ++lane) {
+		out.r[lane] = result[lane];
+		out.g[lane] = result[8 + lane];
+		out.b[lane] = result[16 + lane];
+		out.a[lane] = result[24 + lane];
+	}
+	return true;
+}
+
+DLL_FNC(bool) sample_texture(const sampler_texture_t& texture, const buffer_sampler_t& sampler, uint32_t layer, size_t count,
+							 const float* u, const float* v, const float* w, const float* lod, float* rgba,
+							 const float* border)
+{
+	sample_plan_t plan;
+	if (!make_plan(texture, sampler, layer, border, plan))
+		return false;
+
+	const sample_batch_fn kernel = select_sample_kernel();
+	parallel_for((count + 7) / 8, kBatchGrain, [&](size_t begin, size_t end) {
+		alignas(32) float in[4][8];
+		alignas(32) float result[32];
+		const float* src[4] = { u, v, w, lod };
+		for (size_t b = begin; b < end; ++b) {
+			const size_t first = b * 8, lanes = std::min<size_t>(8, count - first);
+			for (int k = 0; k < 4; ++k) {
+				std::fill(in[k], in[k] + 8, 0.0f);
+				if (src[k])
+					std::memcpy(in[k], src[k] + first, lanes * sizeof(float));
+			}
+			kernel(plan, in[0], in[1], in[2], in[3], result);
+			for (size_t lane = 0; lane < lanes; ++lane)
+				for (int k = 0; k < 4; ++k)
+					rgba[(first + lane) * 4 + k] = result[k * 8 + lane];
+		}
+	});
+	return true;
+}
@@ -0,0 +1,311 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <pre/cpu_features.h>
+#include <core/vexel_tiling.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(SIMD_KERNELS_X86)
+#	include <immintrin.h>
+#endif
+
+// Cada tarea copia filas de tiles completas. En un tile lleno no se comprueban bordes; los parciales se ponen a cero
+// antes de copiar los vexels que existen. La ruta BMI2 recorre la memoria del tile en orden (escrituras o lecturas
+// secuenciales) y saca (x, y) con pext; la portable recorre las filas del tile y avanza el índice Z de x con
+// (i - x_mask) & x_mask. pext está microcodificado en Zen 1/2, donde la ruta portable es la rápida; allí se puede
+// forzar con simd::force_isa(simd::isa_t::SCALAR).
+
+namespace {
+
+	void morton_masks(uint32_t width, uint32_t height, uint32_t& x_mask, uint32_t& y_mask)
+	{
+		x_mask = y_mask = 0;
+		uint32_t bit = 1;
+		for (uint32_t x = width >> 1, y = height >> 1; x || y;) {
+			if (x) {
+				x_mask |= bit;
+				bit <<= 1;
+				x >>= 1;
+			}
+			if (y) {
+				y_mask |= bit;
+				bit <<= 1;
+				y >>= 1;
+			}
+		}
+	}
+
+	// Reparte los bits bajos de v en las posiciones de mask (pdep portable)
+	uint32_t deposit(uint32_t v, uint32_t mask)
+	{
+		uint32_t r = 0;
+		for (uint32_t b = 1; mask; b <<= 1, mask &= mask - 1)
+			if (v & b)
+				r |= mask & (0u - mask);
+		return r;
+	}
+
+	struct tile_copy_t {
+		const uint8_t*		src;
+		uint8_t*			dst;
+		uint64_t			src_pitch;
+		uint64_t			dst_pitch;
+		uint64_t			width;
+		uint32_t			height;
+		uint32_t			vexel_bytes;
+		vexel_tile_info_t	info;
+		bool				to_tiled;	// src lineal -> dst en tiles; si no, al revés
+	};
+
+	// B = 0: tamaño en tiempo de ejecución
+	template<uint32_t B>
+	inline void copy_vexels(uint8_t* dst, const uint8_t* src, uint32_t bytes, uint32_t count)
+	{
+		std::memcpy(dst, src, (B ? B : bytes) * count);
+	}
+
+	// Dirección de un tile y de su primer vexel en la superficie lineal
+	struct tile_ref_t {
+		uint8_t*		tiled;
+		uint8_t*		linear;
+		uint64_t		linear_pitch;
+		uint32_t		cols;		// vexels que existen en el tile
+		uint32_t		rows;
+	};
+
+	// Tile parcial: vexel a vexel, recorriendo sus filas
+	template<uint32_t B>
+	void copy_tile_partial(const tile_copy_t& c, const tile_ref_t& r)
+	{
+		const vexel_tile_info_t& t = c.info;
+		if (c.to_tiled)
+			std::memset(r.tiled, 0, t.byte_count);
+		for (uint32_t y = 0; y < r.rows; ++y) {
+			const uint32_t iy = deposit(y, t.y_mask);
+			uint8_t* row = r.linear + y * r.linear_pitch;
+			uint32_t ix = 0;
+			for (uint32_t x = 0; x < r.cols; ++x, ix = (ix - t.x_mask) & t.x_mask) {
+				uint8_t* tiled = r.tiled + uint64_t(ix | iy) * c.vexel_bytes;
+				uint8_t* linear = row + uint64_t(x) * c.vexel_bytes;
+				if (c.to_tiled)
+					copy_vexels<B>(tiled, linear, c.vexel_bytes, 1);
+				else
+					copy_vexels<B>(linear, tiled, c.vexel_bytes, 1);
+			}
+		}
+	}
+
+	// Tile lleno: los índices Z 4q..4q+3 son el cuadrado 2x2 de (x, y) pares, así que se copian dos parejas de vexels
+	// de dos filas seguidas a 4 vexels seguidos del tile. x avanza de dos en dos con el incremento enmascarado.
+	template<uint32_t B>
+	void copy_tile_full_portable(const tile_copy_t& c, const tile_ref_t& r)
+	{
+		const vexel_tile_info_t& t = c.info;
+		const uint32_t x_mask = t.x_mask & ~1u;
+		const uint32_t pair = 2 * c.vexel_bytes;
+		for (uint32_t y = 0; y < t.height; y += 2) {
+			const uint32_t iy = deposit(y, t.y_mask);
+			uint8_t* row = r.linear + y * r.linear_pitch;
+			uint32_t ix = 0;
+			for (uint32_t x = 0; x < t.width; x += 2, ix = (ix - x_mask) & x_mask) {
+				uint8_t* tiled = r.tiled + uint64_t(ix | iy) * c.vexel_bytes;
+				uint8_t* linear = row + uint64_t(x) * c.vexel_bytes;
+				if (c.to_tiled) {
+					copy_vexels<B>(tiled, linear, c.vexel_bytes, 2);
+					copy_vexels<B>(tiled + pair, linear + r.linear_pitch, c.vexel_bytes, 2);
+				} else {
+					copy_vexels<B>(linear, tiled, c.vexel_bytes, 2);
+					copy_vexels<B>(linear + r.linear_pitch, tiled + pair, c.vexel_bytes, 2);
+				}
+			}
+		}
+	}
+
+#if defined(SIMD_KERNELS_X86)
+
+	// Igual, pero recorriendo el tile en orden de memoria y sacando (x, y) de cada cuadrado con pext
+	template<uint32_t B>
+	SIMD_TARGET("bmi2")
+	void copy_tile_full_bmi2(const tile_copy_t& c, const tile_ref_t& r)
+	{
+		const vexel_tile_info_t& t = c.info;
+		const uint32_t quads = t.width * t.height / 4;
+		const uint32_t pair = 2 * c.vexel_bytes;
+		uint8_t* tiled = r.tiled;
+		for (uint32_t q = 0; q < quads; ++q, tiled += 2 * pair) {
+			const uint32_t x = _pext_u32(q << 2, t.x_mask), y = _pext_u32(q << 2, t.y_mask);
+			uint8_t* linear = r.linear + y * r.linear_pitch + uint64_t(x) * c.vexel_bytes;
+			if (c.to_tiled) {
+				copy_vexels<B>(tiled, linear, c.vexel_bytes, 2);
+				copy_vexels<B>(tiled + pair, linear + r.linear_pitch, c.vexel_bytes, 2);
+			} else {
+				copy_vexels<B>(linear, tiled, c.vexel_bytes, 2);
+				copy_vexels<B>(linear + r.linear_pitch, tiled + pair, c.vexel_bytes, 2);
+			}
+		}
+	}
+
+#endif
+
+	using tile_fn = void (*)(const tile_copy_t& c, const tile_ref_t& r);
+
+	template<tile_fn Full, tile_fn Partial>
+	void copy_tile_rows(const tile_copy_t& c, size_t begin, size_t end)
+	{
+		const vexel_tile_info_t& t = c.info;
+		const uint64_t tiles_x = (c.width + t.width - 1) / t.width;
+		const uint64_t linear_pitch = c.to_tiled ? c.src_pitch : c.dst_pitch;
+		const uint64_t tiled_pitch = c.to_tiled ? c.dst_pitch : c.src_pitch;
+		uint8_t* linear = const_cast<uint8_t*>(c.to_tiled ? c.src : c.dst);
+		uint8_t* tiled = const_cast<uint8_t*>(c.to_tiled ? c.dst : c.src);
+		// Los tiles de una sola columna (vexels de 64 bytes en MORTON_64X64) no tienen cuadrados 2x2
+		const bool quads = t.width >= 2 && t.height >= 2;
+
+		for (size_t ty = begin; ty < end; ++ty) {
+			const uint32_t y0 = uint32_t(ty * t.height);
+			for (uint64_t tx = 0; tx < tiles_x; ++tx) {
+				const uint64_t x0 = tx * t.width;
+				const tile_ref_t r = {
+					tiled + ty * tiled_pitch + tx * t.byte_count,
+					linear + y0 * linear_pitch + x0 * c.vexel_bytes,
+					linear_pitch,
+					uint32_t(std::min<uint64_t>(t.width, c.width - x0)),
+					std::min(t.height, c.height - y0),
+				};
+				if (quads && r.cols == t.width && r.rows == t.height)
+					Full(c, r);
+				else
+					Partial(c, r);
+			}
+		}
+	}
+
+	using tile_rows_fn = void (*)(const tile_copy_t& c, size_t begin, size_t end);
+
+	template<uint32_t B>
+	tile_rows_fn select_tile_rows()
+	{
+#if defined(SIMD_KERNELS_X86)
+		if (cpu_has(CPU_BMI2_BIT) && simd::kernels().isa != simd::isa_t::SCALAR)
+			return copy_tile_rows<copy_tile_full_bmi2<B>, copy_tile_partial<B>>;
+#endif
+		return copy_tile_rows<copy_tile_full_portable<B>, copy_tile_partial<B>>;
+	}
+
+	tile_rows_fn select_tile_rows(uint32_t vexel_bytes)
+	{
+		switch (vexel_bytes) {
+		case 1:		return select_tile_rows<1>();
+		case 2:		return select_tile_rows<2>();
+		case 4:		return select_tile_rows<4>();
+		case 8:		return select_tile_rows<8>();
+		case 16:	return select_tile_rows<16>();
+		default:	return select_tile_rows<0>();
+		}
+	}
+
+	uint64_t surface_pitch(const vexel_surface_t& s, const vexel_tile_info_t& t)
+	{
+		if (s.row_byte_count[0])
+			return s.row_byte_count[0];
+		return (s.layout.object_size.width + t.width - 1) / t.width * t.byte_count;
+	}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+DLL_FNC(bool) vexel_tile_info(buffer_tiling_t tiling, uint32_t vexel_byte_count, vexel_tile_info_t& info)
+{
+	if (!vexel_byte_count)
+		return false;
+	switch (tiling) {
+	case buffer_tiling_t::LINEAR:
+		info.width = info.height = 1;
+		break;
+	case buffer_tiling_t::MORTON_4X4:
+		info.width = info.height = 4;
+		break;
+	case buffer_tiling_t::MORTON_64X64:
+		if (vexel_byte_count > 64 || (vexel_byte_count & (vexel_byte_count - 1)))
+			return false;
+		info.width = 64 / vexel_byte_count;
+		info.height = 64;
+		break;
+	default:
+		return false;
+	}
+	info.byte_count = info.width * info.height * vexel_byte_count;
+	morton_masks(info.width, info.height, info.x_mask, info.y_mask);
+	return true;
+}
+
+DLL_FNC(uint64_t) tiled_vexel_offset(const vexel_tile_info_t& info, uint32_t vexel_byte_count, uint64_t row_byte_count,
+									uint64_t x, uint32_t y)
+{
+	const uint64_t tile = (y / info.height) * row_byte_count + (x / info.width) * info.byte_count;
+	const uint32_t z = deposit(uint32_t(x % info.width), info.x_mask) | deposit(y % info.height, info.y_mask);
+	return tile + uint64_t(z) * vexel_byte_count;
+}
+
+DLL_FNC(bool) copy_surface_tiling(const vexel_surface_t& src, const vexel_surface_t& dst)
+{
+	const uint32_t vexel_bytes = vexel_byte_count(src.format);
+	const uint64_t width = src.layout.object_size.width;
+	const uint32_t height = std::max<uint32_t>(1, src.layout.object_size.height);
+	if (!vexel_bytes || vexel_byte_count(dst.format) != vexel_bytes || dst.layout.object_size.width != width ||
+		std::max<uint32_t>(1, dst.layout.object_size.height) != height)
+		return false;
+
+	vexel_tile_info_t src_tile, dst_tile;
+	if (!vexel_tile_info(src.layout.tiling, vexel_bytes, src_tile) || !vexel_tile_info(dst.layout.tiling, vexel_bytes, dst_tile))
+		return false;
+	if (!width)
+		return true;
+
+	const uint8_t* s = static_cast<const uint8_t*>(src.planes[0]);
+	uint8_t* d = static_cast<uint8_t*>(dst.planes[0]);
+	const uint64_t src_pitch = surface_pitch(src, src_tile);
+	const uint64_t dst_pitch = surface_pitch(dst, dst_tile);
+	const buffer_tiling_t from = src.layout.tiling, to = dst.layout.tiling;
+
+	// Mismo orden: filas (o filas de tiles) enteras
+	if (from == to) {
+		const uint64_t row_bytes = (width + src_tile.width - 1) / src_tile.width * src_tile.byte_count;
+		const size_t rows = (height + src_tile.height - 1) / src_tile.height;
+		parallel_for(rows, std::max<size_t>(1, 64 / src_tile.height), [&](size_t begin, size_t end) {
+			for (size_t r = begin; r < end; ++r)
+				std::memcpy(d + r * dst_pitch, s + r * src_pitch, row_bytes);
+		});
+		return true;
+	}
+
+	if (from == buffer_tiling_t::LINEAR || to == buffer_tiling_t::LINEAR) {
+		const bool to_tiled = from == buffer_tiling_t::LINEAR;
+		const tile_copy_t c = { s, d, src_pitch, dst_pitch, width, height, vexel_bytes, to_tiled ? dst_tile : src_tile, to_tiled };
+		const tile_rows_fn rows_fn = select_tile_rows(vexel_bytes);
+		parallel_for((height + c.info.height - 1) / c.info.height, std::max<size_t>(1, 64 / c.info.height),
+					 [&](size_t begin, size_t end) { rows_fn(c, begin, end); });
+		return true;
+	}
+
+	// Entre dos tilings: cada vexel del destino por su dirección en el origen
+	if (width % dst_tile.width || height % dst_tile.height)
+		for (uint64_t r = 0, rows = (height + dst_tile.height - 1) / dst_tile.height; r < rows; ++r)
+			std::memset(d + r * dst_pitch, 0, (width + dst_tile.width - 1) / dst_tile.width * dst_tile.byte_count);
+	parallel_for(height, 64, [&](size_t begin, size_t end) {
+		for (size_t y = begin; y < end; ++y)
+			for (uint64_t x = 0; x < width; ++x)
+				std::memcpy(d + tiled_vexel_offset(dst_tile, vexel_bytes, dst_pitch, x, uint32_t(y)),
+							s + tiled_vexel_offset(src_tile, vexel_bytes, src_pitch, x, uint32_t(y)), vexel_bytes);
+	});
+	return true;
+}
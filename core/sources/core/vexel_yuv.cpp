@@ -0,0 +1,430 @@
+#define BUILD_DLL
+
+#include <pre.h>
+#include <core/vexel_yuv.h>
+#include <core/vexel_convert.h>
+#include <core/threading.h>
+#include <simd/simd_dispatch.h>
+
+#include "simd/simd_kernels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Cada fila se lleva a float con las muestras en su rango de códigos y la matriz se aplica con los kernels de
+// simd::kernels() (scale_f32 + add_f32 sobre filas enteras); el lado RGB pasa por RGBA float y un vexel_converter_t.
+// La croma se sobremuestrea/submuestrea en float antes/después de la matriz.
+
+namespace {
+
+	enum class yuv_kind_t : uint8_t { PLANAR, SEMI_PLANAR, PACKED_YUYV, PACKED_UYVY };
+
+	// Dónde está cada muestra: plano, primera muestra de la fila y separación entre muestras consecutivas
+	struct yuv_channel_t {
+		uint8_t plane;
+		uint8_t first;
+		uint8_t stride;
+	};
+
+	struct yuv_desc_t {
+		yuv_kind_t		kind;
+		uint8_t			sub_x;			// 1: croma a la mitad de resolución en ese eje
+		uint8_t			sub_y;
+		uint8_t			bytes;			// por muestra
+		yuv_channel_t	chan[3];		// Y, U, V
+	};
+
+	bool describe_yuv(vexel_format_t f, yuv_desc_t& d)
+	{
+		switch (f.layout()) {
+		case vexel_layout_t::BLOCK_YUV_420_Y_U_V:	d.kind = yuv_kind_t::PLANAR;		d.sub_x = 1; d.sub_y = 1; break;
+		case vexel_layout_t::BLOCK_YUV_420_Y_UV:	d.kind = yuv_kind_t::SEMI_PLANAR;	d.sub_x = 1; d.sub_y = 1; break;
+		case vexel_layout_t::BLOCK_YUV_422_Y_U_V:	d.kind = yuv_kind_t::PLANAR;		d.sub_x = 1; d.sub_y = 0; break;
+		case vexel_layout_t::BLOCK_YUV_422_Y_UV:	d.kind = yuv_kind_t::SEMI_PLANAR;	d.sub_x = 1; d.sub_y = 0; break;
+		case vexel_layout_t::BLOCK_YUV_422_YUYV:	d.kind = yuv_kind_t::PACKED_YUYV;	d.sub_x = 1; d.sub_y = 0; break;
+		case vexel_layout_t::BLOCK_YUV_422_UYVY:	d.kind = yuv_kind_t::PACKED_UYVY;	d.sub_x = 1; d.sub_y = 0; break;
+		case vexel_layout_t::BLOCK_YUV_444_Y_U_V:	d.kind = yuv_kind_t::PLANAR;		d.sub_x = 0; d.sub_y = 0; break;
+		case vexel_layout_t::BLOCK_YUV_444_Y_UV:	d.kind = yuv_kind_t::SEMI_PLANAR;	d.sub_x = 0; d.sub_y = 0; break;
+		default: return false;
+		}
+		switch (f.bit_count()) {
+		case vexel_bit_format_t::UNIFORM_8:		d.bytes = 1; break;
+		case vexel_bit_format_t::UNIFORM_16:	d.bytes = 2; break;
+		default: return false;
+		}
+		if (f.number_format() != vexel_number_format_t::INTEGER || f.is_signed())
+			return false;
+
+		const bool swap = f.order() == vexel_order_t::BGRA;
+		const uint8_t u = swap ? 1 : 0, v = swap ? 0 : 1;
+		switch (d.kind) {
+		case yuv_kind_t::PLANAR:
+			d.chan[0] = { 0, 0, 1 };
+			d.chan[1] = { (uint8_t)(1 + u), 0, 1 };
+			d.chan[2] = { (uint8_t)(1 + v), 0, 1 };
+			break;
+		case yuv_kind_t::SEMI_PLANAR:
+			d.chan[0] = { 0, 0, 1 };
+			d.chan[1] = { 1, u, 2 };
+			d.chan[2] = { 1, v, 2 };
+			break;
+		case yuv_kind_t::PACKED_YUYV:
+			d.chan[0] = { 0, 0, 2 };
+			d.chan[1] = { 0, (uint8_t)(1 + 2 * u), 4 };
+			d.chan[2] = { 0, (uint8_t)(1 + 2 * v), 4 };
+			break;
+		case yuv_kind_t::PACKED_UYVY:
+			d.chan[0] = { 0, 1, 2 };
+			d.chan[1] = { 0, (uint8_t)(2 * u), 4 };
+			d.chan[2] = { 0, (uint8_t)(2 * v), 4 };
+			break;
+		}
+		return true;
+	}
+
+	// Bytes por fila de cada plano cuando row_byte_count es 0
+	uint64_t default_pitch(const yuv_desc_t& d, int plane, size_t w)
+	{
+		const size_t cw = (w + d.sub_x) >> d.sub_x;
+		switch (d.kind) {
+		case yuv_kind_t::PLANAR:		return (plane == 0 ? w : cw) * d.bytes;
+		case yuv_kind_t::SEMI_PLANAR:	return (plane == 0 ? w : 2 * cw) * d.bytes;
+		default:						return 4 * cw * d.bytes;
+		}
+	}
+
+	struct plane_rows_t {
+		uint8_t*	base[3];
+		uint64_t	pitch[3];
+
+		uint8_t* row(int plane, size_t y) const { return base[plane] + y * pitch[plane]; }
+	};
+
+	plane_rows_t yuv_rows(const vexel_surface_t& s, const yuv_desc_t& d, size_t w)
+	{
+		plane_rows_t r;
+		for (int p = 0; p < 3; ++p) {
+			r.base[p] = static_cast<uint8_t*>(s.planes[p]);
+			r.pitch[p] = s.row_byte_count[p] ? s.row_byte_count[p] : default_pitch(d, p, w);
+		}
+		return r;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Muestras
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void read_samples(const uint8_t* row, int bytes, const yuv_channel_t& c, size_t n, float s, float* r)
+	{
+		if (bytes == 1) {
+			if (c.stride == 1) {
+				simd::kernels().u8_to_f32(row + c.first, s, r, n);
+				return;
+			}
+			const uint8_t* p = row + c.first;
+			for (size_t i = 0; i < n; ++i) r[i] = (float)p[i * c.stride] * s;
+		} else {
+			const uint16_t* p = reinterpret_cast<const uint16_t*>(row) + c.first;
+			for (size_t i = 0; i < n; ++i) r[i] = (float)p[i * c.stride] * s;
+		}
+	}
+
+	SIMD_FORCEINLINE uint16_t sat_u16(float v) { v = v > 0.f ? v : 0.f; v = v < 65535.f ? v : 65535.f; return (uint16_t)(int32_t)(v + 0.5f); }
+
+	// f ya está en códigos de muestra
+	void write_samples(uint8_t* row, int bytes, const yuv_channel_t& c, size_t n, const float* f)
+	{
+		if (bytes == 1) {
+			if (c.stride == 1) {
+				simd::kernels().f32_to_u8(f, 1.f, row + c.first, n);
+				return;
+			}
+			uint8_t* p = row + c.first;
+			for (size_t i = 0; i < n; ++i) p[i * c.stride] = simd_internal::sat_u8(f[i]);
+		} else {
+			uint16_t* p = reinterpret_cast<uint16_t*>(row) + c.first;
+			for (size_t i = 0; i < n; ++i) p[i * c.stride] = sat_u16(f[i]);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Matriz y rango
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Códigos: Y = y0 + ys·y con y ∈ [0, 1]; C = c0 + cs·c con c ∈ [-0.5, 0.5]
+	struct yuv_coefs_t {
+		float kr, kg, kb;
+		float y0, ys, c0, cs;
+	};
+
+	yuv_coefs_t yuv_coefs(const yuv_params_t& p, int bytes)
+	{
+		yuv_coefs_t k;
+		switch (p.matrix) {
+		case yuv_matrix_t::BT601:	k.kr = 0.299f;	k.kb = 0.114f;	break;
+		case yuv_matrix_t::BT2020:	k.kr = 0.2627f;	k.kb = 0.0593f;	break;
+		default:					k.kr = 0.2126f;	k.kb = 0.0722f;	break;
+		}
+		k.kg = 1.f - k.kr - k.kb;
+		if (p.range == yuv_range_t::LIMITED) {
+			const float m = bytes == 1 ? 1.f : 256.f;
+			k.y0 = 16.f * m;
+			k.ys = 219.f * m;
+			k.c0 = 128.f * m;
+			k.cs = 224.f * m;
+		} else {
+			const float top = bytes == 1 ? 255.f : 65535.f;
+			k.y0 = 0.f;
+			k.ys = top;
+			k.c0 = (top + 1.f) * 0.5f;
+			k.cs = top;
+		}
+		return k;
+	}
+
+	// RGBA float intermedio en el espacio de la matriz
+	vexel_format_t rgb_format(const yuv_params_t& p)
+	{
+		vexel_format_t f = vexel_format_t::VEC4_F32();
+		f.space(p.matrix == yuv_matrix_t::BT2020 ? vexel_space_t::BT2020 : vexel_space_t::BT709);
+		return f;
+	}
+
+	struct rgb_rows_t {
+		uint8_t*	base;
+		uint64_t	pitch;
+
+		uint8_t* row(size_t y) const { return base + y * pitch; }
+	};
+
+	rgb_rows_t rgb_rows(const vexel_surface_t& s, size_t w)
+	{
+		return { static_cast<uint8_t*>(s.planes[0]), s.row_byte_count[0] ? s.row_byte_count[0] : w * vexel_byte_count(s.format) };
+	}
+
+	bool same_size(const vexel_surface_t& a, const vexel_surface_t& b)
+	{
+		return a.layout.object_size.width == b.layout.object_size.width && a.layout.object_size.height == b.layout.object_size.height;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Croma
+	////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Fila de croma para la fila de luma y, a resolución completa (we >= w valores). tmp: 2·cw floats.
+	void upsample_chroma(const plane_rows_t& rows, const yuv_desc_t& d, const yuv_channel_t& c, size_t y, size_t h,
+						 size_t cw, float s, bool linear, float* tmp, float* out)
+	{
+		const size_t cy = y >> d.sub_y;
+		float* c0 = d.sub_x ? tmp : out;
+		read_samples(rows.row(c.plane, cy), d.bytes, c, cw, s, c0);
+
+		// 4:2:0: la fila de croma queda entre dos de luma; la vecina pesa 1/4
+		if (d.sub_y && linear) {
+			const size_t ch = (h + 1) >> 1;
+			const size_t ny = (y & 1) ? std::min(cy + 1, ch - 1) : (cy ? cy - 1 : 0);
+			if (ny != cy) {
+				float* c1 = tmp + cw;
+				read_samples(rows.row(c.plane, ny), d.bytes, c, cw, s, c1);
+				for (size_t i = 0; i < cw; ++i) c0[i] = 0.75f * c0[i] + 0.25f * c1[i];
+			}
+		}
+		if (!d.sub_x)
+			return;
+
+		if (linear) {
+			// Cosituada: las pares copian, las impares promedian con la siguiente
+			for (size_t i = 0; i + 1 < cw; ++i) {
+				out[2 * i] = c0[i];
+				out[2 * i + 1] = 0.5f * (c0[i] + c0[i + 1]);
+			}
+			out[2 * cw - 2] = out[2 * cw - 1] = c0[cw - 1];
+		} else {
+			for (size_t i = 0; i < cw; ++i) out[2 * i] = out[2 * i + 1] = c0[i];
+		}
+	}
+
+	// Media horizontal [1 2 1]/4 centrada en las muestras pares (o la par sola con NEAREST)
+	void downsample_chroma(const float* f, size_t cw, bool linear, float* out)
+	{
+		if (!linear) {
+			for (size_t i = 0; i < cw; ++i) out[i] = f[2 * i];
+			return;
+		}
+		out[0] = 0.75f * f[0] + 0.25f * f[1];
+		for (size_t i = 1; i < cw; ++i) out[i] = 0.25f * (f[2 * i - 1] + f[2 * i + 1]) + 0.5f * f[2 * i];
+	}
+
+} // namespace
+
+DLL_FNC(bool) is_yuv_layout(vexel_layout_t layout)
+{
+	return layout >= vexel_layout_t::BLOCK_YUV_420_Y_U_V && layout <= vexel_layout_t::BLOCK_YUV_444_Y_UV;
+}
+
+DLL_FNC(bool) yuv_to_rgb(const vexel_surface_t& src, const vexel_surface_t& dst, const yuv_params_t& params)
+{
+	yuv_desc_t d;
+	if (!describe_yuv(src.format, d) || !same_size(src, dst))
+		return false;
+	const vexel_converter_t* out = vexel_converter(rgb_format(params), dst.format);
+	if (!out)
+		return false;
+
+	const size_t w = src.layout.object_size.width, h = src.layout.object_size.height;
+	if (!w || !h)
+		return true;
+	const size_t cw = (w + d.sub_x) >> d.sub_x;
+	const size_t we = cw << d.sub_x;
+	const plane_rows_t in_rows = yuv_rows(src, d, w);
+	const rgb_rows_t out_rows = rgb_rows(dst, w);
+	const bool linear = params.chroma_filter == yuv_chroma_filter_t::LINEAR;
+
+	// Normalizadas: R = y + a·v, G = y - b·u - c·v, B = y + e·u; con y = Y/ys - ky, u = U/cs - kc
+	const yuv_coefs_t k = yuv_coefs(params, d.bytes);
+	const float a = 2.f * (1.f - k.kr), e = 2.f * (1.f - k.kb);
+	const float b = 2.f * k.kb * (1.f - k.kb) / k.kg, c = 2.f * k.kr * (1.f - k.kr) / k.kg;
+	const float ky = k.y0 / k.ys, kc = k.c0 / k.cs;
+
+	parallel_for(h, 16, [&](size_t begin, size_t end) {
+		const simd::kernels_t& K = simd::kernels();
+		std::vector<float> buffer(we * 11 + cw * 2);
+		float* yf = buffer.data();
+		float* uf = yf + we;
+		float* vf = uf + we;
+		float* rf = vf + we;
+		float* gf = rf + we;
+		float* bf = gf + we;
+		float* t = bf + we;
+		float* rgba = t + we;
+		float* tmp = rgba + 4 * we;
+
+		for (size_t y = begin; y < end; ++y) {
+			read_samples(in_rows.row(d.chan[0].plane, y), d.bytes, d.chan[0], w, 1.f / k.ys, yf);
+			upsample_chroma(in_rows, d, d.chan[1], y, h, cw, 1.f / k.cs, linear, tmp, uf);
+			upsample_chroma(in_rows, d, d.chan[2], y, h, cw, 1.f / k.cs, linear, tmp, vf);
+
+			K.scale_f32(vf, a, -(ky + a * kc), t, w);
+			K.add_f32(yf, t, rf, w);
+			K.scale_f32(uf, -b, (b + c) * kc - ky, t, w);
+			K.add_f32(yf, t, gf, w);
+			K.scale_f32(vf, -c, 0.f, t, w);
+			K.add_f32(gf, t, gf, w);
+			K.scale_f32(uf, e, -(ky + e * kc), t, w);
+			K.add_f32(yf, t, bf, w);
+
+			for (size_t x = 0; x < w; ++x) {
+				rgba[4 * x + 0] = rf[x];
+				rgba[4 * x + 1] = gf[x];
+				rgba[4 * x + 2] = bf[x];
+				rgba[4 * x + 3] = 1.f;
+			}
+			convert(*out, rgba, out_rows.row(y), w);
+		}
+	});
+	return true;
+}
+
+DLL_FNC(bool) rgb_to_yuv(const vexel_surface_t& src, const vexel_surface_t& dst, const yuv_params_t& params)
+{
+	yuv_desc_t d;
+	if (!describe_yuv(dst.format, d) || !same_size(src, dst))
+		return false;
+	const vexel_converter_t* in = vexel_converter(src.format, rgb_format(params));
+	if (!in)
+		return false;
+
+	const size_t w = src.layout.object_size.width, h = src.layout.object_size.height;
+	if (!w || !h)
+		return true;
+	const size_t cw = (w + d.sub_x) >> d.sub_x;
+	const size_t ch = (h + d.sub_y) >> d.sub_y;
+	const size_t we = cw << d.sub_x;
+	const rgb_rows_t in_rows = rgb_rows(src, w);
+	const plane_rows_t out_rows = yuv_rows(dst, d, w);
+	const bool linear = params.chroma_filter == yuv_chroma_filter_t::LINEAR;
+	const bool packed = d.kind == yuv_kind_t::PACKED_YUYV || d.kind == yuv_kind_t::PACKED_UYVY;
+
+	// En códigos: Y = y0 + ys·(kr R + kg G + kb B), U = c0 + su·(B - Y), V = c0 + sv·(R - Y)
+	const yuv_coefs_t k = yuv_coefs(params, d.bytes);
+	const float su = k.cs / (2.f * (1.f - k.kb)), sv = k.cs / (2.f * (1.f - k.kr));
+	const float ycoef[3] = { k.kr * k.ys, k.kg * k.ys, k.kb * k.ys };
+	const float ucoef[3] = { -k.kr * su, -k.kg * su, (1.f - k.kb) * su };
+	const float vcoef[3] = { (1.f - k.kr) * sv, -k.kg * sv, -k.kb * sv };
+
+	// Cada unidad es una fila de croma: dos de luma en 4:2:0
+	parallel_for(ch, 8, [&](size_t begin, size_t end) {
+		const simd::kernels_t& K = simd::kernels();
+		std::vector<float> buffer(we * 13 + cw * 2);
+		float* rgba = buffer.data();
+		float* rf = rgba + 4 * we;
+		float* gf = rf + we;
+		float* bf = gf + we;
+		float* yf = bf + we;
+		float* t = yf + we;
+		float* uf = t + we;
+		float* vf = uf + we;
+		float* ua = vf + we;
+		float* va = ua + we;
+		float* cu = va + we;
+		float* cv = cu + cw;
+
+		const auto combine = [&](const float* coef, float offset, float* r) {
+			K.scale_f32(rf, coef[0], offset, r, we);
+			K.scale_f32(gf, coef[1], 0.f, t, we);
+			K.add_f32(r, t, r, we);
+			K.scale_f32(bf, coef[2], 0.f, t, we);
+			K.add_f32(r, t, r, we);
+		};
+
+		for (size_t cy = begin; cy < end; ++cy) {
+			const size_t y0 = cy << d.sub_y;
+			const size_t rows = std::min<size_t>((size_t)1 << d.sub_y, h - y0);
+			// Con NEAREST la croma 4:2:0 sale sólo de la primera fila
+			const size_t chroma_rows = linear ? rows : 1;
+
+			for (size_t r = 0; r < rows; ++r) {
+				const size_t y = y0 + r;
+				convert(*in, in_rows.row(y), rgba, w);
+				for (size_t x = 0; x < w; ++x) {
+					rf[x] = rgba[4 * x + 0];
+					gf[x] = rgba[4 * x + 1];
+					bf[x] = rgba[4 * x + 2];
+				}
+				// Anchura impar: la última pareja repite el último vexel
+				for (size_t x = w; x < we; ++x) {
+					rf[x] = rf[w - 1];
+					gf[x] = gf[w - 1];
+					bf[x] = bf[w - 1];
+				}
+
+				combine(ycoef, k.y0, yf);
+				write_samples(out_rows.row(d.chan[0].plane, y), d.bytes, d.chan[0], packed ? we : w, yf);
+
+				if (r < chroma_rows) {
+					combine(ucoef, 0.f, r ? uf : ua);
+					combine(vcoef, 0.f, r ? vf : va);
+					if (r) {
+						K.add_f32(ua, uf, ua, we);
+						K.add_f32(va, vf, va, we);
+					}
+				}
+			}
+
+			K.scale_f32(ua, 1.f / (float)chroma_rows, k.c0, ua, we);
+			K.scale_f32(va, 1.f / (float)chroma_rows, k.c0, va, we);
+			const float* u_out = ua;
+			const float* v_out = va;
+			if (d.sub_x) {
+				downsample_chroma(ua, cw, linear, cu);
+				downsample_chroma(va, cw, linear, cv);
+				u_out = cu;
+				v_out = cv;
+			}
+			write_samples(out_rows.row(d.chan[1].plane, cy), d.bytes, d.chan[1], cw, u_out);
+			write_samples(out_rows.row(d.chan[2].plane, cy), d.bytes, d.chan[2], cw, v_out);
+		}
+	});
+	return true;
+}